@@ -14,7 +14,7 @@ if [[ $dir == "--help" ]]; then
     printf "    software firmware/main\n    firmware/dongle\n    firmware/test\n    tools/fwsim\n"
     echo
     echo "software targets are one of: "
-    printf "    ai\n    mrftest\n    software_test\n    buildid\n    getcore\n    hall2phase\n    log\n    mrfcap\n    nulltest\n    sdutil\n"
+    printf "    ai\n    mrftest\n    software_test\n    buildid\n    getcore\n    hall2phase\n    log\n    mrfcap\n    mrfbench\n    nulltest\n    sdutil\n"
     echo
     echo "firmware/main targets are one of: "
     printf "    robot_firmware.elf\n    robot_firmware.dfuse\n    robot_firmware.dfu\n"
@@ -6,6 +6,7 @@
 #include "led.h"
 #include "mrf.h"
 #include "radio_config.h"
+#include "shared_util/camera_packet.h"
 #include <FreeRTOS.h>
 #include <errno.h>
 #include <event_groups.h>
@@ -307,11 +308,16 @@ static void handle_camera_endpoint_done(unsigned int UNUSED(ep), BaseType_t *fro
  * \brief Writes a camera packet into the radio transmit buffer and begins
  * sending it.
  *
- * \param[in] packet the variable size camera packet (max. 55 bytes) (8 byte timestamp to be added in the function)
+ * A 55-byte packet is in the legacy format and is repacked to carry only the
+ * robots present; any other length is a compact camera packet, which is sent
+ * verbatim.
+ *
+ * \param[in] packet the camera packet
+ * \param[in] length the length of the packet
  *
  * \pre The transmit mutex must be held by the caller.
 */
-static void send_camera_packet(const void *packet)
+static void send_camera_packet(const void *packet, size_t length)
 {
 	unsigned int address = MRF_REG_LONG_TXNFIFO;
 
@@ -332,9 +338,21 @@ static void send_camera_packet(const void *packet)
 	// Record the header length, now that the header is finished.
 	mrf_write_long(header_length_address, address - header_start_address);
 
-	// Camera packet. 1 = mask, 2-3 = Ball x, 4-5 = Ball y, 6-53 = Robots, 54-61 timestamp
 	const uint8_t *rptr = packet;
 
+	if (length != CAMERA_PACKET_LEGACY_LENGTH) {
+		// Compact camera packet; the robots decode it themselves.
+		mrf_write_long(address++, CAMERA_PACKET_PURPOSE);
+		for (size_t i = 0; i != length; ++i) {
+			mrf_write_long(address++, *rptr++);
+		}
+		mrf_write_long(frame_length_address, address - header_start_address);
+		mrf_write_short(MRF_REG_SHORT_TXNCON, 0b00000001U);
+		return;
+	}
+
+	// Camera packet. 1 = mask, 2-3 = Ball x, 4-5 = Ball y, 6-53 = Robots, 54-61 timestamp
+
 	// Message purpose
 	mrf_write_long(address++, 0X10U);
 
@@ -584,18 +602,19 @@ static void camera_task(void *UNUSED(param)) {
 		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
 
 		// Allocate space to store the camera packet
-		static uint8_t packet_buffer[55]; // The max bytes possible in a camera packet
-		static uint8_t usb_buffer[55];
+		static uint8_t packet_buffer[CAMERA_PACKET_MAX_LENGTH]; // The max bytes possible in a camera packet
+		static uint8_t usb_buffer[CAMERA_PACKET_MAX_LENGTH];
+		size_t packet_length = CAMERA_PACKET_LEGACY_LENGTH;
 
 		// Fill the packet buffer with a safe default.
-		memset(packet_buffer, 0, 55);
+		memset(packet_buffer, 0, sizeof(packet_buffer));
 
 		// Run!
 		bool ep_running = false;
 		for (;;) {
 			// Start the endpoint if possible.
 			if (!ep_running) {
-				if (uep_async_read_start(0x02U, usb_buffer, 55, &handle_camera_endpoint_done)) {
+				if (uep_async_read_start(0x02U, usb_buffer, sizeof(usb_buffer), &handle_camera_endpoint_done)) {
 					ep_running = true;
 				} else {
 					if (errno == EPIPE) {
@@ -616,9 +635,14 @@ static void camera_task(void *UNUSED(param)) {
 				size_t transfer_length;
 				if (uep_async_read_finish(0x02U, &transfer_length)) {
 					ep_running = false;
-					if (transfer_length == 55) {
+					if (transfer_length == CAMERA_PACKET_LEGACY_LENGTH) {
 						// This transfer contains new data for every robot.
-						memcpy(packet_buffer, usb_buffer, 55);
+						memcpy(packet_buffer, usb_buffer, transfer_length);
+						packet_length = transfer_length;
+					} else if (transfer_length >= CAMERA_PACKET_HEADER_LENGTH + 4U) {
+						// This transfer is a compact camera packet.
+						memcpy(packet_buffer, usb_buffer, transfer_length);
+						packet_length = transfer_length;
 					} else {
 						// Transfer is wrong length; reject.
 						uep_halt(0x02U);
@@ -637,7 +661,7 @@ static void camera_task(void *UNUSED(param)) {
 			}
 			// Send a packet.
 			xSemaphoreTake(transmit_mutex, portMAX_DELAY);
-			send_camera_packet(packet_buffer);
+			send_camera_packet(packet_buffer, packet_length);
 			xSemaphoreTake(transmit_complete_sem, portMAX_DELAY);
 			xSemaphoreGive(transmit_mutex);
 		}
@@ -105,9 +105,9 @@ void apply_accel(float linear_accel[2], float angular_accel) {
 		linear_accel[1] *= scaling;
 		angular_accel *= scaling;
 	}
-	static float prev_linear_accel0=0;
-	static float prev_linear_accel1=0;
-	static float prev_angular_accel=0;
+	static SIM_LOCAL float prev_linear_accel0=0;
+	static SIM_LOCAL float prev_linear_accel1=0;
+	static SIM_LOCAL float prev_angular_accel=0;
 	
 	float linear_diff0 = linear_accel[0]-prev_linear_accel0;
 	float linear_diff1 = linear_accel[1]-prev_linear_accel1;
@@ -182,7 +182,7 @@ float compute_accel_track_pos_1D(float d_target, float d_cur, float v_cur, float
 	float d_hysteresis = a_max*0.005f;
 	float v_hysteresis = a_max*0.05f;
 
-	static unsigned int frame = 0;
+	static SIM_LOCAL unsigned int frame = 0;
 	
 	frame++;
 	frame = frame%34;
@@ -8,10 +8,10 @@
 /* Description: Main solver file. */
 #include "solver.h"
 
-Settings settings;
-Params params;
-Workspace work;
-Vars vars;
+SIM_LOCAL Settings settings;
+SIM_LOCAL Params params;
+SIM_LOCAL Workspace work;
+SIM_LOCAL Vars vars;
 
 double eval_gap(void) {
   int i;
@@ -32,6 +32,8 @@ void set_defaults(void) {
   settings.verbose = 1;
   settings.verbose_refinement = 0;
   settings.better_start = 1;
+  settings.warm_start = 0;
+  settings.warm_margin = 1e-1;
   settings.kkt_reg = 1e-7;
 }
 void setup_pointers(void) {
@@ -269,6 +271,21 @@ void better_start(void) {
       work.z[i] = z[i] + alpha;
   }
 }
+void warm_start(void) {
+  /* Keeps x from the previous solve and recomputes the slacks for the new */
+  /* problem. Both the slacks and the duals are kept strictly positive, */
+  /* since the iterations need an interior point to start from. */
+  int i;
+  multbymG(work.buffer, work.x);
+  for (i = 0; i < 8; i++) {
+    work.s[i] = work.h[i] + work.buffer[i];
+    if (work.s[i] < settings.warm_margin)
+      work.s[i] = settings.warm_margin;
+  }
+  for (i = 0; i < 8; i++)
+    if (work.z[i] < settings.warm_margin)
+      work.z[i] = settings.warm_margin;
+}
 void fillrhs_start(void) {
   /* Fill rhs with (-q, 0, h, b). */
   int i;
@@ -302,7 +319,9 @@ long solve(void) {
   fillq();
   fillh();
   fillb();
-  if (settings.better_start)
+  if (settings.warm_start)
+    warm_start();
+  else if (settings.better_start)
     better_start();
   else
     set_start();
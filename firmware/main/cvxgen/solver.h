@@ -23,6 +23,8 @@
 /* Space must be allocated somewhere (testsolver.c, csolve.c or your own */
 /* program) for the global variables vars, params, work and settings. */
 /* At the bottom of this file, they are externed. */
+/* The simulator runs a robot per thread, so each gets its own solver state. */
+#include "../physics.h"
 #ifndef ZERO_LIBRARY_MODE
 #include <math.h>
 #define pm(A, m, n) printmatrix(#A, A, m, n, 1)
@@ -71,6 +73,11 @@ typedef struct Settings_t {
   /* Better start obviates the need for s_init and z_init. */
   double s_init;
   double z_init;
+  /* Start from the solution left in work by the previous solve. Takes */
+  /* precedence over better_start. */
+  int warm_start;
+  /* Smallest slack and dual value a warm start may begin from. */
+  double warm_margin;
   int verbose;
   /* Show extra details of the iterative refinement steps. */
   int verbose_refinement;
@@ -78,10 +85,10 @@ typedef struct Settings_t {
   /* For regularization. Minimum value of abs(D_ii) in the kkt D factor. */
   double kkt_reg;
 } Settings;
-extern Vars vars;
-extern Params params;
-extern Workspace work;
-extern Settings settings;
+extern SIM_LOCAL Vars vars;
+extern SIM_LOCAL Params params;
+extern SIM_LOCAL Workspace work;
+extern SIM_LOCAL Settings settings;
 /* Function definitions in ldl.c: */
 void ldl_solve(double *target, double *var);
 void ldl_factor(void);
@@ -114,6 +121,7 @@ void refine(double *target, double *var);
 double calc_ineq_resid_squared(void);
 double calc_eq_resid_squared(void);
 void better_start(void);
+void warm_start(void);
 void fillrhs_start(void);
 long solve(void);
 
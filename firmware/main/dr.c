@@ -200,6 +200,8 @@ void dr_set_ball_frame(int16_t x, int16_t y) {
 
 /**
  * \brief Sets the ball's camera frame and timestamp.
+ *
+ * \param[in] timestamp the capture time, in microseconds
  */
 void dr_set_ball_frame_timestamp(int16_t x, int16_t y, uint64_t timestamp) {
   float new_x = (float)(x/1000.0);
@@ -208,7 +210,7 @@ void dr_set_ball_frame_timestamp(int16_t x, int16_t y, uint64_t timestamp) {
 
   float delta_x = new_x - ball_camera_data.x;
   float delta_y = new_y - ball_camera_data.y;
-  float delta_t = (float) (new_t - ball_camera_data.timestamp) / 1000.0;
+  float delta_t = (float) (new_t - ball_camera_data.timestamp) / 1000000.0f;
 
   if (delta_t > 0) {
     current_ball_state.vx = delta_x / delta_t;
@@ -217,6 +219,7 @@ void dr_set_ball_frame_timestamp(int16_t x, int16_t y, uint64_t timestamp) {
 
   ball_camera_data.x = new_x;
   ball_camera_data.y = new_y;
+  ball_camera_data.timestamp = new_t;
 }
 
 /**
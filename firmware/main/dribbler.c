@@ -18,7 +18,7 @@
 #define VOLTS_PER_RPM (1.0f / SPEED_CONSTANT) // volts per rpm
 #define VOLTS_PER_RPT (VOLTS_PER_RPM * 60.0f * DRIBBLER_TICK_HZ) // volts per rpt, rpt=revolutions per tick
 #define VOLTS_PER_SPEED_UNIT (VOLTS_PER_RPT / 6.0f) // volts per Hall edge
-#define PHASE_RESISTANCE 0.403f // ohms—EC16 datasheet
+#define DRIBBLER_PHASE_RESISTANCE 0.403f // ohms—EC16 datasheet
 #define SWITCH_RESISTANCE (0.019f*2.0f) // ohms—AO4882 datasheet
 
 #define THERMAL_TIME_CONSTANT_WINDING 1.97f // seconds—EC16 datasheet
@@ -40,20 +40,20 @@
 #define DRIBBLER_SPEED_BUFFER_ZONE 200 // RPM
 
 #define MAX_DRIBBLER_CURRENT 5 // Limit the max current the dribbler can draw when stalled
-#define MAX_DELTA_VOLTAGE (MAX_DRIBBLER_CURRENT * (PHASE_RESISTANCE + SWITCH_RESISTANCE + MIN_RESISTANCE_UNDER_PWM70)) // Limit the current by limiting the max delta voltage we can apply
+#define MAX_DELTA_VOLTAGE (MAX_DRIBBLER_CURRENT * (DRIBBLER_PHASE_RESISTANCE + SWITCH_RESISTANCE + MIN_RESISTANCE_UNDER_PWM70)) // Limit the current by limiting the max delta voltage we can apply
 #define MIN_RESISTANCE_UNDER_PWM70 1.5f
 
 
 // Verify that all the timing requirements are set up properly.
 _Static_assert(!(CONTROL_LOOP_HZ % DRIBBLER_TICK_HZ), "Dribbler period is not a multiple of control loop period.");
 
-static uint8_t dribbler_pwm = 0;
-static bool coasting = true;
-static int32_t desired_speed = 0;
-static unsigned int dribbler_tick_counter = 0;
-static float winding_energy = 0.0f, housing_energy = 0.0f;
-static bool hot = false;
-static unsigned int temperature = 0U;
+static SIM_LOCAL uint8_t dribbler_pwm = 0;
+static SIM_LOCAL bool coasting = true;
+static SIM_LOCAL int32_t desired_speed = 0;
+static SIM_LOCAL unsigned int dribbler_tick_counter = 0;
+static SIM_LOCAL float winding_energy = 0.0f, housing_energy = 0.0f;
+static SIM_LOCAL bool hot = false;
+static SIM_LOCAL unsigned int temperature = 0U;
 
 static void update_thermal_model(float added_winding_energy) {
 	float energy_winding_to_housing = (winding_energy / THERMAL_CAPACITANCE_WINDING - housing_energy / THERMAL_CAPACITANCE_HOUSING) / THERMAL_RESISTANCE_WINDING / DRIBBLER_TICK_HZ;
@@ -131,9 +131,9 @@ void dribbler_tick(log_record_t *record) {
 				applied_voltage = battery * dribbler_pwm / 255.0f;
 			}
 			delta_voltage = applied_voltage - back_emf;
-			float current = delta_voltage / (PHASE_RESISTANCE + SWITCH_RESISTANCE + 1);
+			float current = delta_voltage / (DRIBBLER_PHASE_RESISTANCE + SWITCH_RESISTANCE + 1);
 			//printf("Current PWM = %d AppliedV = %f CurrentPumped = %f\r\n", dribbler_pwm, (double)applied_voltage, (double)current);
-			float power = current * current * (PHASE_RESISTANCE+2);
+			float power = current * current * (DRIBBLER_PHASE_RESISTANCE+2);
 			float energy = power / DRIBBLER_TICK_HZ;
 			motor_set(4U, MOTOR_MODE_FORWARD, dribbler_pwm);
 			update_thermal_model(energy);
@@ -6,6 +6,18 @@
 // define our own PI value here that is a float because M_PI in math.h is a double
 #define P_PI 3.14159265f
 
+/**
+ * \brief Marks file-scope state that belongs to one robot.
+ *
+ * The simulator runs several robots at once, one per thread, so there such
+ * state is thread-local; on the robot itself this expands to nothing.
+ */
+#ifdef FWSIM
+#define SIM_LOCAL __thread
+#else
+#define SIM_LOCAL
+#endif
+
 #ifdef FWSIM
 #define max(a, b)                                                              \
     ({                                                                         \
@@ -8,8 +8,8 @@
 
 #define DRIBBLE_TIME_HORIZON 0.05f //s
 
-static primitive_params_t dribble_param;
-static float destination[3];
+static SIM_LOCAL primitive_params_t dribble_param;
+static SIM_LOCAL float destination[3];
 
 /**
  * \brief Initializes the dribble primitive.
@@ -10,6 +10,7 @@
 #include "../bangbang.h"
 #include "../control.h"
 #include "../dr.h"
+#include "../dribbler.h"
 #include "../physics.h"
 #include "../primitives/move.h"
 #include "../breakbeam.h"
@@ -27,12 +28,12 @@
 
 #define X_SPACE_FACTOR (0.002f)
 
-#define TIME_HORIZON (0.01f)
+#define CATCH_TIME_HORIZON (0.01f)
 #define STATIONARY_VEL_MAX (0.05f)
 #define CURR_STATE_UNIT_CONV 1000000
 #define ROBOTRADIUS (0.06f)
 
-static primitive_params_t catch_param;
+static SIM_LOCAL primitive_params_t catch_param;
 
 /**
  * \brief Initializes the catch primitive.
@@ -54,10 +55,10 @@ static void catch_init(void) {
  * @return void - function returns and must be copied into this module if needed
  */
 
-float catchvelocity; //0.4
-float catchmargin; //8.8
+SIM_LOCAL float catchvelocity; //0.4
+SIM_LOCAL float catchmargin; //8.8
 
-float dribbler_speed;
+SIM_LOCAL float dribbler_speed;
 
 static void catch_start(const primitive_params_t *params) {
 		for( unsigned int i = 0; i < 4; i++ ){
@@ -167,7 +168,7 @@ static void catch_tick(log_record_t *log) {
 		float major_vel = major_vec[0]*vel[0] + major_vec[1]*vel[1];
 		PrepareBBTrajectoryMaxV(&major_profile, major_disp, major_vel, end_speed, max_major_a, max_major_v); //3.5, 3.0
 		PlanBBTrajectory(&major_profile);
-		major_accel = BBComputeAvgAccel(&major_profile, TIME_HORIZON);
+		major_accel = BBComputeAvgAccel(&major_profile, CATCH_TIME_HORIZON);
 		float time_major = GetBBTime(&major_profile);
 
 		float max_minor_a = 1;//(get_var(0x02)/4.0);
@@ -176,15 +177,15 @@ static void catch_tick(log_record_t *log) {
 		float minor_vel = minor_vec[0]*vel[0] + minor_vec[1]*vel[1];
 		PrepareBBTrajectoryMaxV(&minor_profile, minor_disp, minor_vel, 0, max_minor_a, max_minor_v); //1.5, 1.5
 		PlanBBTrajectory(&minor_profile);
-		minor_accel = BBComputeAvgAccel(&minor_profile, TIME_HORIZON);
+		minor_accel = BBComputeAvgAccel(&minor_profile, CATCH_TIME_HORIZON);
 		float time_minor = GetBBTime(&minor_profile);
 
 		//timetarget is used for the robot's rotation. It is alwways bigger than 0.1m/s
-		timeTarget = (time_major > TIME_HORIZON) ? time_major : TIME_HORIZON;
+		timeTarget = (time_major > CATCH_TIME_HORIZON) ? time_major : CATCH_TIME_HORIZON;
 
 		//accel[2] is used to find the rotational acceleration
 		float targetVel = 2*relative_destination[2]/timeTarget;
-		accel[2] = (targetVel - vel[2])/TIME_HORIZON;
+		accel[2] = (targetVel - vel[2])/CATCH_TIME_HORIZON;
        }
 	
 	//else statemnet will be executed when the ball is moving faster than 0.05m/s
@@ -206,11 +207,11 @@ static void catch_tick(log_record_t *log) {
 		PrepareBBTrajectoryMaxV(&minor_profile, minor_disp_cur, minor_vel_cur, 0, MAX_X_A, MAX_X_V);
 
 		PlanBBTrajectory(&minor_profile);
-		minor_accel = BBComputeAvgAccel(&minor_profile, TIME_HORIZON);
+		minor_accel = BBComputeAvgAccel(&minor_profile, CATCH_TIME_HORIZON);
 		float time_minor = GetBBTime(&minor_profile);
 
 		// how long it would take to get onto the velocity line with 0 minor vel
-		timeTarget = (time_minor > TIME_HORIZON) ? time_minor : TIME_HORIZON;
+		timeTarget = (time_minor > CATCH_TIME_HORIZON) ? time_minor : CATCH_TIME_HORIZON;
 
 		// now calculate where we would want to end up intercepting the ball
 		float ball_pos_proj[2] = {ballpos[0]+ballvel[0]*timeTarget, ballpos[1]+ballvel[1]*timeTarget};
@@ -230,7 +231,7 @@ static void catch_tick(log_record_t *log) {
 		BBProfile major_profile;
 		PrepareBBTrajectoryMaxV(&major_profile, major_disp_intercept, major_vel, major_vel_intercept, CATCH_MAX_X_V, CATCH_MAX_X_A);
 		PlanBBTrajectory(&major_profile);
-		major_accel = BBComputeAvgAccel(&major_profile, TIME_HORIZON);
+		major_accel = BBComputeAvgAccel(&major_profile, CATCH_TIME_HORIZON);
 		float time_major = GetBBTime(&major_profile);
 
 		major_angle = atan2f(major_vec[1], major_vec[0]);
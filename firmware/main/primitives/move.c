@@ -25,13 +25,13 @@
 #define TIME_HORIZON 0.05f //s
 
 const float PI_2 = P_PI / 2.0f;
-static float destination[3], end_speed, major_vec[2], minor_vec[2];
+static SIM_LOCAL float destination[3], end_speed, major_vec[2], minor_vec[2];
 // store a wheel index here so we only have to calculate the axis
 // we want to use when move start is called
-static unsigned wheel_index;
+static SIM_LOCAL unsigned wheel_index;
 // an array to store the wheel axes in that are perpendicular to
 // each wheel
-static float wheel_axes[8];
+static SIM_LOCAL float wheel_axes[8];
 
 /**
  * builds an array that contains all of the axes perpendicular to
@@ -156,7 +156,6 @@ static void move_start(const primitive_params_t *params)
 	//				end_speed [millimeter/s]
   
 	// Convert into m/s and rad/s because physics is in m and s
-	printf("Move start called.\n");
 	destination[0] = (float) (params->params[0]) / 1000.0f;
 	destination[1] = (float) (params->params[1]) / 1000.0f;
 	destination[2] = (float) (params->params[2]) / 100.0f;
@@ -178,8 +177,10 @@ static void move_start(const primitive_params_t *params)
 	// pick the wheel axis that will be used for faster movement
 	wheel_index = choose_wheel_axis(dx, dy, current_states.angle, destination[2]);
 
+#ifndef FWSIM
     if (params->extra & 0x01) chicker_auto_arm(CHICKER_KICK, 5.5);
 	if(params->extra & 0x02) dribbler_set_speed(16000);
+#endif
 }
 
 /**
@@ -192,8 +193,10 @@ static void move_start(const primitive_params_t *params)
  */
 static void move_end(void) 
 {
+#ifndef FWSIM
 	chicker_auto_disarm();
     dribbler_set_speed(0);
+#endif
 }
 
 
@@ -207,7 +210,6 @@ static void move_end(void)
  * @return void 
  */
 static void move_tick(log_record_t *log) {
-	printf("Move tick called.\n");
 	// get the state of the bot
 	dr_data_t current_states;
 	dr_get(&current_states);
@@ -24,8 +24,8 @@
 #define END_SPEED 1.5f
 #define WITHIN_THRESH(X) (X<=THRESH && X>=-THRESH)
 
-static float radius, angle, center[2], final_dest[2]; 
-static int dir = 1;
+static SIM_LOCAL float radius, angle, center[2], final_dest[2]; 
+static SIM_LOCAL int dir = 1;
 /**
  * \brief Initializes the pivot primitive.
  *
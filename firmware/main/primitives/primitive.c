@@ -5,6 +5,7 @@
 #endif // FWSIM
 
 #include "primitive.h"
+#include "physics.h"
 #include "catch.h"
 #include "direct_velocity.h"
 #include "direct_wheels.h"
@@ -69,12 +70,12 @@ static SemaphoreHandle_t primitive_mutex;
 /**
  * \brief The primitive that is currently operating.
  */
-static const primitive_t *primitive_current;
+static SIM_LOCAL const primitive_t *primitive_current;
 
 /**
  * \brief The index number of the current primitive.
  */
-static unsigned int primitive_current_index;
+static SIM_LOCAL unsigned int primitive_current_index;
 
 /**
  * \brief Initializes the movement primitive manager and all the primitives.
@@ -26,8 +26,8 @@
 #define NUM_SPLINE_POINTS 50
 #endif
 
-static float destination[3], major_vec[2], minor_vec[2], total_rot, shoot_power;
-static bool chip;
+static SIM_LOCAL float destination[3], major_vec[2], minor_vec[2], total_rot, shoot_power;
+static SIM_LOCAL bool chip;
 
 /**
  * Scales the major acceleration by the distance from the major axis and the
@@ -123,7 +123,6 @@ static void shoot_init(void) {
  */
 static void shoot_start(const primitive_params_t *params) {
 
-    printf("Shoot start called.\n");
     // Convert into m/s and rad/s because physics is in m and s
     destination[0] = ((float) (params->params[0]) / 1000.0f);
     destination[1] = ((float) (params->params[1]) / 1000.0f);
@@ -142,7 +141,9 @@ static void shoot_start(const primitive_params_t *params) {
     total_rot = min_angle_delta(destination[2], states.angle);
     float shoot_power = (float) params->params[3]/1000.0f;
 	chip = params->extra & 1;
+#ifndef FWSIM
     chicker_auto_arm( chip ? CHICKER_CHIP : CHICKER_KICK, shoot_power);
+#endif
 }
 
 /**
@@ -178,7 +179,6 @@ static void shoot_end(void) {
  * \c NULL if no record is to be filled
  */
 static void shoot_tick(log_record_t *log) {
-    printf("Shoot tick called.\n");
     dr_data_t states;
     dr_get(&states);
     PhysBot pb = setup_bot(states, destination, major_vec, minor_vec);
@@ -13,14 +13,14 @@
 
 #define TIME_HORIZON 0.5f
 
-static float x_final;
-static float y_final;
-static float avel_final;
-static bool slow;
-
-static float major_vec[2];
-static float minor_vec[2];
-static float major_angle;
+static SIM_LOCAL float x_final;
+static SIM_LOCAL float y_final;
+static SIM_LOCAL float avel_final;
+static SIM_LOCAL bool slow;
+
+static SIM_LOCAL float major_vec[2];
+static SIM_LOCAL float minor_vec[2];
+static SIM_LOCAL float major_angle;
 
 /**
  * \brief Initializes the spin primitive.
@@ -26,6 +26,7 @@
 #include "rtc.h"
 #include "primitives/primitive.h"
 #include "physics.h"
+#include "shared_util/camera_packet.h"
 #include <FreeRTOS.h>
 #include <assert.h>
 #include <semphr.h>
@@ -91,6 +92,8 @@ static void receive_task(void *UNUSED(param)) {
 					}else if(dma_buffer[MESSAGE_PURPOSE_ADDR] == 0x10U){
 						uint8_t buffer_position = MESSAGE_PAYLOAD_ADDR; 
 						handle_camera_packet(dma_buffer, buffer_position);
+					} else if (dma_buffer[MESSAGE_PURPOSE_ADDR] == CAMERA_PACKET_PURPOSE && frame_length >= MESSAGE_PAYLOAD_ADDR + FOOTER_LENGTH) {
+						handle_compact_camera_packet(dma_buffer + MESSAGE_PAYLOAD_ADDR, frame_length - MESSAGE_PAYLOAD_ADDR - FOOTER_LENGTH);
 					}
 				}
 				// Otherwise, it is a message packet specific to this robot.
@@ -325,6 +328,94 @@ void handle_camera_packet(uint8_t * dma_buffer, uint8_t buffer_position){
 	}
 }
 
+/**
+ * \brief Decodes a compact camera packet and applies this robot’s pose, if
+ * present.
+ *
+ * The layout is described in shared_util/camera_packet.h. Delta records are
+ * relative to the last keyframe this robot received, and are ignored if that
+ * keyframe’s generation does not match, meaning an intervening keyframe was
+ * lost.
+ *
+ * \param[in] payload the packet, starting at the flags byte
+ * \param[in] length the length of the packet
+ */
+void handle_compact_camera_packet(const uint8_t *payload, size_t length) {
+	static bool key_valid = false;
+	static uint8_t key_generation;
+	static int16_t key_x, key_y, key_angle;
+	static uint64_t last_timestamp = 0;
+
+	if (length < CAMERA_PACKET_HEADER_LENGTH) {
+		return;
+	}
+	uint8_t flags = payload[0U];
+	if (flags & CAMERA_FLAG_PADDED) {
+		--length;
+	}
+	size_t timestamp_bytes = (flags & CAMERA_FLAG_FULL_TIMESTAMP) ? 8U : 4U;
+	if (length < CAMERA_PACKET_HEADER_LENGTH + timestamp_bytes) {
+		return;
+	}
+
+	int16_t ball_x = (int16_t) (payload[1U] | (payload[2U] << 8U));
+	int16_t ball_y = (int16_t) (payload[3U] | (payload[4U] << 8U));
+
+	// A short timestamp borrows its high word from the last full one.
+	uint64_t timestamp = 0;
+	for (size_t i = 0; i != timestamp_bytes; ++i) {
+		timestamp |= (uint64_t) payload[CAMERA_PACKET_HEADER_LENGTH + i] << (8U * i);
+	}
+	if (!(flags & CAMERA_FLAG_FULL_TIMESTAMP)) {
+		timestamp |= last_timestamp & UINT64_C(0xFFFFFFFF00000000);
+	}
+	last_timestamp = timestamp;
+
+	bool contains_robot = false;
+	size_t pos = CAMERA_PACKET_HEADER_LENGTH + timestamp_bytes;
+	while (pos < length) {
+		uint8_t header = payload[pos];
+		bool keyframe = !!(header & CAMERA_RECORD_KEYFRAME);
+		size_t record_length = keyframe ? CAMERA_KEYFRAME_LENGTH : CAMERA_DELTA_LENGTH;
+		if (pos + record_length > length) {
+			break;
+		}
+		if ((header & CAMERA_RECORD_INDEX_MASK) == robot_index) {
+			uint8_t generation = (header >> CAMERA_RECORD_GENERATION_SHIFT) & CAMERA_RECORD_GENERATION_MASK;
+			const uint8_t *rec = &payload[pos + 1U];
+			if (keyframe) {
+				key_valid = true;
+				key_generation = generation;
+				key_x = (int16_t) (rec[0U] | (rec[1U] << 8U));
+				key_y = (int16_t) (rec[2U] | (rec[3U] << 8U));
+				key_angle = (int16_t) (rec[4U] | (rec[5U] << 8U));
+				dr_set_robot_frame(key_x, key_y, key_angle);
+				contains_robot = true;
+			} else if (key_valid && generation == key_generation) {
+				int angle = key_angle + (int8_t) rec[2U] * CAMERA_DELTA_ANGLE_SCALE;
+				if (angle > 3141) {
+					angle -= 6283;
+				} else if (angle < -3141) {
+					angle += 6283;
+				}
+				dr_set_robot_frame(
+						(int16_t) (key_x + (int8_t) rec[0U] * CAMERA_DELTA_POSITION_SCALE),
+						(int16_t) (key_y + (int8_t) rec[1U] * CAMERA_DELTA_POSITION_SCALE),
+						(int16_t) angle);
+				contains_robot = true;
+			}
+		}
+		pos += record_length;
+	}
+
+	if (contains_robot) {
+		timeout_ticks = 1000U / portTICK_PERIOD_MS;
+		dr_set_robot_timestamp(timestamp);
+	}
+	rtc_set(timestamp);
+	dr_set_ball_frame_timestamp(ball_x, ball_y, timestamp);
+}
+
 void handle_other_packet(uint8_t * dma_buffer, size_t frame_length){
 	//printf("got a message with purpose: %i", dma_buffer[MESSAGE_PURPOSE_ADDR]);
 	//printf("var index: %i", dma_buffer[MESSAGE_PURPOSE_ADDR + 1]);
@@ -2,6 +2,7 @@
 #define RECEIVE_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include "log.h"
 
@@ -10,6 +11,7 @@ void receive_shutdown(void);
 void receive_tick(log_record_t *record);
 uint8_t receive_last_serial(void);
 void handle_camera_packet(uint8_t *, uint8_t);
+void handle_compact_camera_packet(const uint8_t *, size_t);
 void handle_drive_packet(uint8_t *);
 void handle_other_packet(uint8_t *, size_t);
 #endif
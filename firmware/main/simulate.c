@@ -1,103 +1,351 @@
 #ifdef FWSIM
 #include "simulate.h"
 #include "physics.h"
+#include <math.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 
 const float MU = 0.6;
 const float SLIP_FORCE = 0.8 * /* MU */ ROBOT_POINT_MASS * 9.8 * 0.25 /*weight distribution (not entirely accurate)*/;
-static float pos[3] = {0};
-static float vel[3] = {0};
-static float accel[3];
-static float force3[3];
-static float force4[4];
-static bool slip[4];
 
-static FILE* logFile;
+/**
+ * \brief The robot used by a thread that has not selected one.
+ */
+static __thread sim_robot_t default_robot;
+
+/**
+ * \brief The robot selected by the calling thread, or null for the default.
+ */
+static __thread sim_robot_t *current_robot;
+
+/**
+ * \brief Resets a robot to rest at the origin, not logging.
+ *
+ * \param[out] robot the robot to initialize
+ */
+void sim_robot_init(sim_robot_t *robot)
+{
+    memset(robot, 0, sizeof(*robot));
+    robot->log_file   = NULL;
+    robot->slip_force = SLIP_FORCE;
+    robot->friction   = 1.0f;
+}
+
+/**
+ * \brief Returns a uniformly distributed number in [0, 1) from a robot’s
+ * xorshift generator.
+ */
+static double sim_uniform(sim_robot_t *robot)
+{
+    robot->rng ^= robot->rng << 13;
+    robot->rng ^= robot->rng >> 7;
+    robot->rng ^= robot->rng << 17;
+    return (double)(robot->rng >> 11) / 9007199254740992.0;
+}
+
+/**
+ * \brief Returns a normally distributed number from a robot’s generator.
+ *
+ * \param[in,out] robot the robot whose generator to use
+ * \param[in] stddev the standard deviation
+ */
+static float sim_gaussian(sim_robot_t *robot, float stddev)
+{
+    if (stddev == 0.0f)
+    {
+        return 0.0f;
+    }
+    double u = 1.0 - sim_uniform(robot);
+    double v = sim_uniform(robot);
+    return (float)(stddev * sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v));
+}
+
+/**
+ * \brief Checks whether a noise model affects what \ref dr_get reports.
+ */
+static bool sim_noise_affects_sensing(const sim_noise_t *noise)
+{
+    return noise->encoder_noise != 0.0f || noise->encoder_angular_noise != 0.0f ||
+           noise->camera_noise != 0.0f || noise->camera_angular_noise != 0.0f ||
+           noise->camera_delay || noise->camera_jitter || noise->camera_period;
+}
+
+/**
+ * \brief Starts simulating imperfections on a robot.
+ *
+ * Call this after placing the robot and before starting a primitive, so the
+ * estimate starts out at the robot’s true state.
+ *
+ * \param[in,out] robot the robot
+ * \param[in] noise the imperfections to simulate
+ * \param[in] seed the seed for the random number generator, so that runs are
+ * repeatable
+ */
+void sim_robot_start_noise(sim_robot_t *robot, const sim_noise_t *noise, uint64_t seed)
+{
+    robot->noise = *noise;
+    robot->rng   = seed ? seed : 1;
+    robot->slip_force =
+        SLIP_FORCE * fmaxf(0.1f, 1.0f + sim_gaussian(robot, noise->slip_variation));
+    robot->friction =
+        fmaxf(0.0f, 1.0f + sim_gaussian(robot, noise->friction_variation));
+
+    robot->estimate.x     = robot->pos[0];
+    robot->estimate.y     = robot->pos[1];
+    robot->estimate.angle = robot->pos[2];
+    robot->estimate.vx    = robot->vel[0];
+    robot->estimate.vy    = robot->vel[1];
+    robot->estimate.avel  = robot->vel[2];
+    for (unsigned int i = 0; i < SIM_HISTORY_SIZE; i++)
+    {
+        memcpy(robot->history_pos[i], robot->pos, sizeof(robot->pos));
+        memcpy(robot->history_vel[i], robot->vel, sizeof(robot->vel));
+    }
+    robot->sense_ticks = 0;
+}
+
+/**
+ * \brief Updates a robot’s state estimate, as the dead reckoning module does
+ * on each robot tick.
+ *
+ * The estimate is integrated from the measured velocity. When a camera frame
+ * arrives, the estimate is reset to the frame and dead reckoned forward over
+ * the nominal camera delay; any jitter in the true delay shows up as error.
+ *
+ * \param[in,out] robot the robot
+ * \param[in] delta_t the time since the last robot tick, in seconds
+ */
+void sim_robot_sense(sim_robot_t *robot, float delta_t)
+{
+    const sim_noise_t *noise = &robot->noise;
+    if (!sim_noise_affects_sensing(noise))
+    {
+        return;
+    }
+
+    unsigned int now = robot->sense_ticks % SIM_HISTORY_SIZE;
+    float vel[3]     = {
+        robot->vel[0] + sim_gaussian(robot, noise->encoder_noise),
+        robot->vel[1] + sim_gaussian(robot, noise->encoder_noise),
+        robot->vel[2] + sim_gaussian(robot, noise->encoder_angular_noise),
+    };
+    memcpy(robot->history_pos[now], robot->pos, sizeof(robot->pos));
+    memcpy(robot->history_vel[now], vel, sizeof(vel));
+
+    dr_data_t *est = &robot->estimate;
+    est->x += vel[0] * delta_t;
+    est->y += vel[1] * delta_t;
+    est->angle += vel[2] * delta_t;
+    est->vx   = vel[0];
+    est->vy   = vel[1];
+    est->avel = vel[2];
+
+    unsigned int period = noise->camera_period ? noise->camera_period : 1;
+    if (robot->sense_ticks % period == 0)
+    {
+        unsigned int delay = noise->camera_delay;
+        if (noise->camera_jitter)
+        {
+            delay += (unsigned int)(sim_uniform(robot) * (noise->camera_jitter + 1));
+        }
+        unsigned int assumed = noise->camera_delay;
+        if (delay > robot->sense_ticks)
+        {
+            delay = (unsigned int)robot->sense_ticks;
+        }
+        if (delay >= SIM_HISTORY_SIZE)
+        {
+            delay = SIM_HISTORY_SIZE - 1;
+        }
+        if (assumed >= SIM_HISTORY_SIZE)
+        {
+            assumed = SIM_HISTORY_SIZE - 1;
+        }
+        const float *frame =
+            robot->history_pos[(now + SIM_HISTORY_SIZE - delay) % SIM_HISTORY_SIZE];
+        est->x     = frame[0] + sim_gaussian(robot, noise->camera_noise);
+        est->y     = frame[1] + sim_gaussian(robot, noise->camera_noise);
+        est->angle = frame[2] + sim_gaussian(robot, noise->camera_angular_noise);
+        for (unsigned int i = assumed; i > 0; i--)
+        {
+            const float *v =
+                robot->history_vel[(now + SIM_HISTORY_SIZE - i + 1) % SIM_HISTORY_SIZE];
+            est->x += v[0] * delta_t;
+            est->y += v[1] * delta_t;
+            est->angle += v[2] * delta_t;
+        }
+    }
+    robot->sense_ticks++;
+}
+
+/**
+ * \brief Selects the robot that the calling thread’s firmware code acts on.
+ *
+ * \param[in] robot the robot, which must outlive its selection, or null to
+ * go back to the thread’s default robot
+ */
+void sim_robot_select(sim_robot_t *robot)
+{
+    current_robot = robot;
+}
+
+/**
+ * \brief Returns the robot that the calling thread’s firmware code acts on.
+ *
+ * \return the selected robot
+ */
+sim_robot_t *sim_robot_current(void)
+{
+    return current_robot ? current_robot : &default_robot;
+}
 
 void dr_get(dr_data_t * ret){
-	ret->x = pos[0];
-	ret->y = pos[1];
-	ret->angle = pos[2];
-	
-	ret->vx = vel[0];
-	ret->vy = vel[1];
-	ret->avel = vel[2];
+	const sim_robot_t *robot = sim_robot_current();
+	if (sim_noise_affects_sensing(&robot->noise))
+	{
+		*ret = robot->estimate;
+		return;
+	}
+	ret->x = robot->pos[0];
+	ret->y = robot->pos[1];
+	ret->angle = robot->pos[2];
+
+	ret->vx = robot->vel[0];
+	ret->vy = robot->vel[1];
+	ret->avel = robot->vel[2];
 }
 
-void sim_apply_wheel_force(const float new_wheel_force[4]){
-    // printf("\nWF0:%f, WF2:%f, WF2:%f,
-    // WF3:%f",new_wheel_force[0],new_wheel_force[1],new_wheel_force[2],new_wheel_force[3]);
+void dr_get_ball(dr_ball_data_t *ret)
+{
+    const sim_robot_t *robot = sim_robot_current();
+    ret->x  = robot->ball[0];
+    ret->y  = robot->ball[1];
+    ret->vx = 0.0f;
+    ret->vy = 0.0f;
+}
+
+/**
+ * \brief Applies wheel forces to a robot, limiting each to what the wheel can
+ * transmit before it slips.
+ *
+ * \param[in,out] robot the robot
+ * \param[in] new_wheel_force the force each wheel tries to apply, in newtons
+ */
+void sim_robot_apply_wheel_force(sim_robot_t *robot, const float new_wheel_force[4]){
     unsigned int i;
     for (i = 0; i < 4; i++)
     {
-        if (new_wheel_force[i] > SLIP_FORCE)
+        if (new_wheel_force[i] > robot->slip_force)
         {
-            // printf("\nSLIPPING, limit = %f, force = %f\n",SLIP_FORCE,
-            // new_wheel_force[i]);
-            force4[i] = SLIP_FORCE;  //* 0.2; TODO: uncomment this
-            slip[i]   = true;
+            robot->force4[i] = robot->slip_force;  //* 0.2; TODO: uncomment this
+            robot->slip[i]   = true;
         }
-        else if (new_wheel_force[i] < -SLIP_FORCE)
+        else if (new_wheel_force[i] < -robot->slip_force)
         {
-            // printf("\nSLIPPING, limit = %f, force = %f\n",SLIP_FORCE,
-            // new_wheel_force[i]);
-            force4[i] = -SLIP_FORCE;  //* 0.2; TODO: uncomment this
-            slip[i]   = true;
+            robot->force4[i] = -robot->slip_force;  //* 0.2; TODO: uncomment this
+            robot->slip[i]   = true;
         }
         else
         {
-            force4[i] = new_wheel_force[i];
-            slip[i]   = false;
+            robot->force4[i] = new_wheel_force[i];
+            robot->slip[i]   = false;
         }
     }
 
-    // printf("\nWF0:%f, WF2:%f, WF2:%f,
-    // WF3:%f",force4[0],force4[1],force4[2],force4[3]);
-    force4_to_force3(force4, force3);
-    // printf("\nFX:%f, FY:%f, FA:%f",force3[0],force3[1],force3[2]);
+    force4_to_force3(robot->force4, robot->force3);
 
     float locaccel[3];
-    locaccel[0] = force3[0] / ROBOT_POINT_MASS;
-    locaccel[1] = force3[1] / ROBOT_POINT_MASS;
-    locaccel[2] = force3[2] * ROBOT_RADIUS / INERTIA;
+    locaccel[0] = robot->force3[0] / ROBOT_POINT_MASS;
+    locaccel[1] = robot->force3[1] / ROBOT_POINT_MASS;
+    locaccel[2] = robot->force3[2] * ROBOT_RADIUS / INERTIA;
 
-    // printf("sim local y accel: %f", locaccel[1]);
-
-    rotate(locaccel, pos[2]);  // put it back in global coords
-    accel[0] = locaccel[0];
-    accel[1] = locaccel[1];
-    accel[2] = locaccel[2];
-    // fprintf(logFile,"sim global y accel: %f",accel[1]);
+    rotate(locaccel, robot->pos[2]);  // put it back in global coords
+    robot->accel[0] = locaccel[0];
+    robot->accel[1] = locaccel[1];
+    robot->accel[2] = locaccel[2];
 }
-void sim_tick(float delta_t){
+
+/**
+ * \brief Advances a robot through time.
+ *
+ * \param[in,out] robot the robot
+ * \param[in] delta_t the time step, in seconds
+ */
+void sim_robot_tick(sim_robot_t *robot, float delta_t){
+    float *pos = robot->pos, *vel = robot->vel;
+    const float *accel = robot->accel;
+
     pos[0] += vel[0] * delta_t;
     pos[1] += vel[1] * delta_t;
     pos[2] += vel[2] * delta_t;
 
-    vel[0] += accel[0] * delta_t - 1.0 * vel[0] * delta_t;  // complete guess
-    vel[1] += accel[1] * delta_t - 1.0 * vel[1] * delta_t;  // complete guess
-    vel[2] += accel[2] * delta_t - 1.0 * vel[2] * delta_t;  // complete guess
+    vel[0] += accel[0] * delta_t - (double)robot->friction * vel[0] * delta_t;  // complete guess
+    vel[1] += accel[1] * delta_t - (double)robot->friction * vel[1] * delta_t;  // complete guess
+    vel[2] += accel[2] * delta_t - (double)robot->friction * vel[2] * delta_t;  // complete guess
+}
+
+void sim_apply_wheel_force(const float new_wheel_force[4]){
+    sim_robot_apply_wheel_force(sim_robot_current(), new_wheel_force);
+}
+
+void sim_tick(float delta_t){
+    sim_robot_tick(sim_robot_current(), delta_t);
 }
 
 void sim_log_tick(float time){
+    const sim_robot_t *robot = sim_robot_current();
+    FILE *logFile = robot->log_file;
+    if (robot->log_binary)
+    {
+        sim_log_record_t record;
+        record.time = time;
+        memcpy(record.pos, robot->pos, sizeof(record.pos));
+        memcpy(record.vel, robot->vel, sizeof(record.vel));
+        memcpy(record.accel, robot->accel, sizeof(record.accel));
+        fwrite(&record, sizeof(record), 1, logFile);
+        return;
+    }
     fprintf(logFile, "SIM, ");
     fprintf(logFile, "%f, ", time);
-    fprintf(logFile, "%f, ", pos[0]);
-    fprintf(logFile, "%f, ", pos[1]);
-    fprintf(logFile, "%f, ", pos[2]);
-    fprintf(logFile, "%f, ", vel[0]);
-    fprintf(logFile, "%f, ", vel[1]);
-    fprintf(logFile, "%f, ", vel[2]);
-    fprintf(logFile, "%f, ", accel[0]);
-    fprintf(logFile, "%f, ", accel[1]);
-    fprintf(logFile, "%f\n", accel[2]);
-}
-void sim_log_start(char* fileName)
+    fprintf(logFile, "%f, ", robot->pos[0]);
+    fprintf(logFile, "%f, ", robot->pos[1]);
+    fprintf(logFile, "%f, ", robot->pos[2]);
+    fprintf(logFile, "%f, ", robot->vel[0]);
+    fprintf(logFile, "%f, ", robot->vel[1]);
+    fprintf(logFile, "%f, ", robot->vel[2]);
+    fprintf(logFile, "%f, ", robot->accel[0]);
+    fprintf(logFile, "%f, ", robot->accel[1]);
+    fprintf(logFile, "%f\n", robot->accel[2]);
+}
+
+/**
+ * \brief Opens a robot’s log file with a large buffer, so that logging does
+ * not make a system call every few records.
+ */
+static FILE *sim_log_open(sim_robot_t *robot, const char *fileName, bool binary)
 {
-    logFile = fopen(fileName, "w");
+    FILE *logFile = fopen(fileName, binary ? "wb" : "w");
+    if (!logFile)
+    {
+        perror(fileName);
+        exit(EXIT_FAILURE);
+    }
+    robot->log_buffer = malloc(SIM_LOG_BUFFER_SIZE);
+    if (robot->log_buffer)
+    {
+        setvbuf(logFile, robot->log_buffer, _IOFBF, SIM_LOG_BUFFER_SIZE);
+    }
+    robot->log_file = logFile;
+    robot->log_binary = binary;
+    return logFile;
+}
+
+void sim_log_start(const char* fileName)
+{
+    FILE *logFile = sim_log_open(sim_robot_current(), fileName, false);
     fprintf(logFile, "TYPE, ");
     fprintf(logFile, "TIME, ");
     fprintf(logFile, "X, ");
@@ -110,29 +358,52 @@ void sim_log_start(char* fileName)
     fprintf(logFile, "AY, ");
     fprintf(logFile, "AA\n");
 }
+
+/**
+ * \brief Starts logging the trajectory in the binary format.
+ *
+ * \param[in] fileName the file to write
+ * \param[in] primitive the index of the primitive being run
+ * \param[in] params the primitive’s parameters
+ * \param[in] extra the primitive’s extra byte
+ * \param[in] slow whether the primitive was ordered to drive slowly
+ */
+void sim_log_start_binary(const char *fileName, unsigned int primitive, const int16_t params[4], uint8_t extra, bool slow)
+{
+    FILE *logFile = sim_log_open(sim_robot_current(), fileName, true);
+    sim_log_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SIM_LOG_MAGIC, sizeof(header.magic));
+    header.version = SIM_LOG_VERSION;
+    header.record_size = sizeof(sim_log_record_t);
+    header.primitive = primitive;
+    memcpy(header.params, params, sizeof(header.params));
+    header.extra = extra;
+    header.slow = slow;
+    header.log_period = LOG_TICK_T;
+    fwrite(&header, sizeof(header), 1, logFile);
+}
+
 void sim_log_end()
 {
-    fclose(logFile);
+    sim_robot_t *robot = sim_robot_current();
+    fclose(robot->log_file);
+    free(robot->log_buffer);
+    robot->log_file = NULL;
+    robot->log_buffer = NULL;
 }
 
 void sim_reset(){
-    pos[0] = 0.0;
-    pos[1] = 0.0;
-    pos[2] = 0.0;
-    for (unsigned i = 0; i < 3; i++)
+    sim_robot_t *robot = sim_robot_current();
+    if (robot->log_file)
     {
-        vel[i]    = 0.0;
-        force3[i] = 0.0;
-        force4[i] = 0.0;
-        slip[i]   = 0.0;
-        accel[i]  = 0.0;
+        sim_log_end();
     }
-    force4[3] = 0.0;
-    slip[3]   = 0.0;
+    sim_robot_init(robot);
 }
 
 float get_pos_x() {
-	return pos[0];
+	return sim_robot_current()->pos[0];
 }
 
 #endif // FWSIm
@@ -2,13 +2,35 @@
 #define DR_H
 
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
 
 // In ticks
 #define LOG_TICK_T 0.03
 
+/**
+ * \brief The magic string at the start of a binary trajectory file.
+ */
+#define SIM_LOG_MAGIC "FWSIMTRJ"
+
+/**
+ * \brief The version of the binary trajectory format.
+ */
+#define SIM_LOG_VERSION 1U
+
+/**
+ * \brief The size of the buffer trajectories are written through.
+ */
+#define SIM_LOG_BUFFER_SIZE (1024U * 1024U)
+
 #define BASE_CAMERA_DELAY 3
 #define SPEED_SIZE 100
 
+/**
+ * \brief The number of robot ticks of past state kept to model camera delay.
+ */
+#define SIM_HISTORY_SIZE 32U
+
 /**
  * \brief The type of data returned by the dead reckoning module.
  *
@@ -61,11 +83,294 @@ typedef struct {
 } dr_data_t;
 
 
+/**
+ * \brief The type of data returned for the ball, as by the dead reckoning
+ * module.
+ *
+ * The simulator does not model the ball; it stays where the simulation placed
+ * it.
+ */
+typedef struct {
+	/**
+	 * \brief The X component of the ball’s position.
+	 */
+	float x;
+
+	/**
+	 * \brief The Y component of the ball’s position.
+	 */
+	float y;
+
+	/**
+	 * \brief The X component of the ball’s velocity.
+	 */
+	float vx;
+
+	/**
+	 * \brief The Y component of the ball’s velocity.
+	 */
+	float vy;
+} dr_ball_data_t;
+
+/**
+ * \brief The header at the start of a binary trajectory file.
+ *
+ * All fields are in host byte order; the file is a header followed by any
+ * number of \ref sim_log_record_t.
+ */
+typedef struct {
+	/**
+	 * \brief The string \ref SIM_LOG_MAGIC, without a terminator.
+	 */
+	char magic[8];
+
+	/**
+	 * \brief The format version, \ref SIM_LOG_VERSION.
+	 */
+	uint32_t version;
+
+	/**
+	 * \brief The size of each record, in bytes.
+	 */
+	uint32_t record_size;
+
+	/**
+	 * \brief The index of the primitive that was run.
+	 */
+	uint32_t primitive;
+
+	/**
+	 * \brief The primitive’s parameters.
+	 */
+	int16_t params[4];
+
+	/**
+	 * \brief The primitive’s extra byte.
+	 */
+	uint8_t extra;
+
+	/**
+	 * \brief Whether the primitive was ordered to drive slowly.
+	 */
+	uint8_t slow;
+
+	/**
+	 * \brief Padding, always zero.
+	 */
+	uint8_t reserved[2];
+
+	/**
+	 * \brief The nominal time between records, in seconds.
+	 */
+	float log_period;
+} sim_log_header_t;
+
+/**
+ * \brief One sample of a binary trajectory file, carrying the same values as
+ * a line of the CSV format.
+ */
+typedef struct {
+	/**
+	 * \brief The simulation time, in seconds.
+	 */
+	float time;
+
+	/**
+	 * \brief The position (X, Y, angle) in global coordinates.
+	 */
+	float pos[3];
+
+	/**
+	 * \brief The velocity in global coordinates.
+	 */
+	float vel[3];
+
+	/**
+	 * \brief The acceleration in global coordinates.
+	 */
+	float accel[3];
+} sim_log_record_t;
+
+/**
+ * \brief The sensor and actuator imperfections to simulate.
+ *
+ * All zero, the default, is a perfect robot: \ref dr_get returns the true
+ * state and the wheels always slip at the same force. Otherwise \ref dr_get
+ * returns an estimate built the way the dead reckoning module builds it, from
+ * noisy wheel encoder velocities corrected by delayed, noisy camera frames.
+ */
+typedef struct {
+	/**
+	 * \brief The standard deviation of the noise on each linear velocity
+	 * component measured by the encoders, in metres per second.
+	 */
+	float encoder_noise;
+
+	/**
+	 * \brief The standard deviation of the noise on the angular velocity
+	 * measured by the encoders, in radians per second.
+	 */
+	float encoder_angular_noise;
+
+	/**
+	 * \brief The standard deviation of the noise on each position component
+	 * of a camera frame, in metres.
+	 */
+	float camera_noise;
+
+	/**
+	 * \brief The standard deviation of the noise on the orientation in a
+	 * camera frame, in radians.
+	 */
+	float camera_angular_noise;
+
+	/**
+	 * \brief The age of a camera frame when it arrives, in robot ticks.
+	 *
+	 * This is also the delay the estimate assumes when it dead reckons a
+	 * frame forward to the present.
+	 */
+	unsigned int camera_delay;
+
+	/**
+	 * \brief The largest extra delay, in robot ticks, that a camera frame can
+	 * arrive with, chosen uniformly for each frame and not known to the
+	 * estimate.
+	 */
+	unsigned int camera_jitter;
+
+	/**
+	 * \brief The number of robot ticks between camera frames, or zero for a
+	 * frame every tick.
+	 */
+	unsigned int camera_period;
+
+	/**
+	 * \brief The relative standard deviation of the force at which the
+	 * wheels slip, drawn once per run.
+	 */
+	float slip_variation;
+
+	/**
+	 * \brief The relative standard deviation of the robot’s rolling
+	 * friction, drawn once per run.
+	 */
+	float friction_variation;
+} sim_noise_t;
+
+/**
+ * \brief The complete state of one simulated robot.
+ *
+ * Each thread simulates at most one robot at a time, selected with \ref
+ * sim_robot_select; the firmware code paths (\ref dr_get, the control
+ * functions and the primitives) act on the selected robot. Threads that never
+ * select a robot use a private default one, so single-robot programs need not
+ * bother.
+ */
+typedef struct {
+	/**
+	 * \brief The position (X, Y, angle) in global coordinates.
+	 */
+	float pos[3];
+
+	/**
+	 * \brief The velocity in global coordinates.
+	 */
+	float vel[3];
+
+	/**
+	 * \brief The acceleration in global coordinates.
+	 */
+	float accel[3];
+
+	/**
+	 * \brief The force applied in robot coordinates.
+	 */
+	float force3[3];
+
+	/**
+	 * \brief The force applied at each wheel, after slip limiting.
+	 */
+	float force4[4];
+
+	/**
+	 * \brief Whether each wheel is slipping.
+	 */
+	bool slip[4];
+
+	/**
+	 * \brief The position of the (stationary) ball.
+	 */
+	float ball[2];
+
+	/**
+	 * \brief The imperfections being simulated.
+	 */
+	sim_noise_t noise;
+
+	/**
+	 * \brief The state of the random number generator behind \ref noise.
+	 */
+	uint64_t rng;
+
+	/**
+	 * \brief The force at which each wheel slips, in newtons.
+	 */
+	float slip_force;
+
+	/**
+	 * \brief The rolling friction, as a deceleration per unit velocity.
+	 */
+	float friction;
+
+	/**
+	 * \brief The state \ref dr_get reports when \ref noise affects sensing.
+	 */
+	dr_data_t estimate;
+
+	/**
+	 * \brief The true position and the measured velocity, both in global
+	 * coordinates, at each of the last \ref SIM_HISTORY_SIZE robot ticks.
+	 */
+	float history_pos[SIM_HISTORY_SIZE][3];
+	float history_vel[SIM_HISTORY_SIZE][3];
+
+	/**
+	 * \brief The number of robot ticks sensed since \ref sim_robot_start_noise.
+	 */
+	unsigned long sense_ticks;
+
+	/**
+	 * \brief The file the trajectory is logged to, or null if not logging.
+	 */
+	FILE *log_file;
+
+	/**
+	 * \brief Whether \ref log_file is in the binary format rather than CSV.
+	 */
+	bool log_binary;
+
+	/**
+	 * \brief The buffer \ref log_file is written through.
+	 */
+	char *log_buffer;
+} sim_robot_t;
+
+void sim_robot_init(sim_robot_t *robot);
+void sim_robot_select(sim_robot_t *robot);
+sim_robot_t *sim_robot_current(void);
+void sim_robot_apply_wheel_force(sim_robot_t *robot, const float wheel_force[4]);
+void sim_robot_tick(sim_robot_t *robot, float delta_t);
+void sim_robot_start_noise(sim_robot_t *robot, const sim_noise_t *noise, uint64_t seed);
+void sim_robot_sense(sim_robot_t *robot, float delta_t);
+
 void dr_get(dr_data_t*);
+void dr_get_ball(dr_ball_data_t*);
 void sim_apply_wheel_force(const float wheel_force[4]);
 void sim_tick(float delta_t);
 void sim_log_tick(float time);
-void sim_log_start();
+void sim_log_start(const char *fileName);
+void sim_log_start_binary(const char *fileName, unsigned int primitive, const int16_t params[4], uint8_t extra, bool slow);
 void sim_log_end();
 void sim_reset();
 float get_pos_x();
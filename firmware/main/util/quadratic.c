@@ -88,6 +88,30 @@ void put_c_matrix_in_params(float c[4]) {
     }
 }
 
+long quad_solve(float Q[4][4], float c[4], bool warm_start) {
+    static SIM_LOCAL bool initialized = false;
+    if (!initialized) {
+        set_defaults();
+        setup_indexing();
+        // Printing the iterations takes longer than running them.
+        settings.verbose = 0;
+        initialized = true;
+    }
+    put_c_matrix_in_params(c);
+    to_1d_matrix(Q);
+    // work still holds the previous solution, but it is only worth
+    // starting from if the solver actually got there.
+    settings.warm_start = warm_start && work.converged;
+    long iterations = solve();
+    if (settings.warm_start && !work.converged) {
+        // Rarely, the old solution is a poor place to start; a cold start
+        // converges within a few iterations.
+        settings.warm_start = 0;
+        iterations += solve();
+    }
+    return iterations;
+}
+
 /**
  * TODO: Figure out the units for the matrices so we make sure
  * that we get accelerations out of the optimization.
@@ -100,12 +124,8 @@ void quad_optimize(PhysBot pb, dr_data_t state, float a_req[3]) {
     build_M_matrix(pb, state, M);
     transpose_qp(M, M_T);
     build_c_matrix(a_req, M, c);
-    put_c_matrix_in_params(c);
     build_Q_matrix(M, M_T, Q);
-    set_defaults();
-    setup_indexing();
-    to_1d_matrix(Q);
-    solve();
+    quad_solve(Q, c, QUAD_WARM_START);
     double x = *vars.x;
     // TODO: remove this print statement once we figure out what 
     // parameters we need from the solver
@@ -3,6 +3,16 @@
 
 #include "physbot.h"
 #include "../dr.h"
+#include <stdbool.h>
+
+/**
+ * Whether quad_optimize starts each solve from the previous tick's
+ * solution rather than from scratch. Consecutive control ticks pose
+ * nearly the same problem, so the old solution is usually a few
+ * iterations from the new one. Use the quadbench tool in fwsim to check
+ * the effect on iteration counts and solve time.
+ */
+#define QUAD_WARM_START true
 
 /**
  * Builds the M matrix for the optimization. This matrix has one 
@@ -58,6 +68,20 @@ void transpose_qp(float M[3][4], float M_T[4][3]);
  */ 
 void build_Q_matrix(float M[3][4], float M_T[4][3], float Q[4][4]);
 
+/**
+ * Loads a problem into the CVXGEN solver and solves it. The solution
+ * is left in vars.x.
+ *
+ * @param Q A 4 x 4 matrix that is the result of multiplying M.T * M
+ * @param c The c matrix built by build_c_matrix
+ * @param warm_start true to start from the solution of the previous call
+ * rather than from scratch. Ignored if the previous call did not converge.
+ * If the warm started solve does not converge, the problem is solved again
+ * from scratch.
+ * @return the number of iterations the solver took, over both attempts
+ */
+long quad_solve(float Q[4][4], float c[4], bool warm_start);
+
 /**
  * A primitive should call this function to optimize acclerations
  * in the major, minor, and rotational directions. This function
@@ -33,7 +33,7 @@
 #define THERMAL_WARNING_STOP_TEMPERATURE (THERMAL_WARNING_START_TEMPERATURE - 10.0f) // °C—chead
 #define THERMAL_WARNING_STOP_ENERGY ((THERMAL_WARNING_STOP_TEMPERATURE - THERMAL_AMBIENT) * THERMAL_CAPACITANCE) // joules
 
-#define PHASE_RESISTANCE 1.2f // ohms—EC45 datasheet
+#define WHEEL_PHASE_RESISTANCE 1.2f // ohms—EC45 datasheet
 #define SWITCH_RESISTANCE 0.6f // ohms—L6234 datasheet
 
 /**
@@ -182,8 +182,8 @@ void wheels_tick(log_record_t *log) {
 					mmode = MOTOR_MODE_BACKWARD;
 				}
 				float applied_delta_voltage = wheels[i].power / 255.0f * adc_battery() - encoder_speed(i) * WHEELS_VOLTS_PER_ENCODER_COUNT;
-				float current = applied_delta_voltage / (PHASE_RESISTANCE + SWITCH_RESISTANCE);
-				float power = current * current * PHASE_RESISTANCE;
+				float current = applied_delta_voltage / (WHEEL_PHASE_RESISTANCE + SWITCH_RESISTANCE);
+				float power = current * current * WHEEL_PHASE_RESISTANCE;
 				added_energy = power / CONTROL_LOOP_HZ;
 				break;
 
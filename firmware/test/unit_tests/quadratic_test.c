@@ -1,7 +1,9 @@
 #include "test.h"
 #include "check.h"
 #include "main/util/quadratic.h"
+#include "main/cvxgen/solver.h"
 #include <math.h>
+#include <stdbool.h>
 
 // This is an M matrix that is used for multiple tests
 // It is primarily related to the Q matrix from the optimization
@@ -112,6 +114,44 @@ START_TEST(quadratic_test)
 }
 END_TEST
 
+// Solves the wheel force problem for a robot turned to the given angle and
+// returns the objective value it reached
+static double solve_at(float angle, bool warm_start) {
+    PhysBot pb = {
+        .rot = {
+            .disp = 30.0f * M_PI / 180.0f
+        },
+        .major_vec = {1, 0},
+        .minor_vec = {0, 1}
+    };
+    float a_req[3] = {2.0, 0.5, 4.0};
+    dr_data_t state;
+    state.angle = angle;
+    float M[3][4];
+    float M_T[4][3];
+    float Q[4][4];
+    float c[4];
+    build_M_matrix(pb, state, M);
+    transpose_qp(M, M_T);
+    build_c_matrix(a_req, M, c);
+    build_Q_matrix(M, M_T, Q);
+    quad_solve(Q, c, warm_start);
+    ck_assert(work.converged);
+    return eval_objv();
+}
+
+START_TEST(test_warm_start)
+{
+    // the robot turns a little between two ticks; starting the second tick
+    // from the first tick's solution must reach the same optimum
+    solve_at(0.0f, false);
+    double cold_objective = solve_at(0.02f, false);
+    solve_at(0.0f, false);
+    double warm_objective = solve_at(0.02f, true);
+    ck_assert_float_eq_tol(cold_objective, warm_objective, 1e-3);
+}
+END_TEST
+
 /**
  * Test function manager for quadratic.c
  */ 
@@ -126,6 +166,7 @@ void run_quadratic_test() {
     tcase_add_test(tc, test_transpose);
     tcase_add_test(tc, test_build_Q_matrix);
     tcase_add_test(tc, test_build_c_matrix);
+    tcase_add_test(tc, test_warm_start);
     // run the tests
     run_test(tc, s);
 }
\ No newline at end of file
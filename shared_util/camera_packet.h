@@ -0,0 +1,101 @@
+#ifndef CAMERA_PACKET_H
+#define CAMERA_PACKET_H
+
+/**
+ * \file
+ *
+ * \brief Describes the compact camera packet relayed from the host through the
+ * dongle to the robots.
+ *
+ * A compact camera packet consists of:
+ * \li a flags byte (\ref CAMERA_FLAG_FULL_TIMESTAMP, \ref CAMERA_FLAG_PADDED),
+ * \li the ball position as two little-endian int16 values in millimetres,
+ * \li the capture timestamp in microseconds, either all 8 bytes or only the
+ * low 4 bytes (the robot keeps the high 4 bytes from the last full
+ * timestamp),
+ * \li zero or more robot records, and
+ * \li one padding byte if \ref CAMERA_FLAG_PADDED is set.
+ *
+ * Each robot record starts with a header byte holding the robot index
+ * (\ref CAMERA_RECORD_INDEX_MASK), a 3-bit keyframe generation
+ * (\ref CAMERA_RECORD_GENERATION_SHIFT) and a keyframe bit
+ * (\ref CAMERA_RECORD_KEYFRAME). A keyframe carries the absolute position and
+ * orientation as three int16 values in millimetres and milliradians. A delta
+ * carries three int8 values, scaled by \ref CAMERA_DELTA_POSITION_SCALE and
+ * \ref CAMERA_DELTA_ANGLE_SCALE, relative to the keyframe with the same
+ * generation; a robot that missed that keyframe ignores the delta.
+ */
+
+/**
+ * \brief The radio message purpose byte of a compact camera packet.
+ */
+#define CAMERA_PACKET_PURPOSE 0x11U
+
+/**
+ * \brief The largest compact camera packet, which is one full-speed USB
+ * packet.
+ */
+#define CAMERA_PACKET_MAX_LENGTH 64U
+
+/**
+ * \brief The length of a legacy camera packet, which a compact camera packet
+ * must never have.
+ */
+#define CAMERA_PACKET_LEGACY_LENGTH 55U
+
+/**
+ * \brief The length of the flags byte and ball position.
+ */
+#define CAMERA_PACKET_HEADER_LENGTH 5U
+
+/**
+ * \brief Set in the flags byte if the full 8-byte timestamp is present.
+ */
+#define CAMERA_FLAG_FULL_TIMESTAMP 0x01U
+
+/**
+ * \brief Set in the flags byte if the last byte of the packet is padding.
+ */
+#define CAMERA_FLAG_PADDED 0x02U
+
+/**
+ * \brief Set in a record header if the record is a keyframe.
+ */
+#define CAMERA_RECORD_KEYFRAME 0x80U
+
+/**
+ * \brief The position of the keyframe generation in a record header.
+ */
+#define CAMERA_RECORD_GENERATION_SHIFT 4U
+
+/**
+ * \brief The mask of the keyframe generation, after shifting.
+ */
+#define CAMERA_RECORD_GENERATION_MASK 0x07U
+
+/**
+ * \brief The mask of the robot index in a record header.
+ */
+#define CAMERA_RECORD_INDEX_MASK 0x07U
+
+/**
+ * \brief The length of a keyframe record, including its header.
+ */
+#define CAMERA_KEYFRAME_LENGTH 7U
+
+/**
+ * \brief The length of a delta record, including its header.
+ */
+#define CAMERA_DELTA_LENGTH 4U
+
+/**
+ * \brief The number of millimetres in one unit of a delta position.
+ */
+#define CAMERA_DELTA_POSITION_SCALE 2
+
+/**
+ * \brief The number of milliradians in one unit of a delta orientation.
+ */
+#define CAMERA_DELTA_ANGLE_SCALE 4
+
+#endif
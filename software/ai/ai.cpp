@@ -3,6 +3,7 @@
 #include "ai/setup.h"
 #include "util/cacheable.h"
 #include "util/dprint.h"
+#include "util/tick_counter.h"
 
 using AI::AIPackage;
 using AI::BE::Backend;
@@ -37,6 +38,10 @@ void AIPackage::tick()
 {
     // Clear all cached data.
     CacheableBase::flush_all();
+    TickCounter::reset_all();
+
+    // Record where everything is, once, for the whole tick.
+    backend.take_snapshot();
 
     // If we have a HighLevel installed, tick it.
     if (high_level.get())
@@ -1,6 +1,9 @@
 #include "ai/backend/backend.h"
+#include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <cstdlib>
+#include <utility>
 #include "util/algorithm.h"
 #include "util/dprint.h"
 
@@ -9,6 +12,31 @@ using AI::BE::BackendFactory;
 
 DoubleParam AI::BE::LOOP_DELAY(u8"Loop Delay", u8"AI/Backend", 0.08, -1.0, 1.0);
 
+namespace
+{
+/**
+ * \brief The spacing of the clearance field grids, in metres.
+ */
+constexpr double CLEARANCE_RESOLUTION = 0.05;
+
+template <typename T>
+void take_team_snapshot(
+    const AI::BE::Team<T> &team, AI::Common::TeamSnapshot &snapshot)
+{
+    assert(team.size() <= AI::Common::TeamSnapshot::CAPACITY);
+    snapshot.size = std::min(team.size(), AI::Common::TeamSnapshot::CAPACITY);
+    for (std::size_t i = 0; i != snapshot.size; ++i)
+    {
+        const typename T::Ptr bot = team.get(i);
+        snapshot.patterns[i]      = bot->pattern();
+        snapshot.positions[i]     = bot->position();
+        snapshot.velocities[i]    = bot->velocity();
+        snapshot.orientations[i]  = bot->orientation();
+        snapshot.avelocities[i]   = bot->avelocity();
+    }
+}
+}
+
 AI::BE::Backend::~Backend() = default;
 
 const AI::BE::Field &AI::BE::Backend::field() const
@@ -21,6 +49,24 @@ const AI::BE::Ball &AI::BE::Backend::ball() const
     return ball_;
 }
 
+void Backend::take_snapshot()
+{
+    snapshot_.time          = monotonic_time_;
+    snapshot_.ball_position = ball_.position();
+    snapshot_.ball_velocity = ball_.velocity();
+    take_team_snapshot(friendly_team(), snapshot_.friendly);
+    take_team_snapshot(enemy_team(), snapshot_.enemy);
+
+    if (field_.valid())
+    {
+        Point corner(field_.total_length() / 2.0, field_.total_width() / 2.0);
+        friendly_clearance_.build(
+            snapshot_.friendly, -corner, corner, CLEARANCE_RESOLUTION);
+        enemy_clearance_.build(
+            snapshot_.enemy, -corner, corner, CLEARANCE_RESOLUTION);
+    }
+}
+
 std::size_t Backend::visualizable_num_robots() const
 {
     return friendly_team().size() + enemy_team().size();
@@ -77,14 +123,15 @@ void Backend::mouse_moved(Point)
 {
 }
 
-Backend::Backend()
-    : defending_end_(FieldEnd::WEST),
+Backend::Backend(std::unique_ptr<AI::BE::Clock::Clock> clock)
+    : clock_(std::move(clock)),
+      defending_end_(FieldEnd::WEST),
       friendly_colour_(AI::Common::Colour::YELLOW),
       playtype_(AI::Common::PlayType::HALT),
       playtype_override_(AI::Common::PlayType::NONE),
       ball_placement_position_(Point())
 {
-    monotonic_time_ = monotonic_start_time_ = std::chrono::steady_clock::now();
+    monotonic_time_ = monotonic_start_time_ = clock_->now();
 }
 
 void Backend::draw_overlay(Cairo::RefPtr<Cairo::Context> ctx) const
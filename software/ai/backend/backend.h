@@ -7,13 +7,16 @@
 #include <memory>
 #include <vector>
 #include "ai/backend/ball.h"
+#include "ai/backend/clock/clock.h"
 #include "ai/backend/field.h"
 #include "ai/backend/player.h"
 #include "ai/backend/robot.h"
 #include "ai/backend/team.h"
+#include "ai/common/clearance_field.h"
 #include "ai/common/colour.h"
 #include "ai/common/team.h"
 #include "ai/common/time.h"
+#include "ai/common/world_snapshot.h"
 #include "geom/predictor.h"
 #include "proto/messages_robocup_ssl_wrapper.pb.h"
 #include "proto/referee.pb.h"
@@ -123,6 +126,41 @@ class Backend : public Visualizable::World, public NonCopyable
      */
     virtual const Team<Robot> &enemy_team() const = 0;
 
+    /**
+     * \brief Returns the state of the ball and robots as of the start of the
+     * current tick.
+     *
+     * \return the snapshot taken by the last call to \ref take_snapshot
+     */
+    const AI::Common::WorldSnapshot &snapshot() const;
+
+    /**
+     * \brief Returns the distance from each point on the field to the nearest
+     * friendly robot, as of the start of the current tick.
+     *
+     * \return the clearance field built by the last call to \ref
+     * take_snapshot
+     */
+    const AI::Common::ClearanceField &friendly_clearance() const;
+
+    /**
+     * \brief Returns the distance from each point on the field to the nearest
+     * enemy robot, as of the start of the current tick.
+     *
+     * \return the clearance field built by the last call to \ref
+     * take_snapshot
+     */
+    const AI::Common::ClearanceField &enemy_clearance() const;
+
+    /**
+     * \brief Records the current state of the ball and robots into the
+     * snapshot, and rebuilds the clearance fields from it.
+     *
+     * This is called once per tick, after the predictors have been locked and
+     * before the AI runs.
+     */
+    void take_snapshot();
+
     /**
      * \brief Returns the monotonic time at system startup.
      *
@@ -146,6 +184,16 @@ class Backend : public Visualizable::World, public NonCopyable
      */
     Timestamp monotonic_time() const;
 
+    /**
+     * \brief Returns the clock that drives the AI.
+     *
+     * Unlike \ref monotonic_time, which stands still for the whole of a tick,
+     * the clock tells the time at the moment it is asked.
+     *
+     * \return the clock
+     */
+    AI::BE::Clock::Clock &clock() const;
+
     /**
      * \brief Returns the number of table rows the backend's main tab UI
      * controls will consume.
@@ -167,6 +215,10 @@ class Backend : public Visualizable::World, public NonCopyable
      *
      * \param[in] row the number of the first row the backend should start
      * using.
+     *
+     * \note This is not called when the AI runs headless, so widgets should be
+     * created here rather than in the constructor; the same applies to \ref
+     * secondary_ui_controls_attach.
      */
     virtual void main_ui_controls_attach(Gtk::Table &t, unsigned int row);
 
@@ -333,8 +385,10 @@ class Backend : public Visualizable::World, public NonCopyable
 
     /**
      * \brief Constructs a new Backend.
+     *
+     * \param[in] clock the clock that drives the AI and tells it the time
      */
-    explicit Backend();
+    explicit Backend(std::unique_ptr<AI::BE::Clock::Clock> clock);
 
     /**
      * \brief Allows setting the current play type.
@@ -352,10 +406,13 @@ class Backend : public Visualizable::World, public NonCopyable
     }
 
    private:
+    const std::unique_ptr<AI::BE::Clock::Clock> clock_;
     Property<FieldEnd> defending_end_;
     Property<AI::Common::Colour> friendly_colour_;
     Property<AI::Common::PlayType> playtype_, playtype_override_;
     Property<Point> ball_placement_position_;
+    AI::Common::WorldSnapshot snapshot_;
+    AI::Common::ClearanceField friendly_clearance_, enemy_clearance_;
     mutable sigc::signal<void> signal_tick_;
     mutable sigc::signal<void, AI::Timediff> signal_post_tick_;
     mutable sigc::signal<void, AI::Timestamp, const SSL_WrapperPacket &>
@@ -409,6 +466,28 @@ inline AI::Timestamp AI::BE::Backend::monotonic_time() const
     return monotonic_time_;
 }
 
+inline const AI::Common::WorldSnapshot &AI::BE::Backend::snapshot() const
+{
+    return snapshot_;
+}
+
+inline const AI::Common::ClearanceField &AI::BE::Backend::friendly_clearance()
+    const
+{
+    return friendly_clearance_;
+}
+
+inline const AI::Common::ClearanceField &AI::BE::Backend::enemy_clearance()
+    const
+{
+    return enemy_clearance_;
+}
+
+inline AI::BE::Clock::Clock &AI::BE::Backend::clock() const
+{
+    return *clock_;
+}
+
 inline Property<AI::BE::Backend::FieldEnd> &AI::BE::Backend::defending_end()
 {
     return defending_end_;
@@ -2,6 +2,7 @@
 #define AI_BACKEND_CLOCK_CLOCK_H
 
 #include <sigc++/signal.h>
+#include "ai/common/time.h"
 
 namespace AI
 {
@@ -10,7 +11,11 @@ namespace BE
 namespace Clock
 {
 /**
- * \brief A source of ticks.
+ * \brief A source of ticks and of the current time.
+ *
+ * Everything in the AI that needs to know the time asks the backend’s clock,
+ * so a clock that does not follow the wall clock can run the AI faster than
+ * real time or repeat a run exactly.
  */
 class Clock
 {
@@ -19,6 +24,18 @@ class Clock
      * \brief Fired on each tick.
      */
     sigc::signal<void> signal_tick;
+
+    /**
+     * \brief Destroys a Clock.
+     */
+    virtual ~Clock() = default;
+
+    /**
+     * \brief Returns the current time.
+     *
+     * \return the current time
+     */
+    virtual AI::Timestamp now() const = 0;
 };
 }
 }
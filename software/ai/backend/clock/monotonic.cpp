@@ -47,6 +47,11 @@ Monotonic::Monotonic()
         sigc::mem_fun(this, &Monotonic::on_readable), tfd.fd(), Glib::IO_IN);
 }
 
+AI::Timestamp Monotonic::now() const
+{
+    return std::chrono::steady_clock::now();
+}
+
 bool Monotonic::on_readable(Glib::IOCondition)
 {
     uint64_t ticks;
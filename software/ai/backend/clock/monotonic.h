@@ -24,6 +24,8 @@ class Monotonic final : public AI::BE::Clock::Clock, public sigc::trackable
      */
     explicit Monotonic();
 
+    AI::Timestamp now() const override;
+
    private:
     const FileDescriptor tfd;
     Annunciator::Message overflow_message;
@@ -0,0 +1,63 @@
+#include "ai/backend/clock/simulated.h"
+#include <glibmm/main.h>
+#include <sigc++/functors/mem_fun.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include "util/timestep.h"
+
+using AI::BE::Clock::Simulated;
+
+namespace
+{
+/**
+ * \brief The time of the first tick.
+ *
+ * This is an hour past the epoch, like the monotonic clock of a machine that
+ * has been up a while, so looking a little into the past from the first tick
+ * does not reach back before the epoch.
+ */
+const AI::Timestamp EPOCH = AI::Timestamp() + std::chrono::hours(1);
+}
+
+Simulated::Simulated(double speed) : ticks_(0)
+{
+    if (speed > 0.0)
+    {
+        unsigned int interval = static_cast<unsigned int>(
+            1000.0 / (TIMESTEPS_PER_SECOND * speed) + 0.5);
+        connection = Glib::signal_timeout().connect(
+            sigc::mem_fun(this, &Simulated::on_tick), std::max(interval, 1U));
+    }
+    else
+    {
+        connection = Glib::signal_idle().connect(
+            sigc::mem_fun(this, &Simulated::on_tick));
+    }
+}
+
+Simulated::~Simulated()
+{
+    connection.disconnect();
+}
+
+AI::Timestamp Simulated::now() const
+{
+    // Count in whole nanoseconds so every run lands on the same instants.
+    return EPOCH +
+           std::chrono::duration_cast<AI::Timediff>(std::chrono::nanoseconds(
+               static_cast<int64_t>(ticks_) * INT64_C(1000000000) /
+               TIMESTEPS_PER_SECOND));
+}
+
+void Simulated::stop()
+{
+    connection.disconnect();
+}
+
+bool Simulated::on_tick()
+{
+    signal_tick.emit();
+    ++ticks_;
+    return true;
+}
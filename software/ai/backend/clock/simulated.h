@@ -0,0 +1,66 @@
+#ifndef AI_BACKEND_CLOCK_SIMULATED_H
+#define AI_BACKEND_CLOCK_SIMULATED_H
+
+#include <sigc++/connection.h>
+#include <sigc++/trackable.h>
+#include "ai/backend/clock/clock.h"
+
+namespace AI
+{
+namespace BE
+{
+namespace Clock
+{
+/**
+ * \brief A clock source whose time advances by exactly one timestep per tick.
+ *
+ * Time starts at a fixed epoch, so a run does not depend on when it started,
+ * and the ticks come as fast as the main loop allows or paced to a multiple
+ * of real time.
+ */
+class Simulated final : public AI::BE::Clock::Clock, public sigc::trackable
+{
+   public:
+    /**
+     * \brief Constructs a new Simulated.
+     *
+     * \param[in] speed the multiple of real time at which to tick, or zero to
+     * tick whenever the main loop is idle
+     */
+    explicit Simulated(double speed);
+
+    /**
+     * \brief Destroys a Simulated.
+     */
+    ~Simulated();
+
+    AI::Timestamp now() const override;
+
+    /**
+     * \brief Returns the number of ticks fired so far.
+     *
+     * \return the tick count
+     */
+    unsigned int ticks() const;
+
+    /**
+     * \brief Stops firing ticks.
+     */
+    void stop();
+
+   private:
+    unsigned int ticks_;
+    sigc::connection connection;
+
+    bool on_tick();
+};
+}
+}
+}
+
+inline unsigned int AI::BE::Clock::Simulated::ticks() const
+{
+    return ticks_;
+}
+
+#endif
@@ -100,7 +100,8 @@ FriendlyTeam::FriendlyTeam(AI::BE::Backend &backend)
 
 void FriendlyTeam::create_member(unsigned int pattern)
 {
-    members[pattern].create(pattern, std::ref(backend.ball()));
+    members[pattern].create(
+        pattern, std::ref(backend.ball()), std::ref(backend.clock()));
 }
 
 EnemyTeam::EnemyTeam(AI::BE::Backend &backend)
@@ -226,7 +227,7 @@ inline void Backend::tick()
     }
 
     // Do pre-AI stuff (locking predictors).
-    monotonic_time_ = std::chrono::steady_clock::now();
+    monotonic_time_ = clock().now();
     ball_.lock_time(monotonic_time_);
     friendly_team().lock_time(monotonic_time_);
     enemy_team().lock_time(monotonic_time_);
@@ -255,6 +256,6 @@ inline void Backend::tick()
 
     // Notify anyone interested in the finish of a tick.
     AI::Timestamp after;
-    after = std::chrono::steady_clock::now();
+    after = clock().now();
     signal_post_tick().emit(after - monotonic_time_);
 }
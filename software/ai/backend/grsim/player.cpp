@@ -46,14 +46,17 @@ Point linear_controller(Point dest)
 }
 }
 
-Player::Player(unsigned int pattern, const AI::BE::Ball &ball)
+Player::Player(
+    unsigned int pattern, const AI::BE::Ball &ball,
+    const AI::BE::Clock::Clock &clock)
     : AI::BE::Player(pattern),
       _prim(Property<Drive::Primitive>(Drive::Primitive::STOP)),
       _prim_extra(0),
       _ball(ball),
+      _clock(clock),
       _autokick_fired(false),
       _had_ball(false),
-      _last_chick_time(steady_clock::now())
+      _last_chick_time(clock.now())
 {
 }
 
@@ -84,7 +87,7 @@ double Player::get_lps(unsigned int) const
 
 bool Player::chicker_ready() const
 {
-    return steady_clock::now() - _last_chick_time >= CHICKER_CHARGE_TIME;
+    return _clock.now() - _last_chick_time >= CHICKER_CHARGE_TIME;
 }
 
 bool Player::autokick_fired() const
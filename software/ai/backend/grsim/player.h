@@ -1,6 +1,7 @@
 #ifndef AI_BACKEND_GRSIM_PLAYER_H
 #define AI_BACKEND_GRSIM_PLAYER_H
 
+#include "ai/backend/clock/clock.h"
 #include "ai/backend/player.h"
 #include "proto/grSim_Commands.pb.h"
 #include "proto/grSim_Replacement.pb.h"
@@ -18,7 +19,9 @@ class Player final : public AI::BE::Player
    public:
     typedef BoxPtr<Player> Ptr;
 
-    explicit Player(unsigned int pattern, const AI::BE::Ball &ball);
+    explicit Player(
+        unsigned int pattern, const AI::BE::Ball &ball,
+        const AI::BE::Clock::Clock &clock);
     bool has_ball() const override;
     double get_lps(unsigned int index) const override;
     bool chicker_ready() const override;
@@ -57,9 +60,10 @@ class Player final : public AI::BE::Player
     int _prim_extra;
 
     const AI::BE::Ball &_ball;
+    const AI::BE::Clock::Clock &_clock;
     bool _autokick_fired;
     bool _had_ball;
-    std::chrono::steady_clock::time_point _last_chick_time;
+    AI::Timestamp _last_chick_time;
 };
 }
 }
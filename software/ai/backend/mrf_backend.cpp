@@ -1,7 +1,13 @@
+#include <glibmm/ustring.h>
+#include <gtkmm/button.h>
+#include <gtkmm/entry.h>
+#include <gtkmm/label.h>
+#include <gtkmm/table.h>
 #include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <iostream>
+#include <memory>
 #include <tuple>
 #include <vector>
 #include "ai/backend/physical/player.h"
@@ -11,6 +17,8 @@
 #include "ai/logger.h"
 #include "mrf/dongle.h"
 #include "mrf/robot.h"
+#include "util/histogram.h"
+#include "util/timestep.h"
 
 using namespace AI::BE;
 
@@ -86,13 +94,21 @@ class MRFBackend final : public AI::BE::Vision::Backend<FriendlyTeam, EnemyTeam>
     EnemyTeam &enemy_team() override;
     const EnemyTeam &enemy_team() const override;
     void log_to(AI::Logger &logger) override;
+    unsigned int secondary_ui_controls_table_rows() const override;
+    void secondary_ui_controls_attach(Gtk::Table &t, unsigned int row) override;
 
    private:
     void tick() override;
+    void update_drive_latency_entry();
+    void on_reset_drive_latency_clicked();
     FriendlyTeam friendly;
     EnemyTeam enemy;
     MRFDongle dongle;
     Vision::VisionThread vision_thread;
+    std::unique_ptr<Gtk::Label> drive_latency_label;
+    std::unique_ptr<Gtk::Entry> drive_latency_entry;
+    std::unique_ptr<Gtk::Button> reset_drive_latency_button;
+    unsigned int drive_latency_update_counter;
 };
 
 class MRFBackendFactory final : public BackendFactory
@@ -234,7 +250,9 @@ MRFBackend::MRFBackend(
     : Backend(disable_cameras, multicast_interface),
       friendly(*this, dongle),
       enemy(*this),
-      vision_thread(dongle, multicast_interface, vision_port(), disable_cameras)
+      vision_thread(
+          dongle, multicast_interface, vision_port(), disable_cameras),
+      drive_latency_update_counter(0)
 {
     std::cout << "MRF backend has been constructed";
 }
@@ -272,7 +290,7 @@ void MRFBackend::tick()
     }
 
     // Do pre-AI stuff (locking predictors).
-    monotonic_time_ = std::chrono::steady_clock::now();
+    monotonic_time_ = clock().now();
     ball_.lock_time(monotonic_time_);
     friendly_team().lock_time(monotonic_time_);
     enemy_team().lock_time(monotonic_time_);
@@ -297,9 +315,20 @@ void MRFBackend::tick()
         friendly_team().get_backend_robot(i)->update_predictor(monotonic_time_);
     }
 
+    // Send the drive packet now rather than waiting for the main loop to go
+    // idle, so UI work cannot delay the robots’ commands.
+    dongle.flush_drive();
+
+    // Refresh the latency display about once a second.
+    if (++drive_latency_update_counter == TIMESTEPS_PER_SECOND)
+    {
+        drive_latency_update_counter = 0;
+        update_drive_latency_entry();
+    }
+
     // Notify anyone interested in the finish of a tick.
     AI::Timestamp after;
-    after = std::chrono::steady_clock::now();
+    after = clock().now();
     signal_post_tick().emit(after - monotonic_time_);
 }
 
@@ -333,6 +362,52 @@ void MRFBackend::log_to(AI::Logger &logger)
     friendly.log_to(logger);
 }
 
+unsigned int MRFBackend::secondary_ui_controls_table_rows() const
+{
+    return 1;
+}
+
+void MRFBackend::secondary_ui_controls_attach(Gtk::Table &t, unsigned int row)
+{
+    // The widgets are only created once a window asks for them, so a headless
+    // AI never touches GTK.
+    drive_latency_label.reset(new Gtk::Label(u8"Drive latency:"));
+    drive_latency_entry.reset(new Gtk::Entry);
+    drive_latency_entry->set_editable(false);
+    reset_drive_latency_button.reset(new Gtk::Button(u8"X"));
+    reset_drive_latency_button->signal_clicked().connect(
+        sigc::mem_fun(this, &MRFBackend::on_reset_drive_latency_clicked));
+    t.attach(
+        *drive_latency_label, 0, 1, row, row + 1, Gtk::SHRINK | Gtk::FILL,
+        Gtk::SHRINK | Gtk::FILL);
+    t.attach(
+        *drive_latency_entry, 1, 2, row, row + 1, Gtk::EXPAND | Gtk::FILL,
+        Gtk::SHRINK | Gtk::FILL);
+    t.attach(
+        *reset_drive_latency_button, 2, 3, row, row + 1,
+        Gtk::SHRINK | Gtk::FILL, Gtk::SHRINK | Gtk::FILL);
+    update_drive_latency_entry();
+}
+
+void MRFBackend::update_drive_latency_entry()
+{
+    if (!drive_latency_entry)
+    {
+        return;
+    }
+    const LatencyHistogram &hist = dongle.drive_latency();
+    drive_latency_entry->set_text(Glib::ustring::compose(
+        u8"p50 %1 µs, p95 %2 µs, p99 %3 µs, max %4 µs (n=%5)",
+        hist.percentile(0.50).count(), hist.percentile(0.95).count(),
+        hist.percentile(0.99).count(), hist.max().count(), hist.count()));
+}
+
+void MRFBackend::on_reset_drive_latency_clicked()
+{
+    dongle.reset_drive_latency();
+    update_drive_latency_entry();
+}
+
 MRFBackendFactory::MRFBackendFactory() : BackendFactory(u8"mrf")
 {
 }
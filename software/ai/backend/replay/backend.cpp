@@ -0,0 +1,323 @@
+#include "ai/backend/backend.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ai/backend/clock/simulated.h"
+#include "ai/backend/grsim/player.h"
+#include "ai/backend/vision/backend.h"
+#include "ai/backend/vision/team.h"
+#include "log/shared/loader.h"
+#include "proto/log_record.pb.h"
+#include "util/dprint.h"
+#include "util/main_loop.h"
+#include "util/param.h"
+
+namespace AI
+{
+namespace BE
+{
+namespace Replay
+{
+class BackendFactory final : public AI::BE::BackendFactory
+{
+   public:
+    explicit BackendFactory();
+    std::unique_ptr<AI::BE::Backend> create_backend(
+        const std::vector<bool> &disable_cameras,
+        int multicast_interface) const override;
+};
+
+extern BackendFactory replay_backend_factory_instance;
+}
+}
+}
+
+namespace
+{
+IntParam SEED(u8"Random seed", u8"AI/Backend/Replay", 1, 0, 1000000);
+DoubleParam SPEED(
+    u8"Speed (multiple of real time, 0 for unlimited)", u8"AI/Backend/Replay",
+    1.0, 0.0, 1000.0);
+
+/**
+ * \brief Returns the name of the log file to replay.
+ *
+ * \return the filename, from the \c REPLAY_LOG environment variable
+ */
+std::string replay_log()
+{
+    const char *evar = std::getenv("REPLAY_LOG");
+    if (!evar)
+    {
+        throw std::runtime_error(
+            u8"Set REPLAY_LOG to the name of the log file to replay.");
+    }
+    return evar;
+}
+
+AI::Timediff timespec_to_timediff(const Log::MonotonicTimeSpec &ts)
+{
+    return std::chrono::duration_cast<AI::Timediff>(
+        std::chrono::seconds(ts.seconds()) +
+        std::chrono::nanoseconds(ts.nanoseconds()));
+}
+
+class FriendlyTeam final
+    : public AI::BE::Vision::Team<AI::BE::GRSim::Player, AI::BE::Player>
+{
+   public:
+    explicit FriendlyTeam(AI::BE::Backend &backend);
+
+   protected:
+    void create_member(unsigned int pattern) override;
+};
+
+class EnemyTeam final
+    : public AI::BE::Vision::Team<AI::BE::Robot, AI::BE::Robot>
+{
+   public:
+    explicit EnemyTeam(AI::BE::Backend &backend);
+
+   protected:
+    void create_member(unsigned int pattern) override;
+};
+
+/**
+ * \brief A backend that plays the SSL-Vision and referee box packets recorded
+ * in a log back through the vision pipeline.
+ *
+ * Time is virtual: each tick advances exactly one AI timestep through the
+ * log, delivering every packet recorded up to that point with its original
+ * timestamp, whether that happens in real time, a multiple of it, or as fast
+ * as the AI can run. The filters, evaluation and navigator therefore see the
+ * same inputs on every run, and the new log this run produces can be compared
+ * against the original. Primitives are accepted but go nowhere. The main loop
+ * exits at the end of the log.
+ */
+class Backend final : public AI::BE::Vision::Backend<FriendlyTeam, EnemyTeam>
+{
+   public:
+    explicit Backend(const std::vector<bool> &disable_cameras);
+    AI::BE::Replay::BackendFactory &factory() const override;
+    FriendlyTeam &friendly_team() override;
+    const FriendlyTeam &friendly_team() const override;
+    EnemyTeam &enemy_team() override;
+    const EnemyTeam &enemy_team() const override;
+    void log_to(AI::Logger &logger) override;
+
+   private:
+    AI::BE::Clock::Simulated &sim_clock;
+    FriendlyTeam friendly;
+    EnemyTeam enemy;
+    const std::vector<Log::Record> records;
+    std::size_t next_record;
+    unsigned int ai_ticks;
+    AI::Timediff total_compute_time;
+    AI::Timediff max_compute_time;
+
+    explicit Backend(
+        const std::vector<bool> &disable_cameras,
+        AI::BE::Clock::Simulated *clock);
+
+    void tick() override;
+    void deliver(AI::Timediff until);
+    void finish();
+};
+}
+
+AI::BE::Replay::BackendFactory::BackendFactory()
+    : AI::BE::BackendFactory(u8"Replay")
+{
+}
+
+std::unique_ptr<AI::BE::Backend> AI::BE::Replay::BackendFactory::create_backend(
+    const std::vector<bool> &disable_cameras, int) const
+{
+    std::unique_ptr<AI::BE::Backend> be(new ::Backend(disable_cameras));
+    return be;
+}
+
+AI::BE::Replay::BackendFactory AI::BE::Replay::replay_backend_factory_instance;
+
+FriendlyTeam::FriendlyTeam(AI::BE::Backend &backend)
+    : AI::BE::Vision::Team<AI::BE::GRSim::Player, AI::BE::Player>(backend)
+{
+}
+
+void FriendlyTeam::create_member(unsigned int pattern)
+{
+    members[pattern].create(
+        pattern, std::ref(backend.ball()), std::ref(backend.clock()));
+}
+
+EnemyTeam::EnemyTeam(AI::BE::Backend &backend)
+    : AI::BE::Vision::Team<AI::BE::Robot, AI::BE::Robot>(backend)
+{
+}
+
+void EnemyTeam::create_member(unsigned int pattern)
+{
+    members[pattern].create(pattern);
+}
+
+Backend::Backend(const std::vector<bool> &disable_cameras)
+    : Backend(disable_cameras, new AI::BE::Clock::Simulated(SPEED))
+{
+}
+
+Backend::Backend(
+    const std::vector<bool> &disable_cameras, AI::BE::Clock::Simulated *clock)
+    : AI::BE::Vision::Backend<FriendlyTeam, EnemyTeam>(
+          disable_cameras, std::unique_ptr<AI::BE::Clock::Clock>(clock)),
+      sim_clock(*clock),
+      friendly(*this),
+      enemy(*this),
+      records(LogLoader::load(replay_log())),
+      next_record(0),
+      ai_ticks(0),
+      total_compute_time(AI::Timediff::zero()),
+      max_compute_time(AI::Timediff::zero())
+{
+    // Code in the AI draws from the C library generators; seed them so every
+    // replay of the same log makes the same decisions.
+    std::srand(static_cast<unsigned int>(SEED.get()));
+    srand48(SEED.get());
+}
+
+AI::BE::Replay::BackendFactory &Backend::factory() const
+{
+    return AI::BE::Replay::replay_backend_factory_instance;
+}
+
+FriendlyTeam &Backend::friendly_team()
+{
+    return friendly;
+}
+
+const FriendlyTeam &Backend::friendly_team() const
+{
+    return friendly;
+}
+
+EnemyTeam &Backend::enemy_team()
+{
+    return enemy;
+}
+
+const EnemyTeam &Backend::enemy_team() const
+{
+    return enemy;
+}
+
+void Backend::log_to(AI::Logger &)
+{
+}
+
+void Backend::tick()
+{
+    monotonic_time_ = clock().now();
+    deliver(monotonic_time_ - monotonic_start_time_);
+
+    if (field_.valid())
+    {
+        // Do pre-AI stuff (locking predictors).
+        ball_.lock_time(monotonic_time_);
+        friendly_team().lock_time(monotonic_time_);
+        enemy_team().lock_time(monotonic_time_);
+        for (std::size_t i = 0; i < friendly_team().size(); ++i)
+        {
+            friendly_team().get_backend_robot(i)->pre_tick();
+        }
+        for (std::size_t i = 0; i < enemy_team().size(); ++i)
+        {
+            enemy_team().get_backend_robot(i)->pre_tick();
+        }
+
+        // Run the AI.
+        std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+        signal_tick().emit();
+        for (std::size_t i = 0; i < friendly_team().size(); ++i)
+        {
+            friendly_team().get_backend_robot(i)->tick(false, false);
+            friendly_team().get_backend_robot(i)->update_predictor(
+                monotonic_time_);
+        }
+        AI::Timediff compute_time = std::chrono::steady_clock::now() - start;
+        ++ai_ticks;
+        total_compute_time += compute_time;
+        max_compute_time = std::max(max_compute_time, compute_time);
+        signal_post_tick().emit(compute_time);
+    }
+
+    if (next_record == records.size())
+    {
+        finish();
+    }
+}
+
+void Backend::deliver(AI::Timediff until)
+{
+    while (next_record < records.size())
+    {
+        const Log::Record &record = records[next_record];
+        if (record.has_config())
+        {
+            // The recorded packets only make sense from the side that
+            // recorded them.
+            AI::Common::Colour colour =
+                record.config().friendly_colour() == Log::COLOUR_YELLOW
+                    ? AI::Common::Colour::YELLOW
+                    : AI::Common::Colour::BLUE;
+            if (friendly_colour() != colour)
+            {
+                friendly_colour() = colour;
+            }
+        }
+        else if (record.has_vision())
+        {
+            AI::Timediff ts = timespec_to_timediff(record.vision().timestamp());
+            if (ts > until)
+            {
+                return;
+            }
+            process_vision_packet(
+                record.vision().data(), monotonic_start_time_ + ts);
+        }
+        else if (record.has_refbox() && record.refbox().has_new_data())
+        {
+            AI::Timediff ts = timespec_to_timediff(record.refbox().timestamp());
+            if (ts > until)
+            {
+                return;
+            }
+            process_refbox_packet(
+                record.refbox().new_data(), monotonic_start_time_ + ts);
+        }
+        ++next_record;
+    }
+}
+
+void Backend::finish()
+{
+    sim_clock.stop();
+    double mean_ms =
+        ai_ticks
+            ? std::chrono::duration_cast<
+                  std::chrono::duration<double, std::milli>>(total_compute_time)
+                      .count() /
+                  ai_ticks
+            : 0.0;
+    double max_ms =
+        std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(
+            max_compute_time)
+            .count();
+    LOG_INFO(Glib::ustring::compose(
+        u8"Replay finished after %1 ticks, tick time mean %2 ms, max %3 ms",
+        ai_ticks, mean_ms, max_ms));
+    MainLoop::quit();
+}
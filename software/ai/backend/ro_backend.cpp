@@ -226,7 +226,7 @@ inline void ROBackend::tick()
     }
 
     // Do pre-AI stuff (locking predictors).
-    monotonic_time_ = std::chrono::steady_clock::now();
+    monotonic_time_ = clock().now();
     ball_.lock_time(monotonic_time_);
     friendly_team().lock_time(monotonic_time_);
     enemy_team().lock_time(monotonic_time_);
@@ -255,7 +255,7 @@ inline void ROBackend::tick()
 
     // Notify anyone interested in the finish of a tick.
     AI::Timestamp after;
-    after = std::chrono::steady_clock::now();
+    after = clock().now();
     signal_post_tick().emit(after - monotonic_time_);
 }
 
@@ -0,0 +1,475 @@
+#include "ai/backend/backend.h"
+#include <sigc++/functors/mem_fun.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+#include "ai/backend/clock/simulated.h"
+#include "ai/backend/simulator/player.h"
+#include "ai/backend/simulator/world.h"
+#include "util/box.h"
+#include "util/dprint.h"
+#include "util/main_loop.h"
+#include "util/param.h"
+#include "util/timestep.h"
+
+namespace AI
+{
+namespace BE
+{
+namespace Simulator
+{
+class BackendFactory final : public AI::BE::BackendFactory
+{
+   public:
+    explicit BackendFactory();
+    std::unique_ptr<AI::BE::Backend> create_backend(
+        const std::vector<bool> &disable_cameras,
+        int multicast_interface) const override;
+};
+
+extern BackendFactory simulator_backend_factory_instance;
+}
+}
+}
+
+namespace
+{
+IntParam SEED(u8"Random seed", u8"AI/Backend/Simulator", 1, 0, 1000000);
+DoubleParam SPEED(
+    u8"Speed (multiple of real time, 0 for unlimited)",
+    u8"AI/Backend/Simulator", 1.0, 0.0, 1000.0);
+IntParam TEAM_SIZE(u8"Robots per team", u8"AI/Backend/Simulator", 6, 1, 8);
+DoubleParam POSITION_NOISE(
+    u8"Vision position noise (m)", u8"AI/Backend/Simulator", 0.002, 0.0, 0.1);
+DoubleParam ORIENTATION_NOISE(
+    u8"Vision orientation noise (rad)", u8"AI/Backend/Simulator", 0.01, 0.0,
+    1.0);
+DoubleParam MATCH_LENGTH(
+    u8"Quit after (simulated s, 0 to run forever)", u8"AI/Backend/Simulator",
+    0.0, 0.0, 1e6);
+
+/**
+ * \brief The field, which follows the Division B rules.
+ */
+const AI::BE::Simulator::FieldGeometry GEOMETRY = {9.0, 6.0, 0.3, 1.0, 0.18};
+constexpr double REFEREE_WIDTH                  = 0.4;
+constexpr double CENTRE_CIRCLE_RADIUS           = 0.5;
+constexpr double DEFENSE_AREA_WIDTH             = 1.0;
+constexpr double DEFENSE_AREA_STRETCH           = 2.0;
+
+/**
+ * \brief The number of times per AI tick that primitives are turned into
+ * commands, as near the firmware’s 200 Hz control loop as divides the tick.
+ */
+constexpr unsigned int CONTROL_TICKS_PER_TICK = 200 / TIMESTEPS_PER_SECOND;
+
+/**
+ * \brief How often, in ticks, a geometry packet is emitted.
+ */
+constexpr unsigned int GEOMETRY_INTERVAL = TIMESTEPS_PER_SECOND;
+
+/**
+ * \brief Where the robots line up at the start and after each goal, in the
+ * friendly team’s coordinates; the enemy uses the mirror image.
+ */
+const std::array<Point, 8> FORMATION = {{
+    Point(-4.2, 0.0), Point(-3.0, 1.0), Point(-3.0, -1.0), Point(-2.0, 0.0),
+    Point(-1.0, 1.5), Point(-1.0, -1.5), Point(-0.6, 0.0), Point(-2.0, 2.5),
+}};
+
+template <typename T, typename TSuper>
+class Team final : public AI::BE::Team<TSuper>
+{
+   public:
+    std::size_t size() const override
+    {
+        return member_ptrs.size();
+    }
+
+    typename TSuper::Ptr get(std::size_t i) const override
+    {
+        return member_ptrs[i];
+    }
+
+    typename T::Ptr get_backend_robot(std::size_t i) const
+    {
+        return member_ptrs[i];
+    }
+
+    template <typename... Args>
+    void create(unsigned int pattern, Args &&... args)
+    {
+        members[pattern].create(pattern, std::forward<Args>(args)...);
+        member_ptrs.push_back(members[pattern].ptr());
+        AI::BE::Team<TSuper>::signal_membership_changed().emit();
+    }
+
+    void lock_time(AI::Timestamp now)
+    {
+        for (const typename T::Ptr &i : member_ptrs)
+        {
+            i->lock_time(now);
+        }
+    }
+
+   private:
+    std::array<Box<T>, 16> members;
+    std::vector<typename T::Ptr> member_ptrs;
+};
+
+typedef Team<AI::BE::Simulator::Player, AI::BE::Player> FriendlyTeam;
+typedef Team<AI::BE::Robot, AI::BE::Robot> EnemyTeam;
+
+/**
+ * \brief A backend that runs the AI against a simulated world in the same
+ * process.
+ *
+ * Time is virtual: each tick advances the world by exactly one AI timestep,
+ * whether that happens in real time, a multiple of it, or as fast as the AI
+ * can run. With the same seed and parameters, every run is identical. The
+ * enemy robots stand in formation as obstacles.
+ *
+ * The world is observed through synthesized SSL-Vision packets, with noise,
+ * which are also emitted to \ref signal_vision so logs of simulated games
+ * look like logs of real ones.
+ */
+class Backend final : public AI::BE::Backend
+{
+   public:
+    explicit Backend();
+    AI::BE::Simulator::BackendFactory &factory() const override;
+    const FriendlyTeam &friendly_team() const override;
+    const EnemyTeam &enemy_team() const override;
+    void log_to(AI::Logger &logger) override;
+
+   private:
+    AI::BE::Clock::Simulated &sim_clock;
+    AI::BE::Simulator::World world;
+    FriendlyTeam friendly;
+    EnemyTeam enemy;
+    std::mt19937 rng;
+    std::normal_distribution<double> noise;
+    bool placed;
+
+    explicit Backend(AI::BE::Clock::Simulated *clock);
+    double sign() const;
+    void place_robots();
+    void on_playtype_override_changed();
+    void tick();
+    void observe();
+    void emit_geometry();
+    void simulate();
+};
+}
+
+AI::BE::Simulator::BackendFactory::BackendFactory()
+    : AI::BE::BackendFactory(u8"Simulator")
+{
+}
+
+std::unique_ptr<AI::BE::Backend>
+AI::BE::Simulator::BackendFactory::create_backend(
+    const std::vector<bool> &, int) const
+{
+    std::unique_ptr<AI::BE::Backend> be(new ::Backend());
+    return be;
+}
+
+AI::BE::Simulator::BackendFactory
+    AI::BE::Simulator::simulator_backend_factory_instance;
+
+Backend::Backend() : Backend(new AI::BE::Clock::Simulated(SPEED))
+{
+}
+
+Backend::Backend(AI::BE::Clock::Simulated *clock)
+    : AI::BE::Backend(std::unique_ptr<AI::BE::Clock::Clock>(clock)),
+      sim_clock(*clock),
+      world(GEOMETRY),
+      rng(static_cast<std::mt19937::result_type>(SEED.get())),
+      placed(false)
+{
+    // Code in the AI draws from the C library generators; seed them too so
+    // the whole run follows from the seed.
+    std::srand(static_cast<unsigned int>(SEED.get()));
+    srand48(SEED.get());
+
+    field_.update(
+        GEOMETRY.length,
+        GEOMETRY.length + 2.0 * (GEOMETRY.boundary + REFEREE_WIDTH),
+        GEOMETRY.width,
+        GEOMETRY.width + 2.0 * (GEOMETRY.boundary + REFEREE_WIDTH),
+        GEOMETRY.goal_width, CENTRE_CIRCLE_RADIUS, DEFENSE_AREA_WIDTH,
+        DEFENSE_AREA_STRETCH);
+
+    unsigned int team_size = static_cast<unsigned int>(TEAM_SIZE.get());
+    for (unsigned int i = 0; i < team_size; ++i)
+    {
+        std::size_t index = world.add_robot(Point(), Angle::zero());
+        friendly.create(i, std::ref(world), index);
+    }
+    for (unsigned int i = 0; i < team_size; ++i)
+    {
+        world.add_robot(Point(), Angle::zero());
+        enemy.create(i);
+    }
+
+    playtype_rw() = AI::Common::PlayType::PLAY;
+    playtype_override().signal_changed().connect(
+        sigc::mem_fun(this, &Backend::on_playtype_override_changed));
+    defending_end().signal_changed().connect(
+        sigc::mem_fun(this, &Backend::place_robots));
+    sim_clock.signal_tick.connect(sigc::mem_fun(this, &Backend::tick));
+}
+
+AI::BE::Simulator::BackendFactory &Backend::factory() const
+{
+    return AI::BE::Simulator::simulator_backend_factory_instance;
+}
+
+const FriendlyTeam &Backend::friendly_team() const
+{
+    return friendly;
+}
+
+const EnemyTeam &Backend::enemy_team() const
+{
+    return enemy;
+}
+
+void Backend::log_to(AI::Logger &)
+{
+}
+
+double Backend::sign() const
+{
+    return defending_end() == FieldEnd::EAST ? -1.0 : 1.0;
+}
+
+void Backend::place_robots()
+{
+    // The world uses SSL-Vision coordinates; the AI’s are flipped when it
+    // defends the east end.
+    Angle facing = sign() > 0 ? Angle::zero() : Angle::half();
+    for (std::size_t i = 0; i < friendly.size(); ++i)
+    {
+        AI::BE::Simulator::RobotState &robot = world.robots[i];
+        robot.position                       = FORMATION[i] * sign();
+        robot.velocity                       = Point();
+        robot.orientation                    = facing;
+        robot.avelocity                      = Angle::zero();
+    }
+    for (std::size_t i = 0; i < enemy.size(); ++i)
+    {
+        AI::BE::Simulator::RobotState &robot =
+            world.robots[friendly.size() + i];
+        robot.position    = -FORMATION[i] * sign();
+        robot.velocity    = Point();
+        robot.orientation = facing + Angle::half();
+        robot.avelocity   = Angle::zero();
+    }
+    world.place_ball(Point());
+    placed = true;
+}
+
+void Backend::on_playtype_override_changed()
+{
+    AI::Common::PlayType pt = playtype_override();
+    playtype_rw() =
+        pt == AI::Common::PlayType::NONE ? AI::Common::PlayType::PLAY : pt;
+}
+
+void Backend::tick()
+{
+    if (!placed)
+    {
+        place_robots();
+    }
+
+    // The AI sees the world as it is at the start of the tick.
+    monotonic_time_ = clock().now();
+    observe();
+
+    ball_.lock_time(monotonic_time_);
+    friendly.lock_time(monotonic_time_);
+    enemy.lock_time(monotonic_time_);
+    for (std::size_t i = 0; i < friendly.size(); ++i)
+    {
+        friendly.get_backend_robot(i)->pre_tick();
+    }
+    for (std::size_t i = 0; i < enemy.size(); ++i)
+    {
+        enemy.get_backend_robot(i)->pre_tick();
+    }
+
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    signal_tick().emit();
+    for (std::size_t i = 0; i < friendly.size(); ++i)
+    {
+        friendly.get_backend_robot(i)->update_predictor(monotonic_time_);
+    }
+    signal_post_tick().emit(std::chrono::steady_clock::now() - start);
+
+    // Carry out the AI’s orders until the next tick.
+    simulate();
+
+    // The clock counts this tick once it returns.
+    unsigned int ticks = sim_clock.ticks() + 1;
+    if (MATCH_LENGTH > 0.0 && ticks >= MATCH_LENGTH * TIMESTEPS_PER_SECOND)
+    {
+        LOG_INFO(Glib::ustring::compose(
+            u8"Simulation finished at %1 s, score %2–%3",
+            static_cast<double>(ticks) / TIMESTEPS_PER_SECOND,
+            friendly.score.get(), enemy.score.get()));
+        sim_clock.stop();
+        MainLoop::quit();
+    }
+}
+
+void Backend::observe()
+{
+    if (sim_clock.ticks() % GEOMETRY_INTERVAL == 0)
+    {
+        emit_geometry();
+    }
+
+    double t_capture =
+        std::chrono::duration_cast<std::chrono::duration<double>>(
+            monotonic_time_.time_since_epoch())
+            .count();
+    SSL_WrapperPacket packet;
+    SSL_DetectionFrame &det = *packet.mutable_detection();
+    det.set_frame_number(sim_clock.ticks());
+    det.set_t_capture(t_capture);
+    det.set_t_sent(t_capture);
+    det.set_camera_id(0);
+
+    Point ball_pos =
+        world.ball.position + Point(noise(rng), noise(rng)) * POSITION_NOISE;
+    SSL_DetectionBall &ball = *det.add_balls();
+    ball.set_confidence(1.0f);
+    ball.set_x(static_cast<float>(ball_pos.x * 1000.0));
+    ball.set_y(static_cast<float>(ball_pos.y * 1000.0));
+    ball.set_z(static_cast<float>(world.ball.height * 1000.0));
+    ball.set_pixel_x(0.0f);
+    ball.set_pixel_y(0.0f);
+    ball_.add_field_data(ball_pos * sign(), monotonic_time_);
+
+    bool friendly_yellow = friendly_colour() == AI::Common::Colour::YELLOW;
+    for (std::size_t i = 0; i < world.robots.size(); ++i)
+    {
+        const AI::BE::Simulator::RobotState &state = world.robots[i];
+        bool is_friendly                           = i < friendly.size();
+        Point pos =
+            state.position + Point(noise(rng), noise(rng)) * POSITION_NOISE;
+        Angle ori = (state.orientation +
+                     Angle::of_radians(noise(rng) * ORIENTATION_NOISE))
+                        .angle_mod();
+        unsigned int pattern =
+            static_cast<unsigned int>(is_friendly ? i : i - friendly.size());
+
+        SSL_DetectionRobot &bot =
+            *(is_friendly == friendly_yellow ? det.add_robots_yellow()
+                                             : det.add_robots_blue());
+        bot.set_confidence(1.0f);
+        bot.set_robot_id(pattern);
+        bot.set_x(static_cast<float>(pos.x * 1000.0));
+        bot.set_y(static_cast<float>(pos.y * 1000.0));
+        bot.set_orientation(static_cast<float>(ori.to_radians()));
+        bot.set_pixel_x(0.0f);
+        bot.set_pixel_y(0.0f);
+
+        Angle ai_ori = sign() > 0 ? ori : (ori + Angle::half()).angle_mod();
+        if (is_friendly)
+        {
+            friendly.get_backend_robot(pattern)->add_field_data(
+                pos * sign(), ai_ori, monotonic_time_);
+        }
+        else
+        {
+            enemy.get_backend_robot(pattern)->add_field_data(
+                pos * sign(), ai_ori, monotonic_time_);
+        }
+    }
+
+    signal_vision().emit(monotonic_time_, packet);
+}
+
+void Backend::emit_geometry()
+{
+    // Only the features the vision backend reads are filled in.
+    SSL_WrapperPacket packet;
+    SSL_GeometryFieldSize &fsize = *packet.mutable_geometry()->mutable_field();
+    fsize.set_field_length(static_cast<int>(GEOMETRY.length * 1000.0));
+    fsize.set_field_width(static_cast<int>(GEOMETRY.width * 1000.0));
+    fsize.set_goal_width(static_cast<int>(GEOMETRY.goal_width * 1000.0));
+    fsize.set_goal_depth(static_cast<int>(GEOMETRY.goal_depth * 1000.0));
+    fsize.set_boundary_width(static_cast<int>(GEOMETRY.boundary * 1000.0));
+
+    SSL_FieldCicularArc &circle = *fsize.add_field_arcs();
+    circle.set_name("CenterCircle");
+    circle.mutable_center()->set_x(0.0f);
+    circle.mutable_center()->set_y(0.0f);
+    circle.set_radius(static_cast<float>(CENTRE_CIRCLE_RADIUS * 1000.0));
+    circle.set_a1(0.0f);
+    circle.set_a2(static_cast<float>(2.0 * M_PI));
+    circle.set_thickness(0.0f);
+
+    float goal_x  = static_cast<float>(-GEOMETRY.length * 500.0);
+    float front_x = static_cast<float>(goal_x + DEFENSE_AREA_WIDTH * 1000.0);
+    float half_stretch = static_cast<float>(DEFENSE_AREA_STRETCH * 500.0);
+    SSL_FieldLineSegment &stretch = *fsize.add_field_lines();
+    stretch.set_name("LeftPenaltyStretch");
+    stretch.mutable_p1()->set_x(front_x);
+    stretch.mutable_p1()->set_y(-half_stretch);
+    stretch.mutable_p2()->set_x(front_x);
+    stretch.mutable_p2()->set_y(half_stretch);
+    stretch.set_thickness(10.0f);
+    SSL_FieldLineSegment &side = *fsize.add_field_lines();
+    side.set_name("LeftFieldLeftPenaltyStretch");
+    side.mutable_p1()->set_x(goal_x);
+    side.mutable_p1()->set_y(-half_stretch);
+    side.mutable_p2()->set_x(front_x);
+    side.mutable_p2()->set_y(-half_stretch);
+    side.set_thickness(10.0f);
+
+    signal_vision().emit(monotonic_time_, packet);
+}
+
+void Backend::simulate()
+{
+    for (unsigned int i = 0; i < CONTROL_TICKS_PER_TICK; ++i)
+    {
+        for (std::size_t j = 0; j < friendly.size(); ++j)
+        {
+            friendly.get_backend_robot(j)->control();
+        }
+        int goal =
+            world.step(1.0 / (TIMESTEPS_PER_SECOND * CONTROL_TICKS_PER_TICK));
+        for (std::size_t j = 0; j < friendly.size(); ++j)
+        {
+            friendly.get_backend_robot(j)->update_kicked(i == 0);
+        }
+        if (goal)
+        {
+            // A goal in the positive X goal is against the team that defends
+            // it.
+            if (goal * sign() > 0)
+            {
+                friendly.score = friendly.score + 1;
+            }
+            else
+            {
+                enemy.score = enemy.score + 1;
+            }
+            place_robots();
+            return;
+        }
+    }
+}
@@ -0,0 +1,231 @@
+#include "ai/backend/simulator/player.h"
+#include <algorithm>
+#include <cmath>
+
+using AI::BE::Simulator::Player;
+
+namespace
+{
+/**
+ * \brief The deceleration the controller plans on, a little below what the
+ * robot can manage so it does not overshoot.
+ */
+constexpr double LINEAR_DECELERATION = 2.5;
+
+/**
+ * \brief The top speed the controller asks for.
+ */
+constexpr double MAX_SPEED = 2.0;
+
+/**
+ * \brief The angular deceleration the controller plans on.
+ */
+constexpr double ANGULAR_DECELERATION = 20.0;
+
+/**
+ * \brief The top angular speed the controller asks for.
+ */
+constexpr double MAX_ANGULAR_SPEED = 8.0;
+
+/**
+ * \brief The speed of the move primitive’s autokick.
+ */
+constexpr double AUTOKICK_SPEED = 5.5;
+
+/**
+ * \brief Returns the velocity that brings a robot to a point with a given
+ * speed, decelerating as late as possible.
+ */
+Point velocity_to(Point from, Point to, double end_speed)
+{
+    Point diff  = to - from;
+    double dist = diff.len();
+    if (dist < 1e-3)
+    {
+        return Point();
+    }
+    double speed = std::min(
+        MAX_SPEED,
+        std::sqrt(end_speed * end_speed + 2.0 * LINEAR_DECELERATION * dist));
+    return diff * (speed / dist);
+}
+
+/**
+ * \brief Returns the angular velocity that turns a robot to an orientation,
+ * decelerating as late as possible.
+ */
+Angle avelocity_to(Angle from, Angle to)
+{
+    double diff  = (to - from).angle_mod().to_radians();
+    double speed = std::min(
+        MAX_ANGULAR_SPEED,
+        std::sqrt(2.0 * ANGULAR_DECELERATION * std::fabs(diff)));
+    return Angle::of_radians(std::copysign(speed, diff));
+}
+}
+
+Player::Player(unsigned int pattern, World &world, std::size_t index)
+    : AI::BE::Player(pattern),
+      world(world),
+      index(index),
+      prim(Drive::Primitive::STOP),
+      params(Drive::move_brake()),
+      autokick_fired_(false)
+{
+}
+
+bool Player::has_ball() const
+{
+    return world.has_ball(index);
+}
+
+double Player::get_lps(unsigned int) const
+{
+    return 0.0;
+}
+
+bool Player::chicker_ready() const
+{
+    return state().charge_time <= 0.0;
+}
+
+bool Player::autokick_fired() const
+{
+    return autokick_fired_;
+}
+
+const Property<Drive::Primitive> &Player::primitive() const
+{
+    return prim;
+}
+
+void Player::send_prim(Drive::LLPrimitive p)
+{
+    // The pivot swings from wherever the robot was when the pivot started;
+    // the AI resends the same primitive every tick, which must not move the
+    // target along with the robot.
+    if (p.prim == Drive::Primitive::PIVOT &&
+        (params.prim != p.prim || params.params != p.params))
+    {
+        Point centre = p.field_point();
+        pivot_target =
+            centre + (state().position - centre).rotate(p.field_angle());
+    }
+    params = p;
+    prim   = p.prim;
+}
+
+void Player::control()
+{
+    RobotState &robot            = state();
+    RobotCommand &command        = robot.command;
+    command.velocity             = Point();
+    command.avelocity            = Angle::zero();
+    command.dribble              = false;
+    command.kick_speed           = 0.0;
+    command.chip                 = false;
+    const std::vector<double> &p = params.params;
+
+    switch (params.prim)
+    {
+        case Drive::Primitive::STOP:
+            // Braking and coasting both end with the robot at rest; the model
+            // has no wheel friction to tell them apart.
+            break;
+
+        case Drive::Primitive::MOVE:
+            command.velocity = velocity_to(
+                robot.position, params.field_point(), p[3] / 1000.0);
+            command.avelocity =
+                avelocity_to(robot.orientation, params.field_angle());
+            if (params.extra & 0x01)
+            {
+                command.kick_speed = AUTOKICK_SPEED;
+            }
+            command.dribble = params.extra & 0x02;
+            break;
+
+        case Drive::Primitive::DRIBBLE:
+            command.velocity =
+                velocity_to(robot.position, params.field_point(), 0.0);
+            command.avelocity =
+                avelocity_to(robot.orientation, params.field_angle());
+            command.dribble = true;
+            break;
+
+        case Drive::Primitive::SHOOT:
+        {
+            Angle ori =
+                params.extra & 0x02
+                    ? params.field_angle()
+                    : (params.field_point() - robot.position).orientation();
+            command.velocity =
+                velocity_to(robot.position, params.field_point(), 0.0);
+            command.avelocity  = avelocity_to(robot.orientation, ori);
+            command.kick_speed = p[3] / 1000.0;
+            command.chip       = params.extra & 0x01;
+            break;
+        }
+
+        case Drive::Primitive::CATCH:
+        {
+            // Get in front of the ball’s path, facing it, with the dribbler
+            // running.
+            const BallState &ball = world.ball;
+            Point target          = ball.position;
+            if (ball.velocity.lensq() > 1e-4)
+            {
+                Point dir = ball.velocity.norm();
+                double along =
+                    std::max(0.0, (robot.position - ball.position).dot(dir));
+                target = ball.position + dir * along;
+            }
+            command.velocity  = velocity_to(robot.position, target, 0.0);
+            command.avelocity = avelocity_to(
+                robot.orientation,
+                (ball.position - robot.position).orientation());
+            command.dribble = true;
+            break;
+        }
+
+        case Drive::Primitive::PIVOT:
+        {
+            Point centre      = params.field_point();
+            command.velocity  = velocity_to(robot.position, pivot_target, 0.0);
+            command.avelocity = avelocity_to(
+                robot.orientation, (centre - robot.position).orientation());
+            command.dribble = true;
+            break;
+        }
+
+        case Drive::Primitive::SPIN:
+            command.velocity =
+                velocity_to(robot.position, params.field_point(), 0.0);
+            command.avelocity = Angle::of_radians(p[2] / 100.0);
+            break;
+
+        case Drive::Primitive::DIRECT_VELOCITY:
+            command.velocity =
+                Point(p[0] / 1000.0, p[1] / 1000.0).rotate(robot.orientation);
+            command.avelocity = Angle::of_radians(p[2] / 100.0);
+            break;
+
+        case Drive::Primitive::DIRECT_WHEELS:
+            // Individual wheels are not modelled.
+            break;
+    }
+}
+
+void Player::update_kicked(bool reset)
+{
+    if (reset)
+    {
+        autokick_fired_ = false;
+    }
+    autokick_fired_ = autokick_fired_ || state().kicked;
+}
+
+AI::BE::Simulator::RobotState &Player::state() const
+{
+    return world.robots[index];
+}
@@ -0,0 +1,78 @@
+#ifndef AI_BACKEND_SIMULATOR_PLAYER_H
+#define AI_BACKEND_SIMULATOR_PLAYER_H
+
+#include <cstddef>
+#include "ai/backend/player.h"
+#include "ai/backend/simulator/world.h"
+#include "drive/primitive.h"
+#include "util/box_ptr.h"
+#include "util/property.h"
+
+namespace AI
+{
+namespace BE
+{
+namespace Simulator
+{
+/**
+ * \brief A player whose primitives are carried out in a simulated world.
+ *
+ * Each primitive is turned into a velocity, dribbler and kicker command the
+ * way the firmware would, using the robot’s true state.
+ */
+class Player final : public AI::BE::Player
+{
+   public:
+    /**
+     * \brief A pointer to a Player.
+     */
+    typedef BoxPtr<Player> Ptr;
+
+    /**
+     * \brief Constructs a new Player.
+     *
+     * \param[in] pattern the robot’s pattern number
+     *
+     * \param[in] world the world the robot lives in
+     *
+     * \param[in] index the robot’s index in \p world
+     */
+    explicit Player(unsigned int pattern, World &world, std::size_t index);
+
+    bool has_ball() const override;
+    double get_lps(unsigned int index) const override;
+    bool chicker_ready() const override;
+    bool autokick_fired() const override;
+    const Property<Drive::Primitive> &primitive() const override;
+    void send_prim(Drive::LLPrimitive p) override;
+
+    /**
+     * \brief Updates the robot’s command from its primitive, as the firmware
+     * does on each of its control ticks.
+     */
+    void control();
+
+    /**
+     * \brief Records whether the robot fired its kicker during the last world
+     * step.
+     *
+     * \param[in] reset \c true at the start of an AI tick, to forget kicks
+     * reported for the previous tick
+     */
+    void update_kicked(bool reset);
+
+   private:
+    World &world;
+    const std::size_t index;
+    Property<Drive::Primitive> prim;
+    Drive::LLPrimitive params;
+    Point pivot_target;
+    bool autokick_fired_;
+
+    RobotState &state() const;
+};
+}
+}
+}
+
+#endif
@@ -0,0 +1,475 @@
+#include "ai/backend/simulator/world.h"
+#include <algorithm>
+#include <cmath>
+
+using AI::BE::Simulator::World;
+
+namespace
+{
+/**
+ * \brief The fastest a robot can change its velocity, in metres per second
+ * squared.
+ */
+constexpr double MAX_LINEAR_ACCELERATION = 3.0;
+
+/**
+ * \brief The fastest a robot can drive, in metres per second.
+ */
+constexpr double MAX_LINEAR_SPEED = 2.5;
+
+/**
+ * \brief The fastest a robot can change its angular velocity, in radians per
+ * second squared.
+ */
+constexpr double MAX_ANGULAR_ACCELERATION = 30.0;
+
+/**
+ * \brief The fastest a robot can spin, in radians per second.
+ */
+constexpr double MAX_ANGULAR_SPEED = 10.0;
+
+/**
+ * \brief The height of a robot; a ball flying higher passes over it.
+ */
+constexpr double ROBOT_HEIGHT = 0.15;
+
+/**
+ * \brief The height of the goal mouth.
+ */
+constexpr double GOAL_HEIGHT = 0.155;
+
+/**
+ * \brief The thickness of the goal walls and posts.
+ */
+constexpr double GOAL_WALL_THICKNESS = 0.02;
+
+/**
+ * \brief The deceleration of a rolling ball due to friction with the carpet.
+ */
+constexpr double BALL_ROLLING_DECELERATION = 0.5;
+
+constexpr double GRAVITY = 9.81;
+
+/**
+ * \brief The slowest vertical speed at which a landing ball bounces rather
+ * than settling.
+ */
+constexpr double MIN_BOUNCE_SPEED = 0.5;
+
+constexpr double GROUND_RESTITUTION = 0.5;
+constexpr double WALL_RESTITUTION   = 0.5;
+constexpr double ROBOT_RESTITUTION  = 0.3;
+
+/**
+ * \brief How far in front of the dribbler roller the ball can be while still
+ * held or kicked.
+ */
+constexpr double DRIBBLER_REACH = 0.01;
+
+/**
+ * \brief The fastest the ball can approach a running dribbler and still be
+ * caught rather than bouncing off.
+ */
+constexpr double CAPTURE_SPEED = 3.0;
+
+/**
+ * \brief The fastest the kicker can launch the ball, in metres per second.
+ */
+constexpr double MAX_KICK_SPEED = 8.0;
+
+/**
+ * \brief The angle above the ground at which the chipper launches the ball.
+ */
+constexpr Angle CHIP_ANGLE = Angle::of_degrees(45.0);
+
+/**
+ * \brief The time it takes the capacitors to recharge after firing, in
+ * seconds.
+ */
+constexpr double CHARGE_TIME = 2.0;
+
+/**
+ * \brief Moves a value towards a target by no more than a given step.
+ */
+Point approach(Point value, Point target, double step)
+{
+    Point diff = target - value;
+    if (diff.lensq() <= step * step)
+    {
+        return target;
+    }
+    return value + diff.norm() * step;
+}
+
+double approach(double value, double target, double step)
+{
+    return value + std::max(-step, std::min(step, target - value));
+}
+
+/**
+ * \brief Finds how far a disc overlaps a line segment.
+ *
+ * \param[in] centre the centre of the disc
+ *
+ * \param[in] radius the radius of the disc
+ *
+ * \param[in] a one end of the segment
+ *
+ * \param[in] b the other end of the segment
+ *
+ * \param[out] normal the direction in which to move the disc to separate it
+ * from the segment
+ *
+ * \return the distance to move the disc, or zero if it does not overlap
+ */
+double segment_overlap(
+    Point centre, double radius, Point a, Point b, Point &normal)
+{
+    Point along = b - a;
+    double t =
+        std::max(0.0, std::min(1.0, (centre - a).dot(along) / along.lensq()));
+    Point diff  = centre - (a + along * t);
+    double dist = diff.len();
+    if (dist >= radius || dist == 0.0)
+    {
+        return 0.0;
+    }
+    normal = diff / dist;
+    return radius - dist;
+}
+}
+
+constexpr double World::MAX_SUBSTEP;
+
+World::World(const FieldGeometry &geometry) : geometry_(geometry)
+{
+    place_ball(Point());
+}
+
+std::size_t World::add_robot(Point position, Angle orientation)
+{
+    RobotState robot;
+    robot.position           = position;
+    robot.orientation        = orientation;
+    robot.command.dribble    = false;
+    robot.command.kick_speed = 0.0;
+    robot.command.chip       = false;
+    robot.charge_time        = 0.0;
+    robot.kicked             = false;
+    robots.push_back(robot);
+    possession.push_back(false);
+    return robots.size() - 1;
+}
+
+void World::place_ball(Point position)
+{
+    ball.position          = position;
+    ball.velocity          = Point();
+    ball.height            = 0.0;
+    ball.vertical_velocity = 0.0;
+    std::fill(possession.begin(), possession.end(), false);
+}
+
+int World::step(double dt)
+{
+    for (RobotState &robot : robots)
+    {
+        robot.kicked = false;
+    }
+    unsigned int substeps =
+        static_cast<unsigned int>(std::ceil(dt / MAX_SUBSTEP));
+    for (unsigned int i = 0; i < substeps; ++i)
+    {
+        int goal = substep(dt / substeps);
+        if (goal)
+        {
+            return goal;
+        }
+    }
+    return 0;
+}
+
+bool World::has_ball(std::size_t index) const
+{
+    return possession[index];
+}
+
+int World::substep(double dt)
+{
+    for (RobotState &robot : robots)
+    {
+        move_robot(robot, dt);
+    }
+    collide_robots();
+    move_ball(dt);
+    for (std::size_t i = 0; i < robots.size(); ++i)
+    {
+        collide_ball(i);
+    }
+    collide_walls();
+    collide_goals();
+    return check_goal();
+}
+
+void World::move_robot(RobotState &robot, double dt)
+{
+    robot.velocity = approach(
+        robot.velocity, robot.command.velocity, MAX_LINEAR_ACCELERATION * dt);
+    if (robot.velocity.lensq() > MAX_LINEAR_SPEED * MAX_LINEAR_SPEED)
+    {
+        robot.velocity = robot.velocity.norm() * MAX_LINEAR_SPEED;
+    }
+    double avel = approach(
+        robot.avelocity.to_radians(), robot.command.avelocity.to_radians(),
+        MAX_ANGULAR_ACCELERATION * dt);
+    avel = std::max(-MAX_ANGULAR_SPEED, std::min(MAX_ANGULAR_SPEED, avel));
+    robot.avelocity = Angle::of_radians(avel);
+    robot.position += robot.velocity * dt;
+    robot.orientation = (robot.orientation + robot.avelocity * dt).angle_mod();
+    robot.charge_time = std::max(0.0, robot.charge_time - dt);
+}
+
+void World::move_ball(double dt)
+{
+    ball.position += ball.velocity * dt;
+    if (ball.height > 0.0 || ball.vertical_velocity > 0.0)
+    {
+        ball.height += ball.vertical_velocity * dt;
+        ball.vertical_velocity -= GRAVITY * dt;
+        if (ball.height <= 0.0)
+        {
+            ball.height = 0.0;
+            ball.vertical_velocity =
+                -ball.vertical_velocity > MIN_BOUNCE_SPEED
+                    ? -ball.vertical_velocity * GROUND_RESTITUTION
+                    : 0.0;
+        }
+    }
+    else
+    {
+        double speed  = ball.velocity.len();
+        double slowed = speed - BALL_ROLLING_DECELERATION * dt;
+        ball.velocity =
+            slowed > 0.0 ? ball.velocity * (slowed / speed) : Point();
+    }
+}
+
+void World::collide_robots()
+{
+    // Robots push each other apart equally and lose the velocity with which
+    // they were approaching.
+    for (std::size_t i = 0; i < robots.size(); ++i)
+    {
+        for (std::size_t j = i + 1; j < robots.size(); ++j)
+        {
+            RobotState &a = robots[i];
+            RobotState &b = robots[j];
+            Point diff    = b.position - a.position;
+            double dist   = diff.len();
+            if (dist >= 2.0 * ROBOT_RADIUS || dist == 0.0)
+            {
+                continue;
+            }
+            Point normal   = diff / dist;
+            double overlap = 2.0 * ROBOT_RADIUS - dist;
+            a.position -= normal * (overlap / 2.0);
+            b.position += normal * (overlap / 2.0);
+            double closing = (a.velocity - b.velocity).dot(normal);
+            if (closing > 0.0)
+            {
+                a.velocity -= normal * (closing / 2.0);
+                b.velocity += normal * (closing / 2.0);
+            }
+        }
+    }
+}
+
+void World::collide_ball(std::size_t index)
+{
+    RobotState &robot = robots[index];
+    if (ball.height >= ROBOT_HEIGHT)
+    {
+        return;
+    }
+
+    Point local   = (ball.position - robot.position).rotate(-robot.orientation);
+    Point forward = Point::of_angle(robot.orientation);
+    bool in_front = local.x > 0.0 && std::fabs(local.y) <= DRIBBLER_WIDTH / 2.0;
+    double contact_x = ROBOT_CENTRE_TO_FRONT + BALL_RADIUS;
+    bool in_reach    = in_front && local.x <= contact_x + DRIBBLER_REACH;
+
+    // The velocity of the robot’s surface where the ball touches it.
+    Point surface_velocity =
+        robot.velocity +
+        (ball.position - robot.position).perp() * robot.avelocity.to_radians();
+
+    if (in_reach && ball.height <= 0.0 && robot.command.kick_speed > 0.0 &&
+        robot.charge_time <= 0.0)
+    {
+        double speed  = std::min(robot.command.kick_speed, MAX_KICK_SPEED);
+        ball.position = robot.position + local.rotate(robot.orientation);
+        if (robot.command.chip)
+        {
+            ball.velocity = robot.velocity + forward * speed * CHIP_ANGLE.cos();
+            ball.vertical_velocity = speed * CHIP_ANGLE.sin();
+            ball.height            = 0.0;
+        }
+        else
+        {
+            ball.velocity = robot.velocity + forward * speed;
+        }
+        robot.kicked      = true;
+        robot.charge_time = CHARGE_TIME;
+        possession[index] = false;
+        return;
+    }
+
+    if (possession[index])
+    {
+        if (robot.command.dribble && in_reach)
+        {
+            // The dribbler holds the ball against the front of the robot.
+            local.x       = contact_x;
+            ball.position = robot.position + local.rotate(robot.orientation);
+            ball.velocity = surface_velocity;
+            return;
+        }
+        possession[index] = false;
+    }
+
+    Point normal;
+    double depth;
+    if (in_front)
+    {
+        normal = forward;
+        depth  = contact_x - local.x;
+    }
+    else
+    {
+        double dist = local.len();
+        normal      = (ball.position - robot.position).norm();
+        depth       = ROBOT_RADIUS + BALL_RADIUS - dist;
+    }
+    if (depth <= 0.0)
+    {
+        if (in_reach && robot.command.dribble && ball.height <= 0.0 &&
+            (ball.velocity - surface_velocity).len() <= CAPTURE_SPEED)
+        {
+            possession[index] = true;
+        }
+        return;
+    }
+
+    ball.position += normal * depth;
+    double closing = (ball.velocity - surface_velocity).dot(normal);
+    if (closing < 0.0)
+    {
+        ball.velocity -= normal * (closing * (1.0 + ROBOT_RESTITUTION));
+    }
+    if (in_front && robot.command.dribble && ball.height <= 0.0 &&
+        -closing <= CAPTURE_SPEED)
+    {
+        possession[index] = true;
+    }
+}
+
+void World::collide_walls()
+{
+    double max_x = geometry_.length / 2.0 + geometry_.boundary;
+    double max_y = geometry_.width / 2.0 + geometry_.boundary;
+    for (RobotState &robot : robots)
+    {
+        if (std::fabs(robot.position.x) > max_x - ROBOT_RADIUS)
+        {
+            robot.position.x =
+                std::copysign(max_x - ROBOT_RADIUS, robot.position.x);
+            robot.velocity.x = 0.0;
+        }
+        if (std::fabs(robot.position.y) > max_y - ROBOT_RADIUS)
+        {
+            robot.position.y =
+                std::copysign(max_y - ROBOT_RADIUS, robot.position.y);
+            robot.velocity.y = 0.0;
+        }
+    }
+    if (std::fabs(ball.position.x) > max_x - BALL_RADIUS)
+    {
+        ball.position.x = std::copysign(max_x - BALL_RADIUS, ball.position.x);
+        ball.velocity.x = -ball.velocity.x * WALL_RESTITUTION;
+    }
+    if (std::fabs(ball.position.y) > max_y - BALL_RADIUS)
+    {
+        ball.position.y = std::copysign(max_y - BALL_RADIUS, ball.position.y);
+        ball.velocity.y = -ball.velocity.y * WALL_RESTITUTION;
+    }
+}
+
+void World::collide_goals()
+{
+    // Each goal is three walls: the two sides, whose front ends are the posts,
+    // and the back. Walls are segments along their centre lines, widened by
+    // half their thickness. The ball flies over them above the goal’s height.
+    double half_thickness = GOAL_WALL_THICKNESS / 2.0;
+    double front_x        = geometry_.length / 2.0 + half_thickness;
+    double back_x =
+        geometry_.length / 2.0 + geometry_.goal_depth + half_thickness;
+    double side_y = geometry_.goal_width / 2.0 + half_thickness;
+    for (double sign : {-1.0, 1.0})
+    {
+        const Point walls[3][2] = {
+            {Point(sign * front_x, side_y), Point(sign * back_x, side_y)},
+            {Point(sign * front_x, -side_y), Point(sign * back_x, -side_y)},
+            {Point(sign * back_x, side_y), Point(sign * back_x, -side_y)}};
+        for (const auto &wall : walls)
+        {
+            Point normal;
+            for (RobotState &robot : robots)
+            {
+                double depth = segment_overlap(
+                    robot.position, ROBOT_RADIUS + half_thickness, wall[0],
+                    wall[1], normal);
+                if (depth > 0.0)
+                {
+                    robot.position += normal * depth;
+                    double closing = robot.velocity.dot(normal);
+                    if (closing < 0.0)
+                    {
+                        robot.velocity -= normal * closing;
+                    }
+                }
+            }
+            if (ball.height >= GOAL_HEIGHT)
+            {
+                continue;
+            }
+            double depth = segment_overlap(
+                ball.position, BALL_RADIUS + half_thickness, wall[0], wall[1],
+                normal);
+            if (depth > 0.0)
+            {
+                ball.position += normal * depth;
+                double closing = ball.velocity.dot(normal);
+                if (closing < 0.0)
+                {
+                    ball.velocity -=
+                        normal * (closing * (1.0 + WALL_RESTITUTION));
+                }
+            }
+        }
+    }
+}
+
+int World::check_goal() const
+{
+    // The ball must be wholly over the goal line, and inside the goal rather
+    // than behind it.
+    double x = std::fabs(ball.position.x);
+    if (x > geometry_.length / 2.0 + BALL_RADIUS &&
+        x < geometry_.length / 2.0 + geometry_.goal_depth &&
+        std::fabs(ball.position.y) < geometry_.goal_width / 2.0 &&
+        ball.height < GOAL_HEIGHT)
+    {
+        return ball.position.x > 0.0 ? 1 : -1;
+    }
+    return 0;
+}
@@ -0,0 +1,229 @@
+#ifndef AI_BACKEND_SIMULATOR_WORLD_H
+#define AI_BACKEND_SIMULATOR_WORLD_H
+
+#include <cstddef>
+#include <vector>
+#include "geom/angle.h"
+#include "geom/point.h"
+
+namespace AI
+{
+namespace BE
+{
+namespace Simulator
+{
+/**
+ * \brief The dimensions of the simulated field, in metres.
+ *
+ * The goal depth is measured from the goal line to the inside of the back
+ * wall.
+ */
+struct FieldGeometry final
+{
+    double length, width, boundary, goal_width, goal_depth;
+};
+
+/**
+ * \brief The radius of a robot, in metres.
+ */
+constexpr double ROBOT_RADIUS = 0.09;
+
+/**
+ * \brief The distance from the centre of a robot to its dribbler, in metres.
+ */
+constexpr double ROBOT_CENTRE_TO_FRONT = 0.078;
+
+/**
+ * \brief The width of a robot’s dribbler, in metres.
+ */
+constexpr double DRIBBLER_WIDTH = 0.07;
+
+/**
+ * \brief The radius of the ball, in metres.
+ */
+constexpr double BALL_RADIUS = 0.0215;
+
+/**
+ * \brief The state of the ball.
+ */
+struct BallState final
+{
+    /**
+     * \brief The position of the ball on the ground plane.
+     */
+    Point position;
+
+    /**
+     * \brief The velocity of the ball on the ground plane.
+     */
+    Point velocity;
+
+    /**
+     * \brief The height of the bottom of the ball above the ground.
+     */
+    double height;
+
+    /**
+     * \brief The vertical velocity of the ball.
+     */
+    double vertical_velocity;
+};
+
+/**
+ * \brief What a robot is trying to do, as it would be told by its firmware.
+ */
+struct RobotCommand final
+{
+    /**
+     * \brief The velocity the robot is trying to reach, in global
+     * coordinates.
+     */
+    Point velocity;
+
+    /**
+     * \brief The angular velocity the robot is trying to reach.
+     */
+    Angle avelocity;
+
+    /**
+     * \brief Whether the dribbler is running.
+     */
+    bool dribble;
+
+    /**
+     * \brief The speed at which to kick or chip the ball as soon as it is in
+     * front of the kicker, or zero to not kick.
+     */
+    double kick_speed;
+
+    /**
+     * \brief Whether to chip rather than kick.
+     */
+    bool chip;
+};
+
+/**
+ * \brief The state of a robot.
+ */
+struct RobotState final
+{
+    Point position, velocity;
+    Angle orientation, avelocity;
+
+    /**
+     * \brief The command being carried out.
+     */
+    RobotCommand command;
+
+    /**
+     * \brief The time, in seconds, until the capacitors are charged enough to
+     * kick again.
+     */
+    double charge_time;
+
+    /**
+     * \brief Whether the robot kicked or chipped the ball during the last
+     * step.
+     */
+    bool kicked;
+};
+
+/**
+ * \brief A deterministic two-dimensional rigid-body model of the ball and the
+ * robots on a field.
+ *
+ * Robots are discs whose velocities approach their commanded velocities
+ * under acceleration limits, as the firmware’s controllers would make them.
+ * The ball rolls with constant deceleration, flies ballistically when
+ * chipped, bounces off robots, the goal walls and the boundary walls, is
+ * captured by a running dribbler and can be kicked or chipped by a robot it is
+ * touching. Stepping the same world by the same amounts always produces the
+ * same result.
+ */
+class World final
+{
+   public:
+    /**
+     * \brief The largest time, in seconds, integrated in one internal step.
+     */
+    static constexpr double MAX_SUBSTEP = 0.001;
+
+    /**
+     * \brief The robots, with the friendly team first.
+     */
+    std::vector<RobotState> robots;
+
+    /**
+     * \brief The ball.
+     */
+    BallState ball;
+
+    /**
+     * \brief Constructs a new World with no robots and the ball at rest in
+     * the centre.
+     *
+     * \param[in] geometry the field dimensions
+     */
+    explicit World(const FieldGeometry &geometry);
+
+    /**
+     * \brief Returns the field dimensions.
+     */
+    const FieldGeometry &geometry() const
+    {
+        return geometry_;
+    }
+
+    /**
+     * \brief Adds a robot at rest.
+     *
+     * \param[in] position the robot’s position
+     *
+     * \param[in] orientation the robot’s orientation
+     *
+     * \return the index of the new robot
+     */
+    std::size_t add_robot(Point position, Angle orientation);
+
+    /**
+     * \brief Places the ball at rest on the ground.
+     *
+     * \param[in] position the new position
+     */
+    void place_ball(Point position);
+
+    /**
+     * \brief Advances the world through time.
+     *
+     * \param[in] dt the amount of time to advance, in seconds
+     *
+     * \return +1 if the ball entered the goal at the positive X end, −1 if it
+     * entered the goal at the negative X end, or 0 if no goal was scored
+     */
+    int step(double dt);
+
+    /**
+     * \brief Checks whether a robot is holding the ball on its dribbler.
+     *
+     * \param[in] index the robot
+     */
+    bool has_ball(std::size_t index) const;
+
+   private:
+    const FieldGeometry geometry_;
+    std::vector<bool> possession;
+
+    int substep(double dt);
+    void move_robot(RobotState &robot, double dt);
+    void move_ball(double dt);
+    void collide_robots();
+    void collide_ball(std::size_t index);
+    void collide_walls();
+    void collide_goals();
+    int check_goal() const;
+};
+}
+}
+}
+
+#endif
@@ -4,6 +4,7 @@
 #include <chrono>
 #include <cmath>
 #include <iostream>
+#include <memory>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -85,10 +86,44 @@ class Backend : public AI::BE::Backend
     const EnemyTeam &enemy_team() const override       = 0;
     void handle_vision_packet(const SSL_WrapperPacket &packet);
 
+   protected:
+    /**
+     * \brief Constructs a backend whose packets come from the subclass rather
+     * than from the network.
+     *
+     * \param[in] disable_cameras a bitmask indicating which cameras should be
+     * ignored
+     *
+     * \param[in] clock the clock that drives the AI
+     */
+    explicit Backend(
+        const std::vector<bool> &disable_cameras,
+        std::unique_ptr<AI::BE::Clock::Clock> clock);
+
+    /**
+     * \brief Handles an SSL-Vision packet received at a given time.
+     *
+     * \param[in] packet the packet
+     *
+     * \param[in] time_rec the time at which the packet was received
+     */
+    void process_vision_packet(
+        const SSL_WrapperPacket &packet, AI::Timestamp time_rec);
+
+    /**
+     * \brief Handles a referee box packet received at a given time.
+     *
+     * \param[in] packet the packet
+     *
+     * \param[in] time_rec the time at which the packet was received
+     */
+    void process_refbox_packet(
+        const SSL_Referee &packet, AI::Timestamp time_rec);
+
    private:
     const std::vector<bool> &disable_cameras;
-    AI::BE::RefBox refbox;
-    AI::BE::Clock::Monotonic clock;
+    std::unique_ptr<AI::BE::RefBox> refbox;
+    SSL_Referee refbox_packet;
     AI::Timestamp playtype_time;
     Point playtype_arm_ball_position;
     std::vector<std::pair<SSL_DetectionFrame, AI::Timestamp>> detections;
@@ -116,18 +151,29 @@ constexpr double
 template <typename FriendlyTeam, typename EnemyTeam>
 inline AI::BE::Vision::Backend<FriendlyTeam, EnemyTeam>::Backend(
     const std::vector<bool> &disable_cameras, int multicast_interface)
-    : disable_cameras(disable_cameras), refbox(multicast_interface)
+    : Backend(
+          disable_cameras,
+          std::unique_ptr<AI::BE::Clock::Clock>(new AI::BE::Clock::Monotonic))
+{
+    refbox.reset(new AI::BE::RefBox(multicast_interface));
+    refbox->signal_packet.connect(
+        sigc::mem_fun(this, &Backend::on_refbox_packet));
+}
+
+template <typename FriendlyTeam, typename EnemyTeam>
+inline AI::BE::Vision::Backend<FriendlyTeam, EnemyTeam>::Backend(
+    const std::vector<bool> &disable_cameras,
+    std::unique_ptr<AI::BE::Clock::Clock> clock)
+    : AI::BE::Backend(std::move(clock)), disable_cameras(disable_cameras)
 {
     friendly_colour().signal_changed().connect(
         sigc::mem_fun(this, &Backend::on_friendly_colour_changed));
     playtype_override().signal_changed().connect(
         sigc::mem_fun(this, &Backend::update_playtype));
-    refbox.signal_packet.connect(
-        sigc::mem_fun(this, &Backend::on_refbox_packet));
 
-    clock.signal_tick.connect(sigc::mem_fun(this, &Backend::tick));
+    this->clock().signal_tick.connect(sigc::mem_fun(this, &Backend::tick));
 
-    playtype_time = std::chrono::steady_clock::now();
+    playtype_time = this->clock().now();
 
     pFilter_ = nullptr;
 }
@@ -142,7 +188,7 @@ AI::BE::Vision::Backend<
         }
 
         // Do pre-AI stuff (locking predictors).
-        monotonic_time_ = std::chrono::steady_clock::now();
+        monotonic_time_ = clock().now();
         ball_.lock_time(monotonic_time_);
         friendly_team().lock_time(monotonic_time_);
         enemy_team().lock_time(monotonic_time_);
@@ -169,7 +215,7 @@ predictors).
 
         // Notify anyone interested in the finish of a tick.
         AI::Timestamp after;
-        after = std::chrono::steady_clock::now();
+        after = clock().now();
         signal_post_tick().emit(after - monotonic_time_);
 }
 */
@@ -178,8 +224,14 @@ inline void
 AI::BE::Vision::Backend<FriendlyTeam, EnemyTeam>::handle_vision_packet(
     const SSL_WrapperPacket &packet)
 {
-    AI::Timestamp time_rec;
-    time_rec = std::chrono::steady_clock::now();
+    process_vision_packet(packet, clock().now());
+}
+
+template <typename FriendlyTeam, typename EnemyTeam>
+inline void
+AI::BE::Vision::Backend<FriendlyTeam, EnemyTeam>::process_vision_packet(
+    const SSL_WrapperPacket &packet, AI::Timestamp time_rec)
+{
     // Pass it to any attached listeners.
     signal_vision().emit(time_rec, packet);
 
@@ -453,13 +505,20 @@ inline void AI::BE::Vision::Backend<FriendlyTeam, EnemyTeam>::update_ball(
 template <typename FriendlyTeam, typename EnemyTeam>
 inline void AI::BE::Vision::Backend<FriendlyTeam, EnemyTeam>::on_refbox_packet()
 {
+    process_refbox_packet(refbox->packet, clock().now());
+}
+
+template <typename FriendlyTeam, typename EnemyTeam>
+inline void
+AI::BE::Vision::Backend<FriendlyTeam, EnemyTeam>::process_refbox_packet(
+    const SSL_Referee &packet, AI::Timestamp time_rec)
+{
+    refbox_packet = packet;
     update_goalies();
     update_scores();
     update_playtype();
     update_ball_placement();
-    AI::Timestamp now;
-    now = std::chrono::steady_clock::now();
-    signal_refbox().emit(now, refbox.packet);
+    signal_refbox().emit(time_rec, refbox_packet);
 }
 
 template <typename FriendlyTeam, typename EnemyTeam>
@@ -486,7 +545,7 @@ inline void AI::BE::Vision::Backend<FriendlyTeam, EnemyTeam>::update_playtype()
     if (new_pt != playtype())
     {
         playtype_rw() = new_pt;
-        playtype_time = std::chrono::steady_clock::now();
+        playtype_time = clock().now();
     }
 }
 
@@ -495,13 +554,13 @@ inline void AI::BE::Vision::Backend<FriendlyTeam, EnemyTeam>::update_goalies()
 {
     if (friendly_colour() == AI::Common::Colour::YELLOW)
     {
-        friendly_team().goalie = refbox.packet.yellow().goalie();
-        enemy_team().goalie    = refbox.packet.blue().goalie();
+        friendly_team().goalie = refbox_packet.yellow().goalie();
+        enemy_team().goalie    = refbox_packet.blue().goalie();
     }
     else
     {
-        friendly_team().goalie = refbox.packet.blue().goalie();
-        enemy_team().goalie    = refbox.packet.yellow().goalie();
+        friendly_team().goalie = refbox_packet.blue().goalie();
+        enemy_team().goalie    = refbox_packet.yellow().goalie();
     }
 }
 
@@ -509,11 +568,11 @@ template <typename FriendlyTeam, typename EnemyTeam>
 inline void
 AI::BE::Vision::Backend<FriendlyTeam, EnemyTeam>::update_ball_placement()
 {
-    if (refbox.packet.has_designated_position())
+    if (refbox_packet.has_designated_position())
     {
         ball_placement_position_rw() = Point(
-            refbox.packet.designated_position().x() / 1000.0,
-            refbox.packet.designated_position().y() / 1000.0);
+            refbox_packet.designated_position().x() / 1000.0,
+            refbox_packet.designated_position().y() / 1000.0);
     }
 }
 
@@ -522,13 +581,13 @@ inline void AI::BE::Vision::Backend<FriendlyTeam, EnemyTeam>::update_scores()
 {
     if (friendly_colour() == AI::Common::Colour::YELLOW)
     {
-        friendly_team().score = refbox.packet.yellow().score();
-        enemy_team().score    = refbox.packet.blue().score();
+        friendly_team().score = refbox_packet.yellow().score();
+        enemy_team().score    = refbox_packet.blue().score();
     }
     else
     {
-        friendly_team().score = refbox.packet.blue().score();
-        enemy_team().score    = refbox.packet.yellow().score();
+        friendly_team().score = refbox_packet.blue().score();
+        enemy_team().score    = refbox_packet.yellow().score();
     }
 }
 
@@ -547,7 +606,7 @@ inline AI::Common::PlayType
 AI::BE::Vision::Backend<FriendlyTeam, EnemyTeam>::compute_playtype(
     AI::Common::PlayType old_pt)
 {
-    switch (refbox.packet.command())
+    switch (refbox_packet.command())
     {
         case SSL_Referee::HALT:
         case SSL_Referee::TIMEOUT_YELLOW:
@@ -0,0 +1,139 @@
+#include "ai/backend/vision/camera_relay.h"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <stdexcept>
+
+using AI::BE::Vision::CameraRelay;
+
+namespace
+{
+/**
+ * \brief The weight given to the newest sample in the speed estimate.
+ */
+constexpr double SPEED_SMOOTHING = 0.5;
+
+/**
+ * \brief The shortest gap between detections that is used to estimate speed,
+ * so that near-simultaneous frames from overlapping cameras do not produce
+ * wild estimates.
+ */
+constexpr double MIN_SPEED_DT = 0.005;
+}
+
+constexpr std::size_t CameraRelay::MAX_ROBOTS;
+
+CameraRelay::CameraRelay(
+    double packet_rate, double min_interval, double max_interval,
+    double fast_speed)
+    : packet_interval(1.0 / packet_rate),
+      min_interval(min_interval),
+      max_interval(max_interval),
+      fast_speed(fast_speed),
+      last_packet(-std::numeric_limits<double>::infinity())
+{
+    if (!(packet_rate > 0.0))
+    {
+        throw std::invalid_argument(u8"Camera packet rate must be positive");
+    }
+    if (!(fast_speed > 0.0))
+    {
+        throw std::invalid_argument(
+            u8"Camera relay fast speed must be positive");
+    }
+    for (RobotState &state : robots)
+    {
+        state.valid     = false;
+        state.fresh     = false;
+        state.t_capture = 0.0;
+        state.last_sent = -std::numeric_limits<double>::infinity();
+        state.speed     = 0.0;
+    }
+}
+
+void CameraRelay::observe(
+    unsigned int index, double t_capture, Point pos, Angle ori)
+{
+    assert(index < MAX_ROBOTS);
+    RobotState &state = robots[index];
+    if (state.valid)
+    {
+        // Another camera may already have reported a newer frame.
+        double dt = t_capture - state.t_capture;
+        if (dt <= 0.0)
+        {
+            return;
+        }
+        if (dt >= MIN_SPEED_DT)
+        {
+            double sample = (pos - state.pos).len() / dt;
+            state.speed   = SPEED_SMOOTHING * sample +
+                          (1.0 - SPEED_SMOOTHING) * state.speed;
+        }
+    }
+    state.valid     = true;
+    state.fresh     = true;
+    state.t_capture = t_capture;
+    state.pos       = pos;
+    state.ori       = ori;
+}
+
+std::vector<std::tuple<uint8_t, Point, Angle>> CameraRelay::select(double now)
+{
+    std::vector<std::tuple<uint8_t, Point, Angle>> result;
+    if (now - last_packet < packet_interval)
+    {
+        return result;
+    }
+
+    // Order the due robots by how far past their interval they are.
+    std::vector<std::pair<double, unsigned int>> due;
+    for (unsigned int i = 0; i != MAX_ROBOTS; ++i)
+    {
+        const RobotState &state = robots[i];
+        if (state.fresh)
+        {
+            double lateness = (now - state.last_sent) / interval(state);
+            if (lateness >= 1.0)
+            {
+                due.emplace_back(lateness, i);
+            }
+        }
+    }
+    std::sort(
+        due.begin(), due.end(), [](const std::pair<double, unsigned int> &a,
+                                   const std::pair<double, unsigned int> &b) {
+            return a.first > b.first;
+        });
+
+    for (const auto &elt : due)
+    {
+        const RobotState &state = robots[elt.second];
+        result.emplace_back(
+            static_cast<uint8_t>(elt.second), state.pos, state.ori);
+    }
+    return result;
+}
+
+void CameraRelay::mark_sent(
+    const std::vector<std::tuple<uint8_t, Point, Angle>> &robots,
+    std::size_t count, double now)
+{
+    if (!count)
+    {
+        return;
+    }
+    last_packet = now;
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        RobotState &state = this->robots[std::get<0>(robots[i])];
+        state.fresh       = false;
+        state.last_sent   = now;
+    }
+}
+
+double CameraRelay::interval(const RobotState &state) const
+{
+    double fraction = std::min(state.speed / fast_speed, 1.0);
+    return max_interval - (max_interval - min_interval) * fraction;
+}
@@ -0,0 +1,128 @@
+#ifndef AI_BACKEND_VISION_CAMERA_RELAY_H
+#define AI_BACKEND_VISION_CAMERA_RELAY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+#include "geom/angle.h"
+#include "geom/point.h"
+#include "util/noncopyable.h"
+
+namespace AI
+{
+namespace BE
+{
+namespace Vision
+{
+/**
+ * \brief Decides which robots’ camera positions to relay over the radio, and
+ * when.
+ *
+ * Detections from every camera are merged so that each robot keeps only its
+ * freshest detection. Each robot is relayed at an interval that shrinks as it
+ * moves faster, since a stationary robot’s dead reckoning drifts slowly while
+ * a fast one needs frequent corrections. Packets are limited to a fixed rate
+ * so the camera relay cannot starve drive packets of airtime; within a
+ * packet, the most overdue robots go first.
+ */
+class CameraRelay final : public NonCopyable
+{
+   public:
+    /**
+     * \brief The number of robot indices that can be relayed.
+     */
+    static constexpr std::size_t MAX_ROBOTS = 8;
+
+    /**
+     * \brief Constructs a new CameraRelay.
+     *
+     * \param[in] packet_rate the largest number of camera packets to send per
+     * second
+     *
+     * \param[in] min_interval the shortest interval, in seconds, between
+     * updates for a fast-moving robot
+     *
+     * \param[in] max_interval the longest interval, in seconds, between
+     * updates for a stationary robot
+     *
+     * \param[in] fast_speed the speed, in metres per second, at and above
+     * which a robot is updated at \p min_interval
+     *
+     * \exception std::invalid_argument if \p packet_rate or \p fast_speed is
+     * not positive
+     */
+    explicit CameraRelay(
+        double packet_rate = 60.0, double min_interval = 1.0 / 60.0,
+        double max_interval = 0.25, double fast_speed = 1.5);
+
+    /**
+     * \brief Records a detection.
+     *
+     * \param[in] index the robot index
+     *
+     * \param[in] t_capture the capture time of the frame, in seconds
+     *
+     * \param[in] pos the robot’s position
+     *
+     * \param[in] ori the robot’s orientation
+     */
+    void observe(unsigned int index, double t_capture, Point pos, Angle ori);
+
+    /**
+     * \brief Picks the robots to relay now.
+     *
+     * \param[in] now the current time, on the same clock as the capture times
+     *
+     * \return the robots to relay, most overdue first, or an empty vector if
+     * no packet should be sent now
+     */
+    std::vector<std::tuple<uint8_t, Point, Angle>> select(double now);
+
+    /**
+     * \brief Records that a packet was sent.
+     *
+     * \param[in] robots the robots returned by \ref select
+     *
+     * \param[in] count the number of leading elements of \p robots that were
+     * actually sent
+     *
+     * \param[in] now the current time
+     */
+    void mark_sent(
+        const std::vector<std::tuple<uint8_t, Point, Angle>> &robots,
+        std::size_t count, double now);
+
+    /**
+     * \brief Returns the estimated speed of a robot.
+     *
+     * \param[in] index the robot index
+     *
+     * \return the speed, in metres per second
+     */
+    double speed(unsigned int index) const
+    {
+        return robots[index].speed;
+    }
+
+   private:
+    struct RobotState final
+    {
+        bool valid, fresh;
+        double t_capture, last_sent, speed;
+        Point pos;
+        Angle ori;
+    };
+
+    const double packet_interval, min_interval, max_interval, fast_speed;
+    double last_packet;
+    std::array<RobotState, MAX_ROBOTS> robots;
+
+    double interval(const RobotState &state) const;
+};
+}
+}
+}
+
+#endif
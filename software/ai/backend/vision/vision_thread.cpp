@@ -155,7 +155,6 @@ void VisionThread::transmit_bots(SSL_WrapperPacket packet)
         return;
 
     SSL_DetectionFrame det = packet.detection();
-    std::vector<std::tuple<uint8_t, Point, Angle>> detbots;
 
     // if friendly team is yellow grab yellow robots, otherwise grab blue
     const google::protobuf::RepeatedPtrField<SSL_DetectionRobot> &rep =
@@ -191,40 +190,18 @@ void VisionThread::transmit_bots(SSL_WrapperPacket packet)
         Angle ori = (Angle::of_radians(detbot.orientation()) +
                      (neg ? Angle::half() : Angle::zero()))
                         .angle_mod();
-        detbots.push_back(std::make_tuple(pattern, pos, ori));
+        relay.observe(pattern, det.t_capture(), pos, ori);
     }
 
+    // Relay whichever robots are due, freshest detection from any camera.
+    std::vector<std::tuple<uint8_t, Point, Angle>> detbots =
+        relay.select(det.t_capture());
     if (detbots.empty())
         return;
 
-    int64_t t_capture = 0;
-    if (det.has_t_capture())
-    {
-        t_capture = (int64_t)det.t_capture();
-    }
-    /*
-            std::cout << "Calling dongle.send_camera_packet with: ";
-            for (std::size_t i = 0; i < detbots.size(); ++i) {
-                    std::cout << "bot number = " <<
-       unsigned(std::get<0>(detbots[i])) << ", ";
-                    std::cout << "x = " << (std::get<1>(detbots[i])).x << ", ";
-                    std::cout << "y = " << (std::get<1>(detbots[i])).y << ", ";
-                    std::cout << "time capture = " << t_capture << ", ";
-                    std::cout << "theta = " <<
-       (std::get<2>(detbots[i])).to_degrees() << std::endl;
-            }
-    */
     Point ball_pos = vis_inf.ballPos();
 
-    // only send every fourth packet
-    // TODO: make this for each camera
-    if (cam_count == 0)
-    {
-        dongle.send_camera_packet(detbots, ball_pos, t_capture);
-        cam_count = 4;
-    }
-    else
-    {
-        cam_count--;
-    }
+    std::size_t sent = dongle.send_camera_frame(
+        detbots, ball_pos, static_cast<uint64_t>(det.t_capture() * 1.0e6));
+    relay.mark_sent(detbots, sent, det.t_capture());
 }
@@ -10,6 +10,7 @@
 #include <thread>
 #include <tuple>
 #include "ai/backend/backend.h"
+#include "ai/backend/vision/camera_relay.h"
 #include "ai/common/time.h"
 #include "geom/point.h"
 #include "mrf/dongle.h"
@@ -74,7 +75,7 @@ class VisionThread final : public NonCopyable
     std::mutex packets_mutex;
 
    private:
-    int cam_count = 0;
+    CameraRelay relay;
     std::atomic<bool> stop_thread;
     FileDescriptor sock;
     MRFDongle &dongle;
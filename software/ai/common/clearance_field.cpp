@@ -0,0 +1,167 @@
+#include "ai/common/clearance_field.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+using AI::Common::ClearanceField;
+using AI::Common::TeamSnapshot;
+
+ClearanceField::ClearanceField() : step_x(0.0), step_y(0.0), columns(0), rows(0)
+{
+}
+
+void ClearanceField::build(
+    const TeamSnapshot &team, Point min, Point max, double resolution)
+{
+    double width  = std::max(max.x - min.x, 0.0);
+    double height = std::max(max.y - min.y, 0.0);
+    this->team    = team;
+    this->min     = min;
+    columns       = std::max<std::size_t>(
+        2, static_cast<std::size_t>(std::ceil(width / resolution)) + 1);
+    rows = std::max<std::size_t>(
+        2, static_cast<std::size_t>(std::ceil(height / resolution)) + 1);
+    step_x = width / static_cast<double>(columns - 1);
+    step_y = height / static_cast<double>(rows - 1);
+    distances.assign(columns * rows, std::numeric_limits<double>::infinity());
+    owners.assign(columns * rows, 0);
+    if (!team.size)
+    {
+        return;
+    }
+
+    std::vector<std::size_t> by_y(team.size);
+    for (std::size_t i = 0; i != team.size; ++i)
+    {
+        by_y[i] = i;
+    }
+    std::sort(by_y.begin(), by_y.end(), [&team](std::size_t a, std::size_t b) {
+        return team.positions[a].y < team.positions[b].y;
+    });
+    for (std::size_t column = 0; column != columns; ++column)
+    {
+        build_column(column, by_y);
+    }
+}
+
+double ClearanceField::distance(Point p) const
+{
+    if (!team.size)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    if (!covers(p))
+    {
+        return (team.positions[team.nearest(p)] - p).len();
+    }
+
+    double fx         = (p.x - min.x) / step_x;
+    double fy         = (p.y - min.y) / step_y;
+    std::size_t left  = std::min(static_cast<std::size_t>(fx), columns - 2);
+    std::size_t below = std::min(static_cast<std::size_t>(fy), rows - 2);
+    double tx         = fx - static_cast<double>(left);
+    double ty         = fy - static_cast<double>(below);
+    double bottom     = distances[node(left, below)] * (1.0 - tx) +
+                    distances[node(left + 1, below)] * tx;
+    double top = distances[node(left, below + 1)] * (1.0 - tx) +
+                 distances[node(left + 1, below + 1)] * tx;
+    return bottom * (1.0 - ty) + top * ty;
+}
+
+std::size_t ClearanceField::nearest(Point p) const
+{
+    if (!team.size || !covers(p))
+    {
+        return team.nearest(p);
+    }
+    std::size_t column =
+        static_cast<std::size_t>(std::lround((p.x - min.x) / step_x));
+    std::size_t row =
+        static_cast<std::size_t>(std::lround((p.y - min.y) / step_y));
+    return owners[node(column, row)];
+}
+
+bool ClearanceField::covers(Point p) const
+{
+    return step_x > 0.0 && step_y > 0.0 && p.x >= min.x && p.y >= min.y &&
+           p.x <= min.x + step_x * static_cast<double>(columns - 1) &&
+           p.y <= min.y + step_y * static_cast<double>(rows - 1);
+}
+
+std::size_t ClearanceField::node(std::size_t column, std::size_t row) const
+{
+    return row * columns + column;
+}
+
+void ClearanceField::build_column(
+    std::size_t column, const std::vector<std::size_t> &by_y)
+{
+    // Down one column, the squared distance to each robot is a parabola in y
+    // whose vertex is level with the robot and raised by the squared
+    // horizontal distance. The nearest robot at each node is the lowest
+    // parabola there, so find the lower envelope of the parabolas, as in
+    // Felzenszwalb and Huttenlocher’s distance transform, and walk it.
+    double x = min.x + step_x * static_cast<double>(column);
+    std::array<double, TeamSnapshot::CAPACITY> lift;
+    for (std::size_t i = 0; i != team.size; ++i)
+    {
+        double dx = x - team.positions[i].x;
+        lift[i]   = dx * dx;
+    }
+
+    // envelope[k] is lowest from bounds[k] up to bounds[k + 1].
+    std::array<std::size_t, TeamSnapshot::CAPACITY> envelope;
+    std::array<double, TeamSnapshot::CAPACITY> bounds;
+    std::size_t count = 0;
+    for (std::size_t q : by_y)
+    {
+        double yq    = team.positions[q].y;
+        double start = -std::numeric_limits<double>::infinity();
+        bool hidden  = false;
+        while (count)
+        {
+            std::size_t top = envelope[count - 1];
+            double yt       = team.positions[top].y;
+            if (yq == yt)
+            {
+                // Parabolas with level vertices never cross; keep the lower.
+                hidden = lift[q] >= lift[top];
+                if (hidden)
+                {
+                    break;
+                }
+                --count;
+                continue;
+            }
+            start = ((lift[q] + yq * yq) - (lift[top] + yt * yt)) /
+                    (2.0 * (yq - yt));
+            if (start > bounds[count - 1])
+            {
+                break;
+            }
+            --count;
+            start = -std::numeric_limits<double>::infinity();
+        }
+        if (!hidden)
+        {
+            envelope[count] = q;
+            bounds[count]   = start;
+            ++count;
+        }
+    }
+
+    std::size_t k = 0;
+    for (std::size_t row = 0; row != rows; ++row)
+    {
+        double y = min.y + step_y * static_cast<double>(row);
+        while (k + 1 < count && bounds[k + 1] < y)
+        {
+            ++k;
+        }
+        std::size_t q = envelope[k];
+        double dy     = y - team.positions[q].y;
+        distances[node(column, row)] = std::sqrt(lift[q] + dy * dy);
+        owners[node(column, row)]    = static_cast<unsigned char>(q);
+    }
+}
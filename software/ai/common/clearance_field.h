@@ -0,0 +1,86 @@
+#ifndef AI_COMMON_CLEARANCE_FIELD_H
+#define AI_COMMON_CLEARANCE_FIELD_H
+
+#include <cstddef>
+#include <vector>
+#include "ai/common/world_snapshot.h"
+#include "geom/point.h"
+
+namespace AI
+{
+namespace Common
+{
+/**
+ * \brief The distance from every point on the field to the nearest robot of
+ * one team, sampled on a grid.
+ *
+ * The field is built once per tick from a team snapshot. Afterwards, asking
+ * how far a candidate point is from the team costs a few array reads rather
+ * than a loop over the robots.
+ *
+ * The grid holds the exact distance and nearest robot at each node. Between
+ * nodes, the distance is interpolated bilinearly. Because distance changes by
+ * at most one metre per metre, the interpolated value is never off by more
+ * than half the diagonal of a cell. The nearest robot is the one nearest the
+ * closest node, which can differ from the true nearest robot only where two
+ * robots are within a cell diagonal of being equally far away. Points outside
+ * the grid are computed exactly.
+ */
+class ClearanceField final
+{
+   public:
+    /**
+     * \brief Constructs a field with no robots.
+     */
+    explicit ClearanceField();
+
+    /**
+     * \brief Rebuilds the field.
+     *
+     * This takes time linear in the number of grid nodes plus the number of
+     * robots times the number of grid columns.
+     *
+     * \param[in] team the robots to measure distance to
+     * \param[in] min the corner of the grid with the smallest coordinates
+     * \param[in] max the corner of the grid with the largest coordinates
+     * \param[in] resolution the largest spacing between grid nodes, in metres
+     */
+    void build(
+        const TeamSnapshot &team, Point min, Point max, double resolution);
+
+    /**
+     * \brief Returns the distance from a point to the nearest robot.
+     *
+     * \param[in] p the point
+     *
+     * \return the distance from \p p to the nearest robot, or infinity if
+     * there are no robots
+     */
+    double distance(Point p) const;
+
+    /**
+     * \brief Returns the robot nearest a point.
+     *
+     * \param[in] p the point
+     *
+     * \return the index in the team of the robot nearest \p p, or the size of
+     * the team if there are no robots
+     */
+    std::size_t nearest(Point p) const;
+
+   private:
+    TeamSnapshot team;
+    Point min;
+    double step_x, step_y;
+    std::size_t columns, rows;
+    std::vector<double> distances;
+    std::vector<unsigned char> owners;
+
+    bool covers(Point p) const;
+    std::size_t node(std::size_t column, std::size_t row) const;
+    void build_column(std::size_t column, const std::vector<std::size_t> &by_y);
+};
+}
+}
+
+#endif
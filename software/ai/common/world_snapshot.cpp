@@ -0,0 +1,37 @@
+#include "ai/common/world_snapshot.h"
+
+using AI::Common::TeamSnapshot;
+
+constexpr std::size_t TeamSnapshot::CAPACITY;
+
+TeamSnapshot::TeamSnapshot() : size(0)
+{
+}
+
+std::size_t TeamSnapshot::find(unsigned int pattern) const
+{
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        if (patterns[i] == pattern)
+        {
+            return i;
+        }
+    }
+    return size;
+}
+
+std::size_t TeamSnapshot::nearest(Point p) const
+{
+    std::size_t best = size;
+    double best_dist = 0.0;
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        double dist = (positions[i] - p).lensq();
+        if (best == size || dist < best_dist)
+        {
+            best      = i;
+            best_dist = dist;
+        }
+    }
+    return best;
+}
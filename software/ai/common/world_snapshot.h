@@ -0,0 +1,123 @@
+#ifndef AI_COMMON_WORLD_SNAPSHOT_H
+#define AI_COMMON_WORLD_SNAPSHOT_H
+
+#include <array>
+#include <cstddef>
+#include "ai/common/time.h"
+#include "geom/angle.h"
+#include "geom/point.h"
+
+namespace AI
+{
+namespace Common
+{
+/**
+ * \brief The state of one team at the start of a tick.
+ *
+ * The state is kept as parallel arrays rather than as an array of robots, so
+ * a loop that only needs positions walks one small contiguous array. Element
+ * \c i of every array describes the robot at index \c i of the team, which is
+ * also the order in which iterating over the team visits the robots.
+ */
+struct TeamSnapshot final
+{
+    /**
+     * \brief The most robots a team can hold, one per vision pattern.
+     */
+    static constexpr std::size_t CAPACITY = 16;
+
+    /**
+     * \brief The number of robots on the team.
+     */
+    std::size_t size;
+
+    /**
+     * \brief The robots’ patterns.
+     */
+    std::array<unsigned int, CAPACITY> patterns;
+
+    /**
+     * \brief The robots’ positions.
+     */
+    std::array<Point, CAPACITY> positions;
+
+    /**
+     * \brief The robots’ velocities.
+     */
+    std::array<Point, CAPACITY> velocities;
+
+    /**
+     * \brief The robots’ orientations.
+     */
+    std::array<Angle, CAPACITY> orientations;
+
+    /**
+     * \brief The robots’ angular velocities.
+     */
+    std::array<Angle, CAPACITY> avelocities;
+
+    /**
+     * \brief Constructs an empty team.
+     */
+    explicit TeamSnapshot();
+
+    /**
+     * \brief Finds a robot by pattern.
+     *
+     * \param[in] pattern the pattern to look for
+     *
+     * \return the index of the robot with \p pattern, or \ref size if there is
+     * none
+     */
+    std::size_t find(unsigned int pattern) const;
+
+    /**
+     * \brief Finds the robot nearest a point.
+     *
+     * \param[in] p the point
+     *
+     * \return the index of the robot nearest \p p, or \ref size if the team is
+     * empty
+     */
+    std::size_t nearest(Point p) const;
+};
+
+/**
+ * \brief The state of the ball and of both teams, recorded once at the start
+ * of each tick after the backend has locked its predictors.
+ *
+ * Reading a snapshot is cheaper than asking each robot for its position,
+ * which goes through the backend’s predictor every time. A snapshot is also
+ * plain data, so a copy of one can be handed to another thread.
+ */
+struct WorldSnapshot final
+{
+    /**
+     * \brief The monotonic time at which the snapshot was taken.
+     */
+    Timestamp time;
+
+    /**
+     * \brief The ball’s position.
+     */
+    Point ball_position;
+
+    /**
+     * \brief The ball’s velocity.
+     */
+    Point ball_velocity;
+
+    /**
+     * \brief The friendly team.
+     */
+    TeamSnapshot friendly;
+
+    /**
+     * \brief The enemy team.
+     */
+    TeamSnapshot enemy;
+};
+}
+}
+
+#endif
@@ -56,6 +56,9 @@ class HighLevel : public NonCopyable
      * \brief Returns the user interface controls for this high-level.
      *
      * \return the high-level's UI controls.
+     *
+     * \note This is not called when the AI runs headless, so widgets should be
+     * created here on first call rather than in the constructor.
      */
     virtual Gtk::Widget *ui_controls() = 0;
 
@@ -12,7 +12,11 @@
 #include "util/algorithm.h"
 #include "util/dprint.h"
 #include "util/param.h"
+#include "util/tick_counter.h"
 
+#include <cmath>
+#include <initializer_list>
+#include <utility>
 #include <vector>
 
 using namespace AI::HL::W;
@@ -42,6 +46,13 @@ BoolParam open_net_dangerous(
 DoubleParam tdefend_dist(
     u8"Distance between the tdefenders", u8"AI/HL/STP/tdefend", 2.25, 1.0, 3.0);
 
+DoubleParam memo_step(
+    u8"memo grid step (m, m/s or rad), 0 to disable", u8"AI/HL/STP/defense",
+    0.01, 0.0, 0.1);
+
+TickCounter memo_hits(u8"Defense memo hits");
+TickCounter memo_misses(u8"Defense memo misses");
+
 // The closest distance players allowed to the ball
 // DO NOT make this EXACT, instead, add a little tolerance!
 const double AVOIDANCE_DIST =
@@ -69,18 +80,129 @@ bool goalie_top = true;
 
 std::array<Point, MAX_DEFENDERS + 1> waypoints;
 
-std::array<Point, MAX_DEFENDERS + 1> compute(World world)
+/**
+ * The parts of the field the defense measures against, worked out once each
+ * time the field changes instead of on every call.
+ */
+struct DefenseGeometry final
 {
-    const Field &field = world.field();
+    double half_length;
+    double half_goal_width;
+    Point friendly_goal;
+    Point friendly_goalpost_neg;
+    Point friendly_goalpost_pos;
+    Point friendly_crease_neg_corner;
+    Point friendly_crease_pos_corner;
+
+    // A defender placed nearer the goal line than this, or further from the
+    // centre line than max_defender_y, is moved somewhere saner.
+    double min_defender_x;
+    double max_defender_y;
+
+    explicit DefenseGeometry() = default;
+
+    explicit DefenseGeometry(const Field &field)
+        : half_length(field.length() / 2),
+          half_goal_width(field.goal_width() / 2),
+          friendly_goal(field.friendly_goal()),
+          friendly_goalpost_neg(field.friendly_goalpost_neg()),
+          friendly_goalpost_pos(field.friendly_goalpost_pos()),
+          friendly_crease_neg_corner(field.friendly_crease_neg_corner()),
+          friendly_crease_pos_corner(field.friendly_crease_pos_corner()),
+          min_defender_x(
+              Robot::MAX_RADIUS - field.length() / 2 +
+              field.defense_area_stretch()),
+          max_defender_y(field.width() / 4)
+    {
+    }
 
-    if (world.ball().position().y > field.goal_width() / 2)
+    bool in_friendly_crease(Point p) const
     {
-        goalie_top = !goalie_hug_switch;
+        return p.y < friendly_crease_pos_corner.y &&
+               p.y > friendly_crease_neg_corner.y &&
+               p.x < friendly_crease_pos_corner.x && p.x > friendly_goal.x;
+    }
+};
+
+DefenseGeometry geometry;
+bool geometry_stale = true;
+
+/**
+ * Recent results of compute, keyed on the ball and enemies rounded to
+ * memo_step, so that while play is stopped the defense is not worked out
+ * afresh every tick. An entry with an empty key is unused.
+ */
+struct MemoEntry final
+{
+    std::vector<long> key;
+    std::array<Point, MAX_DEFENDERS + 1> waypoints;
+};
+
+// A few entries, so that noise moving the ball or a robot back and forth
+// across a grid line still hits.
+std::array<MemoEntry, 4> memo;
+std::size_t memo_next = 0;
+
+void clear_memo()
+{
+    for (MemoEntry &i : memo)
+    {
+        i.key.clear();
     }
-    else if (world.ball().position().y < -field.goal_width() / 2)
+}
+
+const DefenseGeometry &defense_geometry(World world)
+{
+    static bool watching = false;
+    if (!watching)
     {
-        goalie_top = goalie_hug_switch;
+        world.signal_field_changed().connect([]() {
+            geometry_stale = true;
+            clear_memo();
+        });
+        for (const Param *i : std::initializer_list<const Param *>{
+                 &defense_follow_enemy_baller, &goalie_hug_switch,
+                 &max_goalie_dist, &robot_shrink, &ball2side_ratio,
+                 &open_net_dangerous, &enemy_shoot_accuracy})
+        {
+            i->signal_changed().connect(&clear_memo);
+        }
+        watching = true;
+    }
+    if (geometry_stale)
+    {
+        geometry       = DefenseGeometry(world.field());
+        geometry_stale = false;
     }
+    return geometry;
+}
+
+std::vector<long> memo_key(World world, double step)
+{
+    std::vector<long> key;
+    auto add = [&key, step](double value) {
+        key.push_back(std::lround(value / step));
+    };
+    key.push_back(goalie_top);
+    add(world.ball().position().x);
+    add(world.ball().position().y);
+    add(world.ball().velocity().x);
+    add(world.ball().velocity().y);
+    for (const Robot i : world.enemy_team())
+    {
+        key.push_back(i.pattern());
+        add(i.position().x);
+        add(i.position().y);
+        add(i.velocity().x);
+        add(i.velocity().y);
+        add(i.orientation().to_radians());
+    }
+    return key;
+}
+
+std::array<Point, MAX_DEFENDERS + 1> compute(World world)
+{
+    const DefenseGeometry &field = defense_geometry(world);
 
     // list of points to defend, by order of importance
     std::vector<Point> waypoint_defenders;
@@ -104,11 +226,11 @@ std::array<Point, MAX_DEFENDERS + 1> compute(World world)
     }
 
     const Point goal_side =
-        goalie_top ? Point(-field.length() / 2, field.goal_width() / 2)
-                   : Point(-field.length() / 2, -field.goal_width() / 2);
+        goalie_top ? Point(-field.half_length, field.half_goal_width)
+                   : Point(-field.half_length, -field.half_goal_width);
     const Point goal_opp =
-        goalie_top ? Point(-field.length() / 2, -field.goal_width() / 2)
-                   : Point(-field.length() / 2, field.goal_width() / 2);
+        goalie_top ? Point(-field.half_length, -field.half_goal_width)
+                   : Point(-field.half_length, field.half_goal_width);
 
     // now calculate where you want the goalie to be
     Point waypoint_goalie;
@@ -128,7 +250,7 @@ std::array<Point, MAX_DEFENDERS + 1> compute(World world)
 
         // prevent the goalie from entering the goal area
         waypoint_goalie.x =
-            std::max(waypoint_goalie.x, -field.length() / 2 + radius);
+            std::max(waypoint_goalie.x, -field.half_length + radius);
 
         second_needed = dist(waypoint_goalie, Seg(ball_pos, goal_opp)) > radius;
     }
@@ -145,18 +267,17 @@ std::array<Point, MAX_DEFENDERS + 1> compute(World world)
         }
 
         bool blowup = false;
-        if (D1.x < Robot::MAX_RADIUS - field.length() / 2 +
-                       field.defense_area_stretch())
+        if (D1.x < field.min_defender_x)
         {
             blowup = true;
         }
-        if (std::fabs(D1.y) > field.width() / 4)
+        if (std::fabs(D1.y) > field.max_defender_y)
         {
             blowup = true;
         }
         if (blowup)
         {
-            D1 = (field.friendly_goal() + ball_pos) / 2;
+            D1 = (field.friendly_goal + ball_pos) / 2;
         }
         waypoint_defenders.push_back(D1);
     }
@@ -239,20 +360,19 @@ std::array<Point, MAX_DEFENDERS + 1> compute(World world)
         {
             bool blowup = false;
             D           = closest_lineseg_point(
-                world.field().friendly_goal(), world.ball().position(),
+                field.friendly_goal, world.ball().position(),
                 threat[i].position());
-            if (D.x < Robot::MAX_RADIUS - field.length() / 2 +
-                          field.defense_area_stretch())
+            if (D.x < field.min_defender_x)
             {
                 blowup = true;
             }
-            if (std::fabs(D.y) > field.width() / 4)
+            if (std::fabs(D.y) > field.max_defender_y)
             {
                 blowup = true;
             }
             if (blowup)
             {
-                D = (field.friendly_goal() + threat[i].position()) / 2;
+                D = (field.friendly_goal + threat[i].position()) / 2;
             }
         }
         else
@@ -267,18 +387,17 @@ std::array<Point, MAX_DEFENDERS + 1> compute(World world)
             D           = calc_block_cone(
                 world.ball().position(), world.ball().position(),
                 threat[i].position(), radius);
-            if (D.x < Robot::MAX_RADIUS - field.length() / 2 +
-                          field.defense_area_stretch())
+            if (D.x < field.min_defender_x)
             {
                 blowup = true;
             }
-            if (std::fabs(D.y) > field.width() / 4)
+            if (std::fabs(D.y) > field.max_defender_y)
             {
                 blowup = true;
             }
             if (blowup)
             {
-                D = (field.friendly_goal() + threat[i].position()) / 2;
+                D = (field.friendly_goal + threat[i].position()) / 2;
             }
         }
         waypoint_defenders.push_back(D);
@@ -287,7 +406,7 @@ std::array<Point, MAX_DEFENDERS + 1> compute(World world)
     // there are too few threat, this is strange
     while (waypoint_defenders.size() < MAX_DEFENDERS)
     {
-        waypoint_defenders.push_back((field.friendly_goal() + ball_pos) / 2);
+        waypoint_defenders.push_back((field.friendly_goal + ball_pos) / 2);
     }
 
     std::array<Point, MAX_DEFENDERS + 1> waypoints;
@@ -355,25 +474,15 @@ Point tdefender_block_enemy(World world, Point r, const unsigned index)
 
 bool AI::HL::STP::Evaluation::ball_in_friendly_crease(World world)
 {
-    bool bBallInCrease;
-    Point ballPos = world.ball().position();
-
-    bBallInCrease =
-        ballPos.y < world.field().friendly_crease_pos_corner().y &&
-        ballPos.y > world.field()
-                        .friendly_crease_neg_corner()
-                        .y  // is the ball within the goalie crease?
-        && ballPos.x < (world.field().friendly_crease_pos_corner().x) &&
-        ballPos.x > world.field().friendly_goal().x;
-
-    return bBallInCrease;
+    return defense_geometry(world).in_friendly_crease(world.ball().position());
 }
 
 
 
 Point AI::HL::STP::Evaluation::evaluateShallowAngleBlock(World world, Point position) { //TODO comment this
-    Point negGoalPost = world.field().friendly_goalpost_neg();
-    Point posGoalPost = world.field().friendly_goalpost_pos();
+    const DefenseGeometry &field = defense_geometry(world);
+    Point negGoalPost = field.friendly_goalpost_neg;
+    Point posGoalPost = field.friendly_goalpost_pos;
 
     Point dirToNegPost = (negGoalPost - position).norm();
     Point dirToPosPost = (posGoalPost - position).norm();
@@ -394,10 +503,10 @@ Point AI::HL::STP::Evaluation::evaluateShallowAngleBlock(World world, Point posi
     double x;
 
     if (position.y < 0) {
-        criticalValue = world.field().friendly_crease_neg_corner().y + Robot::MAX_RADIUS;
+        criticalValue = field.friendly_crease_neg_corner.y + Robot::MAX_RADIUS;
         negPostIntersect.y = criticalValue;
     } else {
-        criticalValue = world.field().friendly_crease_pos_corner().y - Robot::MAX_RADIUS;
+        criticalValue = field.friendly_crease_pos_corner.y - Robot::MAX_RADIUS;
         posPostIntersect.y = criticalValue;
     }
 
@@ -423,23 +532,23 @@ Point AI::HL::STP::Evaluation::evaluateShallowAngleBlock(World world, Point posi
         x = sqrt(x);
 
         if (position.y < 0 ) {
-            blockPos = position + (world.field().friendly_goal() - position).norm()*x;
+            blockPos = position + (field.friendly_goal - position).norm()*x;
         }
         else {
-            blockPos.x = position.x + (world.field().friendly_goal() - position).norm().x*x;
-            blockPos.y = position.y + (world.field().friendly_goal() - position).norm().y*x;
+            blockPos.x = position.x + (field.friendly_goal - position).norm().x*x;
+            blockPos.y = position.y + (field.friendly_goal - position).norm().y*x;
             // LOGF_INFO("block x: %1, block y: %2", blockPos.x, blockPos.y);
         }
-        if (blockPos.x < world.field().friendly_goal().x+0.05) {
-            blockPos.x = world.field().friendly_goal().x + Robot::MAX_RADIUS;
+        if (blockPos.x < field.friendly_goal.x+0.05) {
+            blockPos.x = field.friendly_goal.x + Robot::MAX_RADIUS;
 
             if (position.y < 0) {
-                blockPos.y = world.field().friendly_goalpost_neg().y - Robot::MAX_RADIUS;
+                blockPos.y = field.friendly_goalpost_neg.y - Robot::MAX_RADIUS;
             } else {
-                blockPos.y = world.field().friendly_goalpost_pos().y + Robot::MAX_RADIUS;
+                blockPos.y = field.friendly_goalpost_pos.y + Robot::MAX_RADIUS;
             }
-        } else if (blockPos.x > world.field().friendly_crease_pos_corner().x) {
-            blockPos.x = world.field().friendly_crease_pos_corner().x;
+        } else if (blockPos.x > field.friendly_crease_pos_corner.x) {
+            blockPos.x = field.friendly_crease_pos_corner.x;
         }
     }
 
@@ -449,10 +558,11 @@ Point AI::HL::STP::Evaluation::evaluateShallowAngleBlock(World world, Point posi
 }
 
 std::vector<Point> AI::HL::STP::Evaluation::evaluate_shots(World world, Point position) {
+    const DefenseGeometry &field = defense_geometry(world);
 
-    Point dirToNegPost = (world.field().friendly_goalpost_neg() - position).norm();
-    Point dirToPosPost = (world.field().friendly_goalpost_pos() - position).norm();
-    Point dirToCenterGoal = (world.field().friendly_goal() - position).norm();
+    Point dirToNegPost = (field.friendly_goalpost_neg - position).norm();
+    Point dirToPosPost = (field.friendly_goalpost_pos - position).norm();
+    Point dirToCenterGoal = (field.friendly_goal - position).norm();
 
     Point negPostIntersect;
     Point posPostIntersect;
@@ -484,33 +594,20 @@ std::vector<Point> AI::HL::STP::Evaluation::evaluate_shots(World world, Point po
     defensePoint2 = position + dirToPosPost * scaleFactor;
 
 
-    bPoint1InCrease =
-            defensePoint1.y < world.field().friendly_crease_pos_corner().y &&
-            defensePoint1.y > world.field()
-                    .friendly_crease_neg_corner()
-                    .y  // is the ball within the goalie crease?
-            && defensePoint1.x < (world.field().friendly_crease_pos_corner().x) &&
-            defensePoint1.x > world.field().friendly_goal().x;
-
-    bPoint2InCrease =
-            defensePoint2.y < world.field().friendly_crease_pos_corner().y &&
-            defensePoint2.y > world.field()
-                    .friendly_crease_neg_corner()
-                    .y  // is the ball within the goalie crease?
-            && defensePoint2.x < (world.field().friendly_crease_pos_corner().x) &&
-            defensePoint2.x > world.field().friendly_goal().x;
+    bPoint1InCrease = field.in_friendly_crease(defensePoint1);
+    bPoint2InCrease = field.in_friendly_crease(defensePoint2);
 
     defensePoints = Evaluation::positionFriendlyCreaseIntersect(world, world.ball().position());
 
-    if (bPoint1InCrease || defensePoint1.x < -world.field().length()/2) {
+    if (bPoint1InCrease || defensePoint1.x < -field.half_length) {
         defensePoint1 = defensePoints[1];
     }
 
-    if (bPoint2InCrease || defensePoint2.x < -world.field().length()/2) {
+    if (bPoint2InCrease || defensePoint2.x < -field.half_length) {
         defensePoint2 = defensePoints[2];
     }
 
-    defensePointGoalie = positionFriendlyCreaseIntersect(world, world.ball().position())[0];
+    defensePointGoalie = defensePoints[0];
 //    LOGF_INFO("neg..x:%1, y:%2", defensePoint1.x, defensePoint1.y);
 //    LOGF_INFO("pos..x:%1, y:%2", defensePoint2.x, defensePoint2.y);
 
@@ -523,7 +620,8 @@ std::vector<Point> AI::HL::STP::Evaluation::evaluate_shots(World world, Point po
 }
 
 std::vector<Point> AI::HL::STP::Evaluation::positionFriendlyCreaseIntersect(World world, Point position) {
-    Angle dirToGoal = (position - world.field().friendly_goal() ).orientation();
+    const DefenseGeometry &field = defense_geometry(world);
+    Angle dirToGoal = (position - field.friendly_goal ).orientation();
     double criticalValue;
     double scaleFactor;
     Point Intersect;
@@ -577,12 +675,12 @@ std::vector<Point> AI::HL::STP::Evaluation::positionFriendlyCreaseIntersect(Worl
 
     if (dirToGoal < Angle::of_degrees(-45))
     {
-        criticalValue = world.field().friendly_crease_neg_corner().y;
+        criticalValue = field.friendly_crease_neg_corner.y;
         // criticalValue = goaliePos.crit + scaleFactor*trig(goalieangle)
         // scalefactor = (criticalValue - goaliePos.crit) / trig(angle)
-        scaleFactor = (criticalValue - world.field().friendly_goal().y) / dirToGoal.sin();
+        scaleFactor = (criticalValue - field.friendly_goal.y) / dirToGoal.sin();
         Intersect.y = criticalValue;
-        Intersect.x = world.field().friendly_goal().x + scaleFactor * dirToGoal.cos();
+        Intersect.x = field.friendly_goal.x + scaleFactor * dirToGoal.cos();
 
         defender1Intersect = Intersect;
         defender2Intersect = Intersect;
@@ -590,7 +688,7 @@ std::vector<Point> AI::HL::STP::Evaluation::positionFriendlyCreaseIntersect(Worl
         defender1Intersect.x += Robot::MAX_RADIUS;
         defender2Intersect.x -= Robot::MAX_RADIUS;
 
-        if (defender1Intersect.x <= world.field().friendly_goal().x) {
+        if (defender1Intersect.x <= field.friendly_goal.x) {
             defender1Intersect.x = defender2Intersect.x + Robot::MAX_RADIUS;
         }
         defender1Intersect.y -= 2*Robot::MAX_RADIUS;
@@ -598,10 +696,10 @@ std::vector<Point> AI::HL::STP::Evaluation::positionFriendlyCreaseIntersect(Worl
     }
     else if (dirToGoal > Angle::of_degrees(45))
     {
-        criticalValue = world.field().friendly_crease_pos_corner().y;
-        scaleFactor   = (criticalValue - world.field().friendly_goal().y) / dirToGoal.sin();
+        criticalValue = field.friendly_crease_pos_corner.y;
+        scaleFactor   = (criticalValue - field.friendly_goal.y) / dirToGoal.sin();
         Intersect.y   = criticalValue;
-        Intersect.x   = world.field().friendly_goal().x + scaleFactor * dirToGoal.cos();
+        Intersect.x   = field.friendly_goal.x + scaleFactor * dirToGoal.cos();
 
         defender1Intersect = Intersect;
         defender2Intersect = Intersect;
@@ -612,17 +710,17 @@ std::vector<Point> AI::HL::STP::Evaluation::positionFriendlyCreaseIntersect(Worl
         defender1Intersect.y += 2*Robot::MAX_RADIUS;
         defender2Intersect.y += 2*Robot::MAX_RADIUS;
 
-        if (defender2Intersect.x <= world.field().friendly_goal().x) {
+        if (defender2Intersect.x <= field.friendly_goal.x) {
             defender2Intersect.x = defender1Intersect.x + Robot::MAX_RADIUS;
         }
 
     }
     else
     {
-        criticalValue = world.field().friendly_crease_pos_corner().x;
-        scaleFactor   = (criticalValue - world.field().friendly_goal().x) / dirToGoal.cos();
+        criticalValue = field.friendly_crease_pos_corner.x;
+        scaleFactor   = (criticalValue - field.friendly_goal.x) / dirToGoal.cos();
         Intersect.x   = criticalValue;
-        Intersect.y   = world.field().friendly_goal().y + scaleFactor * dirToGoal.sin();
+        Intersect.y   = field.friendly_goal.y + scaleFactor * dirToGoal.sin();
 
         defender1Intersect = Intersect;
         defender2Intersect = Intersect;
@@ -663,7 +761,39 @@ Point endline_intersection(World world, Point position) {
 }
 void AI::HL::STP::Evaluation::tick_defense(World world)
 {
+    const DefenseGeometry &field = defense_geometry(world);
+    if (world.ball().position().y > field.half_goal_width)
+    {
+        goalie_top = !goalie_hug_switch;
+    }
+    else if (world.ball().position().y < -field.half_goal_width)
+    {
+        goalie_top = goalie_hug_switch;
+    }
+
+    if (memo_step <= 0)
+    {
+        waypoints = compute(world);
+        return;
+    }
+
+    std::vector<long> key = memo_key(world, memo_step);
+    for (const MemoEntry &i : memo)
+    {
+        if (i.key == key)
+        {
+            memo_hits.increment();
+            waypoints = i.waypoints;
+            return;
+        }
+    }
+    memo_misses.increment();
     waypoints = compute(world);
+
+    MemoEntry &entry = memo[memo_next];
+    memo_next        = (memo_next + 1) % memo.size();
+    entry.key        = std::move(key);
+    entry.waypoints  = waypoints;
 }
 
 const std::array<Point, MAX_DEFENDERS + 1>
@@ -30,6 +30,8 @@ struct by_risk
         return a.risk > b.risk;
     }
 };
+
+std::vector<Evaluation::Threat> current_threats;
 }
 
 bool AI::HL::STP::Evaluation::enemy_can_shoot_goal(World world, Robot enemy)
@@ -119,18 +121,17 @@ std::pair<Point, Angle> Evaluation::calc_enemy_best_shot_goal(
 std::pair<Point, Angle> Evaluation::calc_enemy_best_shot_goal(
     World world, const Robot enemy, const double radius)
 {
-    std::vector<Point> obstacles;
-    for (const Player i : world.friendly_team())
+    const AI::HL::W::WorldSnapshot &snap = world.snapshot();
+    std::vector<Point> obstacles(
+        snap.friendly.positions.begin(),
+        snap.friendly.positions.begin() + snap.friendly.size);
+    const unsigned int pattern = enemy.pattern();
+    for (std::size_t i = 0; i != snap.enemy.size; ++i)
     {
-        obstacles.push_back(i.position());
-    }
-    for (const Robot erob : world.enemy_team())
-    {
-        if (erob == enemy)
+        if (snap.enemy.patterns[i] != pattern)
         {
-            continue;
+            obstacles.push_back(snap.enemy.positions[i]);
         }
-        obstacles.push_back(erob.position());
     }
     return calc_enemy_best_shot_goal(
         world.field(), obstacles, enemy.position(), radius);
@@ -155,20 +156,14 @@ std::vector<Robot> AI::HL::STP::Evaluation::get_passees(
     return passees;
 }
 
-int AI::HL::STP::Evaluation::calc_enemy_pass(World world, const Robot robot)
+int AI::HL::STP::Evaluation::calc_enemy_pass(World, const Robot robot)
 {
-    EnemyTeam enemy = world.enemy_team();
-
-    auto threats = calc_enemy_threat(world);
-
-    for (std::size_t i = 0; i < enemy.size(); ++i)
+    for (const Threat &i : evaluate_enemy_threat())
     {
-        if (enemy[i] != robot)
+        if (i.robot == robot)
         {
-            continue;
+            return i.passes_goal;
         }
-
-        return threats[i].passes_goal;
     }
 
     return 5;
@@ -206,6 +201,17 @@ int AI::HL::STP::Evaluation::calc_enemy_pass(World world, const Robot robot)
      */
 }
 
+void AI::HL::STP::Evaluation::tick_enemy_threat(World world)
+{
+    current_threats = calc_enemy_threat(world);
+}
+
+const std::vector<Evaluation::Threat>
+    &AI::HL::STP::Evaluation::evaluate_enemy_threat()
+{
+    return current_threats;
+}
+
 std::vector<Evaluation::Threat> AI::HL::STP::Evaluation::calc_enemy_threat(
     World world)
 {
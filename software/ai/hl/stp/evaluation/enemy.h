@@ -65,6 +65,17 @@ struct Threat final
  */
 std::vector<Threat> calc_enemy_threat(World world);
 
+/**
+ * Evaluates how dangerous each enemy is, once per tick, for
+ * evaluate_enemy_threat to return.
+ */
+void tick_enemy_threat(World world);
+
+/**
+ * Returns the threats computed by the last tick_enemy_threat.
+ */
+const std::vector<Threat> &evaluate_enemy_threat();
+
 /**
  * Checks if it's possible for this enemy to shoot to the goal.
  */
@@ -87,6 +98,7 @@ std::pair<Point, Angle> calc_enemy_best_shot_goal(
  * # of passes it takes for the enemy to shoot to our goal
  * 0 means the enemy has a clear shot to our goal!
  * ignore (set to 5 if # of passes > 2)
+ * Read from the threats computed by the last tick_enemy_threat.
  */
 int calc_enemy_pass(World world, Robot robot);
 
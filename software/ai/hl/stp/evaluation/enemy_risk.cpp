@@ -5,7 +5,9 @@
 #include "geom/point.h"
 #include "ai/hl/util.h"
 #include "ai/hl/stp/evaluation/enemy_risk.h"
+#include "ai/hl/stp/evaluation/time_to_reach.h"
 #include <math.h>
+#include <algorithm>
 #include <vector>
 #include <stdio.h>
 #include <iostream>
@@ -60,6 +62,8 @@ double AI::HL::STP::Evaluation::dangerInterception(PassInfo::worldSnapshot snaps
 	//ENEMY_A_MAX and ENEMY_V_MAX should be pulled from the logs
 	double ENEMY_A_MAX = 4;
 	double ENEMY_V_MAX = 3;
+	//Enemies are assumed to drive as hard sideways as forwards
+	const Evaluation::ReachLimits ENEMY_LIMITS = {ENEMY_A_MAX, ENEMY_V_MAX, ENEMY_A_MAX, ENEMY_V_MAX};
 
 	//Estimate of the time it takes the enemy to respond to our actions, should be observed
 	double ENEMY_T_REACT = 0.10;
@@ -84,6 +88,8 @@ double AI::HL::STP::Evaluation::dangerInterception(PassInfo::worldSnapshot snaps
 	//This has 1 more element than enemy_team because a worst case prediction for the closest enemy robot is added.
 	//The closest enemy robot is assumed to move as fast as possible (without crashing) towards the passer
 	std::vector<Point> projected_enemy_positions(num_enemies +1);
+	//The velocities the enemies have at the kick; the virtual enemy starts at rest
+	std::vector<Point> projected_enemy_velocities(num_enemies +1);
 	double shortest_distance = 1000;//start with a very large number
 	Point projected_closest_enemy_position;
 	double current_distance;
@@ -91,6 +97,7 @@ double AI::HL::STP::Evaluation::dangerInterception(PassInfo::worldSnapshot snaps
 	for (unsigned int i = 0; i < snapshot.enemy_positions.size(); ++i){
 		projected_enemy_positions.at(i) = snapshot.enemy_positions.at(i)
 												+ snapshot.enemy_velocities.at(i) * future_time;
+		projected_enemy_velocities.at(i) = snapshot.enemy_velocities.at(i);
 		current_distance = (snapshot.passer_position - projected_enemy_positions.at(i)).len();
 		if (current_distance < shortest_distance){
 			//calculates closest enemy robot at future_time
@@ -153,18 +160,23 @@ double AI::HL::STP::Evaluation::dangerInterception(PassInfo::worldSnapshot snaps
 			t_intercept = delay_time + r*(t_arrive - delay_time);
 		}
 
-		//badly named, will change later
-		double t_move = (t_intercept - delay_time - ENEMY_T_REACT);
+		//the time the enemy has to get in the way once it reacts to the kick
+		double t_move = std::max(0.0, t_intercept - delay_time - ENEMY_T_REACT);
 
 		//find q
-		if (t_move > 2*ENEMY_V_MAX/ENEMY_A_MAX){
-		  q = dist_intercept -R_RADIUS-DIST_UNCERTAINTY -ENEMY_V_MAX*ENEMY_V_MAX/ ENEMY_A_MAX - (t_move - 2*ENEMY_V_MAX/ENEMY_A_MAX)*ENEMY_V_MAX;
-		}
-		else if (t_move > 0 ){
-		  q = dist_intercept -R_RADIUS- DIST_UNCERTAINTY- ENEMY_A_MAX/4*t_move*t_move ;
+		double reach = R_RADIUS + DIST_UNCERTAINTY;
+		if (dist_intercept > reach){
+			//The enemy only has to get within reach of the interception point,
+			//so it heads for the nearest point that close, starting from the
+			//velocity it has. The sigmoid was tuned on a distance margin;
+			//convert the time margin at the enemy's top speed.
+			Point intercept_point = r < 0 ? passer_pos : r > 1 ? destination : passer_pos + r*(destination - passer_pos);
+			Point target = intercept_point + (projected_enemy_positions.at(i) - intercept_point).norm(reach);
+			Evaluation::ReachState enemy = {projected_enemy_positions.at(i), projected_enemy_velocities.at(i)};
+			q = ENEMY_V_MAX*(Evaluation::time_to_reach(enemy, target, ENEMY_LIMITS) - t_move);
 		}
 		else {
-			q = dist_intercept - R_RADIUS - DIST_UNCERTAINTY;
+			q = dist_intercept - reach;
 		}
 
         if (print) printf("q: %f", q);
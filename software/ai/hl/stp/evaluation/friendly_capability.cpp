@@ -4,6 +4,8 @@
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
+#include <vector>
+#include "ai/hl/stp/evaluation/time_to_reach.h"
 #include "ai/hl/stp/gradient_approach/PassInfo.h"
 #include "ai/hl/util.h"
 #include "ai/hl/world.h"
@@ -20,43 +22,28 @@ double AI::HL::STP::Evaluation::getFriendlyCapability(
     double ball_vel)
 {
     // setup constants
-
-    double A_MAX              = 2.0;
+    // The sigmoid was tuned on a distance margin; convert the time margin
+    // at roughly the speed a passee covers ground.
     double V_MAX              = 1.1;
     double SCALING_CONST      = 4;
     double friendlyCapability = 1;
-    double shortest_dist      = 1000;  // Start with a large number
-    Robot best_passee;
-    double current_dist;
 
-    for (Point each_passee_position : snapshot.passee_positions)
+    std::vector<ReachState> passees(snapshot.passee_positions.size());
+    for (std::size_t i = 0; i < passees.size(); ++i)
     {
-        current_dist = (dest - each_passee_position).len();
-        if (current_dist < shortest_dist)
-        {
-            shortest_dist = current_dist;
-        }
+        passees[i].position = snapshot.passee_positions[i];
+        passees[i].velocity = i < snapshot.passee_velocities.size()
+                                  ? snapshot.passee_velocities[i]
+                                  : Point();
     }
 
     // total time is delay time + the time it takes the ball to reach its
     // destination
     double total_time =
         t_delay + (snapshot.passer_position - dest).len() / ball_vel;
-    // the distance the passee is from the destination
-    double passee_dist = shortest_dist;
-    double r           = 0;
 
     // can we get there in time?
-    if (total_time > 2 * V_MAX / A_MAX)
-    {
-        r = V_MAX * V_MAX / A_MAX + (total_time - 2 * V_MAX / A_MAX) * V_MAX -
-            passee_dist;
-    }
-
-    else
-    {
-        r = A_MAX / 4 * total_time * total_time - passee_dist;
-    }
+    double r = V_MAX * (total_time - min_time_to_reach(passees, dest));
 
     friendlyCapability =
         friendlyCapability / (1 + std::exp(-SCALING_CONST * r));
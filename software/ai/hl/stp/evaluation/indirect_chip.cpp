@@ -7,6 +7,7 @@
 #include "ai/hl/util.h"
 #include "ai/hl/world.h"
 #include "geom/angle.h"
+#include "geom/delaunay.h"
 #include "geom/point.h"
 #include "geom/shapes.h"
 #include "geom/util.h"
@@ -310,30 +311,18 @@ std::pair<Point, bool> AI::HL::STP::Evaluation::indirect_chipandchase_target(
 std::vector<Triangle> AI::HL::STP::Evaluation::get_all_triangles(
     World world, std::vector<Point> enemy_players)
 {
-    std::vector<Triangle> triangles;
-    // std::vector<Point> corners =
-    // AI::HL::STP::Evaluation::get_chip_target_area_corners(world,
-    // CHIP_TARGET_AREA_INSET);
     std::vector<Point> allPts = enemy_players;
     allPts.push_back(world.field().enemy_corner_neg());
     allPts.push_back(world.field().enemy_corner_pos());
     allPts.push_back(Point(0, world.field().enemy_corner_pos().y));
     allPts.push_back(Point(0, world.field().enemy_corner_neg().y));
-    // allPts.insert(std::end(allPts), std::begin(corners), std::end(corners));
 
-    for (unsigned int i = 0; i < allPts.size() - 2; i++)
+    // Delaunay triangles contain none of the other points and tile the area
+    // between them, so there is no need to build every triple.
+    std::vector<Triangle> triangles;
+    for (const std::array<std::size_t, 3> &t : delaunay_triangulate(allPts))
     {
-        for (unsigned int j = i + 1; j < allPts.size() - 1; j++)
-        {
-            for (unsigned int k = j + 1; k < allPts.size(); k++)
-            {
-                Point p1   = allPts[i];
-                Point p2   = allPts[j];
-                Point p3   = allPts[k];
-                Triangle t = triangle(p1, p2, p3);
-                triangles.push_back(t);
-            }
-        }
+        triangles.push_back(triangle(allPts[t[0]], allPts[t[1]], allPts[t[2]]));
     }
 
     return triangles;
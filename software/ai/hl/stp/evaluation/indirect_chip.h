@@ -39,9 +39,10 @@ Point deflect_off_enemy_target(World world);
  */
 std::pair<Point, bool> indirect_chipandchase_target(World world);
 
-/* Creates a vector of triangles, picking all permutations of points from the
- * list of all non-goalie
- * enemy players, and the 4 points returned by get_chip_area_target_corners
+/* Creates a vector of triangles from the Delaunay triangulation of the
+ * non-goalie enemy players and the corners of the enemy half of the field.
+ * The triangles tile the area without containing any of those points and
+ * avoid thin slivers, so they are the open regions worth chipping into.
  */
 std::vector<Triangle> get_all_triangles(
     World world, std::vector<Point> enemy_players);
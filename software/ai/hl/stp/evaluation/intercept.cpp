@@ -8,6 +8,7 @@
 #include "intercept.h"
 #include <math.h>
 #include "ai/common/field.h"
+#include "ai/hl/stp/evaluation/time_to_reach.h"
 #include "ai/hl/util.h"
 #include "ai/hl/world.h"
 #include "geom/point.h"
@@ -82,7 +83,9 @@ Point AI::HL::STP::Evaluation::quickest_intercept_position(
 
 double AI::HL::STP::Evaluation::time_to_intercept(Player player, Point target)
 {
-    return (target - player.position()).len() / (2.0 * 0.95) + 0.2;
+    // Allow for the time it takes a new primitive to reach the robot.
+    ReachState state = {player.position(), player.velocity()};
+    return time_to_reach(state, target) + 0.2;
 }
 
 double AI::HL::STP::Evaluation::getBestIntercept(
@@ -84,25 +84,15 @@ double scoring_function(
     const std::vector<Point> &dont_block)
 {
     // can't be too close to enemy
-    double closest_enemy = world.field().width();
-    for (std::size_t i = 0; i < enemy_pos.size(); ++i)
+    const double closest_enemy =
+        std::min(world.field().width(), world.enemy_clearance().distance(dest));
+    if (closest_enemy < near_thresh * Robot::MAX_RADIUS)
     {
-        double dist = (enemy_pos[i] - dest).len();
-        if (dist < near_thresh * Robot::MAX_RADIUS)
-        {
-            return -1e99;
-        }
-        closest_enemy = std::min(closest_enemy, dist);
+        return -1e99;
     }
     const double score_enemy = closest_enemy;
 
-    double closest_friendly     = 1e99;
-    const FriendlyTeam friendly = world.friendly_team();
-    for (const Player i : friendly)
-    {
-        double dist      = (i.position() - dest).len();
-        closest_friendly = std::min(closest_friendly, dist);
-    }
+    const double closest_friendly = world.friendly_clearance().distance(dest);
 
     if (closest_friendly > closest_enemy + Robot::MAX_RADIUS)
     {
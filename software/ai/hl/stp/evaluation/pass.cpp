@@ -204,11 +204,9 @@ std::pair<bool, Angle> Evaluation::best_shoot_ray(
 bool Evaluation::enemy_can_pass(
     World world, const Robot passer, const Robot passee)
 {
-    std::vector<Point> obstacles;
-    for (const Player i : world.friendly_team())
-    {
-        obstacles.push_back(i.position());
-    }
+    const AI::HL::W::TeamSnapshot &friendly = world.snapshot().friendly;
+    std::vector<Point> obstacles(
+        friendly.positions.begin(), friendly.positions.begin() + friendly.size);
 
     return can_pass_check(
         passer.position(), passee.position(), obstacles, enemy_pass_width);
@@ -216,22 +214,17 @@ bool Evaluation::enemy_can_pass(
 
 bool Evaluation::can_pass(World world, Player passer, Player passee)
 {
-    std::vector<Point> obstacles;
-    for (const Robot i : world.enemy_team())
-    {
-        obstacles.push_back(i.position());
-    }
-    for (const Player i : world.friendly_team())
+    const AI::HL::W::WorldSnapshot &snap = world.snapshot();
+    std::vector<Point> obstacles(
+        snap.enemy.positions.begin(),
+        snap.enemy.positions.begin() + snap.enemy.size);
+    for (std::size_t i = 0; i != snap.friendly.size; ++i)
     {
-        if (i == passer)
+        unsigned int pattern = snap.friendly.patterns[i];
+        if (pattern != passer.pattern() && pattern != passee.pattern())
         {
-            continue;
-        }
-        if (i == passee)
-        {
-            continue;
+            obstacles.push_back(snap.friendly.positions[i]);
         }
-        obstacles.push_back(i.position());
     }
 
     return can_pass_check(
@@ -240,11 +233,9 @@ bool Evaluation::can_pass(World world, Player passer, Player passee)
 
 bool Evaluation::can_pass(World world, const Point p1, const Point p2)
 {
-    std::vector<Point> obstacles;
-    for (const Robot i : world.enemy_team())
-    {
-        obstacles.push_back(i.position());
-    }
+    const AI::HL::W::TeamSnapshot &enemy = world.snapshot().enemy;
+    std::vector<Point> obstacles(
+        enemy.positions.begin(), enemy.positions.begin() + enemy.size);
 
     return can_pass_check(p1, p2, obstacles, friendly_pass_width);
 }
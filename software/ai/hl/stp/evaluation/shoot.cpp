@@ -68,20 +68,21 @@ std::pair<Point, Angle> Evaluation::get_best_shot_pair(World world, Robot robot)
             ? world.field().enemy_goal_boundary().first
             : world.field().enemy_goal_boundary().second;
 
+    const AI::HL::W::WorldSnapshot& snap = world.snapshot();
+    const Point pos                      = robot.position();
     std::vector<Point> obstacles;
-
-    for (auto i : world.enemy_team())
+    for (std::size_t i = 0; i != snap.enemy.size; ++i)
     {
-        if ((i.position() - robot.position()).len() > 0.01)
+        if ((snap.enemy.positions[i] - pos).len() > 0.01)
         {
-            obstacles.push_back(i.position());
+            obstacles.push_back(snap.enemy.positions[i]);
         }
     }
-    for (auto i : world.friendly_team())
+    for (std::size_t i = 0; i != snap.friendly.size; ++i)
     {
-        if ((i.position() - robot.position()).len() > 0.01)
+        if ((snap.friendly.positions[i] - pos).len() > 0.01)
         {
-            obstacles.push_back(i.position());
+            obstacles.push_back(snap.friendly.positions[i]);
         }
     }
 
@@ -0,0 +1,72 @@
+#include "ai/hl/stp/evaluation/time_to_reach.h"
+#include <algorithm>
+#include <limits>
+
+extern "C" {
+#include "bangbang.h"
+}
+
+using AI::HL::STP::Evaluation::ReachLimits;
+using AI::HL::STP::Evaluation::ReachState;
+
+namespace
+{
+/**
+ * \brief Computes how long a one-dimensional bang-bang move takes to come to
+ * rest at its destination.
+ */
+double axis_time(
+    double distance, double velocity, double acceleration, double speed)
+{
+    BBProfile profile;
+    PrepareBBTrajectoryMaxV(
+        &profile, static_cast<float>(distance), static_cast<float>(velocity),
+        0.0f, static_cast<float>(acceleration), static_cast<float>(speed));
+    PlanBBTrajectory(&profile);
+    return GetBBTime(&profile);
+}
+}
+
+const ReachLimits AI::HL::STP::Evaluation::MOVE_LIMITS = {3.0, 3.0, 1.5, 1.5};
+
+double AI::HL::STP::Evaluation::time_to_reach(
+    const ReachState &robot, Point target, const ReachLimits &limits)
+{
+    Point disp        = target - robot.position;
+    double distance   = disp.len();
+    Point major       = distance > 1e-9 ? disp / distance : Point(1.0, 0.0);
+    double major_time = axis_time(
+        distance, robot.velocity.dot(major), limits.major_acceleration,
+        limits.major_speed);
+    double minor_time = axis_time(
+        0.0, robot.velocity.dot(major.perp()), limits.minor_acceleration,
+        limits.minor_speed);
+    return std::max(major_time, minor_time);
+}
+
+void AI::HL::STP::Evaluation::time_to_reach(
+    const std::vector<ReachState> &robots, const std::vector<Point> &targets,
+    std::vector<double> &times, const ReachLimits &limits)
+{
+    times.resize(robots.size() * targets.size());
+    std::vector<double>::iterator out = times.begin();
+    for (const ReachState &robot : robots)
+    {
+        for (Point target : targets)
+        {
+            *out++ = time_to_reach(robot, target, limits);
+        }
+    }
+}
+
+double AI::HL::STP::Evaluation::min_time_to_reach(
+    const std::vector<ReachState> &robots, Point target,
+    const ReachLimits &limits)
+{
+    double best = std::numeric_limits<double>::infinity();
+    for (const ReachState &robot : robots)
+    {
+        best = std::min(best, time_to_reach(robot, target, limits));
+    }
+    return best;
+}
@@ -0,0 +1,98 @@
+#ifndef AI_HL_STP_EVALUATION_TIME_TO_REACH_H
+#define AI_HL_STP_EVALUATION_TIME_TO_REACH_H
+
+#include <vector>
+#include "geom/point.h"
+
+namespace AI
+{
+namespace HL
+{
+namespace STP
+{
+namespace Evaluation
+{
+/**
+ * \brief The state of a robot that matters to how soon it can get somewhere.
+ */
+struct ReachState final
+{
+    Point position;
+    Point velocity;
+};
+
+/**
+ * \brief How hard a robot can drive.
+ *
+ * The major axis points from the robot to its destination and the minor axis
+ * is perpendicular to it, as in the firmware’s move primitive.
+ */
+struct ReachLimits final
+{
+    double major_acceleration, major_speed;
+    double minor_acceleration, minor_speed;
+};
+
+/**
+ * \brief The limits the firmware’s move primitive drives our robots with.
+ */
+extern const ReachLimits MOVE_LIMITS;
+
+/**
+ * \brief Computes how long a robot takes to stop at a point.
+ *
+ * The time comes from the same bang-bang planner the firmware steers by,
+ * applied along the major and minor axes, so it accounts for the robot’s
+ * current velocity; the robot arrives when both axes have settled. Rotation
+ * is not considered, as the firmware turns the robot while it translates.
+ *
+ * \param[in] robot the robot
+ *
+ * \param[in] target the point to reach
+ *
+ * \param[in] limits how hard the robot can drive
+ *
+ * \return the time, in seconds
+ */
+double time_to_reach(
+    const ReachState &robot, Point target,
+    const ReachLimits &limits = MOVE_LIMITS);
+
+/**
+ * \brief Computes how long each of a set of robots takes to reach each of a
+ * set of points.
+ *
+ * \param[in] robots the robots
+ *
+ * \param[in] targets the points to reach
+ *
+ * \param[out] times the time, in seconds, for robot \c i to reach target \c j
+ * is stored at index <code>i * targets.size() + j</code>
+ *
+ * \param[in] limits how hard the robots can drive
+ */
+void time_to_reach(
+    const std::vector<ReachState> &robots, const std::vector<Point> &targets,
+    std::vector<double> &times, const ReachLimits &limits = MOVE_LIMITS);
+
+/**
+ * \brief Computes how long the quickest of a set of robots takes to reach a
+ * point.
+ *
+ * \param[in] robots the robots
+ *
+ * \param[in] target the point to reach
+ *
+ * \param[in] limits how hard the robots can drive
+ *
+ * \return the shortest time, in seconds, or infinity if there are no robots
+ */
+double min_time_to_reach(
+    const std::vector<ReachState> &robots, Point target,
+    const ReachLimits &limits = MOVE_LIMITS);
+}
+}
+}
+}
+
+#endif
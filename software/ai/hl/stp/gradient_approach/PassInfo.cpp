@@ -131,10 +131,9 @@ PassInfo::worldSnapshot PassInfo::convertToWorldSnapshot(World world){
 		}
 	}
 	
-	for(Robot robot : world.enemy_team()){
-		new_snapshot.enemy_positions.push_back(robot.position());
-		new_snapshot.enemy_velocities.push_back(robot.velocity());
-	}
+	const AI::HL::W::TeamSnapshot &enemy = world.snapshot().enemy;
+	new_snapshot.enemy_positions.assign(enemy.positions.begin(), enemy.positions.begin() + enemy.size);
+	new_snapshot.enemy_velocities.assign(enemy.velocities.begin(), enemy.velocities.begin() + enemy.size);
 
 	new_snapshot.enemy_goal_boundary = world.field().enemy_goal_boundary();
 	new_snapshot.friendly_goal_boundary = world.field().friendly_goal_boundary();
@@ -6,6 +6,7 @@
  */
 
 #include "ai/hl/stp/gradient_approach/passMainLoop.h"
+#include "ai/hl/stp/evaluation/time_to_reach.h"
 #include "ai/hl/stp/gradient_approach/PassInfo.h"
 #include "ai/hl/stp/gradient_approach/optimizepass.h"
 #include "ai/hl/util.h"
@@ -13,7 +14,9 @@
 #include "geom/angle.h"
 #include "geom/point.h"
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 
 namespace AI {
 	namespace HL {
@@ -171,6 +174,44 @@ namespace AI {
 						startingPositions.resize(quantity/2);
 					}
 
+					// A random pass that no passee can get to until well after the ball
+					// arrives will not optimize into anything useful, so draw those again
+					// rather than spending function evaluations on them.
+					const double REACH_SLACK = 1.0;
+					const unsigned int MAX_REACH_ROUNDS = 5;
+					std::vector<Evaluation::ReachState> passees(snapshot.passee_positions.size());
+					for (unsigned int i = 0; i < passees.size(); i++){
+						passees[i].position = snapshot.passee_positions.at(i);
+						passees[i].velocity = i < snapshot.passee_velocities.size() ? snapshot.passee_velocities.at(i) : Point();
+					}
+					std::vector<PassInfo::passDataStruct> candidates;
+					std::vector<Point> targets;
+					std::vector<double> reach_times;
+					for (unsigned int round = 0; !passees.empty() && round < MAX_REACH_ROUNDS && startingPositions.size() < quantity; round++){
+						candidates.clear();
+						targets.clear();
+						while(startingPositions.size() + candidates.size() < quantity){
+							double x = ((double) rand() / (RAND_MAX)) * (6.0) - 3.0 ;
+							double y = ((double) rand() / (RAND_MAX)) * (4.0) - 2.0 ;
+							double t = ((double) rand() / (RAND_MAX)) * (2.5) + 0.5 ;
+							double v = ((double) rand() / (RAND_MAX)) * (3.5) + 2.5 ;
+							candidates.push_back(PassInfo::passDataStruct(x, y, t, v, 0.5));
+							targets.push_back(Point(x, y));
+						}
+						Evaluation::time_to_reach(passees, targets, reach_times);
+						for (unsigned int j = 0; j < candidates.size(); j++){
+							double quickest = std::numeric_limits<double>::infinity();
+							for (unsigned int i = 0; i < passees.size(); i++){
+								quickest = std::min(quickest, reach_times[i * targets.size() + j]);
+							}
+							const std::vector<double> &params = candidates[j].params;
+							double arrival = params.at(2) + (targets[j] - snapshot.passer_position).len() / params.at(3);
+							if (quickest <= arrival + REACH_SLACK){
+								startingPositions.push_back(candidates[j]);
+							}
+						}
+					}
+
 					while(startingPositions.size() < quantity){
 						//TODO: use defined constants instead of magic numbers
                         double x = ((double) rand() / (RAND_MAX)) * (6.0) - 3.0 ;
@@ -1,5 +1,6 @@
 #include "ai/hl/stp/play/play.h"
 #include "util/dprint.h"
+#include "util/pooled_stack_allocator.h"
 
 using AI::HL::STP::Play::Play;
 using AI::HL::STP::Play::PlayFactory;
@@ -252,10 +253,12 @@ Play::Play(World world) : world(world)
 {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wzero-as-null-pointer-constant"  // boost pls
-    _coroutine = coroutine_t([this](caller_t& caller) {
-        caller();
-        execute(caller);
-    });
+    _coroutine = coroutine_t(
+        [this](caller_t& caller) {
+            caller();
+            execute(caller);
+        },
+        boost::coroutines::attributes(), PooledStackAllocator());
 #pragma GCC diagnostic pop
     assignment_flags[0] = AI::Flags::MoveFlags::NONE;
     for (unsigned int i = 1; i < TEAM_MAX_SIZE; i++)
@@ -1,12 +1,14 @@
 #include "ai/hl/stp/play_executor.h"
 #include <glibmm/ustring.h>
 #include <cassert>
+#include <chrono>
 #include <utility>
 #include "ai/hl/stp/stp.h"
 #include "ai/hl/stp/tactic/idle.h"
 #include "ai/hl/stp/ui.h"
 #include "ai/hl/util.h"
 #include "util/dprint.h"
+#include "util/tick_counter.h"
 #include <iostream>
 
 using AI::HL::STP::PlayExecutor;
@@ -44,6 +46,8 @@ BoolParam high_priority_always(
 IntParam playbook_index(
     u8"Current Playbook, use bitwise operations", u8"AI/HL/STP/PlayExecutor", 0,
     0, 9);
+
+TickCounter plays_created(u8"Plays created");
 }
 
 PlayExecutor::PlayExecutor(World w) : world(w), curr_play(nullptr)
@@ -68,7 +72,10 @@ PlayExecutor::~PlayExecutor()
 
 void PlayExecutor::calc_play()
 {
-    curr_play = nullptr;
+    // Time the whole switch, from tearing down the old play to constructing
+    // the new one, since both run within the tick.
+    auto start = std::chrono::steady_clock::now();
+    curr_play  = nullptr;
 
     // find a valid play
     std::random_shuffle(plays.begin(), plays.end());
@@ -95,6 +102,7 @@ void PlayExecutor::calc_play()
         {
             std::cout << "creating new play\n\n\n" << std::endl;
             curr_play = i->create(world);
+            plays_created.increment();
         }
     }
 
@@ -104,8 +112,11 @@ void PlayExecutor::calc_play()
         return;
     }
 
+    std::chrono::duration<double, std::micro> elapsed =
+        std::chrono::steady_clock::now() - start;
     LOG_INFO(Glib::ustring::compose(
-        u8"Play chosen: %1", curr_play->factory().name()));
+        u8"Play chosen: %1 (switch took %2 µs)", curr_play->factory().name(),
+        elapsed.count()));
 }
 
 void PlayExecutor::tick()
@@ -1,37 +1,78 @@
 #include "ai/hl/stp/stp.h"
+#include <algorithm>
 #include <atomic>
+#include <thread>
 #include "ai/hl/stp/evaluation/ball.h"
 #include "ai/hl/stp/evaluation/defense.h"
+#include "ai/hl/stp/evaluation/enemy.h"
 #include "ai/hl/stp/evaluation/offense.h"
 #include "ai/hl/stp/evaluation/tri_attack.h"
 #include "ai/hl/stp/gradient_approach/PassInfo.h"
 #include "ai/hl/stp/ui.h"
+#include "util/task_graph.h"
 
 using namespace AI::HL::STP;
 
+namespace
+{
+/**
+ * \brief The most evaluation phases that can run at once.
+ */
+constexpr unsigned int EVAL_WIDTH = 3;
+
+/**
+ * \brief Returns how many worker threads to run evaluations on, besides the
+ * main thread.
+ */
+unsigned int eval_threads()
+{
+    unsigned int cores = std::max(std::thread::hardware_concurrency(), 1U);
+    return std::min(cores, EVAL_WIDTH) - 1;
+}
+}
+
 namespace AI {
 	namespace HL {
 		namespace STP {
 			extern Player _goalie;
 			BoolParam use_gradient_pass(u8"Run pass calculation", u8"AI/HL/STP", true);
+			BoolParam parallel_eval(u8"Run evaluations in parallel", u8"AI/HL/STP", true);
 		}
 	}
 }
 
-void AI::HL::STP::tick_eval(World world) {
-	Evaluation::tick_ball(world);
-	Evaluation::tick_offense(world);
-	Evaluation::tick_defense(world);
-	//Evaluation::tick_tri_attack(world);
-
-	//Update version of world used in pass calculation thread
-	
-	if (use_gradient_pass && world.friendly_team().size() > 1 && world.enemy_team().size() > 0){
-		GradientApproach::PassInfo::worldSnapshot snapshot = GradientApproach::PassInfo::Instance().convertToWorldSnapshot(world);
-		GradientApproach::PassInfo::Instance().updateWorldSnapshot(snapshot);
-	}
-}
+void AI::HL::STP::tick_eval(World world)
+{
+    // Each phase reads the world and writes only its own results, so phases
+    // that do not read each other’s results run side by side. Nothing else
+    // runs on the main thread until they have all finished.
+    static TaskGraph graph(eval_threads());
+    graph.clear();
 
+    // Offense and defense read the baller and the enemies ordered by distance
+    // to the ball, which tick_ball computes.
+    TaskGraph::Task ball =
+        graph.add([world]() { Evaluation::tick_ball(world); });
+    graph.add([world]() { Evaluation::tick_offense(world); }, {ball});
+    graph.add([world]() { Evaluation::tick_defense(world); }, {ball});
+    graph.add([world]() { Evaluation::tick_enemy_threat(world); });
+    // Evaluation::tick_tri_attack(world);
+
+    // Update version of world used in pass calculation thread
+    if (use_gradient_pass && world.friendly_team().size() > 1 &&
+        world.enemy_team().size() > 0)
+    {
+        graph.add([world]() {
+            GradientApproach::PassInfo::worldSnapshot snapshot =
+                GradientApproach::PassInfo::Instance().convertToWorldSnapshot(
+                    world);
+            GradientApproach::PassInfo::Instance().updateWorldSnapshot(
+                snapshot);
+        });
+    }
+
+    graph.run(parallel_eval);
+}
 
 void AI::HL::STP::stop_threads()
 {
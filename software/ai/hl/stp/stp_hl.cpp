@@ -3,6 +3,7 @@
 #include <gtkmm/button.h>
 #include <gtkmm/textview.h>
 #include <cmath>
+#include <memory>
 #include "ai/hl/hl.h"
 #include "ai/hl/stp/evaluation/offense.h"
 #include "ai/hl/stp/play_executor.h"
@@ -15,21 +16,31 @@ using namespace AI::HL::STP;
 
 namespace
 {
-class STPHL final : public PlayExecutor, public HighLevel
+/**
+ * \brief The widgets shown in the AI window, which are only created when the
+ * window asks for them so that a headless AI never touches GTK.
+ */
+class STPHLControls final
 {
    public:
     Gtk::VBox vbox;
     Gtk::Button reset_button;
     Gtk::TextView text_view;
 
-    explicit STPHL(World world) : PlayExecutor(world)
+    explicit STPHLControls()
     {
         text_view.set_editable(false);
         vbox.add(reset_button);
         vbox.add(text_view);
         reset_button.set_label(u8"reset");
-        reset_button.signal_clicked().connect(
-            sigc::bind(&STPHL::reset, sigc::ref(*this)));
+    }
+};
+
+class STPHL final : public PlayExecutor, public HighLevel
+{
+   public:
+    explicit STPHL(World world) : PlayExecutor(world)
+    {
     }
 
     void reset()
@@ -43,19 +54,31 @@ class STPHL final : public PlayExecutor, public HighLevel
     {
         PlayExecutor::tick();
         const Glib::ustring &i = info();
-        text_view.get_buffer()->set_text(i);
+        if (controls)
+        {
+            controls->text_view.get_buffer()->set_text(i);
+        }
         ai_notes = i;
     }
 
     Gtk::Widget *ui_controls() override
     {
-        return &vbox;
+        if (!controls)
+        {
+            controls.reset(new STPHLControls);
+            controls->reset_button.signal_clicked().connect(
+                sigc::bind(&STPHL::reset, sigc::ref(*this)));
+        }
+        return &controls->vbox;
     }
 
     void draw_overlay(Cairo::RefPtr<Cairo::Context> ctx) override
     {
         PlayExecutor::draw_overlay(ctx);
     }
+
+   private:
+    std::unique_ptr<STPHLControls> controls;
 };
 }
 
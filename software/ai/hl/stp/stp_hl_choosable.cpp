@@ -6,6 +6,7 @@
 #include <cassert>
 #include <chrono>
 #include <iostream>
+#include <memory>
 #include "ai/hl/hl.h"
 #include "ai/hl/stp/evaluation/defense.h"
 #include "ai/hl/stp/evaluation/offense.h"
@@ -25,7 +26,11 @@ const Glib::ustring CHOOSE_PLAY_TEXT = u8"<Choose Play>";
 // BoolParam use_gradient_pass(u8"Run pass calculation on seperate thread",
 // u8"AI/HL/STP/PlayExecutor", true);
 
-class STPHLChoosable final : public PlayExecutor, public HighLevel
+/**
+ * \brief The widgets shown in the AI window, which are only created when the
+ * window asks for them so that a headless AI never touches GTK.
+ */
+class STPHLChoosableControls final
 {
    public:
     Gtk::VBox vbox;
@@ -34,7 +39,7 @@ class STPHLChoosable final : public PlayExecutor, public HighLevel
     Gtk::TextView text_status;
     Gtk::ComboBoxText combo;
 
-    explicit STPHLChoosable(World world) : PlayExecutor(world)
+    explicit STPHLChoosableControls(const Glib::ustring &selected_play)
     {
         combo.append(CHOOSE_PLAY_TEXT);
         for (const auto &i : Play::PlayFactory::all())
@@ -42,7 +47,7 @@ class STPHLChoosable final : public PlayExecutor, public HighLevel
             combo.append(i.second->name());
         }
 
-        combo.set_active_text(CHOOSE_PLAY_TEXT);
+        combo.set_active_text(selected_play);
         vbox.add(combo);
         vbox.add(start_button);
         vbox.add(stop_button);
@@ -50,11 +55,15 @@ class STPHLChoosable final : public PlayExecutor, public HighLevel
         text_status.set_editable(false);
         start_button.set_label(u8"start");
         stop_button.set_label(u8"stop");
+    }
+};
 
-        start_button.signal_clicked().connect(
-            sigc::bind(&STPHLChoosable::start, sigc::ref(*this)));
-        stop_button.signal_clicked().connect(
-            sigc::bind(&STPHLChoosable::stop, sigc::ref(*this)));
+class STPHLChoosable final : public PlayExecutor, public HighLevel
+{
+   public:
+    explicit STPHLChoosable(World world)
+        : PlayExecutor(world), selected_play(CHOOSE_PLAY_TEXT)
+    {
     }
 
     HighLevelFactory &factory() const;
@@ -69,7 +78,7 @@ class STPHLChoosable final : public PlayExecutor, public HighLevel
             return;
         }
         // check what play is in use
-        if (combo.get_active_text() == CHOOSE_PLAY_TEXT)
+        if (selected_play == CHOOSE_PLAY_TEXT)
         {
             curr_play = nullptr;
             return;
@@ -89,7 +98,7 @@ class STPHLChoosable final : public PlayExecutor, public HighLevel
         curr_play = nullptr;
         for (const auto &i : plays)
         {
-            if (i->name() == combo.get_active_text())
+            if (i->name() == selected_play)
             {
                 curr_play = i->create(world);
             }
@@ -118,14 +127,13 @@ class STPHLChoosable final : public PlayExecutor, public HighLevel
         }
 
         // check what play is in use
-        if (combo.get_active_text() == CHOOSE_PLAY_TEXT)
+        if (selected_play == CHOOSE_PLAY_TEXT)
         {
             curr_play = nullptr;
         }
 
         if (curr_play &&
-            combo.get_active_text() !=
-                Glib::ustring(curr_play->factory().name()))
+            selected_play != Glib::ustring(curr_play->factory().name()))
         {
             curr_play = nullptr;
         }
@@ -158,12 +166,25 @@ class STPHLChoosable final : public PlayExecutor, public HighLevel
             text += info();
         }
 
-        text_status.get_buffer()->set_text(text);
+        if (controls)
+        {
+            controls->text_status.get_buffer()->set_text(text);
+        }
     }
 
     Gtk::Widget *ui_controls() override
     {
-        return &vbox;
+        if (!controls)
+        {
+            controls.reset(new STPHLChoosableControls(selected_play));
+            controls->combo.signal_changed().connect(
+                sigc::mem_fun(this, &STPHLChoosable::on_combo_changed));
+            controls->start_button.signal_clicked().connect(
+                sigc::bind(&STPHLChoosable::start, sigc::ref(*this)));
+            controls->stop_button.signal_clicked().connect(
+                sigc::bind(&STPHLChoosable::stop, sigc::ref(*this)));
+        }
+        return &controls->vbox;
     }
 
     void draw_overlay(Cairo::RefPtr<Cairo::Context> ctx) override
@@ -181,6 +202,15 @@ class STPHLChoosable final : public PlayExecutor, public HighLevel
             return;
         curr_play->draw_overlay(ctx);
     }
+
+   private:
+    Glib::ustring selected_play;
+    std::unique_ptr<STPHLChoosableControls> controls;
+
+    void on_combo_changed()
+    {
+        selected_play = controls->combo.get_active_text();
+    }
 };
 }
 
@@ -3,6 +3,7 @@
 #include "ai/hl/stp/action/action.h"
 #include "util/dprint.h"
 #include "util/param.h"
+#include "util/pooled_stack_allocator.h"
 
 #include <iostream>
 
@@ -49,10 +50,12 @@ Tactic::Tactic(World world) : world(world)
 {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wzero-as-null-pointer-constant"  // boost pls
-    coroutine_ = coroutine_t([this](caller_t& caller) {
-        caller();
-        execute(caller);
-    });
+    coroutine_ = coroutine_t(
+        [this](caller_t& caller) {
+            caller();
+            execute(caller);
+        },
+        boost::coroutines::attributes(), PooledStackAllocator());
 #pragma GCC diagnostic pop
 }
 
@@ -62,10 +65,12 @@ void Tactic::player_changed()
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wzero-as-null-pointer-constant"  // boost pls
-    coroutine_ = coroutine_t([this](caller_t& caller) {
-        caller();
-        execute(caller);
-    });
+    coroutine_ = coroutine_t(
+        [this](caller_t& caller) {
+            caller();
+            execute(caller);
+        },
+        boost::coroutines::attributes(), PooledStackAllocator());
 #pragma GCC diagnostic pop
 }
 
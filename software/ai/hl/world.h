@@ -23,6 +23,22 @@ typedef AI::Common::Field Field;
  */
 typedef AI::Common::Ball Ball;
 
+/**
+ * \brief The state of the ball and robots at the start of the tick
+ */
+typedef AI::Common::WorldSnapshot WorldSnapshot;
+
+/**
+ * \brief The state of one team at the start of the tick
+ */
+typedef AI::Common::TeamSnapshot TeamSnapshot;
+
+/**
+ * \brief The distance from each point on the field to the nearest robot of a
+ * team at the start of the tick
+ */
+typedef AI::Common::ClearanceField ClearanceField;
+
 /**
  * \brief A robot
  */
@@ -238,6 +254,13 @@ class World final
      */
     const Field &field() const;
 
+    /**
+     * \brief Returns the signal fired when the field geometry changes
+     *
+     * \return the field change signal
+     */
+    sigc::signal<void> &signal_field_changed() const;
+
     /**
      * \brief Returns the ball
      *
@@ -259,6 +282,32 @@ class World final
      */
     EnemyTeam enemy_team() const;
 
+    /**
+     * \brief Returns the state of the ball and robots at the start of the tick
+     *
+     * The robots in each team of the snapshot are in the same order as in \ref
+     * friendly_team and \ref enemy_team.
+     *
+     * \return the snapshot
+     */
+    const WorldSnapshot &snapshot() const;
+
+    /**
+     * \brief Returns the distance from each point on the field to the nearest
+     * friendly robot at the start of the tick
+     *
+     * \return the friendly clearance field
+     */
+    const ClearanceField &friendly_clearance() const;
+
+    /**
+     * \brief Returns the distance from each point on the field to the nearest
+     * enemy robot at the start of the tick
+     *
+     * \return the enemy clearance field
+     */
+    const ClearanceField &enemy_clearance() const;
+
     /**
      * \brief Returns the current play type
      *
@@ -430,6 +479,11 @@ inline const AI::HL::W::Field &AI::HL::W::World::field() const
     return impl.field();
 }
 
+inline sigc::signal<void> &AI::HL::W::World::signal_field_changed() const
+{
+    return impl.field().signal_changed;
+}
+
 inline AI::HL::W::Ball AI::HL::W::World::ball() const
 {
     return AI::Common::Ball(impl.ball());
@@ -445,6 +499,23 @@ inline AI::HL::W::EnemyTeam AI::HL::W::World::enemy_team() const
     return EnemyTeam(impl.enemy_team());
 }
 
+inline const AI::HL::W::WorldSnapshot &AI::HL::W::World::snapshot() const
+{
+    return impl.snapshot();
+}
+
+inline const AI::HL::W::ClearanceField &AI::HL::W::World::friendly_clearance()
+    const
+{
+    return impl.friendly_clearance();
+}
+
+inline const AI::HL::W::ClearanceField &AI::HL::W::World::enemy_clearance()
+    const
+{
+    return impl.enemy_clearance();
+}
+
 inline AI::Timestamp AI::HL::W::World::monotonic_time() const
 {
     return impl.monotonic_time();
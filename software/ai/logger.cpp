@@ -23,6 +23,7 @@
 #include "util/dprint.h"
 #include "util/exception.h"
 #include "util/param.h"
+#include "util/tick_counter.h"
 #include "util/timestep.h"
 
 namespace
@@ -67,6 +68,22 @@ uint32_t encode_micros_unsigned(double in)
     return static_cast<uint32_t>(encode_micros(in));
 }
 
+/**
+ * \brief Returns the tag of a protobuf varint field.
+ */
+uint32_t varint_tag(int field)
+{
+    return static_cast<uint32_t>(field) << 3;
+}
+
+/**
+ * \brief Returns the tag of a protobuf length-delimited field.
+ */
+uint32_t length_delimited_tag(int field)
+{
+    return (static_cast<uint32_t>(field) << 3) | 2;
+}
+
 void timestamp_to_log(
     const AI::Timestamp &src, const AI::Timestamp &ref,
     Log::MonotonicTimeSpec &dest)
@@ -271,13 +288,49 @@ void AI::Logger::log_mrf_message_in(
     unsigned int index, const void *data, std::size_t length, unsigned int lqi,
     unsigned int rssi)
 {
-    Log::Record record;
-    Log::MRF::InMessage *msg = record.mutable_mrf()->mutable_in_message();
-    msg->set_index(index);
-    msg->set_data(data, length);
-    msg->set_lqi(lqi);
-    msg->set_rssi(rssi);
-    write_record(record);
+    // Every robot sends several of these a second, so rather than copying the
+    // payload into a Log::Record, write the record’s encoding straight from
+    // the transfer buffer. The bytes are the same as write_record would
+    // produce for a Log::Record with Index, Data, LQI, RSSI and Type set.
+    using google::protobuf::io::CodedOutputStream;
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    uint32_t data_size   = static_cast<uint32_t>(length);
+    uint32_t in_size     = 1 + CodedOutputStream::VarintSize32(index) + 1 +
+                       CodedOutputStream::VarintSize32(data_size) + data_size +
+                       1 + CodedOutputStream::VarintSize32(lqi) + 1 +
+                       CodedOutputStream::VarintSize32(rssi);
+    if (length)
+    {
+        in_size += 1 + CodedOutputStream::VarintSize32(bytes[0]);
+    }
+    uint32_t mrf_size = 1 + CodedOutputStream::VarintSize32(in_size) + in_size;
+    uint32_t record_size =
+        1 + CodedOutputStream::VarintSize32(mrf_size) + mrf_size;
+
+    CodedOutputStream cos(&fos);
+    cos.WriteVarint32(record_size);
+    cos.WriteTag(length_delimited_tag(Log::Record::kMrfFieldNumber));
+    cos.WriteVarint32(mrf_size);
+    cos.WriteTag(length_delimited_tag(Log::MRF::kInMessageFieldNumber));
+    cos.WriteVarint32(in_size);
+    cos.WriteTag(varint_tag(Log::MRF::InMessage::kIndexFieldNumber));
+    cos.WriteVarint32(index);
+    cos.WriteTag(length_delimited_tag(Log::MRF::InMessage::kDataFieldNumber));
+    cos.WriteVarint32(data_size);
+    cos.WriteRaw(data, static_cast<int>(data_size));
+    cos.WriteTag(varint_tag(Log::MRF::InMessage::kLQIFieldNumber));
+    cos.WriteVarint32(lqi);
+    cos.WriteTag(varint_tag(Log::MRF::InMessage::kRSSIFieldNumber));
+    cos.WriteVarint32(rssi);
+    if (length)
+    {
+        cos.WriteTag(varint_tag(Log::MRF::InMessage::kTypeFieldNumber));
+        cos.WriteVarint32(bytes[0]);
+    }
+    if (cos.HadError())
+    {
+        throw std::runtime_error("Failed to serialize log record.");
+    }
 }
 
 void AI::Logger::log_mrf_mdr(unsigned int id, unsigned int code)
@@ -580,6 +633,13 @@ void AI::Logger::on_tick(AI::Timediff compute_time)
                 r->velocity(), r->avelocity(), *robot.mutable_velocity());
         }
 
+        for (const TickCounter *i : TickCounter::all())
+        {
+            Log::Tick::Counter &counter = *tick.add_counters();
+            counter.set_name(i->name());
+            counter.set_count(i->count());
+        }
+
         write_record(record);
     }
 
@@ -1,5 +1,6 @@
 #include "main.h"
 #include <glibmm/exception.h>
+#include <glibmm/init.h>
 #include <gtkmm/comboboxtext.h>
 #include <gtkmm/dialog.h>
 #include <gtkmm/label.h>
@@ -12,10 +13,12 @@
 #include <algorithm>
 #include <cerrno>
 #include <cstdint>
+#include <cstring>
 #include <exception>
 #include <functional>
 #include <iostream>
 #include <locale>
+#include <memory>
 #include <stdexcept>
 #include <vector>
 #include "ai/ai.h"
@@ -160,9 +163,39 @@ int app_main(int argc, char **argv)
     bool minimize = false;
     option_group.add_entry(minimize_entry, minimize);
 
+    Glib::OptionEntry headless_entry;
+    headless_entry.set_long_name(u8"headless");
+    headless_entry.set_description(
+        u8"Runs without a user interface or display connection (requires "
+        u8"--backend)");
+    bool headless = false;
+    option_group.add_entry(headless_entry, headless);
+
     option_context.set_main_group(option_group);
 
-    Gtk::Main app(argc, argv, option_context);
+    // Whether GTK is initialized at all depends on --headless, so look for it
+    // before parsing. Windowed, GTK parses the command line as always, with
+    // its own option group added to ours.
+    for (int i = 1; i < argc && std::strcmp(argv[i], "--"); ++i)
+    {
+        if (!std::strcmp(argv[i], "--headless"))
+        {
+            headless = true;
+        }
+    }
+    std::unique_ptr<Gtk::Main> app;
+    if (headless)
+    {
+        Glib::init();
+        option_context.parse(argc, argv);
+        // Parameters are still backed by Gtk::Adjustment objects, which need
+        // the gtkmm wrappers but not a display.
+        Gtk::Main::init_gtkmm_internals();
+    }
+    else
+    {
+        app.reset(new Gtk::Main(argc, argv, option_context));
+    }
 
     if (list)
     {
@@ -254,6 +287,12 @@ int app_main(int argc, char **argv)
     setup.save();
     if (!backend_name.size())
     {
+        if (headless)
+        {
+            std::cerr << "A backend must be given with --backend when running "
+                         "headless.\n";
+            return 1;
+        }
         backend_name = choose_backend();
         if (!backend_name.size())
         {
@@ -309,17 +348,26 @@ int app_main(int argc, char **argv)
     AI::Logger logger(ai);
     backend.log_to(logger);
 
-    // Run the AI.
+    // Run the AI. Headless, the backend’s clock drives the ticks on the bare
+    // main loop until the process is signalled; the logger finishes the log on
+    // the way out.
     try
     {
-        AI::Window win(ai);
-
-        if (minimize)
+        if (headless)
         {
-            win.iconify();
+            MainLoop::run();
         }
+        else
+        {
+            AI::Window win(ai);
 
-        MainLoop::run(win);
+            if (minimize)
+            {
+                win.iconify();
+            }
+
+            MainLoop::run(win);
+        }
     }
     catch (const Glib::Exception &exp)
     {
@@ -22,7 +22,6 @@ namespace TestNavigator
 
 MPTest::MPTest(AI::Nav::W::World world) : Navigator(world)
 {
-    build_gui();
 }
 
 /**
@@ -30,6 +29,8 @@ MPTest::MPTest(AI::Nav::W::World world) : Navigator(world)
 */
 void MPTest::build_gui()
 {
+    controls.reset(new Controls);
+    current_test                 = std::make_shared<PrimTest>(world);
     primitives[CHOOSE_PLAY_TEXT] = std::make_shared<PrimTest>(world);
 
     // ADD NEW PRIMTESTS HERE
@@ -42,19 +43,19 @@ void MPTest::build_gui()
 
     for (auto const &i : primitives)
     {
-        combo.append(Glib::ustring(i.first));
+        controls->combo.append(Glib::ustring(i.first));
     }
 
-    combo.set_active_text(CHOOSE_PLAY_TEXT);
-    vbox.add(combo);
+    controls->combo.set_active_text(CHOOSE_PLAY_TEXT);
+    controls->vbox.add(controls->combo);
 
-    vbox.add(test_combo);
+    controls->vbox.add(controls->test_combo);
 
-    combo.signal_changed().connect(
+    controls->combo.signal_changed().connect(
         sigc::mem_fun(this, &MPTest::on_combo_changed));
-    test_combo.signal_changed().connect(
+    controls->test_combo.signal_changed().connect(
         sigc::mem_fun(this, &MPTest::on_test_combo_changed));
-    vbox.add(current_test->get_widget());
+    controls->vbox.add(current_test->get_widget());
 }
 
 /**
@@ -63,7 +64,7 @@ void MPTest::build_gui()
 */
 void MPTest::tick()
 {
-    if (world.friendly_team().size() > 0)
+    if (current_test && world.friendly_team().size() > 0)
     {
         current_test->player = world.friendly_team()[0];
         if (current_test->looping_test_fun)
@@ -75,29 +76,33 @@ void MPTest::tick()
 
 Gtk::Widget *MPTest::ui_controls()
 {
-    return &vbox;
+    if (!controls)
+    {
+        build_gui();
+    }
+    return &controls->vbox;
 }
 
 void MPTest::on_combo_changed()
 {
-    vbox.remove(current_test->get_widget());
+    controls->vbox.remove(current_test->get_widget());
 
-    current_test = primitives[combo.get_active_text()];
+    current_test = primitives[controls->combo.get_active_text()];
 
-    test_combo.remove_all();
+    controls->test_combo.remove_all();
     for (auto const &i : current_test->tests)
     {
-        test_combo.append(Glib::ustring(i.first));
+        controls->test_combo.append(Glib::ustring(i.first));
     }
-    test_combo.set_active_text(CHOOSE_TEST_TEXT);
+    controls->test_combo.set_active_text(CHOOSE_TEST_TEXT);
 
-    vbox.add(current_test->get_widget());
+    controls->vbox.add(current_test->get_widget());
     current_test->looping_test_fun = false;
 }
 
 void MPTest::on_test_combo_changed()
 {
-    if (current_test->tests.find(test_combo.get_active_text()) ==
+    if (current_test->tests.find(controls->test_combo.get_active_text()) ==
         current_test->tests.end())
     {
         current_test->current_test_fun = current_test->tests[CHOOSE_TEST_TEXT];
@@ -105,7 +110,7 @@ void MPTest::on_test_combo_changed()
     else
     {
         current_test->current_test_fun =
-            current_test->tests[test_combo.get_active_text()];
+            current_test->tests[controls->test_combo.get_active_text()];
     }
     current_test->looping_test_fun = false;
 }
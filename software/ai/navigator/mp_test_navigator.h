@@ -237,15 +237,23 @@ class MPTest final : public Navigator
     const Glib::ustring CHOOSE_PLAY_TEXT = u8"<Choose Play>";
     void build_gui();
 
-    // The current active movement primitive test set
-    std::shared_ptr<PrimTest> current_test = std::make_shared<PrimTest>(world);
+    // The widgets, which are only created when the AI window asks for them
+    // so that a headless AI never touches GTK
+    struct Controls final
+    {
+        Gtk::VBox vbox;
+        Gtk::ComboBoxText combo;
+        Gtk::ComboBoxText test_combo;
+    };
+
+    // The current active movement primitive test set, or null until the UI
+    // is built, since every test owns widgets of its own
+    std::shared_ptr<PrimTest> current_test;
 
     // A map of displayed names to primitive test sets
     std::map<std::string, std::shared_ptr<PrimTest>> primitives;
 
-    Gtk::VBox vbox;
-    Gtk::ComboBoxText combo;
-    Gtk::ComboBoxText test_combo;
+    std::unique_ptr<Controls> controls;
 };
 }
 }
@@ -72,6 +72,9 @@ class Navigator : public NonCopyable
      * or a null pointer if no GUI widgets are needed for this Navigator.
      *
      * \note The default implementation returns a null pointer.
+     *
+     * \note This is not called when the AI runs headless, so widgets should be
+     * created here on first call rather than in the constructor.
      */
     virtual Gtk::Widget *ui_controls();
 
@@ -30,6 +30,16 @@ DoubleParam angle_increment(
 DoubleParam linear_increment(
     u8"linear increment (m)", u8"AI/Nav/RRT", 0.05, 0.001, 1);
 
+DoubleParam replan_goal_distance(
+    u8"Distance the goal may move before the path is replanned (m)",
+    u8"AI/Nav/RRT", 0.1, 0, 1);
+
+BoolParam use_spline_planner(
+    u8"Try a spline before falling back to RRT", u8"AI/Nav/RRT", true);
+
+BoolParam check_in_time(
+    u8"Check paths against predicted robot motion", u8"AI/Nav/RRT", false);
+
 DoubleParam default_desired_rpm(
     u8"The default desired rpm for dribbling", u8"AI/Movement/Primitives", 7000,
     0, 100000);
@@ -44,6 +54,8 @@ class RRTNavigator final : public Navigator
 
    private:
     void plan(Player player);
+    std::vector<Point> follow_path(Player player, Point goal);
+    bool clear_path(Player player, Point cur, Point dst, double start);
 
     enum ShootActionType
     {
@@ -137,23 +149,12 @@ void RRTNavigator::plan(Player player)
             // get there, do an RRT plan and MOVE to the next path
             // point instead.
 
-
-            if (!valid_path(player.position(), hl_request.field_point(), world, player) &&
+            if (!clear_path(
+                    player, player.position(), hl_request.field_point(), 0.0) &&
                 !player.top_prim()->overrideNavigator)
             {
 #warning Do we need flags here, e.g. to let the goalie into the defense area?
-				
-				// Try Spline planner
-                /*plan = spline_planner.plan(
-                    player, hl_request.field_point(),
-                    AI::Flags::MoveFlags::NONE);
-				*/	
-                //if (plan.empty()){
-					// Spline Planner didn't work, try RRT
-                	plan = rrt_planner.plan(
-						player, hl_request.field_point(),
-						AI::Flags::MoveFlags::NONE);
-				//}
+                plan = follow_path(player, hl_request.field_point());
 
                 if (!plan.empty())
                 {
@@ -171,7 +172,10 @@ void RRTNavigator::plan(Player player)
 
                 player.display_path(plan);
             }
-            else{
+            else if (player.waypoints)
+            {
+                // The way is clear, so the old path is no longer needed.
+                player.waypoints->path.clear();
             }
             break;
 
@@ -287,6 +291,110 @@ void RRTNavigator::plan(Player player)
     // TODO test if primitive is done
 }
 
+std::vector<Point> RRTNavigator::follow_path(Player player, Point goal)
+{
+    if (!player.waypoints)
+    {
+        player.waypoints = std::make_shared<Waypoints>();
+    }
+    Waypoints &waypoints     = *player.waypoints;
+    std::vector<Point> &path = waypoints.path;
+
+    // Keep last tick’s path if it still leads to about the same place, so the
+    // robot does not swerve onto a different random path every tick.
+    bool reuse = !path.empty() &&
+                 (goal - waypoints.path_goal).len() <= replan_goal_distance;
+    if (reuse)
+    {
+        path.back()         = goal;
+        waypoints.path_goal = goal;
+
+        // Drop the points the robot has passed or can skip, by heading for
+        // the furthest point it can already see.
+        std::size_t first = path.size();
+        for (std::size_t i = path.size(); i-- > 0;)
+        {
+            if (clear_path(player, player.position(), path[i], 0.0))
+            {
+                first = i;
+                break;
+            }
+        }
+        bool visible = first != path.size();
+        path.erase(path.begin(), path.begin() + (visible ? first : 0));
+
+        // Check the rest of the path against where the obstacles are now, or
+        // will be when the robot gets there, and replan around any segment
+        // they block. start is when the robot sets off along segment i.
+        double start =
+            visible
+                ? (path[0] - player.position()).len() / PLAYER_AVERAGE_VELOCITY
+                : 0.0;
+        for (std::size_t i = visible ? 1 : 0; reuse && i < path.size(); ++i)
+        {
+            Point from = i ? path[i - 1] : player.position();
+            if (!clear_path(player, from, path[i], start))
+            {
+                std::vector<Point> detour = rrt_planner.plan_from(
+                    player, from, path[i], AI::Flags::MoveFlags::NONE);
+                reuse = !detour.empty() && detour.back() == path[i];
+                if (reuse)
+                {
+                    path.erase(path.begin() + static_cast<std::ptrdiff_t>(i));
+                    path.insert(
+                        path.begin() + static_cast<std::ptrdiff_t>(i),
+                        detour.begin(), detour.end());
+                    for (std::size_t j = 1; j != detour.size(); ++j, ++i)
+                    {
+                        start +=
+                            (path[i] - from).len() / PLAYER_AVERAGE_VELOCITY;
+                        from = path[i];
+                    }
+                }
+            }
+            start += (path[i] - from).len() / PLAYER_AVERAGE_VELOCITY;
+        }
+        if (reuse)
+        {
+            return path;
+        }
+    }
+
+    // A smooth curve is cheaper and nicer to drive than an RRT path, so try
+    // one first.
+    std::vector<Point> fresh;
+    if (use_spline_planner)
+    {
+        fresh = spline_planner.plan(player, goal, AI::Flags::MoveFlags::NONE);
+    }
+    if (fresh.empty())
+    {
+        fresh = rrt_planner.plan(player, goal, AI::Flags::MoveFlags::NONE);
+    }
+
+    // Only a path that reaches the goal is worth keeping; a partial one is
+    // replanned next tick.
+    if (!fresh.empty() && fresh.back() == goal)
+    {
+        path                = fresh;
+        waypoints.path_goal = goal;
+    }
+    else
+    {
+        path.clear();
+    }
+    return fresh;
+}
+
+bool RRTNavigator::clear_path(Player player, Point cur, Point dst, double start)
+{
+    if (check_in_time)
+    {
+        return valid_path_in_time(cur, dst, start, world, player);
+    }
+    return valid_path(cur, dst, world, player);
+}
+
 void RRTNavigator::tick()
 {
     for (Player player : world.friendly_team())
@@ -132,11 +132,22 @@ std::vector<Point> RRTPlanner::plan(
     return rrt_plan(player, goal, POST_PROCESS, added_flags);
 }
 
+std::vector<Point> RRTPlanner::plan_from(
+    Player player, Point start, Point goal, MoveFlags added_flags)
+{
+    return rrt_plan(player, start, goal, POST_PROCESS, added_flags);
+}
+
 std::vector<Point> RRTPlanner::rrt_plan(
     Player player, Point goal, bool post_process, MoveFlags added_flags)
 {
-    Point initial = player.position();
+    return rrt_plan(player, player.position(), goal, post_process, added_flags);
+}
 
+std::vector<Point> RRTPlanner::rrt_plan(
+    Player player, Point initial, Point goal, bool post_process,
+    MoveFlags added_flags)
+{
     if (!player.waypoints)
     {
         player.waypoints = std::make_shared<Waypoints>();
@@ -235,11 +246,11 @@ std::vector<Point> RRTPlanner::rrt_plan(
         }
     }
 
-    // just use the current player position as the destination if we are within
+    // just use the starting position as the destination if we are within
     // the threshold already
     if (final_points.empty())
     {
-        final_points.push_back(player.position());
+        final_points.push_back(initial);
     }
     else if (valid_path(
                  final_points[final_points.size() - 1], goal, world, player))
@@ -29,6 +29,14 @@ class RRTPlanner : public Plan
         AI::Nav::W::Player player, Point goal,
         AI::Flags::MoveFlags added_flags = AI::Flags::MoveFlags::NONE);
 
+    /**
+     * Generates a path for a player that starts somewhere other than where the
+     * player is, such as partway along a path it is already following
+     */
+    std::vector<Point> plan_from(
+        AI::Nav::W::Player player, Point start, Point goal,
+        AI::Flags::MoveFlags added_flags = AI::Flags::MoveFlags::NONE);
+
     static constexpr Point empty_state();
 
    protected:
@@ -60,6 +68,10 @@ class RRTPlanner : public Plan
     std::vector<Point> rrt_plan(
         AI::Nav::W::Player player, Point goal, bool post_process = true,
         AI::Flags::MoveFlags added_flags = AI::Flags::MoveFlags::NONE);
+
+    std::vector<Point> rrt_plan(
+        AI::Nav::W::Player player, Point initial, Point goal, bool post_process,
+        AI::Flags::MoveFlags added_flags);
 };
 }
 }
@@ -1,6 +1,7 @@
 #include "ai/navigator/spline_planner.h"
-#include <memory>
-#include "ai/navigator/util.h"
+#include <algorithm>
+#include <array>
+#include <limits>
 #include "geom/angle.h"
 #include "util/dprint.h"
 #include "util/param.h"
@@ -10,66 +11,135 @@ using namespace AI::Nav::W;
 using namespace AI::Nav::Util;
 using namespace AI::Flags;
 
-const unsigned NUM_PATHPOINTS = 7;
-    
-namespace {
-    inline double splineWt(int ptNum, double t){
-        switch(ptNum){
-            case 0:
-                return (1-t)*(1-t)*(1-t);
-            case 1:
-                return 3*t*(1-t)*(1-t);
-            case 2:
-                return 3*t*t*(1-t);
-            case 3:
-                return t*t*t;
-            default:
-                return 0.0;
-        }
-    }
-    std::vector<Point> getBezierPath(std::vector<Point> ctrlPts){
-        std::vector<Point> path;
-        for(unsigned i=1;i<=NUM_PATHPOINTS;i++){
-                double t = (double)i/(NUM_PATHPOINTS);
-                path.push_back(splineWt(0,t)*ctrlPts.at(0) + splineWt(1,t)*ctrlPts.at(1) +splineWt(2,t)*ctrlPts.at(2) + splineWt(3,t)*ctrlPts.at(3));
-        }
-        return path;
+namespace
+{
+const unsigned int NUM_PATHPOINTS = 7;
+
+// Candidates bend the curve out to either side of the straight line by
+// multiples of OFFSET_STEP, up to NUM_OFFSETS steps each way.
+const double OFFSET_STEP          = 0.1;
+const unsigned int NUM_OFFSETS    = 15;
+const unsigned int NUM_CANDIDATES = 2 * NUM_OFFSETS + 1;
+
+DoubleParam clearance_weight(
+    u8"Path length given up per metre of enemy clearance", u8"AI/Nav/Spline",
+    1.0, 0.0, 10.0);
+DoubleParam clearance_cap(
+    u8"Enemy clearance beyond which a path is no better (m)", u8"AI/Nav/Spline",
+    0.3, 0.0, 2.0);
+
+inline double splineWt(int ptNum, double t)
+{
+    switch (ptNum)
+    {
+        case 0:
+            return (1 - t) * (1 - t) * (1 - t);
+        case 1:
+            return 3 * t * (1 - t) * (1 - t);
+        case 2:
+            return 3 * t * t * (1 - t);
+        case 3:
+            return t * t * t;
+        default:
+            return 0.0;
     }
 }
 
+// The first two control points are both the robot’s position, so each path
+// point is a blend of the start, the bending control point and the goal.
+typedef std::array<std::array<double, 3>, NUM_PATHPOINTS> BezierWeights;
 
+BezierWeights make_weights()
+{
+    BezierWeights weights;
+    for (unsigned int i = 0; i != NUM_PATHPOINTS; ++i)
+    {
+        double t      = static_cast<double>(i + 1) / NUM_PATHPOINTS;
+        weights[i][0] = splineWt(0, t) + splineWt(1, t);
+        weights[i][1] = splineWt(2, t);
+        weights[i][2] = splineWt(3, t);
+    }
+    return weights;
+}
 
-std::vector<Point> SplinePlanner::plan(Player player, Point goal, MoveFlags added_flags)
+const BezierWeights WEIGHTS = make_weights();
+}
+
+std::vector<Point> SplinePlanner::plan(
+    Player player, Point goal, MoveFlags added_flags)
 {
-    Point initial = player.position();// + player.velocity()*player.velocity().len()/(2.0*3.0);
-    Point mid = (initial + goal)/2;
-    double interDist = 0.1;
-    double maxDist = 1.5;
-    std::vector<Point> ctrlPts = {player.position(), initial, mid, goal};
+    if (enemies_time != world.monotonic_time())
+    {
+        enemies      = EnemyObstacles(world);
+        enemies_time = world.monotonic_time();
+    }
 
-    std::vector<Point> path = getBezierPath(ctrlPts);
-    if(valid_path(path,world,player,added_flags)){
-        return ctrlPts;
+    Point initial = player.position();
+    Point mid     = (initial + goal) / 2;
+    Point normal  = (goal - initial).rotate(Angle::quarter()).norm();
+
+    // Lay out every candidate: the straight line first, then bending further
+    // out, alternating sides.
+    curves.clear();
+    for (unsigned int c = 0; c != NUM_CANDIDATES; ++c)
+    {
+        double offset = OFFSET_STEP * ((c + 1) / 2) * ((c & 1) ? 1.0 : -1.0);
+        Point control = mid + normal * offset;
+        for (const std::array<double, 3> &w : WEIGHTS)
+        {
+            curves.push_back(w[0] * initial + w[1] * control + w[2] * goal);
+        }
     }
 
-    Point normal = (goal - initial).rotate(Angle::quarter()).norm();
-    for(double r=0.0;r<=maxDist;r+=interDist){
-        ctrlPts.at(2) = mid + normal*r;
-        path = getBezierPath(ctrlPts);
-        if(valid_path(path,world,player,added_flags)){
-            return path;
+    // Enemies are what usually block a path, so drop a candidate at its first
+    // segment that runs further into an enemy than its start already is, as
+    // valid_path would, and score the rest on length and enemy clearance.
+    ranked.clear();
+    for (std::size_t c = 0; c != NUM_CANDIDATES; ++c)
+    {
+        const Point *curve = &curves[c * NUM_PATHPOINTS];
+        Point from         = initial;
+        double length      = 0.0;
+        double clearance   = std::numeric_limits<double>::infinity();
+        bool ok            = true;
+        for (unsigned int i = 0; ok && i != NUM_PATHPOINTS; ++i)
+        {
+            double start_trespass = enemies.trespass(from, from);
+            double seg_clearance  = enemies.clearance(from, curve[i]);
+            ok                    = -seg_clearance < start_trespass + Geom::EPS;
+            clearance             = std::min(clearance, seg_clearance);
+            length += (curve[i] - from).len();
+            from = curve[i];
+        }
+        if (ok)
+        {
+            double cost =
+                length - clearance_weight * std::min(clearance, clearance_cap);
+            ranked.emplace_back(cost, c);
         }
-        ctrlPts.at(2) = mid - normal*r;
-        path = getBezierPath(ctrlPts);
-        if(valid_path(path,world,player,added_flags)){
+    }
+    std::stable_sort(
+        ranked.begin(), ranked.end(),
+        [](const std::pair<double, std::size_t> &a,
+           const std::pair<double, std::size_t> &b) {
+            return a.first < b.first;
+        });
+
+    // Only the survivors get the full check against every rule, best first.
+    for (const std::pair<double, std::size_t> &i : ranked)
+    {
+        auto begin = curves.begin() +
+                     static_cast<std::ptrdiff_t>(i.second * NUM_PATHPOINTS);
+        std::vector<Point> path(begin, begin + NUM_PATHPOINTS);
+        if (valid_path(initial, path[0], world, player, added_flags) &&
+            valid_path(path, world, player, added_flags))
+        {
             return path;
         }
     }
-    path.clear(); // fail- return empty vector
-    return path;
+    return std::vector<Point>();  // fail- return empty vector
 }
 
-
-SplinePlanner::SplinePlanner(World world) : Plan(world)
+SplinePlanner::SplinePlanner(World world) : Plan(world), enemies_time()
 {
 }
@@ -1,4 +1,10 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
 #include "ai/navigator/plan.h"
+#include "ai/navigator/util.h"
 
 namespace AI
 {
@@ -12,6 +18,15 @@ class SplinePlanner : public Plan
         AI::Nav::W::Player player, Point goal,
         AI::Flags::MoveFlags added_flags = AI::Flags::MoveFlags::NONE);
 
+   private:
+    // The enemies as of enemies_time, shared by every plan in one tick.
+    AI::Nav::Util::EnemyObstacles enemies;
+    AI::Timestamp enemies_time;
+
+    // Every candidate curve, one after another, and the survivors of the
+    // cheap check with their costs; kept between calls to reuse the memory.
+    std::vector<Point> curves;
+    std::vector<std::pair<double, std::size_t>> ranked;
 };
 }
 }
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <util/timestep.h>
 #include "ai/flags.h"
@@ -56,6 +57,9 @@ DoubleParam ENEMY_MOVEMENT_FACTOR(
     u8"Enemy position interp length", u8"AI/Nav/Util", 0.0, 0.0, 2.0);
 DoubleParam FRIENDLY_MOVEMENT_FACTOR(
     u8"Friendly movement extrapolation factor", u8"AI/Nav/Util", 1.0, 0.0, 2.0);
+DoubleParam PREDICTION_HORIZON(
+    u8"Time robots are predicted to keep moving (s)", u8"AI/Nav/Util", 1.0, 0.0,
+    5.0);
 DoubleParam GOAL_POST_BUFFER(
     u8"Goal post avoidance dist", u8"AI/Nav/Util", 0.0, -0.2, 0.2);
 
@@ -256,8 +260,9 @@ double get_goal_post_trespass(
 
 double get_enemy_trespass(Point cur, Point dst, AI::Nav::W::World world)
 {
+    // This runs for every segment the RRT checks, so it loops over the team
+    // directly rather than building an EnemyObstacles.
     double violate = 0.0;
-    // avoid enemy robots
     for (AI::Nav::W::Robot rob : world.enemy_team())
     {
         double circle_radius = enemy(world, rob);
@@ -349,6 +354,71 @@ double get_friendly_trespass(
     return violate;
 }
 
+// How far a player driving from cur at time start to dst at time end (both in
+// seconds from now) comes within radius of a robot now at pos moving at vel.
+// The robot is taken to keep its velocity up to PREDICTION_HORIZON and then
+// stop, so before and after the horizon both move in straight lines and the
+// gap between them does too.
+double get_moving_trespass(
+    Point cur, Point dst, double start, double end, Point pos, Point vel,
+    double radius)
+{
+    double horizon = PREDICTION_HORIZON;
+    auto player_at = [&](double t) {
+        return end > start ? cur + (dst - cur) * ((t - start) / (end - start))
+                           : cur;
+    };
+    auto robot_at = [&](double t) { return pos + vel * std::min(t, horizon); };
+    auto gap_at   = [&](double t) { return player_at(t) - robot_at(t); };
+
+    double closest = std::numeric_limits<double>::infinity();
+    if (start < horizon)
+    {
+        double t = std::min(end, horizon);
+        closest =
+            std::min(closest, dist(Point(), Seg(gap_at(start), gap_at(t))));
+    }
+    if (end >= horizon)
+    {
+        double t = std::max(start, horizon);
+        closest = std::min(closest, dist(Point(), Seg(gap_at(t), gap_at(end))));
+    }
+    return std::max(0.0, radius - closest);
+}
+
+double get_enemy_trespass_in_time(
+    Point cur, Point dst, double start, double end, AI::Nav::W::World world)
+{
+    double violate = 0.0;
+    for (AI::Nav::W::Robot rob : world.enemy_team())
+    {
+        violate = std::max(
+            violate, get_moving_trespass(
+                         cur, dst, start, end, rob.position(), rob.velocity(),
+                         enemy(world, rob)));
+    }
+    return violate;
+}
+
+double get_friendly_trespass_in_time(
+    Point cur, Point dst, double start, double end, AI::Nav::W::World world,
+    AI::Nav::W::Player player)
+{
+    double violate = 0.0;
+    for (AI::Nav::W::Player rob : world.friendly_team())
+    {
+        if (rob == player)
+        {
+            continue;
+        }
+        violate = std::max(
+            violate, get_moving_trespass(
+                         cur, dst, start, end, rob.position(), rob.velocity(),
+                         friendly(player, rob.prio())));
+    }
+    return violate;
+}
+
 double get_ball_stop_trespass(
     Point cur, Point dst, AI::Nav::W::World world, AI::Nav::W::Player player)
 {
@@ -597,6 +667,20 @@ struct Violation final
         set_violation_amount(cur, dst, world, player);
     }
 
+    // judge the other robots where they are predicted to be while the player
+    // drives from cur to dst, setting off start seconds from now, rather than
+    // where they are now
+    void set_robot_violation_in_time(
+        Point cur, Point dst, double start, AI::Nav::W::World world,
+        AI::Nav::W::Player player)
+    {
+        double end =
+            start + (dst - cur).len() / AI::Nav::PLAYER_AVERAGE_VELOCITY;
+        enemy = get_enemy_trespass_in_time(cur, dst, start, end, world);
+        friendly =
+            get_friendly_trespass_in_time(cur, dst, start, end, world, player);
+    }
+
     static Violation get_violation_amount(
         Point cur, Point dst, AI::Nav::W::World world,
         AI::Nav::W::Player player)
@@ -722,6 +806,37 @@ bool AI::Nav::Util::valid_dst(
         .violation_free();
 }
 
+AI::Nav::Util::EnemyObstacles::EnemyObstacles()
+{
+}
+
+AI::Nav::Util::EnemyObstacles::EnemyObstacles(AI::Nav::W::World world)
+{
+    // avoid enemy robots
+    for (AI::Nav::W::Robot rob : world.enemy_team())
+    {
+        paths.push_back(
+            Seg(rob.position(),
+                rob.position() + ENEMY_MOVEMENT_FACTOR * rob.velocity()));
+        radii.push_back(enemy(world, rob));
+    }
+}
+
+double AI::Nav::Util::EnemyObstacles::clearance(Point cur, Point dst) const
+{
+    double clear = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < paths.size(); ++i)
+    {
+        clear = std::min(clear, dist(paths[i], Seg(cur, dst)) - radii[i]);
+    }
+    return clear;
+}
+
+double AI::Nav::Util::EnemyObstacles::trespass(Point cur, Point dst) const
+{
+    return std::max(0.0, -clearance(cur, dst));
+}
+
 bool AI::Nav::Util::valid_path(
     Point cur, Point dst, AI::Nav::W::World world, AI::Nav::W::Player player)
 {
@@ -739,6 +854,17 @@ bool AI::Nav::Util::valid_path(
             cur, cur, world, player, extra_flags));
 }
 
+bool AI::Nav::Util::valid_path_in_time(
+    Point cur, Point dst, double start, AI::Nav::W::World world,
+    AI::Nav::W::Player player)
+{
+    Violation path = Violation::get_violation_amount(cur, dst, world, player);
+    Violation here = Violation::get_violation_amount(cur, cur, world, player);
+    path.set_robot_violation_in_time(cur, dst, start, world, player);
+    here.set_robot_violation_in_time(cur, cur, start, world, player);
+    return path.no_more_violating_than(here);
+}
+
 bool AI::Nav::Util::valid_path(
     std::vector<Point> path, AI::Nav::W::World world, AI::Nav::W::Player player, MoveFlags extra_flags)
 {
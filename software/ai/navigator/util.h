@@ -76,9 +76,60 @@ bool valid_path(
     Point cur, Point dst, AI::Nav::W::World world, AI::Nav::W::Player player,
     AI::Flags::MoveFlags extra_flags);
 
+/**
+ * Returns true if the straight line path between cur & dst has a maximum level
+ * of rules violation exactly equal to the violation level of cur, like
+ * valid_path, except that other robots are checked where they are predicted
+ * to be as the player passes rather than where they are now. The player is
+ * taken to set off from cur start seconds from now and to drive at
+ * PLAYER_AVERAGE_VELOCITY; other robots are taken to keep their velocity for
+ * a while. A path checked this way stays valid as robots move, so long as
+ * they move as predicted.
+ */
+bool valid_path_in_time(
+    Point cur, Point dst, double start, AI::Nav::W::World world,
+    AI::Nav::W::Player player);
+
 bool valid_path(
     std::vector<Point> path, AI::Nav::W::World world, AI::Nav::W::Player player, AI::Flags::MoveFlags extra_flags);
 
+/**
+ * The enemy robots as valid_path avoids them: the stretch each robot covers
+ * over the next moment, and how far to keep from it. Building this once and
+ * checking many segments against it is cheaper than going through the enemy
+ * team for every segment.
+ */
+class EnemyObstacles final
+{
+   public:
+    /**
+     * Constructs a set with no enemies.
+     */
+    EnemyObstacles();
+
+    /**
+     * Records the enemies in the world as they are now.
+     */
+    explicit EnemyObstacles(AI::Nav::W::World world);
+
+    /**
+     * Returns how far the straight line from cur to dst stays outside the
+     * space kept around every enemy, or a negative number if it cuts in.
+     */
+    double clearance(Point cur, Point dst) const;
+
+    /**
+     * Returns how far the straight line from cur to dst cuts into the space
+     * kept around the enemies; the enemy part of the rules violation that
+     * valid_path checks.
+     */
+    double trespass(Point cur, Point dst) const;
+
+   private:
+    std::vector<Geom::Seg> paths;
+    std::vector<double> radii;
+};
+
 /**
  * returns a list of legal points circling the destination. These set of points
  * may be valuable as a search space for a navigator
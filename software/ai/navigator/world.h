@@ -21,6 +21,18 @@ class Waypoints
     AI::Flags::MoveFlags added_flags;
     Timestamp lastSentTime;
     Point move_dest;
+
+    /**
+     * \brief The path planned on an earlier tick, not including the point it
+     * started from, which is kept and repaired rather than replanned while
+     * its goal stays put.
+     */
+    std::vector<Point> path;
+
+    /**
+     * \brief The goal \ref path was planned to.
+     */
+    Point path_goal;
 };
 
 namespace W
@@ -21,7 +21,8 @@ function(build_specific_binary binary_name)
     # link against libraries
     target_link_libraries(${binary_name}
             "${BOOST_LIBRARIES}"
-            "${UTIL_LIBRARIES}")
+            "${UTIL_LIBRARIES}"
+            "bangbang")
 
 
 endfunction(build_specific_binary)
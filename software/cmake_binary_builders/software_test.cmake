@@ -3,10 +3,19 @@ function(build_specific_binary binary_name)
     # the folders where the source files are
     set(SOURCE_FOLDERS "test/unit-tests" "geom" "util")
     # the file names to match
-    set(PATTERNS "${COMMON_PATTERNS} param.*" "string.*" "config.*" "exception.*" "misc.*" "dprint.*" "hungarian.*" "matrix.*" "codec.*")
+    set(PATTERNS "${COMMON_PATTERNS} param.*" "string.*" "config.*" "exception.*" "misc.*" "dprint.*" "hungarian.*" "matrix.*" "codec.*" "histogram.*")
 
     # get the source files
     search("${PATTERNS}" "${SOURCE_FOLDERS}" "src")
+    list(APPEND "src" "${CMAKE_CURRENT_SOURCE_DIR}/mrf/camera_codec.cpp")
+    list(APPEND "src" "${CMAKE_CURRENT_SOURCE_DIR}/mrf/feedback.cpp")
+    list(APPEND "src" "${CMAKE_CURRENT_SOURCE_DIR}/mrf/drive_filter.cpp")
+    list(APPEND "src" "${CMAKE_CURRENT_SOURCE_DIR}/mrf/drive_latency.cpp")
+    list(APPEND "src" "${CMAKE_CURRENT_SOURCE_DIR}/ai/common/world_snapshot.cpp")
+    list(APPEND "src" "${CMAKE_CURRENT_SOURCE_DIR}/ai/common/clearance_field.cpp")
+    list(APPEND "src" "${CMAKE_CURRENT_SOURCE_DIR}/ai/backend/simulator/world.cpp")
+    list(APPEND "src" "${CMAKE_CURRENT_SOURCE_DIR}/ai/backend/vision/camera_relay.cpp")
+    list(APPEND "src" "${CMAKE_CURRENT_SOURCE_DIR}/ai/hl/stp/evaluation/time_to_reach.cpp")
 
     # add the source files
     add_executable(${binary_name} "${src}")
@@ -15,5 +24,6 @@ function(build_specific_binary binary_name)
     target_link_libraries(${binary_name}
             "${UTIL_LIBRARIES}"
             "${GTEST_BOTH_LIBRARIES}"
-            "${CMAKE_THREAD_LIBS_INIT}")
+            "${CMAKE_THREAD_LIBS_INIT}"
+            "bangbang")
 endfunction(build_specific_binary)
@@ -0,0 +1,375 @@
+#include "geom/delaunay.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace
+{
+/**
+ * \brief The tolerance below which two points are the same point, in square
+ * metres.
+ */
+constexpr double EPS2 = 1e-18;
+
+/**
+ * \brief Half the machine epsilon, the largest relative rounding error of one
+ * operation.
+ */
+constexpr double HALF_EPSILON = std::numeric_limits<double>::epsilon() / 2.0;
+
+/**
+ * \brief The error bounds on the floating-point orientation and incircle
+ * determinants, relative to their permanents, from Shewchuk’s “Adaptive
+ * Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates”.
+ *
+ * A determinant larger than its bound has the right sign; otherwise the sign
+ * is found exactly.
+ */
+constexpr double ORIENTATION_BOUND = (3.0 + 16.0 * HALF_EPSILON) * HALF_EPSILON;
+constexpr double INCIRCLE_BOUND = (10.0 + 96.0 * HALF_EPSILON) * HALF_EPSILON;
+
+/**
+ * \brief A number held exactly as a sum of doubles that do not overlap,
+ * smallest magnitude first.
+ */
+typedef std::vector<double> Expansion;
+
+void two_sum(double a, double b, double &sum, double &err)
+{
+    sum            = a + b;
+    double b_virt  = sum - a;
+    double a_virt  = sum - b_virt;
+    double b_round = b - b_virt;
+    double a_round = a - a_virt;
+    err            = a_round + b_round;
+}
+
+void two_product(double a, double b, double &product, double &err)
+{
+    product = a * b;
+    err     = std::fma(a, b, -product);
+}
+
+void push_nonzero(Expansion &e, double x)
+{
+    // Zero components carry nothing and would only make later steps longer.
+    if (x != 0.0)
+    {
+        e.push_back(x);
+    }
+}
+
+Expansion grow(const Expansion &e, double b)
+{
+    Expansion h;
+    h.reserve(e.size() + 1);
+    double q = b;
+    for (double i : e)
+    {
+        double err;
+        two_sum(q, i, q, err);
+        push_nonzero(h, err);
+    }
+    push_nonzero(h, q);
+    return h;
+}
+
+Expansion add(const Expansion &e, const Expansion &f)
+{
+    Expansion h(e);
+    for (double i : f)
+    {
+        h = grow(h, i);
+    }
+    return h;
+}
+
+Expansion scale(const Expansion &e, double b)
+{
+    Expansion h;
+    h.reserve(e.size() * 2);
+    double q, err;
+    if (e.empty())
+    {
+        return h;
+    }
+    two_product(e[0], b, q, err);
+    push_nonzero(h, err);
+    for (std::size_t i = 1; i != e.size(); ++i)
+    {
+        double product, product_err;
+        two_product(e[i], b, product, product_err);
+        two_sum(q, product_err, q, err);
+        push_nonzero(h, err);
+        two_sum(product, q, q, err);
+        push_nonzero(h, err);
+    }
+    push_nonzero(h, q);
+    return h;
+}
+
+Expansion multiply(const Expansion &e, const Expansion &f)
+{
+    Expansion h;
+    for (double i : f)
+    {
+        h = add(h, scale(e, i));
+    }
+    return h;
+}
+
+Expansion difference(double a, double b)
+{
+    double sum, err;
+    two_sum(a, -b, sum, err);
+    Expansion e;
+    push_nonzero(e, err);
+    push_nonzero(e, sum);
+    return e;
+}
+
+Expansion negate(Expansion e)
+{
+    for (double &i : e)
+    {
+        i = -i;
+    }
+    return e;
+}
+
+int sign(const Expansion &e)
+{
+    // The largest component is the last nonzero one and outweighs the rest.
+    for (auto i = e.rbegin(); i != e.rend(); ++i)
+    {
+        if (*i != 0.0)
+        {
+            return *i > 0.0 ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief Finds which side of the line through \p a and \p b the point \p c
+ * lies on.
+ *
+ * \return 1 if \p a, \p b, \p c turn counterclockwise, −1 if clockwise, or 0
+ * if they are collinear
+ */
+int orientation(Point a, Point b, Point c)
+{
+    double left  = (a.x - c.x) * (b.y - c.y);
+    double right = (a.y - c.y) * (b.x - c.x);
+    double det   = left - right;
+    if (std::fabs(det) >
+        ORIENTATION_BOUND * (std::fabs(left) + std::fabs(right)))
+    {
+        return det > 0.0 ? 1 : -1;
+    }
+    return sign(
+        add(multiply(difference(a.x, c.x), difference(b.y, c.y)),
+            negate(multiply(difference(a.y, c.y), difference(b.x, c.x)))));
+}
+
+/**
+ * \brief Finds whether \p d lies inside the circle through \p a, \p b and
+ * \p c, which must be in counterclockwise order.
+ *
+ * \return 1 if \p d is inside the circle, −1 if outside, or 0 if on it
+ */
+int in_circle(Point a, Point b, Point c, Point d)
+{
+    double adx = a.x - d.x, ady = a.y - d.y;
+    double bdx = b.x - d.x, bdy = b.y - d.y;
+    double cdx = c.x - d.x, cdy = c.y - d.y;
+    double alift = adx * adx + ady * ady;
+    double blift = bdx * bdx + bdy * bdy;
+    double clift = cdx * cdx + cdy * cdy;
+    double det   = alift * (bdx * cdy - cdx * bdy) +
+                 blift * (cdx * ady - adx * cdy) +
+                 clift * (adx * bdy - bdx * ady);
+    double permanent = alift * (std::fabs(bdx * cdy) + std::fabs(cdx * bdy)) +
+                       blift * (std::fabs(cdx * ady) + std::fabs(adx * cdy)) +
+                       clift * (std::fabs(adx * bdy) + std::fabs(bdx * ady));
+    if (std::fabs(det) > INCIRCLE_BOUND * permanent)
+    {
+        return det > 0.0 ? 1 : -1;
+    }
+
+    Expansion eadx = difference(a.x, d.x), eady = difference(a.y, d.y);
+    Expansion ebdx = difference(b.x, d.x), ebdy = difference(b.y, d.y);
+    Expansion ecdx = difference(c.x, d.x), ecdy = difference(c.y, d.y);
+    auto lift = [](const Expansion &dx, const Expansion &dy) {
+        return add(multiply(dx, dx), multiply(dy, dy));
+    };
+    auto cross = [](
+        const Expansion &ux, const Expansion &uy, const Expansion &vx,
+        const Expansion &vy) {
+        return add(multiply(ux, vy), negate(multiply(vx, uy)));
+    };
+    return sign(
+        add(add(multiply(lift(eadx, eady), cross(ebdx, ebdy, ecdx, ecdy)),
+                multiply(lift(ebdx, ebdy), cross(ecdx, ecdy, eadx, eady))),
+            multiply(lift(ecdx, ecdy), cross(eadx, eady, ebdx, ebdy))));
+}
+
+/**
+ * \brief Checks whether \p p, which is collinear with \p a and \p b, lies
+ * strictly between them.
+ */
+bool strictly_between(Point a, Point b, Point p)
+{
+    if (a.x != b.x)
+    {
+        return std::min(a.x, b.x) < p.x && p.x < std::max(a.x, b.x);
+    }
+    return std::min(a.y, b.y) < p.y && p.y < std::max(a.y, b.y);
+}
+
+/**
+ * \brief A triangle under construction, its vertices in counterclockwise
+ * order.
+ *
+ * One vertex may be the point at infinity. Such a ghost face stands for the
+ * unbounded region beyond one edge of the convex hull; with the point at
+ * infinity last, that region is to the left of the edge from the first vertex
+ * to the second.
+ */
+struct Face final
+{
+    std::array<std::size_t, 3> v;
+};
+
+/**
+ * \brief Checks whether inserting a point must remove a face.
+ *
+ * A finite face is removed if the point is strictly inside its circumcircle.
+ * A ghost face is removed if the point is strictly beyond its hull edge, or on
+ * the edge between its ends, which is how its “circumcircle” (the open half
+ * plane plus the open edge) behaves.
+ */
+bool in_conflict(
+    const std::vector<Point> &points, std::size_t infinite, const Face &f,
+    Point p)
+{
+    for (std::size_t k = 0; k != 3; ++k)
+    {
+        if (f.v[k] == infinite)
+        {
+            Point a = points[f.v[(k + 1) % 3]];
+            Point b = points[f.v[(k + 2) % 3]];
+            int o   = orientation(a, b, p);
+            return o > 0 || (o == 0 && strictly_between(a, b, p));
+        }
+    }
+    return in_circle(points[f.v[0]], points[f.v[1]], points[f.v[2]], p) > 0;
+}
+}
+
+std::vector<std::array<std::size_t, 3>> Geom::delaunay_triangulate(
+    const std::vector<Point> &points)
+{
+    std::vector<std::array<std::size_t, 3>> result;
+    std::size_t n = points.size();
+
+    // Start from the first three points that make a proper triangle,
+    // surrounded by ghost faces. The point at infinity is numbered n.
+    std::size_t first = 0, second = n, third = n;
+    for (std::size_t i = 1; i < n && second == n; ++i)
+    {
+        if ((points[i] - points[first]).lensq() >= EPS2)
+        {
+            second = i;
+        }
+    }
+    for (std::size_t i = second + 1; i < n && third == n; ++i)
+    {
+        if (orientation(points[first], points[second], points[i]))
+        {
+            third = i;
+        }
+    }
+    if (third == n)
+    {
+        return result;
+    }
+    if (orientation(points[first], points[second], points[third]) < 0)
+    {
+        std::swap(second, third);
+    }
+    std::vector<Face> faces = {{{{first, second, third}}},
+                               {{{second, first, n}}},
+                               {{{third, second, n}}},
+                               {{{first, third, n}}}};
+    std::vector<std::size_t> inserted = {first, second, third};
+
+    std::vector<std::pair<std::size_t, std::size_t>> edges;
+    for (std::size_t i = 0; i != n; ++i)
+    {
+        const Point &p = points[i];
+        if (i == first || i == second || i == third)
+        {
+            continue;
+        }
+        bool duplicate = false;
+        for (std::size_t j = 0; j != inserted.size() && !duplicate; ++j)
+        {
+            duplicate = (points[inserted[j]] - p).lensq() < EPS2;
+        }
+        if (duplicate)
+        {
+            continue;
+        }
+        inserted.push_back(i);
+
+        // Remove every face in conflict with the new point, keeping the edges
+        // of the hole they leave.
+        edges.clear();
+        std::size_t kept = 0;
+        for (std::size_t j = 0; j != faces.size(); ++j)
+        {
+            const Face &f = faces[j];
+            if (in_conflict(points, n, f, p))
+            {
+                for (std::size_t k = 0; k != 3; ++k)
+                {
+                    edges.emplace_back(f.v[k], f.v[(k + 1) % 3]);
+                }
+            }
+            else
+            {
+                faces[kept++] = f;
+            }
+        }
+        faces.resize(kept);
+
+        // An edge shared by two removed faces is inside the hole; the rest
+        // form its boundary and each makes a new face with the new point.
+        // Because the predicates are exact, every new finite face turns
+        // properly counterclockwise.
+        for (std::size_t j = 0; j != edges.size(); ++j)
+        {
+            bool shared = false;
+            for (std::size_t k = 0; k != edges.size() && !shared; ++k)
+            {
+                shared = k != j && edges[k].first == edges[j].second &&
+                         edges[k].second == edges[j].first;
+            }
+            if (!shared)
+            {
+                faces.push_back({{{edges[j].first, edges[j].second, i}}});
+            }
+        }
+    }
+
+    for (const Face &f : faces)
+    {
+        if (f.v[0] != n && f.v[1] != n && f.v[2] != n)
+        {
+            result.push_back(f.v);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+#include "geom/point.h"
+
+namespace Geom
+{
+/**
+ * \brief Computes the Delaunay triangulation of a set of points.
+ *
+ * Points are inserted one at a time (the Bowyer–Watson algorithm). No point
+ * lies strictly inside the circumcircle of any resulting triangle, so each
+ * triangle is an empty region between its three vertices, and together the
+ * triangles cover the convex hull of the points. Where four or more points lie
+ * on one circle, any one of the valid triangulations is returned. The
+ * orientation and incircle tests are exact, so this holds even for points that
+ * are collinear or nearly so, such as robots standing on a field line.
+ *
+ * Duplicate points are ignored. Fewer than three distinct points, or points
+ * that are all collinear, give no triangles.
+ *
+ * \param[in] points the points to triangulate
+ *
+ * \return the triangles, each as the indices in \p points of its vertices, in
+ * counterclockwise order
+ */
+std::vector<std::array<std::size_t, 3>> delaunay_triangulate(
+    const std::vector<Point> &points);
+}
@@ -1,5 +1,5 @@
 #include "particle_filter.h"
-#include <chrono>
+#include <cstdlib>
 #include "geom/util.h"
 
 namespace AI
@@ -74,9 +74,10 @@ ParticleFilter::ParticleFilter(double length, double width)
     particles =
         std::vector<Particle>(PARTICLE_FILTER_NUM_PARTICLES, Particle());
 
-    // Set the seed for the random number generator
-    seed = static_cast<unsigned int>(
-        std::chrono::system_clock::now().time_since_epoch().count());
+    // Set the seed for the random number generator from the C library
+    // generator, which is seeded randomly at startup unless the backend wants
+    // a reproducible run.
+    seed = static_cast<unsigned int>(std::rand());
 
     // These will be used to generate Points with a gaussian distribution
     generator = std::default_random_engine(seed);
@@ -7,6 +7,7 @@
 #include "geom/angle.h"
 #include "util/dprint.h"
 #include "util/hungarian.h"
+#include "util/small_assignment.h"
 
 namespace Geom
 {
@@ -291,14 +292,28 @@ std::vector<std::size_t> dist_matching(
     if (v1.size() != v2.size())
         LOG_ERROR(u8"vector sizes not equal");
 
-    if (v1.size() > 1)
+    if (v1.size() > 1 && v1.size() <= SmallAssignment::MAX_SIZE)
+    {
+        SmallAssignment assignment(v1.size(), v1.size());
+        for (std::size_t i = 0; i < v1.size(); i++)
+            for (std::size_t o = 0; o < v1.size(); o++)
+                assignment.cost(i, o, (v1[i] - v2[o]).len());
+        assignment.solve();
+        std::vector<std::size_t> order(v1.size());
+
+        for (std::size_t i = 0; i < v1.size(); i++)
+            order[i]       = assignment.column_of(i);
+
+        return order;
+    }
+    else if (v1.size() > 1)
     {
         // use hungarian O(n^3)
         Hungarian hung(v1.size());
         for (std::size_t i = 0; i < v1.size(); i++)
             for (std::size_t o = 0; o < v1.size(); o++)
                 hung.weight(i, o) =
-                    0 - (v2[i] - v1[o]).len();  // this is negative because
+                    0 - (v1[i] - v2[o]).len();  // this is negative because
                                                 // hungarian tries to maximize
                                                 // the total weight
         // use lensq instead to put more weight on outliers?
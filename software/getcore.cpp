@@ -9,6 +9,7 @@
 #include <vector>
 #include "main.h"
 #include "mrf/constants.h"
+#include "util/bitcodec_primitives.h"
 #include "util/libusb.h"
 #include "util/string.h"
 
@@ -29,6 +30,14 @@ void usage(const char *appname)
     std::cerr << '\n';
 }
 
+/**
+ * \brief Decodes a build ID, which devices send in little-endian byte order.
+ */
+uint32_t decode_build_id(const uint8_t (&buffer)[4])
+{
+    return BitcodecPrimitives::LittleEndianDecoder<uint32_t, 0, 32>()(buffer);
+}
+
 void run_robot(const std::string &filename)
 {
     // Open the dongle
@@ -71,11 +80,11 @@ void run_robot(const std::string &filename)
     std::cout << "OK\nReading build ID… ";
     std::cout.flush();
     {
-        uint32_t id;
+        uint8_t buffer[4];
         devh.control_in(
             LIBUSB_REQUEST_TYPE_VENDOR | LIBUSB_RECIPIENT_DEVICE,
-            ROBOT_READ_BUILD_ID, 0, 0, &id, sizeof(id), 0);
-        std::cout << "0x" << tohex(id, 8) << '\n';
+            ROBOT_READ_BUILD_ID, 0, 0, buffer, sizeof(buffer), 0);
+        std::cout << "0x" << tohex(decode_build_id(buffer), 8) << '\n';
     }
 }
 
@@ -123,11 +132,12 @@ void run_dongle(const std::string &filename)
     std::cout << "OK\nReading build ID… ";
     std::cout.flush();
     {
-        uint32_t id;
+        uint8_t buffer[4];
         devh.control_in(
             LIBUSB_REQUEST_TYPE_VENDOR | LIBUSB_RECIPIENT_DEVICE,
-            MRF::CONTROL_REQUEST_READ_BUILD_ID, 0, 0, &id, sizeof(id), 0);
-        std::cout << "0x" << tohex(id, 8) << '\n';
+            MRF::CONTROL_REQUEST_READ_BUILD_ID, 0, 0, buffer, sizeof(buffer),
+            0);
+        std::cout << "0x" << tohex(decode_build_id(buffer), 8) << '\n';
     }
 }
 }
@@ -23,7 +23,7 @@
 #include "ai/common/colour.h"
 #include "ai/common/playtype.h"
 #include "ai/flags.h"
-#include "log/loader.h"
+#include "log/shared/loader.h"
 #include "proto/log_record.pb.h"
 #include "uicomponents/abstract_list_model.h"
 #include "util/codec.h"
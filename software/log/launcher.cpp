@@ -25,8 +25,8 @@
 #include <string>
 #include <vector>
 #include "log/analyzer.h"
-#include "log/loader.h"
 #include "log/player.h"
+#include "log/shared/loader.h"
 #include "util/algorithm.h"
 #include "util/exception.h"
 #include "util/fd.h"
@@ -22,8 +22,8 @@
 #include <iterator>
 #include <vector>
 #include "ai/common/playtype.h"
-#include "log/loader.h"
 #include "log/shared/enums.h"
+#include "log/shared/loader.h"
 #include "proto/log_record.pb.h"
 #include "util/algorithm.h"
 #include "util/box.h"
@@ -1,4 +1,4 @@
-#include "log/loader.h"
+#include "log/shared/loader.h"
 #include <fcntl.h>
 #include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/io/zero_copy_stream_impl.h>
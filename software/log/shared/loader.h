@@ -1,5 +1,5 @@
-#ifndef LOG_LOADER_H
-#define LOG_LOADER_H
+#ifndef LOG_SHARED_LOADER_H
+#define LOG_SHARED_LOADER_H
 
 #include <string>
 #include <vector>
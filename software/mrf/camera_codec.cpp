@@ -0,0 +1,245 @@
+#include "mrf/camera_codec.h"
+#include <cassert>
+#include <cstdlib>
+
+namespace
+{
+const int MILLIRADIANS_PER_TURN = 6283;
+
+/**
+ * \brief Wraps an angle difference in milliradians into [−π, π].
+ */
+int wrap_angle(int angle)
+{
+    while (angle > MILLIRADIANS_PER_TURN / 2)
+    {
+        angle -= MILLIRADIANS_PER_TURN;
+    }
+    while (angle < -MILLIRADIANS_PER_TURN / 2)
+    {
+        angle += MILLIRADIANS_PER_TURN;
+    }
+    return angle;
+}
+
+/**
+ * \brief Divides by a scale, rounding to nearest.
+ */
+int scale_round(int value, int scale)
+{
+    return value >= 0 ? (value + scale / 2) / scale
+                      : -((-value + scale / 2) / scale);
+}
+
+bool fits_int8(int value)
+{
+    return -128 <= value && value <= 127;
+}
+
+void put_int16(uint8_t *&ptr, int16_t value)
+{
+    *ptr++ = static_cast<uint8_t>(value);
+    *ptr++ = static_cast<uint8_t>(static_cast<uint16_t>(value) >> 8);
+}
+
+int16_t get_int16(const uint8_t *ptr)
+{
+    return static_cast<int16_t>(
+        static_cast<uint16_t>(ptr[0] | static_cast<unsigned int>(ptr[1] << 8)));
+}
+}
+
+MRF::CameraEncoder::CameraEncoder(
+    unsigned int keyframe_interval, unsigned int timestamp_interval)
+    : keyframe_interval(keyframe_interval),
+      timestamp_interval(timestamp_interval),
+      robots(),
+      timestamp_valid(false),
+      last_full_timestamp(0),
+      short_timestamps(0)
+{
+}
+
+std::size_t MRF::CameraEncoder::encode(
+    const CameraPose *poses, std::size_t count, int16_t ball_x, int16_t ball_y,
+    uint64_t timestamp, uint8_t *out, std::size_t &encoded)
+{
+    uint8_t *ptr = out;
+
+    // The robot can only rebuild a shortened timestamp if the high word is the
+    // same as in the last full one it received.
+    bool full_timestamp = !timestamp_valid ||
+                          short_timestamps >= timestamp_interval ||
+                          (timestamp >> 32) != (last_full_timestamp >> 32);
+    uint8_t flags = full_timestamp ? CAMERA_FLAG_FULL_TIMESTAMP : 0;
+    *ptr++        = flags;
+    put_int16(ptr, ball_x);
+    put_int16(ptr, ball_y);
+    std::size_t timestamp_bytes = full_timestamp ? 8 : 4;
+    for (std::size_t i = 0; i != timestamp_bytes; ++i)
+    {
+        *ptr++ = static_cast<uint8_t>(timestamp >> (8 * i));
+    }
+    if (full_timestamp)
+    {
+        timestamp_valid     = true;
+        last_full_timestamp = timestamp;
+        short_timestamps    = 0;
+    }
+    else
+    {
+        ++short_timestamps;
+    }
+
+    encoded = 0;
+    for (; encoded != count; ++encoded)
+    {
+        const CameraPose &pose = poses[encoded];
+        assert(pose.index < robots.size());
+        RobotState &state = robots[pose.index];
+        std::size_t space =
+            CAMERA_PACKET_MAX_LENGTH - static_cast<std::size_t>(ptr - out);
+
+        int dx = scale_round(pose.x - state.key.x, CAMERA_DELTA_POSITION_SCALE);
+        int dy = scale_round(pose.y - state.key.y, CAMERA_DELTA_POSITION_SCALE);
+        int da = scale_round(
+            wrap_angle(pose.angle - state.key.angle), CAMERA_DELTA_ANGLE_SCALE);
+        bool keyframe = !state.valid || state.deltas >= keyframe_interval ||
+                        !fits_int8(dx) || !fits_int8(dy) || !fits_int8(da);
+
+        if (space < (keyframe ? CAMERA_KEYFRAME_LENGTH : CAMERA_DELTA_LENGTH))
+        {
+            break;
+        }
+
+        if (keyframe)
+        {
+            state.valid      = true;
+            state.generation = static_cast<uint8_t>(
+                (state.generation + 1) & CAMERA_RECORD_GENERATION_MASK);
+            state.deltas = 0;
+            state.key    = pose;
+            *ptr++       = static_cast<uint8_t>(
+                CAMERA_RECORD_KEYFRAME |
+                (state.generation << CAMERA_RECORD_GENERATION_SHIFT) |
+                pose.index);
+            put_int16(ptr, pose.x);
+            put_int16(ptr, pose.y);
+            put_int16(ptr, pose.angle);
+        }
+        else
+        {
+            ++state.deltas;
+            *ptr++ = static_cast<uint8_t>(
+                (state.generation << CAMERA_RECORD_GENERATION_SHIFT) |
+                pose.index);
+            *ptr++ = static_cast<uint8_t>(static_cast<int8_t>(dx));
+            *ptr++ = static_cast<uint8_t>(static_cast<int8_t>(dy));
+            *ptr++ = static_cast<uint8_t>(static_cast<int8_t>(da));
+        }
+    }
+
+    // The dongle tells the formats apart by length, so never emit a packet
+    // that looks like a legacy one.
+    std::size_t length = static_cast<std::size_t>(ptr - out);
+    if (length == CAMERA_PACKET_LEGACY_LENGTH)
+    {
+        out[0]        = static_cast<uint8_t>(out[0] | CAMERA_FLAG_PADDED);
+        out[length++] = 0;
+    }
+    return length;
+}
+
+void MRF::CameraEncoder::invalidate(unsigned int index)
+{
+    assert(index < robots.size());
+    robots[index].valid = false;
+}
+
+MRF::CameraDecoder::CameraDecoder(unsigned int index)
+    : index(index),
+      key_valid(false),
+      key_generation(0),
+      key(),
+      ball_x_(0),
+      ball_y_(0),
+      timestamp_(0)
+{
+}
+
+bool MRF::CameraDecoder::decode(
+    const uint8_t *data, std::size_t length, CameraPose &pose)
+{
+    if (length < CAMERA_PACKET_HEADER_LENGTH)
+    {
+        return false;
+    }
+    uint8_t flags = data[0];
+    if (flags & CAMERA_FLAG_PADDED)
+    {
+        --length;
+    }
+    std::size_t timestamp_bytes = (flags & CAMERA_FLAG_FULL_TIMESTAMP) ? 8 : 4;
+    if (length < CAMERA_PACKET_HEADER_LENGTH + timestamp_bytes)
+    {
+        return false;
+    }
+    ball_x_        = get_int16(data + 1);
+    ball_y_        = get_int16(data + 3);
+    uint64_t stamp = 0;
+    for (std::size_t i = 0; i != timestamp_bytes; ++i)
+    {
+        stamp |= static_cast<uint64_t>(data[CAMERA_PACKET_HEADER_LENGTH + i])
+                 << (8 * i);
+    }
+    if (!(flags & CAMERA_FLAG_FULL_TIMESTAMP))
+    {
+        stamp |= timestamp_ & UINT64_C(0xFFFFFFFF00000000);
+    }
+    timestamp_ = stamp;
+
+    bool found      = false;
+    std::size_t pos = CAMERA_PACKET_HEADER_LENGTH + timestamp_bytes;
+    while (pos < length)
+    {
+        uint8_t header = data[pos];
+        bool keyframe  = !!(header & CAMERA_RECORD_KEYFRAME);
+        std::size_t reclen =
+            keyframe ? CAMERA_KEYFRAME_LENGTH : CAMERA_DELTA_LENGTH;
+        if (pos + reclen > length)
+        {
+            return false;
+        }
+        if ((header & CAMERA_RECORD_INDEX_MASK) == index)
+        {
+            uint8_t generation = (header >> CAMERA_RECORD_GENERATION_SHIFT) &
+                                 CAMERA_RECORD_GENERATION_MASK;
+            if (keyframe)
+            {
+                key_valid      = true;
+                key_generation = generation;
+                key.index      = static_cast<uint8_t>(index);
+                key.x          = get_int16(data + pos + 1);
+                key.y          = get_int16(data + pos + 3);
+                key.angle      = get_int16(data + pos + 5);
+                pose           = key;
+                found          = true;
+            }
+            else if (key_valid && generation == key_generation)
+            {
+                const int8_t *delta =
+                    reinterpret_cast<const int8_t *>(data + pos + 1);
+                pose.index = static_cast<uint8_t>(index);
+                pose.x     = static_cast<int16_t>(
+                    key.x + delta[0] * CAMERA_DELTA_POSITION_SCALE);
+                pose.y = static_cast<int16_t>(
+                    key.y + delta[1] * CAMERA_DELTA_POSITION_SCALE);
+                pose.angle = static_cast<int16_t>(wrap_angle(
+                    key.angle + delta[2] * CAMERA_DELTA_ANGLE_SCALE));
+                found = true;
+            }
+        }
+        pos += reclen;
+    }
+    return found;
+}
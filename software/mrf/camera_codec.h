@@ -0,0 +1,183 @@
+#ifndef MRF_CAMERA_CODEC_H
+#define MRF_CAMERA_CODEC_H
+
+/**
+ * \file
+ *
+ * \brief Encodes and decodes compact camera packets.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "shared_util/camera_packet.h"
+
+namespace MRF
+{
+/**
+ * \brief A robot’s position and orientation as carried in a camera packet.
+ */
+struct CameraPose final
+{
+    /**
+     * \brief The robot index.
+     */
+    uint8_t index;
+
+    /**
+     * \brief The X position, in millimetres.
+     */
+    int16_t x;
+
+    /**
+     * \brief The Y position, in millimetres.
+     */
+    int16_t y;
+
+    /**
+     * \brief The orientation, in milliradians between −π and π.
+     */
+    int16_t angle;
+};
+
+/**
+ * \brief Builds compact camera packets, choosing between keyframe and delta
+ * records for each robot.
+ *
+ * The encoder remembers the last keyframe sent to each robot. A keyframe is
+ * sent when the robot has none, when the pose is too far from the keyframe
+ * to express as a delta, or after a fixed number of deltas so that a robot
+ * which missed a keyframe does not stay without corrections for long.
+ */
+class CameraEncoder final
+{
+   public:
+    /**
+     * \brief Constructs a new CameraEncoder.
+     *
+     * \param[in] keyframe_interval the largest number of consecutive deltas
+     * sent to a robot before another keyframe
+     *
+     * \param[in] timestamp_interval the largest number of consecutive packets
+     * sent with a shortened timestamp
+     */
+    explicit CameraEncoder(
+        unsigned int keyframe_interval  = 8,
+        unsigned int timestamp_interval = 16);
+
+    /**
+     * \brief Encodes a packet.
+     *
+     * Robots are encoded in the order given until the packet is full; those
+     * that do not fit are left out and the encoder’s state for them is not
+     * changed.
+     *
+     * \param[in] poses the robots to include, most important first
+     *
+     * \param[in] count the number of elements in \p poses
+     *
+     * \param[in] ball_x the X position of the ball, in millimetres
+     *
+     * \param[in] ball_y the Y position of the ball, in millimetres
+     *
+     * \param[in] timestamp the capture time, in microseconds
+     *
+     * \param[out] out the buffer to write the packet into, which must hold
+     * at least \ref CAMERA_PACKET_MAX_LENGTH bytes
+     *
+     * \param[out] encoded the number of leading elements of \p poses that
+     * were included
+     *
+     * \return the length of the packet
+     */
+    std::size_t encode(
+        const CameraPose *poses, std::size_t count, int16_t ball_x,
+        int16_t ball_y, uint64_t timestamp, uint8_t *out, std::size_t &encoded);
+
+    /**
+     * \brief Forces the next record for a robot to be a keyframe.
+     *
+     * \param[in] index the robot index
+     */
+    void invalidate(unsigned int index);
+
+   private:
+    struct RobotState final
+    {
+        bool valid;
+        uint8_t generation;
+        unsigned int deltas;
+        CameraPose key;
+    };
+
+    const unsigned int keyframe_interval, timestamp_interval;
+    std::array<RobotState, CAMERA_RECORD_INDEX_MASK + 1> robots;
+    bool timestamp_valid;
+    uint64_t last_full_timestamp;
+    unsigned int short_timestamps;
+};
+
+/**
+ * \brief Decodes compact camera packets on behalf of one robot, as the robot
+ * firmware does.
+ */
+class CameraDecoder final
+{
+   public:
+    /**
+     * \brief Constructs a new CameraDecoder.
+     *
+     * \param[in] index the robot index to decode for
+     */
+    explicit CameraDecoder(unsigned int index);
+
+    /**
+     * \brief Decodes a packet.
+     *
+     * \param[in] data the packet
+     *
+     * \param[in] length the length of \p data
+     *
+     * \param[out] pose the robot’s pose, if present
+     *
+     * \return \c true if the packet carried a usable pose for the robot, or
+     * \c false if it did not or the packet was malformed
+     */
+    bool decode(const uint8_t *data, std::size_t length, CameraPose &pose);
+
+    /**
+     * \brief Returns the ball X position from the last packet decoded.
+     */
+    int16_t ball_x() const
+    {
+        return ball_x_;
+    }
+
+    /**
+     * \brief Returns the ball Y position from the last packet decoded.
+     */
+    int16_t ball_y() const
+    {
+        return ball_y_;
+    }
+
+    /**
+     * \brief Returns the reconstructed timestamp from the last packet
+     * decoded.
+     */
+    uint64_t timestamp() const
+    {
+        return timestamp_;
+    }
+
+   private:
+    const unsigned int index;
+    bool key_valid;
+    uint8_t key_generation;
+    CameraPose key;
+    int16_t ball_x_, ball_y_;
+    uint64_t timestamp_;
+};
+}
+
+#endif
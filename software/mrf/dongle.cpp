@@ -18,7 +18,9 @@
 #include <string>
 #include <unordered_map>
 #include "mrf/constants.h"
+#include "mrf/feedback.h"
 #include "mrf/robot.h"
+#include "mrf/usb_transport.h"
 #include "util/annunciator.h"
 #include "util/dprint.h"
 
@@ -40,8 +42,10 @@ const RadioConfig DEFAULT_CONFIGS[4] = {
 
 const unsigned int ANNUNCIATOR_BEEP_LENGTH = 750;
 
-std::unique_ptr<USB::BulkOutTransfer> create_reliable_message_transfer(
-    USB::DeviceHandle &device, unsigned int robot, uint8_t message_id,
+const uint8_t EMPTY_DRIVE_PACKET[64] = {0};
+
+std::unique_ptr<MRF::OutTransfer> create_reliable_message_transfer(
+    MRF::Transport &transport, unsigned int robot, uint8_t message_id,
     unsigned int tries, const void *data, std::size_t length)
 {
     assert(robot < 8);
@@ -51,9 +55,8 @@ std::unique_ptr<USB::BulkOutTransfer> create_reliable_message_transfer(
     buffer[1] = message_id;
     buffer[2] = static_cast<uint8_t>(tries & 0xFF);
     std::memcpy(buffer + 3, data, length);
-    std::unique_ptr<USB::BulkOutTransfer> ptr(
-        new USB::BulkOutTransfer(device, 3, buffer, sizeof(buffer), 64, 0));
-    return ptr;
+    return transport.create_out_transfer(
+        MRF::Transport::MESSAGE_ENDPOINT, buffer, sizeof(buffer), 64);
 }
 }
 
@@ -64,7 +67,7 @@ MRFDongle::SendReliableMessageOperation::SendReliableMessageOperation(
       message_id(dongle.alloc_message_id()),
       delivery_status(0xFF),
       transfer(create_reliable_message_transfer(
-          dongle.device, robot, message_id, tries, data, length))
+          *dongle.transport, robot, message_id, tries, data, length))
 {
     if (dongle.logger)
     {
@@ -136,14 +139,14 @@ MRFDongle::SendReliableMessageOperation::ClearChannelError::ClearChannelError()
 }
 
 MRFDongle::MRFDongle()
+    : MRFDongle(std::unique_ptr<MRF::Transport>(
+          new MRF::USBTransport(Glib::PRIORITY_HIGH)))
+{
+}
+
+MRFDongle::MRFDongle(std::unique_ptr<MRF::Transport> transport)
     : logger(nullptr),
-      context(),
-      device(
-          context, MRF::VENDOR_ID, MRF::PRODUCT_ID, std::getenv("MRF_SERIAL")),
-      radio_interface(-1),
-      configuration_altsetting(-1),
-      normal_altsetting(-1),
-      status_transfer(device, 3, 1, true, 0),
+      transport(std::move(transport)),
       rx_fcs_fail_message(
           u8"Dongle receive FCS fail", Annunciator::Message::TriggerMode::EDGE,
           Annunciator::Message::Severity::HIGH),
@@ -157,64 +160,11 @@ MRFDongle::MRFDongle()
       receive_queue_full_message(
           u8"Receive Queue Full", Annunciator::Message::TriggerMode::LEVEL,
           Annunciator::Message::Severity::HIGH),
+      drive_transfer_busy(false),
       pending_beep_length(0)
 {
-    // Sanity-check the dongle by looking for an interface with the appropriate
-    // subclass and alternate settings with the appropriate protocols.
-    // While doing so, discover which interface number is used for the radio and
-    // which alternate settings are for configuration-setting and normal
-    // operation.
-    {
-        const libusb_config_descriptor &desc =
-            device.configuration_descriptor_by_value(1);
-        for (int i = 0; i < desc.bNumInterfaces; ++i)
-        {
-            const libusb_interface &intf = desc.interface[i];
-            if (intf.num_altsetting &&
-                intf.altsetting[0].bInterfaceClass == 0xFF &&
-                intf.altsetting[1].bInterfaceSubClass == MRF::SUBCLASS)
-            {
-                radio_interface = i;
-                for (int j = 0; j < intf.num_altsetting; ++j)
-                {
-                    const libusb_interface_descriptor &as = intf.altsetting[j];
-                    if (as.bInterfaceClass == 0xFF &&
-                        as.bInterfaceSubClass == MRF::SUBCLASS)
-                    {
-                        if (as.bInterfaceProtocol == MRF::PROTOCOL_OFF)
-                        {
-                            configuration_altsetting = j;
-                        }
-                        else if (as.bInterfaceProtocol == MRF::PROTOCOL_NORMAL)
-                        {
-                            normal_altsetting = j;
-                        }
-                    }
-                }
-                break;
-            }
-        }
-        if (radio_interface < 0 || configuration_altsetting < 0 ||
-            normal_altsetting < 0)
-        {
-            throw std::runtime_error(
-                "Wrong USB descriptors (is your dongle firmware or your "
-                "software out of date or mismatched across branches?).");
-        }
-    }
-
-    // Move the dongle into configuration 1 (it will nearly always already be
-    // there).
-    if (device.get_configuration() != 1)
-    {
-        device.set_configuration(1);
-    }
-
-    // Claim the radio interface.
-    interface_claimer.reset(new USB::InterfaceClaimer(device, radio_interface));
-
-    // Switch to configuration mode and configure the radio parameters.
-    device.set_interface_alt_setting(radio_interface, configuration_altsetting);
+    // Work out the radio parameters.
+    MRF::Transport::Config radio_config;
     {
         unsigned int config = 0U;
         {
@@ -275,42 +225,12 @@ MRFDongle::MRFDongle()
                 pan_ = static_cast<uint16_t>(i);
             }
         }
-        device.control_no_data(
-            LIBUSB_REQUEST_TYPE_VENDOR | LIBUSB_RECIPIENT_INTERFACE,
-            MRF::CONTROL_REQUEST_SET_CHANNEL, channel_,
-            static_cast<uint16_t>(radio_interface), 0);
-        device.control_no_data(
-            LIBUSB_REQUEST_TYPE_VENDOR | LIBUSB_RECIPIENT_INTERFACE,
-            MRF::CONTROL_REQUEST_SET_SYMBOL_RATE, symbol_rate == 625 ? 1 : 0,
-            static_cast<uint16_t>(radio_interface), 0);
-        device.control_no_data(
-            LIBUSB_REQUEST_TYPE_VENDOR | LIBUSB_RECIPIENT_INTERFACE,
-            MRF::CONTROL_REQUEST_SET_PAN_ID, pan_,
-            static_cast<uint16_t>(radio_interface), 0);
-        static const uint64_t MAC = UINT64_C(0x20cb13bd834ab817);
-        device.control_out(
-            LIBUSB_REQUEST_TYPE_VENDOR | LIBUSB_RECIPIENT_INTERFACE,
-            MRF::CONTROL_REQUEST_SET_MAC_ADDRESS, 0,
-            static_cast<uint16_t>(radio_interface), &MAC, sizeof(MAC), 0);
-
-        {
-            std::chrono::system_clock::time_point now =
-                std::chrono::system_clock::now();
-            std::chrono::system_clock::time_point epoch =
-                std::chrono::system_clock::from_time_t(0);
-            std::chrono::system_clock::duration diff = now - epoch;
-            std::chrono::microseconds micros =
-                std::chrono::duration_cast<std::chrono::microseconds>(diff);
-            uint64_t stamp = static_cast<uint64_t>(micros.count());
-            device.control_out(
-                LIBUSB_REQUEST_TYPE_VENDOR | LIBUSB_RECIPIENT_DEVICE,
-                MRF::CONTROL_REQUEST_SET_TIME, 0, 0, &stamp, sizeof(stamp), 0);
-        }
+        radio_config.channel     = channel_;
+        radio_config.symbol_rate = symbol_rate;
+        radio_config.pan         = pan_;
+        radio_config.mac         = UINT64_C(0x20cb13bd834ab817);
     }
 
-    // Switch to normal mode.
-    device.set_interface_alt_setting(radio_interface, normal_altsetting);
-
     // Create the robots.
     for (unsigned int i = 0; i < 8; ++i)
     {
@@ -323,28 +243,23 @@ MRFDongle::MRFDongle()
         free_message_ids.push(static_cast<uint8_t>(i));
     }
 
-    // Submit the message delivery report transfers.
-    for (auto &i : mdr_transfers)
-    {
-        i.reset(new USB::BulkInTransfer(device, 1, 8, false, 0));
-        i->signal_done.connect(sigc::mem_fun(this, &MRFDongle::handle_mdrs));
-        i->submit();
-    }
-
-    // Submit the received message transfers.
-    for (auto &i : message_transfers)
-    {
-        i.reset(new USB::BulkInTransfer(device, 2, 105, false, 0));
-        i->signal_done.connect(sigc::bind(
-            sigc::mem_fun(this, &MRFDongle::handle_message),
-            sigc::ref(*i.get())));
-        i->submit();
-    }
-
-    // Submit the estop transfer.
-    status_transfer.signal_done.connect(
+    // Prepare the drive transfer, which is reused for every drive packet.
+    drive_transfer = this->transport->create_out_transfer(
+        MRF::Transport::DRIVE_ENDPOINT, EMPTY_DRIVE_PACKET,
+        sizeof(EMPTY_DRIVE_PACKET), 64);
+    drive_transfer->signal_done.connect(
+        sigc::mem_fun(this, &MRFDongle::handle_drive_transfer_done));
+
+    // Listen for data from the dongle and start the radio.
+    this->transport->signal_mdrs.connect(
+        sigc::mem_fun(this, &MRFDongle::handle_mdrs));
+    this->transport->signal_message.connect(
+        sigc::mem_fun(this, &MRFDongle::handle_message));
+    this->transport->signal_status.connect(
         sigc::mem_fun(this, &MRFDongle::handle_status));
-    status_transfer.submit();
+    estop_state.signal_changed().connect(
+        sigc::mem_fun(this, &MRFDongle::handle_estop_changed));
+    this->transport->start(radio_config);
 
     // Connect signals to beep the dongle when an annunciator message occurs.
     annunciator_beep_connections[0] =
@@ -362,8 +277,9 @@ MRFDongle::~MRFDongle()
     annunciator_beep_connections[1].disconnect();
     drive_submit_connection.disconnect();
 
-    // Mark USB device as shutting down to squelch cancelled transfer warnings.
-    device.mark_shutting_down();
+    // Mark the transport as shutting down to squelch cancelled transfer
+    // warnings.
+    transport->mark_shutting_down();
 }
 
 void MRFDongle::beep(unsigned int length)
@@ -371,11 +287,8 @@ void MRFDongle::beep(unsigned int length)
     pending_beep_length = std::max(length, pending_beep_length);
     if (!beep_transfer && pending_beep_length)
     {
-        beep_transfer.reset(new USB::ControlNoDataTransfer(
-            device, LIBUSB_REQUEST_TYPE_VENDOR | LIBUSB_RECIPIENT_INTERFACE,
-            MRF::CONTROL_REQUEST_BEEP,
-            static_cast<uint16_t>(pending_beep_length),
-            static_cast<uint16_t>(radio_interface), 0));
+        beep_transfer = transport->create_beep_transfer(
+            static_cast<uint16_t>(pending_beep_length));
         beep_transfer->signal_done.connect(
             sigc::mem_fun(this, &MRFDongle::handle_beep_done));
         beep_transfer->submit();
@@ -404,66 +317,69 @@ void MRFDongle::free_message_id(uint8_t id)
     free_message_ids.push(id);
 }
 
-void MRFDongle::handle_mdrs(AsyncOperation<void> &op)
+void MRFDongle::handle_mdrs(const uint8_t *data, std::size_t length)
 {
-    USB::BulkInTransfer &mdr_transfer = dynamic_cast<USB::BulkInTransfer &>(op);
-    mdr_transfer.result();
-    if ((mdr_transfer.size() % 2) != 0)
+    if ((length % 2) != 0)
     {
         throw std::runtime_error("MDR transfer has odd size");
     }
-    for (unsigned int i = 0; i < mdr_transfer.size(); i += 2)
+    for (unsigned int i = 0; i < length; i += 2)
     {
         if (logger)
         {
-            logger->log_mrf_mdr(
-                mdr_transfer.data()[i], mdr_transfer.data()[i + 1]);
+            logger->log_mrf_mdr(data[i], data[i + 1]);
         }
-        signal_message_delivery_report.emit(
-            mdr_transfer.data()[i], mdr_transfer.data()[i + 1]);
+        signal_message_delivery_report.emit(data[i], data[i + 1]);
     }
-    mdr_transfer.submit();
 }
 
-void MRFDongle::handle_message(
-    AsyncOperation<void> &, USB::BulkInTransfer &transfer)
+void MRFDongle::handle_message(const uint8_t *data, std::size_t length)
 {
-    transfer.result();
-    if (transfer.size() > 2)
+    constexpr std::size_t FRAMING =
+        MRF::ReceivedHeader::BUFFER_SIZE + MRF::ReceivedTrailer::BUFFER_SIZE;
+    if (length >= FRAMING)
     {
-        unsigned int robot = transfer.data()[0];
+        const MRF::ReceivedHeaderView header(data);
+        const MRF::ReceivedTrailerView trailer(
+            data + length - MRF::ReceivedTrailer::BUFFER_SIZE);
+        const uint8_t *payload     = data + MRF::ReceivedHeader::BUFFER_SIZE;
+        std::size_t payload_length = length - FRAMING;
+        unsigned int robot         = header.robot();
         if (logger)
         {
             logger->log_mrf_message_in(
-                robot, transfer.data() + 1, transfer.size() - 3,
-                transfer.data()[transfer.size() - 2],
-                transfer.data()[transfer.size() - 1]);
+                robot, payload, payload_length, trailer.lqi(), trailer.rssi());
         }
         robots[robot]->handle_message(
-            transfer.data() + 1, transfer.size() - 3,
-            transfer.data()[transfer.size() - 2],
-            transfer.data()[transfer.size() - 1]);
+            payload, payload_length, trailer.lqi(), trailer.rssi());
     }
-    transfer.submit();
 }
 
-void MRFDongle::handle_status(AsyncOperation<void> &)
+void MRFDongle::handle_status(uint8_t status)
 {
-    status_transfer.result();
-    estop_state = static_cast<EStopState>(status_transfer.data()[0] & 3U);
-    if (status_transfer.data()[0U] & 4U)
+    estop_state = static_cast<EStopState>(status & 3U);
+    if (status & 4U)
     {
         rx_fcs_fail_message.fire();
     }
-    second_dongle_message.active(status_transfer.data()[0] & 8U);
-    transmit_queue_full_message.active(status_transfer.data()[0] & 16U);
-    receive_queue_full_message.active(status_transfer.data()[0] & 32U);
+    second_dongle_message.active(status & 8U);
+    transmit_queue_full_message.active(status & 16U);
+    receive_queue_full_message.active(status & 32U);
+}
 
-    status_transfer.submit();
+void MRFDongle::handle_estop_changed()
+{
+    // The robots handle drive records differently while stopped, so the first
+    // record after a change must not be held back as a repeat.
+    for (const std::unique_ptr<MRFRobot> &bot : robots)
+    {
+        bot->drive_filter.reset();
+    }
 }
 
 void MRFDongle::dirty_drive()
 {
+    drive_latency_.dirtied(MRF::DriveLatency::Clock::now());
     if (!drive_submit_connection.connected())
     {
         // Tells the Glib control loop to send a drive transfer when it has
@@ -552,6 +468,42 @@ void MRFDongle::send_camera_packet(
         return;
     }
 
+    submit_camera_transfer(camera_packet, sizeof(camera_packet));
+}
+
+std::size_t MRFDongle::send_camera_frame(
+    const std::vector<std::tuple<uint8_t, Point, Angle>> &robots, Point ball,
+    uint64_t timestamp)
+{
+    std::vector<MRF::CameraPose> poses;
+    poses.reserve(robots.size());
+    for (const auto &robot : robots)
+    {
+        MRF::CameraPose pose;
+        pose.index = std::get<0>(robot);
+        pose.x     = static_cast<int16_t>(std::get<1>(robot).x * 1000.0);
+        pose.y     = static_cast<int16_t>(std::get<1>(robot).y * 1000.0);
+        pose.angle = static_cast<int16_t>(
+            std::get<2>(robot).angle_mod().to_radians() * 1000.0);
+        poses.push_back(pose);
+    }
+
+    std::lock_guard<std::mutex> lock(cam_mtx);
+    if (camera_transfers.size() >= 8)
+    {
+        return 0;
+    }
+    uint8_t packet[CAMERA_PACKET_MAX_LENGTH];
+    std::size_t encoded;
+    std::size_t length = camera_encoder.encode(
+        poses.data(), poses.size(), static_cast<int16_t>(ball.x * 1000.0),
+        static_cast<int16_t>(ball.y * 1000.0), timestamp, packet, encoded);
+    submit_camera_transfer(packet, length);
+    return encoded;
+}
+
+void MRFDongle::submit_camera_transfer(const void *packet, std::size_t length)
+{
     std::chrono::system_clock::time_point now =
         std::chrono::system_clock::now();
     std::chrono::system_clock::time_point epoch =
@@ -560,22 +512,30 @@ void MRFDongle::send_camera_packet(
     std::chrono::microseconds micros =
         std::chrono::duration_cast<std::chrono::microseconds>(diff);
     uint64_t stamp = static_cast<uint64_t>(micros.count());
-    std::unique_ptr<USB::BulkOutTransfer> elt(
-        new USB::BulkOutTransfer(device, 2, camera_packet, 55, 55, 0));
+    std::unique_ptr<MRF::OutTransfer> elt(transport->create_out_transfer(
+        MRF::Transport::CAMERA_ENDPOINT, packet, length,
+        CAMERA_PACKET_MAX_LENGTH));
     auto i = camera_transfers.insert(
         camera_transfers.end(),
-        std::pair<std::unique_ptr<USB::BulkOutTransfer>, uint64_t>(
+        std::pair<std::unique_ptr<MRF::OutTransfer>, uint64_t>(
             std::move(elt), stamp));
     (*i).first->signal_done.connect(sigc::bind(
         sigc::mem_fun(this, &MRFDongle::handle_camera_transfer_done), i));
     (*i).first->submit();
+}
 
-    // std::cout << "Submitted camera transfer in position:"<<
-    // camera_transfers.size() << std::endl;
+void MRFDongle::flush_drive()
+{
+    // Dirty data was stamped when it became dirty; a flush with nothing dirty
+    // must not stamp, or the wait until the next dirty record would count.
+    drive_submit_connection.disconnect();
+    submit_drive_transfer();
 }
+
 bool MRFDongle::submit_drive_transfer()
 {
-    if (!drive_transfer)
+    drive_submit_connection.disconnect();
+    if (!drive_transfer_busy)
     {
         std::size_t dirty_indices[sizeof(robots) / sizeof(*robots)];
         std::size_t dirty_indices_count = 0;
@@ -618,11 +578,10 @@ bool MRFDongle::submit_drive_transfer()
                     length += 8;
                 }
             }
-            drive_transfer.reset(new USB::BulkOutTransfer(
-                device, 1, drive_packet, length, 64, 0));
-            drive_transfer->signal_done.connect(
-                sigc::mem_fun(this, &MRFDongle::handle_drive_transfer_done));
+            drive_transfer->refill(drive_packet, length);
             drive_transfer->submit();
+            drive_transfer_busy = true;
+            drive_latency_.submitted(MRF::DriveLatency::Clock::now());
             if (logger)
             {
                 logger->log_mrf_drive(drive_packet, length);
@@ -634,9 +593,9 @@ bool MRFDongle::submit_drive_transfer()
 
 void MRFDongle::handle_drive_transfer_done(AsyncOperation<void> &op)
 {
-    // std::cout << "Drive Transfer done" << std::endl;
+    drive_latency_.completed(MRF::DriveLatency::Clock::now());
+    drive_transfer_busy = false;
     op.result();
-    drive_transfer.reset();
     if (std::find_if(
             robots, robots + sizeof(robots) / sizeof(*robots),
             [](const std::unique_ptr<MRFRobot> &bot) {
@@ -649,8 +608,8 @@ void MRFDongle::handle_drive_transfer_done(AsyncOperation<void> &op)
 
 void MRFDongle::handle_camera_transfer_done(
     AsyncOperation<void> &,
-    std::list<std::pair<std::unique_ptr<USB::BulkOutTransfer>, uint64_t>>::
-        iterator iter)
+    std::list<std::pair<std::unique_ptr<MRF::OutTransfer>, uint64_t>>::iterator
+        iter)
 {
     std::chrono::system_clock::time_point now =
         std::chrono::system_clock::now();
@@ -681,8 +640,8 @@ void MRFDongle::send_unreliable(
     buffer[0] = static_cast<uint8_t>(robot);
     buffer[1] = static_cast<uint8_t>(tries & 0xFF);
     std::memcpy(buffer + 2, data, len);
-    std::unique_ptr<USB::BulkOutTransfer> elt(
-        new USB::BulkOutTransfer(device, 3, buffer, sizeof(buffer), 64, 0));
+    std::unique_ptr<MRF::OutTransfer> elt(transport->create_out_transfer(
+        MRF::Transport::MESSAGE_ENDPOINT, buffer, sizeof(buffer), 64));
     auto i =
         unreliable_messages.insert(unreliable_messages.end(), std::move(elt));
     (*i)->signal_done.connect(sigc::bind(
@@ -692,7 +651,7 @@ void MRFDongle::send_unreliable(
 
 void MRFDongle::check_unreliable_transfer(
     AsyncOperation<void> &,
-    std::list<std::unique_ptr<USB::BulkOutTransfer>>::iterator iter)
+    std::list<std::unique_ptr<MRF::OutTransfer>>::iterator iter)
 {
     (*iter)->result();
     unreliable_messages.erase(iter);
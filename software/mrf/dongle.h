@@ -11,8 +11,10 @@
 #include <sigc++/signal.h>
 #include <sigc++/trackable.h>
 #include <cassert>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -22,10 +24,13 @@
 #include "drive/dongle.h"
 #include "geom/angle.h"
 #include "geom/point.h"
+#include "mrf/camera_codec.h"
+#include "mrf/drive_latency.h"
 #include "mrf/packet_logger.h"
 #include "mrf/robot.h"
+#include "mrf/transport.h"
 #include "util/async_operation.h"
-#include "util/libusb.h"
+#include "util/histogram.h"
 #include "util/noncopyable.h"
 #include "util/property.h"
 
@@ -53,10 +58,19 @@ class MRFDongle final : public Drive::Dongle
         signal_message_received;
 
     /**
-     * \brief Constructs a new MRFDongle.
+     * \brief Constructs a new MRFDongle attached to a physical dongle over
+     * USB.
      */
     explicit MRFDongle();
 
+    /**
+     * \brief Constructs a new MRFDongle that communicates through a specific
+     * transport.
+     *
+     * \param[in] transport the transport to use
+     */
+    explicit MRFDongle(std::unique_ptr<MRF::Transport> transport);
+
     /**
      * \brief Destroys an MRFDongle.
      */
@@ -103,55 +117,104 @@ class MRFDongle final : public Drive::Dongle
         std::vector<std::tuple<uint8_t, Point, Angle>> robots, Point ball,
         uint64_t timestamp);
 
+    /**
+     * \brief Sends a compact camera packet.
+     *
+     * Each robot is sent either as a keyframe or as a small delta from its
+     * last keyframe. Robots are encoded in the order given until the packet is
+     * full, so the most urgent should come first.
+     *
+     * \param[in] robots the robot indices, positions and orientations
+     *
+     * \param[in] ball the ball position
+     *
+     * \param[in] timestamp the capture time, in microseconds
+     *
+     * \return the number of leading elements of \p robots that were sent,
+     * which is zero if the camera transfer queue is full
+     */
+    std::size_t send_camera_frame(
+        const std::vector<std::tuple<uint8_t, Point, Angle>> &robots,
+        Point ball, uint64_t timestamp);
+
+    /**
+     * \brief Sends any pending drive data immediately.
+     *
+     * This should be called at the end of each AI tick, once every robot has
+     * been given its primitive for the tick. If no drive data is dirty, it
+     * does nothing. If a drive transfer is already in flight, the pending data
+     * is sent as soon as it completes.
+     */
+    void flush_drive();
+
+    /**
+     * \brief Returns the distribution of drive packet latencies.
+     *
+     * Each sample is the time from when the data carried by a drive
+     * transfer first became dirty to the completion of that transfer.
+     *
+     * \return the latency histogram
+     */
+    const LatencyHistogram &drive_latency() const
+    {
+        return drive_latency_.histogram();
+    }
+
+    /**
+     * \brief Discards all recorded drive latency samples.
+     */
+    void reset_drive_latency()
+    {
+        drive_latency_.reset();
+    }
+
    private:
     friend class MRFRobot;
     friend class SendReliableMessageOperation;
 
     std::mutex cam_mtx;
     MRFPacketLogger *logger;
-    USB::Context context;
-    USB::DeviceHandle device;
-    int radio_interface, configuration_altsetting, normal_altsetting;
-    std::unique_ptr<USB::InterfaceClaimer> interface_claimer;
+    std::unique_ptr<MRF::Transport> transport;
     uint8_t channel_;
     uint16_t pan_;
-    std::array<std::unique_ptr<USB::BulkInTransfer>, 32> mdr_transfers;
-    std::array<std::unique_ptr<USB::BulkInTransfer>, 32> message_transfers;
-    USB::InterruptInTransfer status_transfer;
     Annunciator::Message rx_fcs_fail_message, second_dongle_message,
         transmit_queue_full_message, receive_queue_full_message;
-    std::unique_ptr<USB::BulkOutTransfer> drive_transfer;
-    std::unique_ptr<USB::BulkOutTransfer> camera_transfer;
-    std::list<std::unique_ptr<USB::BulkOutTransfer>> unreliable_messages;
-    std::list<std::pair<std::unique_ptr<USB::BulkOutTransfer>, uint64_t>>
+    std::unique_ptr<MRF::OutTransfer> drive_transfer;
+    bool drive_transfer_busy;
+    MRF::DriveLatency drive_latency_;
+    std::list<std::unique_ptr<MRF::OutTransfer>> unreliable_messages;
+    std::list<std::pair<std::unique_ptr<MRF::OutTransfer>, uint64_t>>
         camera_transfers;
+    MRF::CameraEncoder camera_encoder;
     std::unique_ptr<MRFRobot> robots[8];
     uint8_t drive_packet[64];
     sigc::connection drive_submit_connection;
     std::queue<uint8_t> free_message_ids;
     sigc::signal<void, uint8_t, uint8_t> signal_message_delivery_report;
-    std::unique_ptr<USB::ControlNoDataTransfer> beep_transfer;
+    std::unique_ptr<MRF::Transfer> beep_transfer;
     unsigned int pending_beep_length;
     sigc::connection annunciator_beep_connections[2];
 
     uint8_t alloc_message_id();
     void free_message_id(uint8_t id);
-    void handle_mdrs(AsyncOperation<void> &);
-    void handle_message(AsyncOperation<void> &, USB::BulkInTransfer &transfer);
-    void handle_status(AsyncOperation<void> &);
+    void handle_mdrs(const uint8_t *data, std::size_t length);
+    void handle_message(const uint8_t *data, std::size_t length);
+    void handle_status(uint8_t status);
+    void handle_estop_changed();
     void dirty_drive();
     bool submit_drive_transfer();
     void handle_drive_transfer_done(AsyncOperation<void> &);
+    void submit_camera_transfer(const void *packet, std::size_t length);
     void handle_camera_transfer_done(
         AsyncOperation<void> &,
-        std::list<std::pair<std::unique_ptr<USB::BulkOutTransfer>, uint64_t>>::
+        std::list<std::pair<std::unique_ptr<MRF::OutTransfer>, uint64_t>>::
             iterator iter);
     void send_unreliable(
         unsigned int robot, unsigned int tries, const void *data,
         std::size_t len);
     void check_unreliable_transfer(
         AsyncOperation<void> &,
-        std::list<std::unique_ptr<USB::BulkOutTransfer>>::iterator iter);
+        std::list<std::unique_ptr<MRF::OutTransfer>>::iterator iter);
     void submit_beep();
     void handle_beep_done(AsyncOperation<void> &);
     void handle_annunciator_message_activated();
@@ -205,7 +268,7 @@ class MRFDongle::SendReliableMessageOperation final
    private:
     MRFDongle &dongle;
     uint8_t message_id, delivery_status;
-    std::unique_ptr<USB::BulkOutTransfer> transfer;
+    std::unique_ptr<MRF::OutTransfer> transfer;
     sigc::connection mdr_connection;
 
     void out_transfer_done(AsyncOperation<void> &);
@@ -0,0 +1,53 @@
+#include "mrf/drive_filter.h"
+#include <cmath>
+
+using MRF::DriveFilter;
+using MRF::DriveRecord;
+
+namespace
+{
+bool close(double a, double b, double tolerance)
+{
+    // NaNs are all sent as zero, so they only match each other.
+    if (std::isnan(a) || std::isnan(b))
+    {
+        return std::isnan(a) && std::isnan(b);
+    }
+    return a == b || std::fabs(a - b) <= tolerance;
+}
+}
+
+DriveFilter::DriveFilter() : last(), valid(false)
+{
+}
+
+bool DriveFilter::should_send(
+    const DriveRecord &record, double tolerance, Clock::duration keepalive,
+    Clock::time_point now) const
+{
+    if (!valid || now - last_time >= keepalive ||
+        record.primitive != last.primitive || record.flags != last.flags)
+    {
+        return true;
+    }
+    for (std::size_t i = 0; i != record.params.size(); ++i)
+    {
+        if (!close(record.params[i], last.params[i], tolerance))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DriveFilter::sent(const DriveRecord &record, Clock::time_point now)
+{
+    last      = record;
+    last_time = now;
+    valid     = true;
+}
+
+void DriveFilter::reset()
+{
+    valid = false;
+}
@@ -0,0 +1,98 @@
+#ifndef MRF_DRIVE_FILTER_H
+#define MRF_DRIVE_FILTER_H
+
+#include <array>
+#include <chrono>
+
+namespace MRF
+{
+/**
+ * \brief The contents of one robot’s drive record, before encoding.
+ */
+struct DriveRecord final
+{
+    /**
+     * \brief The movement primitive number.
+     */
+    unsigned int primitive;
+
+    /**
+     * \brief The primitive parameters, in the units in which they are sent.
+     */
+    std::array<double, 4> params;
+
+    /**
+     * \brief Everything else in the record, such as the extra field and
+     * charger state, packed together to be compared exactly.
+     */
+    unsigned int flags;
+};
+
+/**
+ * \brief Decides whether a robot’s drive record has changed enough since it
+ * was last sent to be worth sending again.
+ *
+ * Every record sent uses USB bandwidth and dongle time. The robot ignores a
+ * record identical to the one it is carrying out, but any change to a
+ * parameter, however small, makes it restart its primitive. A record is
+ * therefore held back if its primitive and flags match the last record sent
+ * and each of its parameters is within a tolerance of the last one sent.
+ * Comparing against
+ * the last record sent, rather than the last one offered, means slow drift
+ * still gets through once it adds up. Whatever the record, it is sent once the
+ * last one sent is older than a keepalive interval.
+ */
+class DriveFilter final
+{
+   public:
+    /**
+     * \brief The clock used to time the keepalive interval.
+     */
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * \brief Constructs a filter that has not yet seen a record sent.
+     */
+    explicit DriveFilter();
+
+    /**
+     * \brief Checks whether a record should be sent.
+     *
+     * \param[in] record the record
+     * \param[in] tolerance the largest change in any parameter that is
+     * ignored
+     * \param[in] keepalive the longest time to go between records
+     * \param[in] now the current time
+     *
+     * \return \c true if \p record should be sent, or \c false if it is close
+     * enough to the last record sent, which was sent recently enough
+     */
+    bool should_send(
+        const DriveRecord &record, double tolerance, Clock::duration keepalive,
+        Clock::time_point now) const;
+
+    /**
+     * \brief Records that a record has been sent.
+     *
+     * \param[in] record the record
+     * \param[in] now the current time
+     */
+    void sent(const DriveRecord &record, Clock::time_point now);
+
+    /**
+     * \brief Forgets the last record sent, so the next one is always sent.
+     *
+     * This should be called whenever the robot may handle the next record
+     * differently from the last, such as when direct control starts or stops
+     * or the emergency stop changes state.
+     */
+    void reset();
+
+   private:
+    DriveRecord last;
+    Clock::time_point last_time;
+    bool valid;
+};
+}
+
+#endif
@@ -0,0 +1,28 @@
+#include "mrf/drive_latency.h"
+
+using MRF::DriveLatency;
+
+DriveLatency::DriveLatency() : pending_valid(false)
+{
+}
+
+void DriveLatency::dirtied(Clock::time_point now)
+{
+    if (!pending_valid)
+    {
+        pending_stamp = now;
+        pending_valid = true;
+    }
+}
+
+void DriveLatency::submitted(Clock::time_point now)
+{
+    submitted_stamp = pending_valid ? pending_stamp : now;
+    pending_valid   = false;
+}
+
+void DriveLatency::completed(Clock::time_point now)
+{
+    histogram_.record(std::chrono::duration_cast<LatencyHistogram::Duration>(
+        now - submitted_stamp));
+}
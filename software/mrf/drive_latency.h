@@ -0,0 +1,78 @@
+#ifndef MRF_DRIVE_LATENCY_H
+#define MRF_DRIVE_LATENCY_H
+
+#include <chrono>
+#include "util/histogram.h"
+
+namespace MRF
+{
+/**
+ * \brief Measures how long drive data waits to reach the dongle.
+ *
+ * Each sample runs from when the data carried by a drive transfer first
+ * became dirty to when that transfer completed. Nothing is stamped while no
+ * data is dirty, so ticks on which every record is held back add nothing to
+ * the next sample.
+ */
+class DriveLatency final
+{
+   public:
+    /**
+     * \brief The clock used to stamp drive data.
+     */
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * \brief Constructs a tracker with no data pending and no samples.
+     */
+    explicit DriveLatency();
+
+    /**
+     * \brief Records that drive data has become dirty.
+     *
+     * Only the first call after each submission is stamped, since the data
+     * pending has been waiting since then.
+     *
+     * \param[in] now the current time
+     */
+    void dirtied(Clock::time_point now);
+
+    /**
+     * \brief Records that a transfer carrying all the dirty data has been
+     * submitted.
+     *
+     * \param[in] now the current time, used if no data was stamped dirty
+     */
+    void submitted(Clock::time_point now);
+
+    /**
+     * \brief Records that the last transfer submitted has completed.
+     *
+     * \param[in] now the current time
+     */
+    void completed(Clock::time_point now);
+
+    /**
+     * \brief Returns the distribution of latencies recorded.
+     */
+    const LatencyHistogram &histogram() const
+    {
+        return histogram_;
+    }
+
+    /**
+     * \brief Discards all recorded samples.
+     */
+    void reset()
+    {
+        histogram_.reset();
+    }
+
+   private:
+    LatencyHistogram histogram_;
+    Clock::time_point pending_stamp, submitted_stamp;
+    bool pending_valid;
+};
+}
+
+#endif
@@ -0,0 +1,66 @@
+#include "mrf/feedback.h"
+#include "mrf/constants.h"
+
+#define BITCODEC_DEF_FILE "mrf/status.def"
+#define BITCODEC_STRUCT_NAME StatusMessage
+#define BITCODEC_NAMESPACE MRF
+#define BITCODEC_GEN_SOURCE
+#include "util/bitcodec.h"
+#undef BITCODEC_GEN_SOURCE
+#undef BITCODEC_NAMESPACE
+#undef BITCODEC_STRUCT_NAME
+#undef BITCODEC_DEF_FILE
+
+#define BITCODEC_DEF_FILE "mrf/build_ids.def"
+#define BITCODEC_STRUCT_NAME BuildIDsExtension
+#define BITCODEC_NAMESPACE MRF
+#define BITCODEC_GEN_SOURCE
+#include "util/bitcodec.h"
+#undef BITCODEC_GEN_SOURCE
+#undef BITCODEC_NAMESPACE
+#undef BITCODEC_STRUCT_NAME
+#undef BITCODEC_DEF_FILE
+
+#define BITCODEC_DEF_FILE "mrf/lps.def"
+#define BITCODEC_STRUCT_NAME LPSExtension
+#define BITCODEC_NAMESPACE MRF
+#define BITCODEC_GEN_SOURCE
+#include "util/bitcodec.h"
+#undef BITCODEC_GEN_SOURCE
+#undef BITCODEC_NAMESPACE
+#undef BITCODEC_STRUCT_NAME
+#undef BITCODEC_DEF_FILE
+
+#define BITCODEC_DEF_FILE "mrf/error_bits.def"
+#define BITCODEC_STRUCT_NAME ErrorBitsExtension
+#define BITCODEC_NAMESPACE MRF
+#define BITCODEC_GEN_SOURCE
+#include "util/bitcodec.h"
+#undef BITCODEC_GEN_SOURCE
+#undef BITCODEC_NAMESPACE
+#undef BITCODEC_STRUCT_NAME
+#undef BITCODEC_DEF_FILE
+
+#define BITCODEC_DEF_FILE "mrf/received_header.def"
+#define BITCODEC_STRUCT_NAME ReceivedHeader
+#define BITCODEC_NAMESPACE MRF
+#define BITCODEC_GEN_SOURCE
+#include "util/bitcodec.h"
+#undef BITCODEC_GEN_SOURCE
+#undef BITCODEC_NAMESPACE
+#undef BITCODEC_STRUCT_NAME
+#undef BITCODEC_DEF_FILE
+
+#define BITCODEC_DEF_FILE "mrf/received_trailer.def"
+#define BITCODEC_STRUCT_NAME ReceivedTrailer
+#define BITCODEC_NAMESPACE MRF
+#define BITCODEC_GEN_SOURCE
+#include "util/bitcodec.h"
+#undef BITCODEC_GEN_SOURCE
+#undef BITCODEC_NAMESPACE
+#undef BITCODEC_STRUCT_NAME
+#undef BITCODEC_DEF_FILE
+
+static_assert(
+    MRF::ErrorBitsExtension::BUFFER_SIZE == MRF::ERROR_BYTES,
+    "Error bits extension does not match the error counts!");
@@ -0,0 +1,102 @@
+#ifndef MRF_FEEDBACK_H
+#define MRF_FEEDBACK_H
+
+/**
+ * \file
+ *
+ * \brief Defines the layouts of the messages robots send back over the radio.
+ *
+ * Each layout comes as a struct, for building messages, and as a view, for
+ * reading a received message in place in the transfer buffer.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include "util/bitcodec_primitives.h"
+
+// The general status message, message type 0x00, without any of the
+// extensions that may follow it.
+#define BITCODEC_DEF_FILE "mrf/status.def"
+#define BITCODEC_STRUCT_NAME StatusMessage
+#define BITCODEC_VIEW_NAME StatusView
+#define BITCODEC_NAMESPACE MRF
+#define BITCODEC_GEN_HEADER
+#include "util/bitcodec.h"
+#undef BITCODEC_GEN_HEADER
+#undef BITCODEC_NAMESPACE
+#undef BITCODEC_VIEW_NAME
+#undef BITCODEC_STRUCT_NAME
+#undef BITCODEC_DEF_FILE
+
+// The body of the build IDs extension, which follows extension code 0x01 in a
+// general status message.
+#define BITCODEC_DEF_FILE "mrf/build_ids.def"
+#define BITCODEC_STRUCT_NAME BuildIDsExtension
+#define BITCODEC_VIEW_NAME BuildIDsView
+#define BITCODEC_NAMESPACE MRF
+#define BITCODEC_GEN_HEADER
+#include "util/bitcodec.h"
+#undef BITCODEC_GEN_HEADER
+#undef BITCODEC_NAMESPACE
+#undef BITCODEC_VIEW_NAME
+#undef BITCODEC_STRUCT_NAME
+#undef BITCODEC_DEF_FILE
+
+// The body of the LPS extension, which follows extension code 0x02 in a general
+// status message. The four readings are in tenths.
+#define BITCODEC_DEF_FILE "mrf/lps.def"
+#define BITCODEC_STRUCT_NAME LPSExtension
+#define BITCODEC_VIEW_NAME LPSView
+#define BITCODEC_NAMESPACE MRF
+#define BITCODEC_GEN_HEADER
+#include "util/bitcodec.h"
+#undef BITCODEC_GEN_HEADER
+#undef BITCODEC_NAMESPACE
+#undef BITCODEC_VIEW_NAME
+#undef BITCODEC_STRUCT_NAME
+#undef BITCODEC_DEF_FILE
+
+// The body of the error bits extension, which follows extension code 0x00 in a
+// general status message. Error i is bit i of the little-endian whole: the
+// level-triggered errors first, then the edge-triggered ones.
+#define BITCODEC_DEF_FILE "mrf/error_bits.def"
+#define BITCODEC_STRUCT_NAME ErrorBitsExtension
+#define BITCODEC_VIEW_NAME ErrorBitsView
+#define BITCODEC_NAMESPACE MRF
+#define BITCODEC_GEN_HEADER
+#include "util/bitcodec.h"
+#undef BITCODEC_GEN_HEADER
+#undef BITCODEC_NAMESPACE
+#undef BITCODEC_VIEW_NAME
+#undef BITCODEC_STRUCT_NAME
+#undef BITCODEC_DEF_FILE
+
+// What the dongle puts before a message received from a robot: the robot’s
+// index.
+#define BITCODEC_DEF_FILE "mrf/received_header.def"
+#define BITCODEC_STRUCT_NAME ReceivedHeader
+#define BITCODEC_VIEW_NAME ReceivedHeaderView
+#define BITCODEC_NAMESPACE MRF
+#define BITCODEC_GEN_HEADER
+#include "util/bitcodec.h"
+#undef BITCODEC_GEN_HEADER
+#undef BITCODEC_NAMESPACE
+#undef BITCODEC_VIEW_NAME
+#undef BITCODEC_STRUCT_NAME
+#undef BITCODEC_DEF_FILE
+
+// What the dongle puts after a message received from a robot: the link
+// quality indicator and received signal strength of the frame.
+#define BITCODEC_DEF_FILE "mrf/received_trailer.def"
+#define BITCODEC_STRUCT_NAME ReceivedTrailer
+#define BITCODEC_VIEW_NAME ReceivedTrailerView
+#define BITCODEC_NAMESPACE MRF
+#define BITCODEC_GEN_HEADER
+#include "util/bitcodec.h"
+#undef BITCODEC_GEN_HEADER
+#undef BITCODEC_NAMESPACE
+#undef BITCODEC_VIEW_NAME
+#undef BITCODEC_STRUCT_NAME
+#undef BITCODEC_DEF_FILE
+
+#endif
@@ -0,0 +1,404 @@
+#include "mrf/loopback_transport.h"
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include "drive/dongle.h"
+#include "mrf/constants.h"
+#include "util/exception.h"
+
+namespace MRF
+{
+/**
+ * \brief A transfer to the emulated dongle.
+ */
+class LoopbackTransfer final : public OutTransfer
+{
+   public:
+    explicit LoopbackTransfer(
+        LoopbackTransport &transport, unsigned int endpoint, const void *data,
+        std::size_t len, std::size_t capacity)
+        : transport(transport),
+          endpoint(endpoint),
+          capacity(capacity),
+          submitted(false),
+          done(false),
+          alive(std::make_shared<char>())
+    {
+        refill(data, len);
+    }
+
+    void result() const override
+    {
+        assert(done);
+    }
+
+    void submit() override
+    {
+        assert(!submitted);
+        submitted = true;
+        done      = false;
+        std::weak_ptr<char> token(alive);
+        LoopbackTransport::Timestamp now = std::chrono::steady_clock::now();
+        transport.schedule(now + transport.params.usb_delay, [this, token]() {
+            if (token.lock())
+            {
+                submitted = false;
+                done      = true;
+                signal_done.emit(*this);
+            }
+        });
+        if (endpoint)
+        {
+            transport.handle_out(endpoint, buffer, now);
+        }
+    }
+
+    void refill(const void *data, std::size_t len) override
+    {
+        assert(!submitted);
+        assert(len <= capacity);
+        const uint8_t *bytes = static_cast<const uint8_t *>(data);
+        buffer.assign(bytes, bytes + len);
+    }
+
+   private:
+    LoopbackTransport &transport;
+    const unsigned int endpoint;
+    const std::size_t capacity;
+    std::vector<uint8_t> buffer;
+    bool submitted, done;
+    std::shared_ptr<char> alive;
+};
+}
+
+namespace
+{
+FileDescriptor create_timerfd()
+{
+    int fd = timerfd_create(CLOCK_MONOTONIC, 0);
+    if (fd < 0)
+    {
+        throw SystemError("timerfd_create", errno);
+    }
+    return FileDescriptor::create_from_fd(fd);
+}
+
+/**
+ * \brief The length of a general status message, excluding the type byte.
+ */
+const std::size_t GENERAL_STATUS_LENGTH = 13;
+}
+
+MRF::LoopbackTransport::Parameters::Parameters()
+    : usb_delay(125),
+      radio_delay(1000),
+      feedback_period(100000),
+      loss(0.0),
+      seed(0)
+{
+    robots.set();
+}
+
+MRF::LoopbackTransport::LoopbackTransport(const Parameters &params)
+    : params(params),
+      tfd(create_timerfd()),
+      next_seq(0),
+      rng(params.seed),
+      lose(params.loss),
+      started(false),
+      status(static_cast<uint8_t>(Drive::Dongle::EStopState::RUN)),
+      stats()
+{
+    tfd.set_blocking(false);
+    tfd_connection = Glib::signal_io().connect(
+        sigc::mem_fun(this, &LoopbackTransport::on_readable), tfd.fd(),
+        Glib::IO_IN, Glib::PRIORITY_HIGH);
+}
+
+MRF::LoopbackTransport::~LoopbackTransport()
+{
+    tfd_connection.disconnect();
+}
+
+void MRF::LoopbackTransport::start(const Config &)
+{
+    started = true;
+    set_status(status);
+    if (params.feedback_period.count() > 0)
+    {
+        Timestamp now = std::chrono::steady_clock::now();
+        for (unsigned int i = 0; i != params.robots.size(); ++i)
+        {
+            if (params.robots[i])
+            {
+                // Stagger the robots so their feedback does not all arrive in
+                // the same instant.
+                schedule(
+                    now + params.feedback_period * (i + 1) / 8,
+                    std::bind(&LoopbackTransport::send_feedback, this, i));
+            }
+        }
+    }
+}
+
+std::unique_ptr<MRF::OutTransfer> MRF::LoopbackTransport::create_out_transfer(
+    unsigned int endpoint, const void *data, std::size_t len,
+    std::size_t max_len)
+{
+    assert(endpoint);
+    return std::unique_ptr<OutTransfer>(new LoopbackTransfer(
+        *this, endpoint, data, len, std::max(len, max_len)));
+}
+
+std::unique_ptr<MRF::Transfer> MRF::LoopbackTransport::create_beep_transfer(
+    uint16_t)
+{
+    return std::unique_ptr<Transfer>(
+        new LoopbackTransfer(*this, 0, nullptr, 0, 0));
+}
+
+void MRF::LoopbackTransport::set_status(uint8_t status)
+{
+    this->status = status;
+    if (started)
+    {
+        schedule(
+            std::chrono::steady_clock::now() + params.usb_delay,
+            [this, status]() { signal_status.emit(status); });
+    }
+}
+
+void MRF::LoopbackTransport::schedule(
+    Timestamp due, std::function<void()> action)
+{
+    Event ev;
+    ev.due    = due;
+    ev.seq    = next_seq++;
+    ev.action = std::move(action);
+    events.push(std::move(ev));
+    rearm();
+}
+
+void MRF::LoopbackTransport::rearm()
+{
+    itimerspec tspec;
+    std::memset(&tspec, 0, sizeof(tspec));
+    if (!events.empty())
+    {
+        // An all-zero expiry would disarm the timer, so always wait at least
+        // one nanosecond; events are thus never run re-entrantly.
+        std::chrono::nanoseconds ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                events.top().due.time_since_epoch());
+        if (ns.count() <= 0)
+        {
+            ns = std::chrono::nanoseconds(1);
+        }
+        tspec.it_value.tv_sec  = static_cast<time_t>(ns.count() / 1000000000);
+        tspec.it_value.tv_nsec = static_cast<long>(ns.count() % 1000000000);
+    }
+    if (timerfd_settime(tfd.fd(), TFD_TIMER_ABSTIME, &tspec, nullptr) < 0)
+    {
+        throw SystemError("timerfd_settime", errno);
+    }
+}
+
+bool MRF::LoopbackTransport::on_readable(Glib::IOCondition)
+{
+    uint64_t expirations;
+    if (read(tfd.fd(), &expirations, sizeof(expirations)) < 0 &&
+        errno != EAGAIN)
+    {
+        throw SystemError("read(timerfd)", errno);
+    }
+
+    Timestamp now = std::chrono::steady_clock::now();
+    while (!events.empty() && events.top().due <= now)
+    {
+        std::function<void()> action = events.top().action;
+        events.pop();
+        action();
+    }
+    rearm();
+    return true;
+}
+
+void MRF::LoopbackTransport::handle_out(
+    unsigned int endpoint, const std::vector<uint8_t> &data,
+    Timestamp submitted)
+{
+    switch (endpoint)
+    {
+        case DRIVE_ENDPOINT:
+            handle_drive(data, submitted);
+            break;
+
+        case CAMERA_ENDPOINT:
+            ++stats.camera_packets;
+            break;
+
+        case MESSAGE_ENDPOINT:
+            schedule(
+                submitted + params.usb_delay,
+                std::bind(&LoopbackTransport::handle_message, this, data));
+            break;
+    }
+}
+
+void MRF::LoopbackTransport::handle_drive(
+    const std::vector<uint8_t> &data, Timestamp submitted)
+{
+    ++stats.drive_packets;
+
+    // Split the packet into per-robot records, following the same rules as
+    // the dongle firmware.
+    std::vector<std::pair<unsigned int, std::vector<uint8_t>>> records;
+    if (data.size() == 64)
+    {
+        for (unsigned int i = 0; i != 8; ++i)
+        {
+            records.emplace_back(
+                i, std::vector<uint8_t>(
+                       data.begin() + i * 8, data.begin() + i * 8 + 8));
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i + 9 <= data.size(); i += 9)
+        {
+            records.emplace_back(
+                data[i] & 7U, std::vector<uint8_t>(
+                                  data.begin() + static_cast<long>(i) + 1,
+                                  data.begin() + static_cast<long>(i) + 9));
+        }
+    }
+
+    // The drive packet is broadcast once; each robot hears it or not.
+    Timestamp arrival = submitted + params.usb_delay + params.radio_delay;
+    for (const auto &record : records)
+    {
+        if (!params.robots[record.first] || lose(rng))
+        {
+            ++stats.drive_records_lost;
+            continue;
+        }
+        ++stats.drive_records_delivered;
+        unsigned int robot         = record.first;
+        std::vector<uint8_t> bytes = record.second;
+        schedule(arrival, [this, robot, bytes, submitted]() {
+            signal_robot_drive.emit(robot, bytes.data(), submitted);
+        });
+    }
+}
+
+void MRF::LoopbackTransport::handle_message(const std::vector<uint8_t> &data)
+{
+    if (data.size() < 2)
+    {
+        return;
+    }
+    bool reliable      = !!(data[0] & 0x10);
+    unsigned int robot = data[0] & 0x0F;
+    std::size_t header = reliable ? 3 : 2;
+    if (data.size() < header || robot >= params.robots.size())
+    {
+        return;
+    }
+    uint8_t id         = reliable ? data[1] : 0;
+    unsigned int tries = data[header - 1] ? data[header - 1] : 256;
+    ++stats.messages_sent;
+
+    // A reliable message is retried until the robot's acknowledgement makes
+    // it back; a lost acknowledgement means the robot may see it more than
+    // once, but it is counted as delivered only once.
+    unsigned int attempts = 0;
+    bool delivered        = false;
+    uint8_t code          = MRF::MDR_STATUS_NOT_ASSOCIATED;
+    if (params.robots[robot])
+    {
+        code = MRF::MDR_STATUS_NOT_ACKNOWLEDGED;
+        while (attempts < tries)
+        {
+            ++attempts;
+            if (lose(rng))
+            {
+                continue;
+            }
+            delivered = true;
+            if (!reliable || !lose(rng))
+            {
+                code = MRF::MDR_STATUS_OK;
+                break;
+            }
+        }
+    }
+
+    Timestamp now = std::chrono::steady_clock::now();
+    if (delivered)
+    {
+        ++stats.messages_delivered;
+        std::vector<uint8_t> payload(data.begin() + header, data.end());
+        schedule(now + params.radio_delay * attempts, [this, robot, payload]() {
+            signal_robot_message.emit(robot, payload.data(), payload.size());
+        });
+    }
+    else
+    {
+        ++stats.messages_failed;
+    }
+    if (reliable)
+    {
+        schedule(
+            now + params.radio_delay * std::max(attempts, 1U) +
+                params.usb_delay,
+            [this, id, code]() {
+                uint8_t mdr[2] = {id, code};
+                signal_mdrs.emit(mdr, sizeof(mdr));
+            });
+    }
+}
+
+void MRF::LoopbackTransport::send_feedback(unsigned int robot)
+{
+    Timestamp now = std::chrono::steady_clock::now();
+    schedule(
+        now + params.feedback_period,
+        std::bind(&LoopbackTransport::send_feedback, this, robot));
+
+    ++stats.feedback_sent;
+    if (lose(rng))
+    {
+        ++stats.feedback_lost;
+        return;
+    }
+
+    // Robot index, message type, general status, LQI and RSSI.
+    std::vector<uint8_t> msg;
+    msg.reserve(2 + GENERAL_STATUS_LENGTH + 2);
+    msg.push_back(static_cast<uint8_t>(robot));
+    msg.push_back(0x00);
+    const uint16_t words[] = {
+        16000,  // Battery voltage, mV
+        22000,  // Capacitor voltage, cV
+        0,      // Break beam reading
+        3000,   // Board temperature, c°C
+    };
+    for (uint16_t word : words)
+    {
+        msg.push_back(static_cast<uint8_t>(word));
+        msg.push_back(static_cast<uint8_t>(word >> 8));
+    }
+    msg.push_back(0x40);  // Capacitor charged, logger OK
+    msg.push_back(0x00);  // SD card OK
+    msg.push_back(0x00);  // Dribbler speed
+    msg.push_back(0x00);
+    msg.push_back(30);  // Dribbler temperature
+    msg.push_back(255);
+    msg.push_back(255);
+    schedule(now + params.radio_delay + params.usb_delay, [this, msg]() {
+        signal_message.emit(msg.data(), msg.size());
+    });
+}
@@ -0,0 +1,193 @@
+#ifndef MRF_LOOPBACK_TRANSPORT_H
+#define MRF_LOOPBACK_TRANSPORT_H
+
+#include <glibmm/main.h>
+#include <sigc++/signal.h>
+#include <sigc++/trackable.h>
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <vector>
+#include "mrf/transport.h"
+#include "util/fd.h"
+
+namespace MRF
+{
+/**
+ * \brief A transport that emulates a dongle and a set of robots in software.
+ *
+ * Packets sent to the emulated dongle are delivered to emulated robots after
+ * configurable USB and radio delays, with each radio frame independently lost
+ * with a configurable probability. Reliable messages produce message delivery
+ * reports and present robots send periodic general status messages, so an
+ * MRFDongle attached to this transport behaves as if a real dongle were
+ * present. Events are scheduled on the Glib main loop.
+ */
+class LoopbackTransport final : public Transport, public sigc::trackable
+{
+   public:
+    /**
+     * \brief The type of timestamps used by the emulation.
+     */
+    typedef std::chrono::steady_clock::time_point Timestamp;
+
+    /**
+     * \brief The behaviour of the emulated link.
+     */
+    struct Parameters final
+    {
+        /**
+         * \brief The time taken for a USB transfer between host and dongle.
+         */
+        std::chrono::microseconds usb_delay;
+
+        /**
+         * \brief The time taken to send one radio frame, including any
+         * acknowledgement.
+         */
+        std::chrono::microseconds radio_delay;
+
+        /**
+         * \brief The interval between general status messages from each
+         * present robot, or zero to disable feedback.
+         */
+        std::chrono::microseconds feedback_period;
+
+        /**
+         * \brief The probability that any individual radio frame is lost.
+         */
+        double loss;
+
+        /**
+         * \brief Which robot indices are present and answering.
+         */
+        std::bitset<8> robots;
+
+        /**
+         * \brief The seed for the loss random number generator.
+         */
+        unsigned int seed;
+
+        /**
+         * \brief Constructs a set of parameters approximating a real dongle
+         * with all robots present and no loss.
+         */
+        explicit Parameters();
+    };
+
+    /**
+     * \brief Counters of the traffic seen by the emulation.
+     */
+    struct Statistics final
+    {
+        uint64_t drive_packets, drive_records_delivered, drive_records_lost;
+        uint64_t camera_packets;
+        uint64_t messages_sent, messages_delivered, messages_failed;
+        uint64_t feedback_sent, feedback_lost;
+    };
+
+    /**
+     * \brief Emitted when an emulated robot receives its drive record.
+     *
+     * \param[in] robot the robot index
+     *
+     * \param[in] record the 8-byte drive record
+     *
+     * \param[in] submitted the time at which the drive packet carrying the
+     * record was submitted by the host
+     */
+    sigc::signal<void, unsigned int, const uint8_t *, Timestamp>
+        signal_robot_drive;
+
+    /**
+     * \brief Emitted when an emulated robot receives a message.
+     *
+     * \param[in] robot the robot index
+     *
+     * \param[in] data the message payload
+     *
+     * \param[in] length the length of the payload
+     */
+    sigc::signal<void, unsigned int, const uint8_t *, std::size_t>
+        signal_robot_message;
+
+    /**
+     * \brief Constructs a new LoopbackTransport.
+     *
+     * \param[in] params the behaviour of the emulated link
+     */
+    explicit LoopbackTransport(const Parameters &params = Parameters());
+
+    /**
+     * \brief Destroys the transport, discarding any pending events.
+     */
+    ~LoopbackTransport();
+
+    void start(const Config &config) override;
+    std::unique_ptr<OutTransfer> create_out_transfer(
+        unsigned int endpoint, const void *data, std::size_t len,
+        std::size_t max_len) override;
+    std::unique_ptr<Transfer> create_beep_transfer(uint16_t length) override;
+
+    /**
+     * \brief Changes the status byte reported by the emulated dongle.
+     *
+     * \param[in] status the new status, which is reported after one USB delay
+     */
+    void set_status(uint8_t status);
+
+    /**
+     * \brief Returns the traffic counters.
+     *
+     * \return the counters
+     */
+    const Statistics &statistics() const
+    {
+        return stats;
+    }
+
+   private:
+    friend class LoopbackTransfer;
+
+    struct Event final
+    {
+        Timestamp due;
+        uint64_t seq;
+        std::function<void()> action;
+
+        bool operator<(const Event &other) const
+        {
+            // std::priority_queue pops the largest element first.
+            return due > other.due || (due == other.due && seq > other.seq);
+        }
+    };
+
+    const Parameters params;
+    const FileDescriptor tfd;
+    sigc::connection tfd_connection;
+    std::priority_queue<Event> events;
+    uint64_t next_seq;
+    std::mt19937 rng;
+    std::bernoulli_distribution lose;
+    bool started;
+    uint8_t status;
+    Statistics stats;
+
+    void schedule(Timestamp due, std::function<void()> action);
+    void rearm();
+    bool on_readable(Glib::IOCondition);
+    void handle_out(
+        unsigned int endpoint, const std::vector<uint8_t> &data,
+        Timestamp submitted);
+    void handle_drive(const std::vector<uint8_t> &data, Timestamp submitted);
+    void handle_message(const std::vector<uint8_t> &data);
+    void send_feedback(unsigned int robot);
+};
+}
+
+#endif
@@ -3,6 +3,7 @@
 #include <sigc++/functors/mem_fun.h>
 #include <array>
 #include <cassert>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
@@ -12,11 +13,13 @@
 #include <utility>
 #include "mrf/constants.h"
 #include "mrf/dongle.h"
+#include "mrf/drive_filter.h"
+#include "mrf/feedback.h"
 #include "util/algorithm.h"
-#include "util/codec.h"
 #include "util/dprint.h"
 #include "util/param.h"
 #include "util/string.h"
+#include "util/tick_counter.h"
 
 BoolParam send_tune_updates(
     u8"Whether or not to broadcast variable tune updates", u8"MRF/Robot/",
@@ -25,6 +28,13 @@ IntParam tune_param0(u8"Tunable parameter 0", u8"MRF/Robot/", 0, 0, 65535);
 IntParam tune_param1(u8"Tunable parameter 1", u8"MRF/Robot/", 0, 0, 65535);
 IntParam tune_param2(u8"Tunable parameter 2", u8"MRF/Robot/", 0, 0, 65535);
 IntParam tune_param3(u8"Tunable parameter 3", u8"MRF/Robot/", 0, 0, 65535);
+BoolParam filter_drive(
+    u8"Suppress unchanged drive records", u8"MRF/Robot/", true);
+DoubleParam drive_tolerance(
+    u8"Drive parameter change to ignore (wire units)", u8"MRF/Robot/", 2.0, 0.0,
+    100.0);
+IntParam drive_keepalive(
+    u8"Longest time between drive records (ms)", u8"MRF/Robot/", 100, 20, 1000);
 static int last_tp0;
 static int last_tp1;
 static int last_tp2;
@@ -43,6 +53,8 @@ const unsigned int REQUEST_BUILD_IDS_COUNT = 7;
  */
 const double REQUEST_BUILD_IDS_INTERVAL = 0.5;
 
+TickCounter drive_suppressed(u8"Drive records suppressed");
+
 struct RSSITableEntry final
 {
     int rssi;
@@ -155,7 +167,6 @@ void MRFRobot::send_prim(Drive::LLPrimitive p)
         params[i] = p.params[i];
     }
     extra = p.extra;
-    if(p.prim == Drive::Primitive::MOVE) /*extra = 1;*/printf("extra: %i", extra);
     dirty_drive();
 }
 
@@ -328,8 +339,23 @@ MRFRobot::~MRFRobot()
     feedback_timeout_connection.disconnect();
 }
 
+MRF::DriveRecord MRFRobot::drive_record() const
+{
+    MRF::DriveRecord record;
+    record.primitive = static_cast<unsigned int>(primitive.get());
+    for (std::size_t i = 0; i != sizeof(params) / sizeof(*params); ++i)
+    {
+        record.params[i] = params[i];
+    }
+    record.flags = static_cast<unsigned int>(extra) | (slow ? 0x80U : 0U) |
+                   static_cast<unsigned int>(charger_state) << 8;
+    return record;
+}
+
 void MRFRobot::encode_drive_packet(void *out)
 {
+    drive_filter.sent(drive_record(), MRF::DriveFilter::Clock::now());
+
     uint16_t words[4];
 
     // Encode the parameter words.
@@ -456,40 +482,23 @@ void MRFRobot::handle_message(
         {
             case 0x00:
                 // General robot status update
-                ++bptr;
-                --len;
-                if (len >= 13)
+                if (len >= MRF::StatusMessage::BUFFER_SIZE)
                 {
                     alive = true;
 
-                    battery_voltage =
-                        (bptr[0] | static_cast<unsigned int>(bptr[1] << 8)) /
-                        1000.0;
-                    bptr += 2;
-                    len -= 2;
+                    const MRF::StatusView status(bptr);
+                    bptr += MRF::StatusMessage::BUFFER_SIZE;
+                    len -= MRF::StatusMessage::BUFFER_SIZE;
 
-                    capacitor_voltage =
-                        (bptr[0] | static_cast<unsigned int>(bptr[1] << 8)) /
-                        100.0;
+                    battery_voltage   = status.battery_voltage() / 1000.0;
+                    capacitor_voltage = status.capacitor_voltage() / 100.0;
                     low_capacitor_message.active(capacitor_voltage < 5.0);
-                    bptr += 2;
-                    len -= 2;
-
-                    break_beam_reading =
-                        (bptr[0] | static_cast<unsigned int>(bptr[1] << 8)) /
-                        1000.0;
-                    bptr += 2;
-                    len -= 2;
-
-                    board_temperature =
-                        (bptr[0] | static_cast<unsigned int>(bptr[1] << 8)) /
-                        100.0;
-                    bptr += 2;
-                    len -= 2;
-
-                    ball_in_beam               = !!(*bptr & 0x80);
-                    capacitor_charged          = !!(*bptr & 0x40);
-                    unsigned int logger_status = *bptr & 0x3F;
+                    break_beam_reading = status.break_beam_reading() / 1000.0;
+                    board_temperature  = status.board_temperature() / 100.0;
+                    ball_in_beam       = status.ball_in_beam();
+                    capacitor_charged  = status.capacitor_charged();
+
+                    unsigned int logger_status = status.logger_status();
                     for (std::size_t i = 0; i < logger_messages.size(); ++i)
                     {
                         if (logger_messages[i])
@@ -497,64 +506,51 @@ void MRFRobot::handle_message(
                             logger_messages[i]->active(logger_status == i);
                         }
                     }
-                    ++bptr;
-                    --len;
 
+                    unsigned int sd_status = status.sd_status();
                     for (std::size_t i = 0; i < sd_messages.size(); ++i)
                     {
                         if (sd_messages[i])
                         {
-                            sd_messages[i]->active(*bptr == i);
+                            sd_messages[i]->active(sd_status == i);
                         }
                     }
-                    ++bptr;
-                    --len;
 
-                    dribbler_speed = static_cast<int16_t>(static_cast<uint16_t>(
-                                         bptr[0] | (bptr[1] << 8))) *
-                                     25 * 60 / 6;
-                    bptr += 2;
-                    len -= 2;
-
-                    dribbler_temperature = *bptr++;
-                    --len;
+                    dribbler_speed = status.dribbler_speed() * 25 * 60 / 6;
+                    dribbler_temperature = status.dribbler_temperature();
 
                     bool has_error_extension = false;
                     while (len)
                     {
                         // Decode extensions.
-                        switch (*bptr)
+                        uint8_t code = *bptr++;
+                        --len;
+                        switch (code)
                         {
                             case 0x00:  // Error bits.
-                                ++bptr;
-                                --len;
-                                if (len >= MRF::ERROR_BYTES)
+                                if (len >= MRF::ErrorBitsExtension::BUFFER_SIZE)
                                 {
                                     has_error_extension = true;
+                                    uint32_t bits =
+                                        MRF::ErrorBitsView(bptr).bits();
                                     for (unsigned int i = 0;
                                          i != MRF::ERROR_LT_COUNT; ++i)
                                     {
-                                        unsigned int byte = i / CHAR_BIT;
-                                        unsigned int bit  = i % CHAR_BIT;
                                         error_lt_messages[i]->active(
-                                            bptr[byte] & (1 << bit));
+                                            (bits >> i) & 1U);
                                     }
+                                    bits >>= MRF::ERROR_LT_COUNT;
                                     for (unsigned int i = 0;
                                          i != MRF::ERROR_ET_COUNT; ++i)
                                     {
-                                        unsigned int byte =
-                                            (i + MRF::ERROR_LT_COUNT) /
-                                            CHAR_BIT;
-                                        unsigned int bit =
-                                            (i + MRF::ERROR_LT_COUNT) %
-                                            CHAR_BIT;
-                                        if (bptr[byte] & (1 << bit))
+                                        if ((bits >> i) & 1U)
                                         {
                                             error_et_messages[i]->fire();
                                         }
                                     }
-                                    bptr += MRF::ERROR_BYTES;
-                                    len -= MRF::ERROR_BYTES;
+                                    bptr +=
+                                        MRF::ErrorBitsExtension::BUFFER_SIZE;
+                                    len -= MRF::ErrorBitsExtension::BUFFER_SIZE;
                                 }
                                 else
                                 {
@@ -563,20 +559,20 @@ void MRFRobot::handle_message(
                                         u8"update with truncated error bits "
                                         u8"extension of length %1",
                                         len));
+                                    len = 0;
                                 }
                                 break;
 
                             case 0x01:  // Build IDs.
-                                ++bptr;
-                                --len;
-                                if (len >= 8)
+                                if (len >= MRF::BuildIDsExtension::BUFFER_SIZE)
                                 {
+                                    const MRF::BuildIDsView ids(bptr);
                                     build_ids_valid = true;
-                                    fw_build_id     = decode_u32_le(bptr);
-                                    fpga_build_id   = decode_u32_le(bptr + 4);
+                                    fw_build_id     = ids.fw_build_id();
+                                    fpga_build_id   = ids.fpga_build_id();
                                     check_build_id_mismatch();
-                                    bptr += 8;
-                                    len -= 8;
+                                    bptr += MRF::BuildIDsExtension::BUFFER_SIZE;
+                                    len -= MRF::BuildIDsExtension::BUFFER_SIZE;
                                 }
                                 else
                                 {
@@ -585,20 +581,20 @@ void MRFRobot::handle_message(
                                         u8"update with truncated build IDs "
                                         u8"extension of length %1",
                                         len));
+                                    len = 0;
                                 }
                                 break;
 
                             case 0x02:  // LPS data.
-                                ++bptr;
-                                --len;
-                                if (len >= 4)
+                                if (len >= MRF::LPSExtension::BUFFER_SIZE)
                                 {
-                                    for (unsigned int i = 0; i < 4; ++i)
-                                    {
-                                        lps_values[i] =
-                                            static_cast<int8_t>(*bptr++) / 10.0;
-                                    }
-                                    len -= 4;
+                                    const MRF::LPSView lps(bptr);
+                                    lps_values[0] = lps.lps0() / 10.0;
+                                    lps_values[1] = lps.lps1() / 10.0;
+                                    lps_values[2] = lps.lps2() / 10.0;
+                                    lps_values[3] = lps.lps3() / 10.0;
+                                    bptr += MRF::LPSExtension::BUFFER_SIZE;
+                                    len -= MRF::LPSExtension::BUFFER_SIZE;
                                 }
                                 else
                                 {
@@ -607,6 +603,7 @@ void MRFRobot::handle_message(
                                         u8"update with truncated LPS data "
                                         u8"extension of length %1",
                                         len));
+                                    len = 0;
                                 }
                                 break;
 
@@ -614,7 +611,7 @@ void MRFRobot::handle_message(
                                 LOG_ERROR(Glib::ustring::compose(
                                     u8"Received general status packet from "
                                     u8"robot with unknown extension code %1",
-                                    static_cast<unsigned int>(*bptr)));
+                                    static_cast<unsigned int>(code)));
                                 len = 0;
                                 break;
                         }
@@ -734,11 +731,25 @@ void MRFRobot::handle_direct_control_changed()
     params[2] = 0.0;
     params[3] = 0.0;
     extra     = 0;
+    // Whoever takes over, the first record must reach the robot.
+    drive_filter.reset();
     dirty_drive();
 }
 
 void MRFRobot::dirty_drive()
 {
+    // The AI sets the primitive, slow flag and charger state every tick, so
+    // this also runs every tick, which is often enough for the keepalive.
+    // Direct control comes from a person, so it gets no tolerance.
+    if (filter_drive && !drive_dirty &&
+        !drive_filter.should_send(
+            drive_record(), direct_control ? 0.0 : drive_tolerance.get(),
+            std::chrono::milliseconds(drive_keepalive.get()),
+            MRF::DriveFilter::Clock::now()))
+    {
+        drive_suppressed.increment();
+        return;
+    }
     drive_dirty = true;
     dongle_.dirty_drive();
 }
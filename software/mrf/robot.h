@@ -11,6 +11,7 @@
 #include <memory>
 #include "drive/robot.h"
 #include "mrf/constants.h"
+#include "mrf/drive_filter.h"
 #include "util/annunciator.h"
 #include "util/async_operation.h"
 #include "util/noncopyable.h"
@@ -63,6 +64,7 @@ class MRFRobot final : public Drive::Robot
     double params[Drive::LLPrimitive::PARAMS_MAX_SIZE];
     uint8_t extra;
     bool drive_dirty;
+    MRF::DriveFilter drive_filter;
     Glib::Timer request_build_ids_timer;
     unsigned int request_build_ids_counter;
 
@@ -71,6 +73,7 @@ class MRFRobot final : public Drive::Robot
    public:
     ~MRFRobot();  // Public only for std::unique_ptr.
    private:
+    MRF::DriveRecord drive_record() const;
     void encode_drive_packet(void *out);
     void handle_message(
         const void *data, std::size_t len, uint8_t lqi, uint8_t rssi);
@@ -0,0 +1,11 @@
+#include "mrf/transport.h"
+
+constexpr unsigned int MRF::Transport::DRIVE_ENDPOINT;
+constexpr unsigned int MRF::Transport::CAMERA_ENDPOINT;
+constexpr unsigned int MRF::Transport::MESSAGE_ENDPOINT;
+
+MRF::Transport::~Transport() = default;
+
+void MRF::Transport::mark_shutting_down()
+{
+}
@@ -0,0 +1,182 @@
+#ifndef MRF_TRANSPORT_H
+#define MRF_TRANSPORT_H
+
+/**
+ * \file
+ *
+ * \brief Provides the link between an MRFDongle and the radio hardware.
+ */
+
+#include <sigc++/signal.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "util/async_operation.h"
+#include "util/noncopyable.h"
+
+namespace MRF
+{
+/**
+ * \brief A request to the dongle that completes asynchronously.
+ */
+class Transfer : public AsyncOperation<void>
+{
+   public:
+    /**
+     * \brief Starts the transfer.
+     *
+     * The transfer must not already be in progress.
+     */
+    virtual void submit() = 0;
+};
+
+/**
+ * \brief An outbound data transfer that can be reused for multiple packets.
+ */
+class OutTransfer : public Transfer
+{
+   public:
+    /**
+     * \brief Replaces the data to send.
+     *
+     * The transfer must not be in progress.
+     *
+     * \param[in] data the data to send, which is copied before the function
+     * returns
+     *
+     * \param[in] len the number of bytes to send, which must not exceed the
+     * capacity the transfer was created with
+     */
+    virtual void refill(const void *data, std::size_t len) = 0;
+};
+
+/**
+ * \brief A means of exchanging packets with the dongle’s endpoints.
+ *
+ * The endpoints mirror those exposed by the dongle firmware: outbound drive
+ * packets on endpoint 1, camera packets on endpoint 2 and addressed messages
+ * on endpoint 3; inbound message delivery reports, received messages and
+ * status updates are reported through signals.
+ */
+class Transport : public NonCopyable
+{
+   public:
+    /**
+     * \brief The radio parameters to operate with.
+     */
+    struct Config final
+    {
+        /**
+         * \brief The channel number, between 0x0B and 0x1A.
+         */
+        uint8_t channel;
+
+        /**
+         * \brief The symbol rate in kilobaud, either 250 or 625.
+         */
+        int symbol_rate;
+
+        /**
+         * \brief The PAN ID.
+         */
+        uint16_t pan;
+
+        /**
+         * \brief The dongle’s MAC address.
+         */
+        uint64_t mac;
+    };
+
+    /**
+     * \brief The outbound endpoint that carries drive packets.
+     */
+    static constexpr unsigned int DRIVE_ENDPOINT = 1;
+
+    /**
+     * \brief The outbound endpoint that carries camera packets.
+     */
+    static constexpr unsigned int CAMERA_ENDPOINT = 2;
+
+    /**
+     * \brief The outbound endpoint that carries reliable and unreliable
+     * messages.
+     */
+    static constexpr unsigned int MESSAGE_ENDPOINT = 3;
+
+    /**
+     * \brief Emitted when message delivery reports arrive.
+     *
+     * \param[in] data the reports, as pairs of message ID and status code
+     *
+     * \param[in] length the number of bytes in \p data
+     */
+    sigc::signal<void, const uint8_t *, std::size_t> signal_mdrs;
+
+    /**
+     * \brief Emitted when a message from a robot arrives.
+     *
+     * \param[in] data the robot index, followed by the message, followed by
+     * the LQI and RSSI bytes
+     *
+     * \param[in] length the number of bytes in \p data
+     */
+    sigc::signal<void, const uint8_t *, std::size_t> signal_message;
+
+    /**
+     * \brief Emitted when the dongle reports its status.
+     *
+     * \param[in] status the status byte, containing the emergency stop state
+     * and error flags
+     */
+    sigc::signal<void, uint8_t> signal_status;
+
+    /**
+     * \brief Destroys the transport.
+     */
+    virtual ~Transport();
+
+    /**
+     * \brief Configures the radio and begins normal operation.
+     *
+     * Inbound signals are not emitted before this is called.
+     *
+     * \param[in] config the radio parameters
+     */
+    virtual void start(const Config &config) = 0;
+
+    /**
+     * \brief Creates an outbound transfer.
+     *
+     * \param[in] endpoint the endpoint on which to send
+     *
+     * \param[in] data the initial data to send
+     *
+     * \param[in] len the number of bytes in \p data
+     *
+     * \param[in] max_len the largest packet the endpoint accepts, which is
+     * also the capacity available to OutTransfer::refill
+     *
+     * \return the transfer, which has not yet been submitted
+     */
+    virtual std::unique_ptr<OutTransfer> create_out_transfer(
+        unsigned int endpoint, const void *data, std::size_t len,
+        std::size_t max_len) = 0;
+
+    /**
+     * \brief Creates a transfer that makes the dongle beep.
+     *
+     * \param[in] length the length of the beep, in milliseconds
+     *
+     * \return the transfer, which has not yet been submitted
+     */
+    virtual std::unique_ptr<Transfer> create_beep_transfer(uint16_t length) = 0;
+
+    /**
+     * \brief Marks the transport as shutting down, so that transfers
+     * cancelled by destruction do not issue warnings.
+     */
+    virtual void mark_shutting_down();
+};
+}
+
+#endif
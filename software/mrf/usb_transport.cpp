@@ -0,0 +1,261 @@
+#include "mrf/usb_transport.h"
+#include <sigc++/bind.h>
+#include <sigc++/functors/mem_fun.h>
+#include <sigc++/reference_wrapper.h>
+#include <sigc++/trackable.h>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+#include "mrf/constants.h"
+
+namespace
+{
+/**
+ * \brief An outbound bulk transfer to the dongle.
+ */
+class USBOutTransfer final : public MRF::OutTransfer, public sigc::trackable
+{
+   public:
+    explicit USBOutTransfer(
+        USB::DeviceHandle &device, unsigned int endpoint, const void *data,
+        std::size_t len, std::size_t max_len)
+        : transfer(
+              device, static_cast<unsigned char>(endpoint), data, len, max_len,
+              0)
+    {
+        transfer.signal_done.connect(
+            sigc::mem_fun(this, &USBOutTransfer::on_done));
+    }
+
+    void result() const override
+    {
+        transfer.result();
+    }
+
+    void submit() override
+    {
+        transfer.submit();
+    }
+
+    void refill(const void *data, std::size_t len) override
+    {
+        transfer.refill(data, len);
+    }
+
+   private:
+    USB::BulkOutTransfer transfer;
+
+    void on_done(AsyncOperation<void> &)
+    {
+        signal_done.emit(*this);
+    }
+};
+
+/**
+ * \brief A control transfer that makes the dongle beep.
+ */
+class USBBeepTransfer final : public MRF::Transfer, public sigc::trackable
+{
+   public:
+    explicit USBBeepTransfer(
+        USB::DeviceHandle &device, int radio_interface, uint16_t length)
+        : transfer(
+              device, LIBUSB_REQUEST_TYPE_VENDOR | LIBUSB_RECIPIENT_INTERFACE,
+              MRF::CONTROL_REQUEST_BEEP, length,
+              static_cast<uint16_t>(radio_interface), 0)
+    {
+        transfer.signal_done.connect(
+            sigc::mem_fun(this, &USBBeepTransfer::on_done));
+    }
+
+    void result() const override
+    {
+        transfer.result();
+    }
+
+    void submit() override
+    {
+        transfer.submit();
+    }
+
+   private:
+    USB::ControlNoDataTransfer transfer;
+
+    void on_done(AsyncOperation<void> &)
+    {
+        signal_done.emit(*this);
+    }
+};
+}
+
+MRF::USBTransport::USBTransport(int priority)
+    : context(priority),
+      device(
+          context, MRF::VENDOR_ID, MRF::PRODUCT_ID, std::getenv("MRF_SERIAL")),
+      radio_interface(-1),
+      configuration_altsetting(-1),
+      normal_altsetting(-1),
+      status_transfer(device, 3, 1, true, 0)
+{
+    // Sanity-check the dongle by looking for an interface with the appropriate
+    // subclass and alternate settings with the appropriate protocols.
+    // While doing so, discover which interface number is used for the radio and
+    // which alternate settings are for configuration-setting and normal
+    // operation.
+    {
+        const libusb_config_descriptor &desc =
+            device.configuration_descriptor_by_value(1);
+        for (int i = 0; i < desc.bNumInterfaces; ++i)
+        {
+            const libusb_interface &intf = desc.interface[i];
+            if (intf.num_altsetting &&
+                intf.altsetting[0].bInterfaceClass == 0xFF &&
+                intf.altsetting[1].bInterfaceSubClass == MRF::SUBCLASS)
+            {
+                radio_interface = i;
+                for (int j = 0; j < intf.num_altsetting; ++j)
+                {
+                    const libusb_interface_descriptor &as = intf.altsetting[j];
+                    if (as.bInterfaceClass == 0xFF &&
+                        as.bInterfaceSubClass == MRF::SUBCLASS)
+                    {
+                        if (as.bInterfaceProtocol == MRF::PROTOCOL_OFF)
+                        {
+                            configuration_altsetting = j;
+                        }
+                        else if (as.bInterfaceProtocol == MRF::PROTOCOL_NORMAL)
+                        {
+                            normal_altsetting = j;
+                        }
+                    }
+                }
+                break;
+            }
+        }
+        if (radio_interface < 0 || configuration_altsetting < 0 ||
+            normal_altsetting < 0)
+        {
+            throw std::runtime_error(
+                "Wrong USB descriptors (is your dongle firmware or your "
+                "software out of date or mismatched across branches?).");
+        }
+    }
+
+    // Move the dongle into configuration 1 (it will nearly always already be
+    // there).
+    if (device.get_configuration() != 1)
+    {
+        device.set_configuration(1);
+    }
+
+    // Claim the radio interface.
+    interface_claimer.reset(new USB::InterfaceClaimer(device, radio_interface));
+}
+
+MRF::USBTransport::~USBTransport() = default;
+
+void MRF::USBTransport::start(const Config &config)
+{
+    // Switch to configuration mode and configure the radio parameters.
+    device.set_interface_alt_setting(radio_interface, configuration_altsetting);
+    device.control_no_data(
+        LIBUSB_REQUEST_TYPE_VENDOR | LIBUSB_RECIPIENT_INTERFACE,
+        MRF::CONTROL_REQUEST_SET_CHANNEL, config.channel,
+        static_cast<uint16_t>(radio_interface), 0);
+    device.control_no_data(
+        LIBUSB_REQUEST_TYPE_VENDOR | LIBUSB_RECIPIENT_INTERFACE,
+        MRF::CONTROL_REQUEST_SET_SYMBOL_RATE, config.symbol_rate == 625 ? 1 : 0,
+        static_cast<uint16_t>(radio_interface), 0);
+    device.control_no_data(
+        LIBUSB_REQUEST_TYPE_VENDOR | LIBUSB_RECIPIENT_INTERFACE,
+        MRF::CONTROL_REQUEST_SET_PAN_ID, config.pan,
+        static_cast<uint16_t>(radio_interface), 0);
+    device.control_out(
+        LIBUSB_REQUEST_TYPE_VENDOR | LIBUSB_RECIPIENT_INTERFACE,
+        MRF::CONTROL_REQUEST_SET_MAC_ADDRESS, 0,
+        static_cast<uint16_t>(radio_interface), &config.mac, sizeof(config.mac),
+        0);
+
+    {
+        std::chrono::system_clock::time_point now =
+            std::chrono::system_clock::now();
+        std::chrono::system_clock::time_point epoch =
+            std::chrono::system_clock::from_time_t(0);
+        std::chrono::system_clock::duration diff = now - epoch;
+        std::chrono::microseconds micros =
+            std::chrono::duration_cast<std::chrono::microseconds>(diff);
+        uint64_t stamp = static_cast<uint64_t>(micros.count());
+        device.control_out(
+            LIBUSB_REQUEST_TYPE_VENDOR | LIBUSB_RECIPIENT_DEVICE,
+            MRF::CONTROL_REQUEST_SET_TIME, 0, 0, &stamp, sizeof(stamp), 0);
+    }
+
+    // Switch to normal mode.
+    device.set_interface_alt_setting(radio_interface, normal_altsetting);
+
+    // Submit the message delivery report transfers.
+    for (auto &i : mdr_transfers)
+    {
+        i.reset(new USB::BulkInTransfer(device, 1, 8, false, 0));
+        i->signal_done.connect(sigc::mem_fun(this, &USBTransport::handle_mdrs));
+        i->submit();
+    }
+
+    // Submit the received message transfers.
+    for (auto &i : message_transfers)
+    {
+        i.reset(new USB::BulkInTransfer(device, 2, 105, false, 0));
+        i->signal_done.connect(sigc::bind(
+            sigc::mem_fun(this, &USBTransport::handle_message),
+            sigc::ref(*i.get())));
+        i->submit();
+    }
+
+    // Submit the estop transfer.
+    status_transfer.signal_done.connect(
+        sigc::mem_fun(this, &USBTransport::handle_status));
+    status_transfer.submit();
+}
+
+std::unique_ptr<MRF::OutTransfer> MRF::USBTransport::create_out_transfer(
+    unsigned int endpoint, const void *data, std::size_t len,
+    std::size_t max_len)
+{
+    return std::unique_ptr<OutTransfer>(
+        new USBOutTransfer(device, endpoint, data, len, max_len));
+}
+
+std::unique_ptr<MRF::Transfer> MRF::USBTransport::create_beep_transfer(
+    uint16_t length)
+{
+    return std::unique_ptr<Transfer>(
+        new USBBeepTransfer(device, radio_interface, length));
+}
+
+void MRF::USBTransport::mark_shutting_down()
+{
+    device.mark_shutting_down();
+}
+
+void MRF::USBTransport::handle_mdrs(AsyncOperation<void> &op)
+{
+    USB::BulkInTransfer &mdr_transfer = dynamic_cast<USB::BulkInTransfer &>(op);
+    mdr_transfer.result();
+    signal_mdrs.emit(mdr_transfer.data(), mdr_transfer.size());
+    mdr_transfer.submit();
+}
+
+void MRF::USBTransport::handle_message(
+    AsyncOperation<void> &, USB::BulkInTransfer &transfer)
+{
+    transfer.result();
+    signal_message.emit(transfer.data(), transfer.size());
+    transfer.submit();
+}
+
+void MRF::USBTransport::handle_status(AsyncOperation<void> &)
+{
+    status_transfer.result();
+    signal_status.emit(status_transfer.data()[0]);
+    status_transfer.submit();
+}
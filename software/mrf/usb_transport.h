@@ -0,0 +1,55 @@
+#ifndef MRF_USB_TRANSPORT_H
+#define MRF_USB_TRANSPORT_H
+
+#include <array>
+#include <memory>
+#include "mrf/transport.h"
+#include "util/libusb.h"
+
+namespace MRF
+{
+/**
+ * \brief A transport that talks to a physical dongle over USB.
+ */
+class USBTransport final : public Transport
+{
+   public:
+    /**
+     * \brief Opens the dongle and claims its radio interface.
+     *
+     * The dongle is selected by the \c MRF_SERIAL environment variable if it
+     * is set.
+     *
+     * \param[in] priority the main loop priority at which to handle USB
+     * events
+     */
+    explicit USBTransport(int priority);
+
+    /**
+     * \brief Closes the dongle.
+     */
+    ~USBTransport();
+
+    void start(const Config &config) override;
+    std::unique_ptr<OutTransfer> create_out_transfer(
+        unsigned int endpoint, const void *data, std::size_t len,
+        std::size_t max_len) override;
+    std::unique_ptr<Transfer> create_beep_transfer(uint16_t length) override;
+    void mark_shutting_down() override;
+
+   private:
+    USB::Context context;
+    USB::DeviceHandle device;
+    int radio_interface, configuration_altsetting, normal_altsetting;
+    std::unique_ptr<USB::InterfaceClaimer> interface_claimer;
+    std::array<std::unique_ptr<USB::BulkInTransfer>, 32> mdr_transfers;
+    std::array<std::unique_ptr<USB::BulkInTransfer>, 32> message_transfers;
+    USB::InterruptInTransfer status_transfer;
+
+    void handle_mdrs(AsyncOperation<void> &);
+    void handle_message(AsyncOperation<void> &, USB::BulkInTransfer &transfer);
+    void handle_status(AsyncOperation<void> &);
+};
+}
+
+#endif
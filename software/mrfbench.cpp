@@ -0,0 +1,273 @@
+#include <glibmm/main.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <locale>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "drive/primitive.h"
+#include "geom/angle.h"
+#include "geom/point.h"
+#include "main.h"
+#include "mrf/dongle.h"
+#include "mrf/loopback_transport.h"
+#include "util/config.h"
+#include "util/exception.h"
+#include "util/histogram.h"
+#include "util/main_loop.h"
+#include "util/timestep.h"
+
+namespace
+{
+typedef MRF::LoopbackTransport::Timestamp Timestamp;
+
+/**
+ * \brief Drives an MRFDongle attached to a loopback transport the way the AI
+ * does and measures how the radio stack copes.
+ */
+class Benchmark final : public sigc::trackable
+{
+   public:
+    explicit Benchmark(
+        MRFDongle &dongle, MRF::LoopbackTransport &transport,
+        unsigned int seconds)
+        : dongle(dongle),
+          transport(transport),
+          ticks_remaining(seconds * TIMESTEPS_PER_SECOND),
+          tick_count(0),
+          messages_ok(0),
+          messages_failed(0)
+    {
+        transport.signal_robot_drive.connect(
+            sigc::mem_fun(this, &Benchmark::on_robot_drive));
+        tick_connection = Glib::signal_timeout().connect(
+            sigc::mem_fun(this, &Benchmark::tick), 1000 / TIMESTEPS_PER_SECOND,
+            Glib::PRIORITY_HIGH);
+    }
+
+    ~Benchmark()
+    {
+        tick_connection.disconnect();
+    }
+
+    void report(
+        std::ostream &os, std::chrono::microseconds wall,
+        std::chrono::microseconds cpu) const
+    {
+        const MRF::LoopbackTransport::Statistics &stats =
+            transport.statistics();
+        os << "Ticks:                " << tick_count << '\n';
+        print_histogram(os, "Dirty to USB done:    ", dongle.drive_latency());
+        print_histogram(os, "Tick to robot:        ", end_to_end);
+        os << "Drive packets:        " << stats.drive_packets << " ("
+           << stats.drive_records_delivered << " records delivered, "
+           << stats.drive_records_lost << " lost)\n";
+        os << "Camera packets:       " << stats.camera_packets << '\n';
+        unsigned int messages = messages_ok + messages_failed;
+        os << "Reliable messages:    " << messages_ok << '/' << messages
+           << " delivered";
+        if (messages)
+        {
+            os << " (" << std::fixed << std::setprecision(1)
+               << 100.0 * messages_ok / messages << "%)";
+        }
+        os << '\n';
+        os << "Feedback messages:    " << stats.feedback_sent << " ("
+           << stats.feedback_lost << " lost)\n";
+        os << "CPU time:             " << cpu.count() / 1000 << " ms of "
+           << wall.count() / 1000 << " ms (" << std::fixed
+           << std::setprecision(2)
+           << 100.0 * static_cast<double>(cpu.count()) /
+                  static_cast<double>(wall.count())
+           << "%)\n";
+    }
+
+   private:
+    MRFDongle &dongle;
+    MRF::LoopbackTransport &transport;
+    unsigned int ticks_remaining, tick_count;
+    unsigned int messages_ok, messages_failed;
+    sigc::connection tick_connection;
+    std::deque<Timestamp> tick_ends;
+    LatencyHistogram end_to_end;
+    std::list<std::unique_ptr<MRFDongle::SendReliableMessageOperation>>
+        messages;
+
+    static void print_histogram(
+        std::ostream &os, const char *label, const LatencyHistogram &hist)
+    {
+        os << label << "p50 " << hist.percentile(0.50).count() << " µs, p95 "
+           << hist.percentile(0.95).count() << " µs, p99 "
+           << hist.percentile(0.99).count() << " µs, max " << hist.max().count()
+           << " µs (n=" << hist.count() << ")\n";
+    }
+
+    bool tick()
+    {
+        if (!ticks_remaining)
+        {
+            if (messages.empty())
+            {
+                MainLoop::quit();
+                return false;
+            }
+            // Wait for outstanding messages before finishing.
+            return true;
+        }
+        --ticks_remaining;
+        ++tick_count;
+
+        // Send a camera packet and a fresh primitive to every robot, as the AI
+        // would after receiving a vision frame.
+        double phase = static_cast<double>(tick_count) / TIMESTEPS_PER_SECOND;
+        std::vector<std::tuple<uint8_t, Point, Angle>> detbots;
+        for (unsigned int i = 0; i != 8; ++i)
+        {
+            Point pos(std::cos(phase + i), std::sin(phase + i));
+            detbots.emplace_back(
+                static_cast<uint8_t>(i), pos, Angle::of_radians(phase));
+            dongle.robot(i).send_prim(Drive::LLPrimitive(
+                Drive::Primitive::MOVE, {pos.x, pos.y, phase, 0.0}, 1));
+        }
+        dongle.send_camera_packet(
+            detbots, Point(),
+            static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::system_clock::now().time_since_epoch())
+                    .count()));
+
+        // Once per second, send each robot a reliable message.
+        if (tick_count % TIMESTEPS_PER_SECOND == 0)
+        {
+            for (unsigned int i = 0; i != 8; ++i)
+            {
+                static const uint8_t PAYLOAD[] = {0x00};
+                auto iter                      = messages.emplace(
+                    messages.end(),
+                    new MRFDongle::SendReliableMessageOperation(
+                        dongle, i, 20, PAYLOAD, sizeof(PAYLOAD)));
+                (*iter)->signal_done.connect(sigc::bind(
+                    sigc::mem_fun(this, &Benchmark::on_message_done), iter));
+            }
+        }
+
+        tick_ends.push_back(std::chrono::steady_clock::now());
+        dongle.flush_drive();
+        return true;
+    }
+
+    void on_robot_drive(unsigned int, const uint8_t *, Timestamp submitted)
+    {
+        // Attribute the record to the last tick that ended before the packet
+        // carrying it was submitted.
+        while (tick_ends.size() > 1 && tick_ends[1] <= submitted)
+        {
+            tick_ends.pop_front();
+        }
+        if (!tick_ends.empty() && tick_ends.front() <= submitted)
+        {
+            end_to_end.record(
+                std::chrono::duration_cast<LatencyHistogram::Duration>(
+                    std::chrono::steady_clock::now() - tick_ends.front()));
+        }
+    }
+
+    void on_message_done(
+        AsyncOperation<void> &op,
+        std::list<std::unique_ptr<MRFDongle::SendReliableMessageOperation>>::
+            iterator iter)
+    {
+        try
+        {
+            op.result();
+            ++messages_ok;
+        }
+        catch (const std::runtime_error &)
+        {
+            ++messages_failed;
+        }
+        messages.erase(iter);
+    }
+};
+
+std::chrono::microseconds cpu_time()
+{
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) < 0)
+    {
+        throw SystemError("getrusage", errno);
+    }
+    return std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           std::chrono::microseconds(
+               usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+}
+
+int app_main(int argc, char **argv)
+{
+    // Set the current locale from environment variables.
+    std::locale::global(std::locale(""));
+
+    // Parse command-line arguments.
+    if (argc < 1 || argc > 4)
+    {
+        std::cerr << "Usage:\n";
+        std::cerr << argv[0] << " [<seconds> [<loss> [<radio-delay>]]]\n";
+        std::cerr << '\n';
+        std::cerr << "  <seconds> is how long to run for (default 10)\n";
+        std::cerr << "  <loss> is the probability of losing each radio frame, "
+                     "from 0 to 1 (default 0)\n";
+        std::cerr << "  <radio-delay> is the time to send one radio frame, in "
+                     "microseconds (default 1000)\n";
+        return 1;
+    }
+    MRF::LoopbackTransport::Parameters params;
+    unsigned int seconds = 10;
+    if (argc >= 2)
+    {
+        seconds = static_cast<unsigned int>(std::stoul(argv[1]));
+    }
+    if (argc >= 3)
+    {
+        params.loss = std::stod(argv[2]);
+        if (!(params.loss >= 0.0 && params.loss <= 1.0))
+        {
+            std::cerr << "Invalid loss; must be between 0 and 1\n";
+            return 1;
+        }
+    }
+    if (argc >= 4)
+    {
+        params.radio_delay = std::chrono::microseconds(std::stoul(argv[3]));
+    }
+
+    // Load the configuration file.
+    Config::load();
+
+    // Attach a dongle to an emulated radio link.
+    MRF::LoopbackTransport *transport = new MRF::LoopbackTransport(params);
+    MRFDongle dongle{std::unique_ptr<MRF::Transport>(transport)};
+
+    // Run the benchmark.
+    std::cout << "Running for " << seconds << " s at " << TIMESTEPS_PER_SECOND
+              << " ticks per second…\n";
+    Benchmark bench(dongle, *transport, seconds);
+    std::chrono::microseconds cpu_start = cpu_time();
+    Timestamp wall_start                = std::chrono::steady_clock::now();
+    MainLoop::run();
+    std::chrono::microseconds wall =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - wall_start);
+    bench.report(std::cout, wall, cpu_time() - cpu_start);
+
+    return 0;
+}
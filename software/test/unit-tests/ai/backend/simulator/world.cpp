@@ -0,0 +1,148 @@
+#include "ai/backend/simulator/world.h"
+#include <gtest/gtest.h>
+
+using AI::BE::Simulator::World;
+
+namespace
+{
+const AI::BE::Simulator::FieldGeometry GEOMETRY = {9.0, 6.0, 0.3, 1.0, 0.18};
+
+TEST(SimulatorWorldTest, ball_rolls_to_rest)
+{
+    World world(GEOMETRY);
+    world.place_ball(Point(-3.0, 0.0));
+    world.ball.velocity = Point(2.0, 0.0);
+    EXPECT_EQ(0, world.step(5.0));
+    // Constant deceleration of 0.5 m/s² stops the ball after v²/2a = 4 m.
+    EXPECT_NEAR(1.0, world.ball.position.x, 0.01);
+    EXPECT_EQ(0.0, world.ball.velocity.len());
+}
+
+TEST(SimulatorWorldTest, robot_acceleration_is_limited)
+{
+    World world(GEOMETRY);
+    std::size_t i = world.add_robot(Point(-2.0, 1.0), Angle::zero());
+    world.robots[i].command.velocity = Point(2.0, 0.0);
+    world.step(0.5);
+    EXPECT_NEAR(1.5, world.robots[i].velocity.x, 1e-6);
+    EXPECT_NEAR(-2.0 + 0.375, world.robots[i].position.x, 0.01);
+    world.step(1.0);
+    EXPECT_NEAR(2.0, world.robots[i].velocity.x, 1e-6);
+}
+
+TEST(SimulatorWorldTest, dribbler_carries_ball)
+{
+    World world(GEOMETRY);
+    std::size_t i = world.add_robot(Point(0.0, 0.0), Angle::zero());
+    world.place_ball(Point(0.5, 0.0));
+    world.robots[i].command.velocity = Point(1.0, 0.0);
+    world.robots[i].command.dribble  = true;
+    world.step(1.0);
+    ASSERT_TRUE(world.has_ball(i));
+    world.robots[i].command.velocity = Point(0.0, 1.0);
+    world.step(1.0);
+    EXPECT_TRUE(world.has_ball(i));
+    Point offset = world.ball.position - world.robots[i].position;
+    EXPECT_NEAR(
+        AI::BE::Simulator::ROBOT_CENTRE_TO_FRONT +
+            AI::BE::Simulator::BALL_RADIUS,
+        offset.x, 1e-3);
+    EXPECT_NEAR(0.0, offset.y, 0.01);
+}
+
+TEST(SimulatorWorldTest, kick_and_chip)
+{
+    World world(GEOMETRY);
+    std::size_t i = world.add_robot(Point(0.0, 0.0), Angle::quarter());
+    world.place_ball(Point(0.0, 0.1));
+    world.robots[i].command.kick_speed = 4.0;
+    world.step(0.01);
+    EXPECT_TRUE(world.robots[i].kicked);
+    EXPECT_NEAR(4.0, world.ball.velocity.y, 0.01);
+
+    // The kicker must recharge before it fires again.
+    world.place_ball(world.robots[i].position + Point(0.0, 0.1));
+    world.step(0.01);
+    EXPECT_FALSE(world.robots[i].kicked);
+    world.robots[i].command.kick_speed = 0.0;
+    world.step(2.0);
+    world.place_ball(world.robots[i].position + Point(0.0, 0.1));
+    world.robots[i].command.kick_speed = 4.0;
+    world.robots[i].command.chip       = true;
+    world.step(0.01);
+    EXPECT_TRUE(world.robots[i].kicked);
+    EXPECT_GT(world.ball.height, 0.0);
+    EXPECT_GT(world.ball.vertical_velocity, 2.0);
+}
+
+TEST(SimulatorWorldTest, goal_scored)
+{
+    World world(GEOMETRY);
+    world.place_ball(Point(4.0, 0.2));
+    world.ball.velocity = Point(3.0, 0.0);
+    EXPECT_EQ(1, world.step(1.0));
+    world.place_ball(Point(-4.0, 0.8));
+    world.ball.velocity = Point(-3.0, 0.0);
+    EXPECT_EQ(0, world.step(1.0));
+}
+
+TEST(SimulatorWorldTest, ball_behind_goal_is_not_a_goal)
+{
+    // Between the back of the goal and the boundary wall, the ball rolls
+    // across the goal’s width without scoring.
+    World world(GEOMETRY);
+    world.place_ball(Point(4.75, -1.0));
+    world.ball.velocity = Point(0.0, 2.0);
+    EXPECT_EQ(0, world.step(1.5));
+    EXPECT_GT(world.ball.position.y, 0.5);
+    EXPECT_NEAR(4.75, world.ball.position.x, 1e-9);
+
+    // Rolling towards the field from there, it bounces off the back wall.
+    world.place_ball(Point(4.76, 0.0));
+    world.ball.velocity = Point(-1.0, 0.0);
+    EXPECT_EQ(0, world.step(0.1));
+    EXPECT_GT(world.ball.position.x, 4.7);
+    EXPECT_GT(world.ball.velocity.x, 0.0);
+}
+
+TEST(SimulatorWorldTest, ball_bounces_off_post)
+{
+    World world(GEOMETRY);
+    world.place_ball(Point(4.0, 0.51));
+    world.ball.velocity = Point(3.0, 0.0);
+    EXPECT_EQ(0, world.step(0.5));
+    EXPECT_LT(world.ball.position.x, 4.5);
+    EXPECT_LT(world.ball.velocity.x, 0.0);
+}
+
+TEST(SimulatorWorldTest, deterministic)
+{
+    World a(GEOMETRY), b(GEOMETRY);
+    for (World *w : {&a, &b})
+    {
+        for (int j = 0; j < 6; ++j)
+        {
+            std::size_t i = w->add_robot(
+                Point(-1.0 + 0.3 * j, 0.05 * j), Angle::of_degrees(30.0 * j));
+            w->robots[i].command.velocity = Point(0.5 - 0.2 * j, 1.0 - 0.3 * j);
+            w->robots[i].command.avelocity = Angle::of_radians(j - 3.0);
+            w->robots[i].command.dribble   = j % 2;
+        }
+        w->ball.velocity = Point(-1.5, 0.7);
+    }
+    for (int t = 0; t < 300; ++t)
+    {
+        a.step(1.0 / 30.0);
+        b.step(1.0 / 30.0);
+    }
+    EXPECT_EQ(a.ball.position.x, b.ball.position.x);
+    EXPECT_EQ(a.ball.position.y, b.ball.position.y);
+    for (std::size_t i = 0; i < a.robots.size(); ++i)
+    {
+        EXPECT_EQ(a.robots[i].position.x, b.robots[i].position.x);
+        EXPECT_EQ(
+            a.robots[i].orientation.to_radians(),
+            b.robots[i].orientation.to_radians());
+    }
+}
+}
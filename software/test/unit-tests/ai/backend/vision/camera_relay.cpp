@@ -0,0 +1,133 @@
+#include "ai/backend/vision/camera_relay.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using AI::BE::Vision::CameraRelay;
+
+namespace
+{
+typedef std::vector<std::tuple<uint8_t, Point, Angle>> Selection;
+
+TEST(CameraRelayTest, rejects_bad_parameters)
+{
+    EXPECT_THROW(CameraRelay(0.0), std::invalid_argument);
+    EXPECT_THROW(CameraRelay(-60.0), std::invalid_argument);
+    EXPECT_THROW(
+        CameraRelay(60.0, 1.0 / 60.0, 0.25, 0.0), std::invalid_argument);
+}
+
+TEST(CameraRelayTest, keeps_freshest_detection)
+{
+    CameraRelay relay;
+    relay.observe(2, 1.0, Point(1.0, 0.0), Angle::zero());
+    // An older frame from another camera arrives late and is ignored.
+    relay.observe(2, 0.9, Point(5.0, 5.0), Angle::half());
+    Selection robots = relay.select(1.0);
+    ASSERT_EQ(1U, robots.size());
+    EXPECT_EQ(2U, std::get<0>(robots[0]));
+    EXPECT_EQ(Point(1.0, 0.0), std::get<1>(robots[0]));
+    EXPECT_EQ(0.0, relay.speed(2));
+}
+
+TEST(CameraRelayTest, speed_estimate)
+{
+    CameraRelay relay;
+    relay.observe(0, 0.0, Point(0.0, 0.0), Angle::zero());
+    relay.observe(0, 0.1, Point(0.1, 0.0), Angle::zero());
+    EXPECT_NEAR(0.5, relay.speed(0), 1e-9);
+
+    // A frame from an overlapping camera too soon after the last one moves
+    // the robot but does not touch the speed.
+    relay.observe(0, 0.102, Point(0.2, 0.0), Angle::zero());
+    EXPECT_NEAR(0.5, relay.speed(0), 1e-9);
+    Selection robots = relay.select(0.2);
+    ASSERT_EQ(1U, robots.size());
+    EXPECT_EQ(Point(0.2, 0.0), std::get<1>(robots[0]));
+}
+
+/**
+ * \brief Finds how long after being sent a robot is next due, by relaying it
+ * once at \p t and then polling in steps of a millisecond.
+ */
+double resend_interval(CameraRelay &relay, unsigned int index, double t)
+{
+    Selection robots = relay.select(t);
+    EXPECT_EQ(1U, robots.size());
+    relay.mark_sent(robots, robots.size(), t);
+    // Too soon after the last frame to change the speed estimate.
+    relay.observe(index, t + 0.001, Point(), Angle::zero());
+    for (int i = 1; i != 1000; ++i)
+    {
+        if (!relay.select(t + i * 0.001).empty())
+        {
+            return i * 0.001;
+        }
+    }
+    return 1.0;
+}
+
+TEST(CameraRelayTest, interval_shrinks_with_speed)
+{
+    // Stationary: max_interval.
+    CameraRelay stationary(1000.0, 0.02, 0.2, 1.0);
+    stationary.observe(1, 0.0, Point(), Angle::zero());
+    EXPECT_NEAR(0.2, resend_interval(stationary, 1, 0.0), 0.0015);
+
+    // Half of fast_speed: halfway between the intervals.
+    CameraRelay medium(1000.0, 0.02, 0.2, 1.0);
+    medium.observe(3, 0.0, Point(), Angle::zero());
+    medium.observe(3, 0.1, Point(0.1, 0.0), Angle::zero());
+    ASSERT_NEAR(0.5, medium.speed(3), 1e-9);
+    EXPECT_NEAR(0.11, resend_interval(medium, 3, 0.1), 0.0015);
+
+    // At or above fast_speed: min_interval.
+    CameraRelay fast(1000.0, 0.02, 0.2, 1.0);
+    fast.observe(5, 0.0, Point(), Angle::zero());
+    fast.observe(5, 0.1, Point(0.4, 0.0), Angle::zero());
+    ASSERT_GE(fast.speed(5), 1.0);
+    EXPECT_NEAR(0.02, resend_interval(fast, 5, 0.1), 0.0015);
+}
+
+TEST(CameraRelayTest, packet_rate_is_capped)
+{
+    CameraRelay relay(10.0, 0.001, 0.001, 1.0);
+    relay.observe(0, 0.0, Point(), Angle::zero());
+    Selection robots = relay.select(0.0);
+    ASSERT_EQ(1U, robots.size());
+    relay.mark_sent(robots, 1, 0.0);
+
+    // The robot is due again, but a packet went out too recently.
+    relay.observe(0, 0.05, Point(), Angle::zero());
+    EXPECT_TRUE(relay.select(0.05).empty());
+    EXPECT_EQ(1U, relay.select(0.1).size());
+
+    // A packet that could not be sent does not count against the rate.
+    relay.mark_sent(relay.select(0.1), 0, 0.1);
+    EXPECT_EQ(1U, relay.select(0.15).size());
+}
+
+TEST(CameraRelayTest, most_overdue_first_and_partial_send)
+{
+    CameraRelay relay(1000.0, 0.25, 0.25, 1.0);
+    relay.observe(3, 0.0, Point(), Angle::zero());
+    relay.mark_sent(relay.select(0.0), 1, 0.0);
+    relay.observe(5, 0.1, Point(), Angle::zero());
+    relay.mark_sent(relay.select(0.1), 1, 0.1);
+    relay.observe(6, 0.3, Point(), Angle::zero());
+    relay.observe(3, 0.4, Point(), Angle::zero());
+    relay.observe(5, 0.4, Point(), Angle::zero());
+
+    // Robot 6 has never been sent, then robot 3 was sent longest ago.
+    Selection robots = relay.select(0.5);
+    ASSERT_EQ(3U, robots.size());
+    EXPECT_EQ(6U, std::get<0>(robots[0]));
+    EXPECT_EQ(3U, std::get<0>(robots[1]));
+    EXPECT_EQ(5U, std::get<0>(robots[2]));
+
+    // Only the robots that fitted in the packet are cleared.
+    relay.mark_sent(robots, 2, 0.5);
+    robots = relay.select(0.51);
+    ASSERT_EQ(1U, robots.size());
+    EXPECT_EQ(5U, std::get<0>(robots[0]));
+}
+}
@@ -0,0 +1,99 @@
+#include "ai/common/clearance_field.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+
+using AI::Common::ClearanceField;
+using AI::Common::TeamSnapshot;
+
+namespace
+{
+constexpr double RESOLUTION = 0.05;
+
+TeamSnapshot random_team(std::mt19937 &rng, std::size_t size)
+{
+    std::uniform_real_distribution<double> x(-5.0, 5.0), y(-3.5, 3.5);
+    TeamSnapshot team;
+    team.size = size;
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        team.patterns[i]  = static_cast<unsigned int>(i);
+        team.positions[i] = Point(x(rng), y(rng));
+    }
+    return team;
+}
+
+TEST(ClearanceFieldTest, empty_team)
+{
+    ClearanceField field;
+    field.build(TeamSnapshot(), Point(-5, -3.5), Point(5, 3.5), RESOLUTION);
+    EXPECT_TRUE(std::isinf(field.distance(Point(1.0, 1.0))));
+    EXPECT_EQ(0U, field.nearest(Point(1.0, 1.0)));
+}
+
+TEST(ClearanceFieldTest, exact_at_robots_and_outside)
+{
+    TeamSnapshot team;
+    team.size         = 2;
+    team.positions[0] = Point(1.0, 1.0);
+    team.positions[1] = Point(-2.0, 0.5);
+    ClearanceField field;
+    field.build(team, Point(-5, -3.5), Point(5, 3.5), RESOLUTION);
+    EXPECT_NEAR(0.0, field.distance(Point(1.0, 1.0)), RESOLUTION);
+    EXPECT_EQ(0U, field.nearest(Point(1.0, 1.0)));
+    EXPECT_EQ(1U, field.nearest(Point(-2.0, 0.5)));
+    EXPECT_DOUBLE_EQ(5.0, field.distance(Point(1.0, 6.0)));
+    EXPECT_EQ(0U, field.nearest(Point(1.0, 6.0)));
+}
+
+TEST(ClearanceFieldTest, robots_level_with_each_other)
+{
+    TeamSnapshot team;
+    team.size         = 3;
+    team.positions[0] = Point(-1.0, 0.0);
+    team.positions[1] = Point(1.0, 0.0);
+    team.positions[2] = Point(3.0, 0.0);
+    ClearanceField field;
+    field.build(team, Point(-5, -3.5), Point(5, 3.5), RESOLUTION);
+    EXPECT_EQ(0U, field.nearest(Point(-1.2, 2.0)));
+    EXPECT_EQ(1U, field.nearest(Point(0.8, -2.0)));
+    EXPECT_EQ(2U, field.nearest(Point(4.0, 1.0)));
+    EXPECT_NEAR(2.0, field.distance(Point(1.0, 2.0)), RESOLUTION);
+}
+
+TEST(ClearanceFieldTest, matches_brute_force)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> x(-5.0, 5.0), y(-3.5, 3.5);
+    for (std::size_t size = 1; size <= TeamSnapshot::CAPACITY; ++size)
+    {
+        TeamSnapshot team = random_team(rng, size);
+        ClearanceField field;
+        field.build(team, Point(-5, -3.5), Point(5, 3.5), RESOLUTION);
+        for (unsigned int i = 0; i != 200; ++i)
+        {
+            Point p(x(rng), y(rng));
+            std::size_t best = team.nearest(p);
+            double exact     = (team.positions[best] - p).len();
+            EXPECT_NEAR(exact, field.distance(p), RESOLUTION * M_SQRT1_2);
+
+            // The nearest robot may only differ where two are almost tied.
+            std::size_t found = field.nearest(p);
+            ASSERT_LT(found, size);
+            EXPECT_LE(
+                (team.positions[found] - p).len(), exact + RESOLUTION * 2);
+        }
+
+        // At the grid nodes the distance is exact.
+        for (unsigned int i = 0; i <= 200; i += 7)
+        {
+            for (unsigned int j = 0; j <= 140; j += 7)
+            {
+                Point p(-5.0 + i * RESOLUTION, -3.5 + j * RESOLUTION);
+                double exact = (team.positions[team.nearest(p)] - p).len();
+                EXPECT_NEAR(exact, field.distance(p), 1e-9);
+            }
+        }
+    }
+}
+}
@@ -0,0 +1,52 @@
+#include "ai/common/world_snapshot.h"
+#include <gtest/gtest.h>
+
+using AI::Common::TeamSnapshot;
+
+namespace
+{
+TeamSnapshot make_team()
+{
+    TeamSnapshot team;
+    team.size         = 3;
+    team.patterns[0]  = 4;
+    team.positions[0] = Point(1.0, 1.0);
+    team.patterns[1]  = 9;
+    team.positions[1] = Point(-2.0, 0.5);
+    team.patterns[2]  = 0;
+    team.positions[2] = Point(0.0, -3.0);
+    return team;
+}
+
+TEST(TeamSnapshotTest, empty_team)
+{
+    TeamSnapshot team;
+    EXPECT_EQ(0U, team.size);
+    EXPECT_EQ(0U, team.find(0));
+    EXPECT_EQ(0U, team.nearest(Point()));
+}
+
+TEST(TeamSnapshotTest, find)
+{
+    TeamSnapshot team = make_team();
+    EXPECT_EQ(0U, team.find(4));
+    EXPECT_EQ(1U, team.find(9));
+    EXPECT_EQ(2U, team.find(0));
+    EXPECT_EQ(3U, team.find(5));
+}
+
+TEST(TeamSnapshotTest, find_ignores_slots_past_size)
+{
+    TeamSnapshot team = make_team();
+    team.patterns[3]  = 5;
+    EXPECT_EQ(3U, team.find(5));
+}
+
+TEST(TeamSnapshotTest, nearest)
+{
+    TeamSnapshot team = make_team();
+    EXPECT_EQ(0U, team.nearest(Point(0.9, 1.2)));
+    EXPECT_EQ(1U, team.nearest(Point(-5.0, 0.0)));
+    EXPECT_EQ(2U, team.nearest(Point(0.5, -2.0)));
+}
+}
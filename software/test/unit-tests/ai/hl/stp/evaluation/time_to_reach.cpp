@@ -0,0 +1,86 @@
+#include "ai/hl/stp/evaluation/time_to_reach.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using AI::HL::STP::Evaluation::ReachState;
+using AI::HL::STP::Evaluation::ReachLimits;
+
+namespace
+{
+const ReachLimits LIMITS = {2.0, 1.0, 1.0, 1.0};
+
+TEST(TimeToReachTest, from_rest_without_reaching_top_speed)
+{
+    // Accelerate for half the distance and brake for the other half:
+    // 2·√(d/a) = 2·√(0.16/2) s.
+    ReachState robot = {Point(1.0, 1.0), Point()};
+    EXPECT_NEAR(
+        2.0 * std::sqrt(0.08),
+        AI::HL::STP::Evaluation::time_to_reach(robot, Point(1.16, 1.0), LIMITS),
+        1e-4);
+}
+
+TEST(TimeToReachTest, from_rest_with_cruise)
+{
+    // Half a second each to reach and lose 1 m/s covers 0.5 m; the other
+    // 2.5 m are covered at top speed.
+    ReachState robot = {Point(), Point()};
+    EXPECT_NEAR(
+        3.5,
+        AI::HL::STP::Evaluation::time_to_reach(robot, Point(0.0, 3.0), LIMITS),
+        1e-4);
+}
+
+TEST(TimeToReachTest, velocity_towards_target_helps)
+{
+    ReachState still  = {Point(), Point()};
+    ReachState moving = {Point(), Point(1.0, 0.0)};
+    ReachState away   = {Point(), Point(-1.0, 0.0)};
+    Point target(2.0, 0.0);
+    double t_still =
+        AI::HL::STP::Evaluation::time_to_reach(still, target, LIMITS);
+    EXPECT_LT(
+        AI::HL::STP::Evaluation::time_to_reach(moving, target, LIMITS),
+        t_still);
+    EXPECT_GT(
+        AI::HL::STP::Evaluation::time_to_reach(away, target, LIMITS), t_still);
+}
+
+TEST(TimeToReachTest, sideways_velocity_must_be_cancelled)
+{
+    // Already at the target but drifting sideways at 1 m/s: one second to
+    // stop 0.5 m away, then 2·√(0.5/1) s to come back.
+    ReachState robot = {Point(), Point(0.0, 1.0)};
+    EXPECT_NEAR(
+        1.0 + 2.0 * std::sqrt(0.5),
+        AI::HL::STP::Evaluation::time_to_reach(robot, Point(), LIMITS), 1e-4);
+}
+
+TEST(TimeToReachTest, batch_matches_single)
+{
+    std::vector<ReachState> robots = {{Point(), Point()},
+                                      {Point(1.0, -1.0), Point(0.5, 0.5)}};
+    std::vector<Point> targets = {Point(2.0, 0.0), Point(-1.0, 3.0),
+                                  Point(0.5, 0.5)};
+    std::vector<double> times;
+    AI::HL::STP::Evaluation::time_to_reach(robots, targets, times, LIMITS);
+    ASSERT_EQ(robots.size() * targets.size(), times.size());
+    for (std::size_t i = 0; i < robots.size(); ++i)
+    {
+        for (std::size_t j = 0; j < targets.size(); ++j)
+        {
+            EXPECT_EQ(
+                AI::HL::STP::Evaluation::time_to_reach(
+                    robots[i], targets[j], LIMITS),
+                times[i * targets.size() + j]);
+        }
+    }
+    EXPECT_EQ(
+        std::min(times[2], times[5]),
+        AI::HL::STP::Evaluation::min_time_to_reach(robots, targets[2], LIMITS));
+    EXPECT_TRUE(std::isinf(AI::HL::STP::Evaluation::min_time_to_reach(
+        std::vector<ReachState>(), targets[0], LIMITS)));
+}
+}
@@ -0,0 +1,153 @@
+#include "geom/delaunay.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+
+namespace
+{
+double area(const std::vector<Point> &pts, const std::array<std::size_t, 3> &t)
+{
+    return (pts[t[1]] - pts[t[0]]).cross(pts[t[2]] - pts[t[0]]) / 2.0;
+}
+
+TEST(DelaunayTest, too_few_points)
+{
+    EXPECT_TRUE(Geom::delaunay_triangulate({}).empty());
+    EXPECT_TRUE(Geom::delaunay_triangulate({Point(0, 0), Point(1, 0)}).empty());
+    EXPECT_TRUE(Geom::delaunay_triangulate(
+                    {Point(0, 0), Point(1, 0), Point(2, 0), Point(3, 0)})
+                    .empty());
+}
+
+TEST(DelaunayTest, single_triangle_is_counterclockwise)
+{
+    std::vector<Point> pts = {Point(0, 0), Point(0, 1), Point(1, 0)};
+    auto tris              = Geom::delaunay_triangulate(pts);
+    ASSERT_EQ(1U, tris.size());
+    EXPECT_DOUBLE_EQ(0.5, area(pts, tris[0]));
+}
+
+TEST(DelaunayTest, square_with_centre)
+{
+    std::vector<Point> pts = {Point(0, 0), Point(2, 0), Point(2, 2),
+                              Point(0, 2), Point(1, 1), Point(1, 1)};
+    auto tris = Geom::delaunay_triangulate(pts);
+    ASSERT_EQ(4U, tris.size());
+    for (const auto &t : tris)
+    {
+        EXPECT_DOUBLE_EQ(1.0, area(pts, t));
+        EXPECT_TRUE(t[0] == 4 || t[1] == 4 || t[2] == 4);
+    }
+}
+
+TEST(DelaunayTest, random_points_are_delaunay)
+{
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<double> x(-4.5, 4.5), y(-3.0, 3.0);
+    for (unsigned int trial = 0; trial != 50; ++trial)
+    {
+        // The corners fix the convex hull so the total area is known.
+        std::vector<Point> pts = {Point(-4.5, -3.0), Point(4.5, -3.0),
+                                  Point(4.5, 3.0), Point(-4.5, 3.0)};
+        for (unsigned int i = 0; i != 12; ++i)
+        {
+            pts.push_back(Point(x(gen), y(gen)));
+        }
+        auto tris = Geom::delaunay_triangulate(pts);
+
+        // Euler: 2n - 2 - h triangles for n points with h on the hull.
+        EXPECT_EQ(2 * pts.size() - 2 - 4, tris.size());
+
+        double total = 0.0;
+        for (const auto &t : tris)
+        {
+            double a = area(pts, t);
+            EXPECT_GT(a, 0.0);
+            total += a;
+
+            // Empty circumcircle.
+            Point ab = pts[t[1]] - pts[t[0]], ac = pts[t[2]] - pts[t[0]];
+            double d = 2.0 * ab.cross(ac);
+            Point centre =
+                pts[t[0]] + Point(
+                                (ac.y * ab.lensq() - ab.y * ac.lensq()) / d,
+                                (ab.x * ac.lensq() - ac.x * ab.lensq()) / d);
+            double r = (pts[t[0]] - centre).len();
+            for (std::size_t i = 0; i != pts.size(); ++i)
+            {
+                EXPECT_GE((pts[i] - centre).len(), r - 1e-9);
+            }
+        }
+        EXPECT_NEAR(9.0 * 6.0, total, 1e-9);
+    }
+}
+
+TEST(DelaunayTest, collinear_points_cover_hull)
+{
+    // Robots on or within a hair of the halfway line or a sideline, in the
+    // half field from x = 0 to 4.5. The first case once gave overlapping
+    // triangles.
+    std::vector<Point> hard = {Point(2.21e-7, 1.242), Point(2.9295, 1.176),
+                               Point(1.87e-7, 1.272), Point(5.33e-7, 1.59),
+                               Point(4.5, 3.0),       Point(4.5, -3.0),
+                               Point(0.0, 3.0),       Point(0.0, -3.0)};
+    std::vector<std::vector<Point>> cases = {hard};
+    std::mt19937 gen(54321);
+    std::uniform_real_distribution<double> x(0.0, 4.5), y(-3.0, 3.0);
+    std::uniform_int_distribution<int> line(0, 2);
+    for (double jitter : {0.0, 1e-6, 1e-3})
+    {
+        std::uniform_real_distribution<double> off(0.0, jitter);
+        for (unsigned int trial = 0; trial != 500; ++trial)
+        {
+            std::vector<Point> pts = {Point(4.5, -3.0), Point(4.5, 3.0),
+                                      Point(0.0, 3.0), Point(0.0, -3.0)};
+            for (unsigned int i = 0; i != 8; ++i)
+            {
+                switch (line(gen))
+                {
+                    case 0:
+                        pts.push_back(Point(off(gen), y(gen)));
+                        break;
+                    case 1:
+                        pts.push_back(Point(x(gen), 3.0 - off(gen)));
+                        break;
+                    default:
+                        pts.push_back(Point(x(gen), y(gen)));
+                        break;
+                }
+            }
+            cases.push_back(pts);
+        }
+    }
+
+    for (const std::vector<Point> &pts : cases)
+    {
+        double total = 0.0;
+        for (const auto &t : Geom::delaunay_triangulate(pts))
+        {
+            double a = area(pts, t);
+            EXPECT_GT(a, 0.0);
+            total += a;
+        }
+        EXPECT_NEAR(4.5 * 6.0, total, 1e-9);
+    }
+}
+
+TEST(DelaunayTest, points_on_a_line_and_one_off_it)
+{
+    // Five points on the halfway line and one beside it make a fan of four
+    // triangles, which needs the collinear points handled exactly.
+    std::vector<Point> pts = {Point(0, -2), Point(0, -1), Point(0, 0),
+                              Point(0, 1),  Point(0, 2),  Point(1e-9, 0.5)};
+    auto tris    = Geom::delaunay_triangulate(pts);
+    double total = 0.0;
+    for (const auto &t : tris)
+    {
+        EXPECT_GT(area(pts, t), 0.0);
+        total += area(pts, t);
+    }
+    EXPECT_EQ(4U, tris.size());
+    EXPECT_NEAR(4.0 * 1e-9 / 2.0, total, 1e-21);
+}
+}
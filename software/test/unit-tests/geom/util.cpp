@@ -241,6 +241,28 @@ TEST(GeomUtilTest, test_dist_matching)
     EXPECT_TRUE(match[3] == 3);
 }
 
+TEST(GeomUtilTest, test_dist_matching_direction)
+{
+    // Every size, including those too large for the small solver, matches
+    // element i of v1 with element match[i] of v2. Shifting by one is not its
+    // own inverse, so a swapped matching would show up.
+    for (std::size_t n : {2U, 5U, 12U, 13U, 20U})
+    {
+        std::vector<Point> v1, v2(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            v1.push_back(Point(static_cast<double>(i), 0.0));
+            v2[(i + 1) % n] = Point(static_cast<double>(i), 0.1);
+        }
+        std::vector<std::size_t> match = dist_matching(v1, v2);
+        ASSERT_EQ(n, match.size());
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            EXPECT_EQ((i + 1) % n, match[i]) << "n = " << n << ", i = " << i;
+        }
+    }
+}
+
 TEST(GeomUtilTest, test_angle_sweep_circles)
 {
     std::vector<Point> obs;
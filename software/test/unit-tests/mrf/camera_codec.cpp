@@ -0,0 +1,125 @@
+#include "mrf/camera_codec.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+MRF::CameraPose pose(uint8_t index, int16_t x, int16_t y, int16_t angle)
+{
+    MRF::CameraPose p;
+    p.index = index;
+    p.x     = x;
+    p.y     = y;
+    p.angle = angle;
+    return p;
+}
+
+TEST(CameraCodecTest, keyframe_then_delta)
+{
+    MRF::CameraEncoder enc;
+    MRF::CameraDecoder dec(3);
+    uint8_t buf[CAMERA_PACKET_MAX_LENGTH];
+    std::size_t encoded;
+    MRF::CameraPose out;
+
+    MRF::CameraPose p = pose(3, 1000, -2000, 1500);
+    std::size_t len   = enc.encode(&p, 1, 10, 20, 123456789, buf, encoded);
+    EXPECT_EQ(1U, encoded);
+    EXPECT_EQ(CAMERA_PACKET_HEADER_LENGTH + 8 + CAMERA_KEYFRAME_LENGTH, len);
+    ASSERT_TRUE(dec.decode(buf, len, out));
+    EXPECT_EQ(1000, out.x);
+    EXPECT_EQ(-2000, out.y);
+    EXPECT_EQ(1500, out.angle);
+    EXPECT_EQ(10, dec.ball_x());
+    EXPECT_EQ(20, dec.ball_y());
+    EXPECT_EQ(123456789U, dec.timestamp());
+
+    p   = pose(3, 1100, -2050, 1520);
+    len = enc.encode(&p, 1, 10, 20, 123466789, buf, encoded);
+    EXPECT_EQ(CAMERA_PACKET_HEADER_LENGTH + 4 + CAMERA_DELTA_LENGTH, len);
+    ASSERT_TRUE(dec.decode(buf, len, out));
+    EXPECT_EQ(1100, out.x);
+    EXPECT_EQ(-2050, out.y);
+    EXPECT_EQ(1520, out.angle);
+    EXPECT_EQ(123466789U, dec.timestamp());
+}
+
+TEST(CameraCodecTest, large_move_sends_keyframe)
+{
+    MRF::CameraEncoder enc;
+    uint8_t buf[CAMERA_PACKET_MAX_LENGTH];
+    std::size_t encoded;
+    MRF::CameraPose p = pose(0, 0, 0, 0);
+    enc.encode(&p, 1, 0, 0, 0, buf, encoded);
+    p               = pose(0, 500, 0, 0);
+    std::size_t len = enc.encode(&p, 1, 0, 0, 0, buf, encoded);
+    EXPECT_EQ(CAMERA_PACKET_HEADER_LENGTH + 4 + CAMERA_KEYFRAME_LENGTH, len);
+}
+
+TEST(CameraCodecTest, missed_keyframe_ignores_deltas)
+{
+    MRF::CameraEncoder enc;
+    MRF::CameraDecoder dec(1);
+    uint8_t buf[CAMERA_PACKET_MAX_LENGTH];
+    std::size_t encoded, len;
+    MRF::CameraPose out;
+
+    MRF::CameraPose p = pose(1, 0, 0, 0);
+    len               = enc.encode(&p, 1, 0, 0, 0, buf, encoded);
+    ASSERT_TRUE(dec.decode(buf, len, out));
+
+    // The robot never hears this keyframe.
+    p = pose(1, 2000, 0, 0);
+    enc.encode(&p, 1, 0, 0, 0, buf, encoded);
+
+    p   = pose(1, 2010, 0, 0);
+    len = enc.encode(&p, 1, 0, 0, 0, buf, encoded);
+    EXPECT_FALSE(dec.decode(buf, len, out));
+}
+
+TEST(CameraCodecTest, angle_delta_wraps)
+{
+    MRF::CameraEncoder enc;
+    MRF::CameraDecoder dec(2);
+    uint8_t buf[CAMERA_PACKET_MAX_LENGTH];
+    std::size_t encoded, len;
+    MRF::CameraPose out;
+
+    MRF::CameraPose p = pose(2, 0, 0, 3130);
+    len               = enc.encode(&p, 1, 0, 0, 0, buf, encoded);
+    ASSERT_TRUE(dec.decode(buf, len, out));
+    p   = pose(2, 0, 0, -3130);
+    len = enc.encode(&p, 1, 0, 0, 0, buf, encoded);
+    EXPECT_EQ(CAMERA_PACKET_HEADER_LENGTH + 4 + CAMERA_DELTA_LENGTH, len);
+    ASSERT_TRUE(dec.decode(buf, len, out));
+    EXPECT_NEAR(-3130, out.angle, CAMERA_DELTA_ANGLE_SCALE);
+}
+
+TEST(CameraCodecTest, budget_and_padding)
+{
+    MRF::CameraEncoder enc;
+    uint8_t buf[CAMERA_PACKET_MAX_LENGTH];
+    std::size_t encoded;
+    MRF::CameraPose poses[8];
+    for (uint8_t i = 0; i != 8; ++i)
+    {
+        poses[i] = pose(i, static_cast<int16_t>(i * 100), 0, 0);
+    }
+
+    // All keyframes with a full timestamp: only seven robots fit.
+    std::size_t len = enc.encode(poses, 8, 0, 0, 0, buf, encoded);
+    EXPECT_EQ(7U, encoded);
+    EXPECT_LE(len, CAMERA_PACKET_MAX_LENGTH);
+
+    // Six keyframes and a full timestamp would be exactly the legacy length.
+    MRF::CameraEncoder enc2;
+    len = enc2.encode(poses, 6, 0, 0, 0, buf, encoded);
+    EXPECT_EQ(6U, encoded);
+    EXPECT_EQ(CAMERA_PACKET_LEGACY_LENGTH + 1, len);
+    EXPECT_TRUE(buf[0] & CAMERA_FLAG_PADDED);
+
+    MRF::CameraDecoder dec(5);
+    MRF::CameraPose out;
+    ASSERT_TRUE(dec.decode(buf, len, out));
+    EXPECT_EQ(500, out.x);
+}
+}
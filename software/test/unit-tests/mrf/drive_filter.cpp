@@ -0,0 +1,86 @@
+#include "mrf/drive_filter.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+const MRF::DriveFilter::Clock::duration KEEPALIVE =
+    std::chrono::milliseconds(100);
+
+MRF::DriveRecord move(double x, double y)
+{
+    MRF::DriveRecord record;
+    record.primitive = 1;
+    record.params    = {{x, y, 0.0, 0.0}};
+    record.flags     = 0;
+    return record;
+}
+
+TEST(DriveFilterTest, first_record_is_sent)
+{
+    MRF::DriveFilter filter;
+    EXPECT_TRUE(filter.should_send(
+        move(0.0, 0.0), 2.0, KEEPALIVE, MRF::DriveFilter::Clock::now()));
+}
+
+TEST(DriveFilterTest, jitter_is_suppressed_but_drift_is_not)
+{
+    MRF::DriveFilter filter;
+    MRF::DriveFilter::Clock::time_point now = MRF::DriveFilter::Clock::now();
+    filter.sent(move(100.0, 200.0), now);
+    EXPECT_FALSE(filter.should_send(move(100.0, 200.0), 0.0, KEEPALIVE, now));
+    EXPECT_FALSE(filter.should_send(move(101.5, 198.5), 2.0, KEEPALIVE, now));
+    EXPECT_TRUE(filter.should_send(move(101.5, 198.5), 1.0, KEEPALIVE, now));
+
+    // Each step is small, but the total is compared with what was sent.
+    EXPECT_FALSE(filter.should_send(move(101.0, 200.0), 2.0, KEEPALIVE, now));
+    EXPECT_TRUE(filter.should_send(move(103.0, 200.0), 2.0, KEEPALIVE, now));
+}
+
+TEST(DriveFilterTest, primitive_and_flags_compare_exactly)
+{
+    MRF::DriveFilter filter;
+    MRF::DriveFilter::Clock::time_point now = MRF::DriveFilter::Clock::now();
+    filter.sent(move(0.0, 0.0), now);
+
+    MRF::DriveRecord record = move(0.0, 0.0);
+    record.primitive        = 0;
+    EXPECT_TRUE(filter.should_send(record, 1000.0, KEEPALIVE, now));
+    record       = move(0.0, 0.0);
+    record.flags = 0x80;
+    EXPECT_TRUE(filter.should_send(record, 1000.0, KEEPALIVE, now));
+}
+
+TEST(DriveFilterTest, keepalive_forces_send)
+{
+    MRF::DriveFilter filter;
+    MRF::DriveFilter::Clock::time_point now = MRF::DriveFilter::Clock::now();
+    filter.sent(move(5.0, 5.0), now);
+    EXPECT_FALSE(filter.should_send(
+        move(5.0, 5.0), 0.0, KEEPALIVE, now + std::chrono::milliseconds(99)));
+    EXPECT_TRUE(filter.should_send(
+        move(5.0, 5.0), 0.0, KEEPALIVE, now + std::chrono::milliseconds(100)));
+}
+
+TEST(DriveFilterTest, special_values)
+{
+    MRF::DriveFilter filter;
+    MRF::DriveFilter::Clock::time_point now = MRF::DriveFilter::Clock::now();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    filter.sent(move(nan, inf), now);
+    EXPECT_FALSE(filter.should_send(move(nan, inf), 0.0, KEEPALIVE, now));
+    EXPECT_TRUE(filter.should_send(move(0.0, inf), 2.0, KEEPALIVE, now));
+    EXPECT_TRUE(filter.should_send(move(nan, -inf), 2.0, KEEPALIVE, now));
+}
+
+TEST(DriveFilterTest, reset_forces_send)
+{
+    MRF::DriveFilter filter;
+    MRF::DriveFilter::Clock::time_point now = MRF::DriveFilter::Clock::now();
+    filter.sent(move(0.0, 0.0), now);
+    filter.reset();
+    EXPECT_TRUE(filter.should_send(move(0.0, 0.0), 0.0, KEEPALIVE, now));
+}
+}
@@ -0,0 +1,50 @@
+#include "mrf/drive_latency.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+typedef std::chrono::milliseconds ms;
+
+TEST(DriveLatencyTest, measures_from_first_dirty)
+{
+    MRF::DriveLatency latency;
+    MRF::DriveLatency::Clock::time_point t0 = MRF::DriveLatency::Clock::now();
+    latency.dirtied(t0);
+    latency.dirtied(t0 + ms(3));
+    latency.submitted(t0 + ms(5));
+    latency.completed(t0 + ms(6));
+    ASSERT_EQ(1U, latency.histogram().count());
+    EXPECT_EQ(6000, latency.histogram().max().count());
+}
+
+TEST(DriveLatencyTest, idle_ticks_are_not_counted)
+{
+    // Ticks whose records were all held back leave nothing dirty, so the
+    // time before the next dirty record is not part of its latency.
+    MRF::DriveLatency latency;
+    MRF::DriveLatency::Clock::time_point t0 = MRF::DriveLatency::Clock::now();
+    latency.dirtied(t0);
+    latency.submitted(t0);
+    latency.completed(t0 + ms(1));
+    latency.dirtied(t0 + ms(100));
+    latency.submitted(t0 + ms(102));
+    latency.completed(t0 + ms(103));
+    ASSERT_EQ(2U, latency.histogram().count());
+    EXPECT_EQ(3000, latency.histogram().max().count());
+}
+
+TEST(DriveLatencyTest, dirty_during_transfer_waits_for_next)
+{
+    MRF::DriveLatency latency;
+    MRF::DriveLatency::Clock::time_point t0 = MRF::DriveLatency::Clock::now();
+    latency.dirtied(t0);
+    latency.submitted(t0);
+    latency.dirtied(t0 + ms(1));
+    latency.completed(t0 + ms(2));
+    latency.submitted(t0 + ms(2));
+    latency.completed(t0 + ms(4));
+    ASSERT_EQ(2U, latency.histogram().count());
+    EXPECT_EQ(3000, latency.histogram().max().count());
+    EXPECT_EQ(2500, latency.histogram().mean().count());
+}
+}
@@ -0,0 +1,86 @@
+#include "mrf/feedback.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+// A general status message as the firmware sends it: battery 16.123 V,
+// capacitor 200.5 V, break beam 0.513 V, board 35.07 °C, ball in beam,
+// capacitor not charged, logger status 5, SD status 3, dribbler speed -300 and
+// dribbler 41 °C.
+const uint8_t STATUS[] = {0x00, 0xFB, 0x3E, 0x52, 0x4E, 0x01, 0x02,
+                          0xB3, 0x0D, 0x85, 0x03, 0xD4, 0xFE, 0x29};
+
+TEST(FeedbackTest, status_view)
+{
+    static_assert(
+        sizeof(STATUS) == MRF::StatusMessage::BUFFER_SIZE,
+        "Wrong status message size!");
+    const MRF::StatusView status(STATUS);
+    EXPECT_EQ(0x00U, status.type());
+    EXPECT_EQ(16123U, status.battery_voltage());
+    EXPECT_EQ(20050U, status.capacitor_voltage());
+    EXPECT_EQ(513U, status.break_beam_reading());
+    EXPECT_EQ(3507U, status.board_temperature());
+    EXPECT_TRUE(status.ball_in_beam());
+    EXPECT_FALSE(status.capacitor_charged());
+    EXPECT_EQ(5U, status.logger_status());
+    EXPECT_EQ(3U, status.sd_status());
+    EXPECT_EQ(-300, status.dribbler_speed());
+    EXPECT_EQ(41U, status.dribbler_temperature());
+}
+
+TEST(FeedbackTest, status_round_trip)
+{
+    const MRF::StatusMessage decoded(STATUS);
+    EXPECT_EQ(-300, decoded.dribbler_speed);
+    uint8_t buffer[MRF::StatusMessage::BUFFER_SIZE];
+    decoded.encode(buffer);
+    for (std::size_t i = 0; i != sizeof(buffer); ++i)
+    {
+        EXPECT_EQ(STATUS[i], buffer[i]);
+    }
+}
+
+TEST(FeedbackTest, build_ids_view)
+{
+    static const uint8_t BUILD_IDS[] = {0x78, 0x56, 0x34, 0x12,
+                                        0xEF, 0xBE, 0xAD, 0xDE};
+    const MRF::BuildIDsView ids(BUILD_IDS);
+    EXPECT_EQ(UINT32_C(0x12345678), ids.fw_build_id());
+    EXPECT_EQ(UINT32_C(0xDEADBEEF), ids.fpga_build_id());
+}
+
+TEST(FeedbackTest, lps_view)
+{
+    static const uint8_t LPS[] = {0x0A, 0xF6, 0x00, 0x80};
+    const MRF::LPSView lps(LPS);
+    EXPECT_EQ(10, lps.lps0());
+    EXPECT_EQ(-10, lps.lps1());
+    EXPECT_EQ(0, lps.lps2());
+    EXPECT_EQ(-128, lps.lps3());
+}
+
+TEST(FeedbackTest, error_bits_view)
+{
+    // Errors 0, 9 and 23 asserted.
+    static const uint8_t ERRORS[] = {0x01, 0x02, 0x80};
+    static_assert(
+        sizeof(ERRORS) == MRF::ErrorBitsExtension::BUFFER_SIZE,
+        "Wrong error bits extension size!");
+    const MRF::ErrorBitsView errors(ERRORS);
+    EXPECT_EQ(UINT32_C(0x800201), errors.bits());
+}
+
+TEST(FeedbackTest, received_framing_views)
+{
+    // Robot 7 sent an autokick notification, received with LQI 200 and RSSI
+    // 0x9C.
+    static const uint8_t FRAME[] = {0x07, 0x01, 0xC8, 0x9C};
+    const MRF::ReceivedHeaderView header(FRAME);
+    const MRF::ReceivedTrailerView trailer(
+        FRAME + sizeof(FRAME) - MRF::ReceivedTrailer::BUFFER_SIZE);
+    EXPECT_EQ(7U, header.robot());
+    EXPECT_EQ(200U, trailer.lqi());
+    EXPECT_EQ(0x9CU, trailer.rssi());
+}
+}
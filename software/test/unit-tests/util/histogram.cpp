@@ -0,0 +1,44 @@
+#include "util/histogram.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+typedef LatencyHistogram::Duration us;
+
+TEST(HistogramTest, empty)
+{
+    LatencyHistogram hist;
+    EXPECT_EQ(0U, hist.count());
+    EXPECT_EQ(0, hist.max().count());
+    EXPECT_EQ(0, hist.mean().count());
+    EXPECT_EQ(0, hist.percentile(0.5).count());
+}
+
+TEST(HistogramTest, percentiles)
+{
+    LatencyHistogram hist(us(100));
+    for (int i = 0; i < 100; ++i)
+    {
+        hist.record(us(i * 10));
+    }
+    EXPECT_EQ(100U, hist.count());
+    EXPECT_EQ(990, hist.max().count());
+    EXPECT_EQ(495, hist.mean().count());
+    EXPECT_EQ(500, hist.percentile(0.5).count());
+    EXPECT_EQ(990, hist.percentile(1.0).count());
+    EXPECT_EQ(10U, hist.bucket(0));
+}
+
+TEST(HistogramTest, overflow_and_reset)
+{
+    LatencyHistogram hist(us(1));
+    hist.record(us(-5));
+    hist.record(us(1000000));
+    EXPECT_EQ(1U, hist.bucket(0));
+    EXPECT_EQ(1U, hist.bucket(LatencyHistogram::NUM_BUCKETS));
+    EXPECT_EQ(1000000, hist.percentile(0.99).count());
+    hist.reset();
+    EXPECT_EQ(0U, hist.count());
+    EXPECT_EQ(0U, hist.bucket(LatencyHistogram::NUM_BUCKETS));
+}
+}
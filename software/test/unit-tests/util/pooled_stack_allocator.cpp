@@ -0,0 +1,73 @@
+#include "util/pooled_stack_allocator.h"
+#include <gtest/gtest.h>
+#include <cstring>
+
+namespace
+{
+TEST(PooledStackAllocatorTest, stack_is_writable)
+{
+    PooledStackAllocator alloc;
+    boost::coroutines::stack_context ctx;
+    alloc.allocate(ctx, 20000);
+    ASSERT_NE(nullptr, ctx.sp);
+    EXPECT_GE(ctx.size, 20000U);
+    // The top 20000 bytes are usable; the guard page is below them.
+    std::memset(static_cast<char *>(ctx.sp) - 20000, 0x55, 20000);
+    alloc.deallocate(ctx);
+    EXPECT_EQ(nullptr, ctx.sp);
+    PooledStackAllocator::release_idle();
+}
+
+TEST(PooledStackAllocatorTest, freed_stack_is_reused)
+{
+    PooledStackAllocator::release_idle();
+    PooledStackAllocator alloc;
+    boost::coroutines::stack_context first, second;
+    alloc.allocate(first, 64 * 1024);
+    void *sp = first.sp;
+    alloc.deallocate(first);
+    EXPECT_EQ(1U, PooledStackAllocator::idle());
+
+    // A copy of the allocator draws from the same pool.
+    PooledStackAllocator copy(alloc);
+    copy.allocate(second, 64 * 1024);
+    EXPECT_EQ(sp, second.sp);
+    EXPECT_EQ(0U, PooledStackAllocator::idle());
+    copy.deallocate(second);
+    PooledStackAllocator::release_idle();
+    EXPECT_EQ(0U, PooledStackAllocator::idle());
+}
+
+TEST(PooledStackAllocatorTest, sizes_are_kept_apart)
+{
+    PooledStackAllocator::release_idle();
+    PooledStackAllocator alloc;
+    boost::coroutines::stack_context small, large;
+    alloc.allocate(small, 16 * 1024);
+    std::size_t small_size = small.size;
+    alloc.deallocate(small);
+    alloc.allocate(large, 256 * 1024);
+    EXPECT_GT(large.size, small_size);
+    EXPECT_EQ(1U, PooledStackAllocator::idle());
+    alloc.deallocate(large);
+    EXPECT_EQ(2U, PooledStackAllocator::idle());
+    PooledStackAllocator::release_idle();
+}
+
+TEST(PooledStackAllocatorTest, pool_is_bounded)
+{
+    PooledStackAllocator::release_idle();
+    PooledStackAllocator alloc;
+    boost::coroutines::stack_context ctx[PooledStackAllocator::MAX_IDLE + 4];
+    for (boost::coroutines::stack_context &i : ctx)
+    {
+        alloc.allocate(i, 8 * 1024);
+    }
+    for (boost::coroutines::stack_context &i : ctx)
+    {
+        alloc.deallocate(i);
+    }
+    EXPECT_EQ(PooledStackAllocator::MAX_IDLE, PooledStackAllocator::idle());
+    PooledStackAllocator::release_idle();
+}
+}
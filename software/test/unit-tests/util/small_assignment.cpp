@@ -0,0 +1,260 @@
+#include "util/small_assignment.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "util/hungarian.h"
+
+namespace
+{
+// The cheapest assignment found by trying every one.
+double brute_force(const SmallAssignment &a)
+{
+    std::vector<std::size_t> columns(a.columns());
+    for (std::size_t i = 0; i != columns.size(); ++i)
+    {
+        columns[i] = i;
+    }
+    double best = std::numeric_limits<double>::infinity();
+    do
+    {
+        double sum = 0.0;
+        for (std::size_t i = 0; i != a.rows(); ++i)
+        {
+            sum += a.cost(i, columns[i]);
+        }
+        best = std::min(best, sum);
+    } while (std::next_permutation(columns.begin(), columns.end()));
+    return best;
+}
+
+void expect_consistent(const SmallAssignment &a)
+{
+    std::vector<bool> taken(a.columns(), false);
+    double sum = 0.0;
+    for (std::size_t i = 0; i != a.rows(); ++i)
+    {
+        std::size_t j = a.column_of(i);
+        ASSERT_LT(j, a.columns());
+        EXPECT_FALSE(taken[j]);
+        taken[j] = true;
+        EXPECT_EQ(i, a.row_of(j));
+        sum += a.cost(i, j);
+    }
+    for (std::size_t j = 0; j != a.columns(); ++j)
+    {
+        if (!taken[j])
+        {
+            EXPECT_EQ(a.rows(), a.row_of(j));
+        }
+    }
+    EXPECT_DOUBLE_EQ(sum, a.total());
+}
+
+void fill(SmallAssignment &a, std::mt19937 &rng)
+{
+    std::uniform_real_distribution<double> dist(-5.0, 10.0);
+    for (std::size_t i = 0; i != a.rows(); ++i)
+    {
+        for (std::size_t j = 0; j != a.columns(); ++j)
+        {
+            a.cost(i, j, dist(rng));
+        }
+    }
+}
+
+TEST(SmallAssignmentTest, rejects_bad_sizes)
+{
+    EXPECT_THROW(SmallAssignment(3, 2), std::invalid_argument);
+    EXPECT_THROW(
+        SmallAssignment(1, SmallAssignment::MAX_SIZE + 1),
+        std::invalid_argument);
+}
+
+TEST(SmallAssignmentTest, simple_square)
+{
+    SmallAssignment a(3, 3);
+    const double costs[3][3] = {{4, 1, 3}, {2, 0, 5}, {3, 2, 2}};
+    for (std::size_t i = 0; i != 3; ++i)
+    {
+        for (std::size_t j = 0; j != 3; ++j)
+        {
+            a.cost(i, j, costs[i][j]);
+        }
+    }
+    a.solve();
+    expect_consistent(a);
+    EXPECT_EQ(1U, a.column_of(0));
+    EXPECT_EQ(0U, a.column_of(1));
+    EXPECT_EQ(2U, a.column_of(2));
+    EXPECT_DOUBLE_EQ(5.0, a.total());
+}
+
+TEST(SmallAssignmentTest, random_square_and_rectangular)
+{
+    std::mt19937 rng(1);
+    for (std::size_t columns = 1; columns <= 7; ++columns)
+    {
+        for (std::size_t rows = 0; rows <= columns; ++rows)
+        {
+            for (unsigned int round = 0; round != 20; ++round)
+            {
+                SmallAssignment a(rows, columns);
+                fill(a, rng);
+                a.solve();
+                expect_consistent(a);
+                EXPECT_NEAR(brute_force(a), a.total(), 1e-9);
+            }
+        }
+    }
+}
+
+TEST(SmallAssignmentTest, incremental_row_and_column_changes)
+{
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<double> dist(-5.0, 10.0);
+    for (std::size_t rows = 1; rows <= 6; ++rows)
+    {
+        SmallAssignment a(rows, 6);
+        fill(a, rng);
+        a.solve();
+        for (unsigned int round = 0; round != 200; ++round)
+        {
+            switch (round % 3)
+            {
+                case 0:
+                {
+                    std::size_t i = rng() % rows;
+                    for (std::size_t j = 0; j != a.columns(); ++j)
+                    {
+                        a.cost(i, j, dist(rng));
+                    }
+                    break;
+                }
+                case 1:
+                {
+                    std::size_t j = rng() % a.columns();
+                    for (std::size_t i = 0; i != rows; ++i)
+                    {
+                        a.cost(i, j, dist(rng));
+                    }
+                    break;
+                }
+                default:
+                    fill(a, rng);
+                    break;
+            }
+            a.solve();
+            expect_consistent(a);
+            EXPECT_NEAR(brute_force(a), a.total(), 1e-9);
+        }
+    }
+}
+
+TEST(SmallAssignmentTest, agrees_with_hungarian)
+{
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> dist(0.0, 10.0);
+    for (unsigned int round = 0; round != 100; ++round)
+    {
+        const std::size_t n = SmallAssignment::MAX_SIZE;
+        SmallAssignment a(n, n);
+        Hungarian h(n);
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            for (std::size_t j = 0; j != n; ++j)
+            {
+                double c = dist(rng);
+                a.cost(i, j, c);
+                h.weight(i, j) = -c;
+            }
+        }
+        a.solve();
+        h.execute();
+        double hungarian_total = 0.0;
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            hungarian_total -= h.weight(i, h.matchX(i));
+        }
+        EXPECT_NEAR(hungarian_total, a.total(), 1e-6);
+    }
+}
+
+// Run with --gtest_also_run_disabled_tests to compare speeds.
+TEST(SmallAssignmentTest, DISABLED_benchmark_against_hungarian)
+{
+    typedef std::chrono::steady_clock Clock;
+    const unsigned int ROUNDS = 20000;
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<double> dist(0.0, 10.0);
+    for (std::size_t n : {4U, 8U, 12U})
+    {
+        std::vector<double> costs(ROUNDS * n * n);
+        for (double &i : costs)
+        {
+            i = dist(rng);
+        }
+
+        double sink             = 0.0;
+        Clock::time_point start = Clock::now();
+        for (unsigned int round = 0; round != ROUNDS; ++round)
+        {
+            Hungarian h(n);
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                for (std::size_t j = 0; j != n; ++j)
+                {
+                    h.weight(i, j) = -costs[(round * n + i) * n + j];
+                }
+            }
+            h.execute();
+            sink += static_cast<double>(h.matchX(0));
+        }
+        Clock::duration hungarian = Clock::now() - start;
+
+        SmallAssignment a(n, n);
+        start = Clock::now();
+        for (unsigned int round = 0; round != ROUNDS; ++round)
+        {
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                for (std::size_t j = 0; j != n; ++j)
+                {
+                    a.cost(i, j, costs[(round * n + i) * n + j]);
+                }
+            }
+            a.solve();
+            sink += static_cast<double>(a.column_of(0));
+        }
+        Clock::duration small = Clock::now() - start;
+
+        // Change one row each round, as when one robot moves.
+        start = Clock::now();
+        for (unsigned int round = 0; round != ROUNDS; ++round)
+        {
+            std::size_t i = round % n;
+            for (std::size_t j = 0; j != n; ++j)
+            {
+                a.cost(i, j, costs[(round * n + i) * n + j]);
+            }
+            a.solve();
+            sink += static_cast<double>(a.column_of(0));
+        }
+        Clock::duration incremental = Clock::now() - start;
+
+        auto per_solve = [ROUNDS](Clock::duration d) {
+            return std::chrono::duration<double, std::micro>(d).count() /
+                   ROUNDS;
+        };
+        std::cout << "n = " << n << ": Hungarian " << per_solve(hungarian)
+                  << " µs, SmallAssignment " << per_solve(small)
+                  << " µs, one row changed " << per_solve(incremental)
+                  << " µs (" << sink << ")\n";
+    }
+}
+}
@@ -0,0 +1,95 @@
+#include "util/task_graph.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+
+namespace
+{
+TEST(TaskGraphTest, empty_graph)
+{
+    TaskGraph graph(2);
+    EXPECT_EQ(2U, graph.threads());
+    graph.run();
+}
+
+TEST(TaskGraphTest, rejects_unknown_dependency)
+{
+    TaskGraph graph(0);
+    TaskGraph::Task a = graph.add([]() {});
+    EXPECT_THROW(graph.add([]() {}, {a + 1}), std::invalid_argument);
+}
+
+TEST(TaskGraphTest, dependencies_finish_first)
+{
+    TaskGraph graph(3);
+    for (unsigned int round = 0; round != 100; ++round)
+    {
+        // A diamond: b and c after a, d after both.
+        std::atomic<unsigned int> clock(0);
+        unsigned int a_done = 0, b_done = 0, c_done = 0, b_start = 0,
+                     c_start = 0, d_start = 0;
+        graph.clear();
+        TaskGraph::Task a = graph.add([&]() { a_done = ++clock; });
+        TaskGraph::Task b = graph.add(
+            [&]() {
+                b_start = ++clock;
+                b_done  = ++clock;
+            },
+            {a});
+        TaskGraph::Task c = graph.add(
+            [&]() {
+                c_start = ++clock;
+                c_done  = ++clock;
+            },
+            {a});
+        graph.add([&]() { d_start = ++clock; }, {b, c});
+        graph.run();
+        EXPECT_LT(a_done, b_start);
+        EXPECT_LT(a_done, c_start);
+        EXPECT_LT(b_done, d_start);
+        EXPECT_LT(c_done, d_start);
+        EXPECT_EQ(6U, clock.load());
+    }
+}
+
+TEST(TaskGraphTest, serial_runs_in_order)
+{
+    TaskGraph graph(2);
+    std::vector<int> order;
+    graph.add([&]() { order.push_back(0); });
+    graph.add([&]() { order.push_back(1); });
+    graph.add([&]() { order.push_back(2); });
+    graph.run(false);
+    EXPECT_EQ(std::vector<int>({0, 1, 2}), order);
+}
+
+TEST(TaskGraphTest, independent_tasks_all_run)
+{
+    TaskGraph graph(3);
+    std::atomic<unsigned int> count(0);
+    for (unsigned int i = 0; i != 50; ++i)
+    {
+        graph.add([&]() { ++count; });
+    }
+    graph.run();
+    graph.run();
+    EXPECT_EQ(100U, count.load());
+}
+
+TEST(TaskGraphTest, exception_skips_dependents)
+{
+    TaskGraph graph(2);
+    bool dependent_ran  = false;
+    TaskGraph::Task bad = graph.add([]() { throw std::runtime_error("bad"); });
+    graph.add([&]() { dependent_ran = true; }, {bad});
+    EXPECT_THROW(graph.run(), std::runtime_error);
+    EXPECT_FALSE(dependent_ran);
+
+    // The graph can run again afterwards.
+    graph.clear();
+    bool ran = false;
+    graph.add([&]() { ran = true; });
+    graph.run();
+    EXPECT_TRUE(ran);
+}
+}
@@ -0,0 +1,55 @@
+#include "util/tick_counter.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace
+{
+TEST(TickCounterTest, registers_while_alive)
+{
+    {
+        TickCounter counter("registers");
+        const std::vector<TickCounter *> &all = TickCounter::all();
+        EXPECT_NE(all.end(), std::find(all.begin(), all.end(), &counter));
+        EXPECT_STREQ("registers", counter.name());
+    }
+    for (const TickCounter *i : TickCounter::all())
+    {
+        EXPECT_STRNE("registers", i->name());
+    }
+}
+
+TEST(TickCounterTest, reset_all_clears_every_counter)
+{
+    TickCounter a("a"), b("b");
+    a.increment();
+    a.increment();
+    b.increment();
+    EXPECT_EQ(2U, a.count());
+    EXPECT_EQ(1U, b.count());
+    TickCounter::reset_all();
+    EXPECT_EQ(0U, a.count());
+    EXPECT_EQ(0U, b.count());
+}
+
+TEST(TickCounterTest, counts_from_many_threads)
+{
+    TickCounter counter("threads");
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i != 4; ++i)
+    {
+        threads.emplace_back([&counter]() {
+            for (unsigned int j = 0; j != 1000; ++j)
+            {
+                counter.increment();
+            }
+        });
+    }
+    for (std::thread &i : threads)
+    {
+        i.join();
+    }
+    EXPECT_EQ(4000U, counter.count());
+}
+}
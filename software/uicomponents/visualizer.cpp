@@ -2,8 +2,21 @@
 #include <glibmm/refptr.h>
 #include <gtkmm/window.h>
 #include <cmath>
+#include <stdexcept>
 
-Visualizer::Visualizer(Visualizable::World &data)
+namespace
+{
+unsigned int frame_interval_ms(unsigned int max_frame_rate)
+{
+    if (!max_frame_rate)
+    {
+        throw std::invalid_argument(u8"Visualizer frame rate must be nonzero");
+    }
+    return (1000 + max_frame_rate / 2) / max_frame_rate;
+}
+}
+
+Visualizer::Visualizer(Visualizable::World &data, unsigned int max_frame_rate)
     : show_field(true),
       show_ball(true),
       show_ball_v(true),
@@ -13,7 +26,10 @@ Visualizer::Visualizer(Visualizable::World &data)
       show_robots_path(true),
       show_robots_graphs(true),
       show_overlay(true),
-      data(data)
+      data(data),
+      frame_interval(frame_interval_ms(max_frame_rate)),
+      update_pending(false),
+      field_surface_lines(false)
 {
     set_size_request(600, 600);
     add_events(Gdk::POINTER_MOTION_MASK);
@@ -30,11 +46,21 @@ Visualizer::Visualizer(Visualizable::World &data)
 
 void Visualizer::update()
 {
+    // While the frame timer runs, a frame has been drawn recently; leave it
+    // to the timer to draw the next one.
+    if (frame_timer_connection.connected())
+    {
+        update_pending = true;
+        return;
+    }
+
     const Glib::RefPtr<Gdk::Window> win(get_window());
     if (win)
     {
         win->invalidate(false);
     }
+    frame_timer_connection = Glib::signal_timeout().connect(
+        sigc::mem_fun(this, &Visualizer::on_frame_timer), frame_interval);
 }
 
 sigc::signal<void, Point> &Visualizer::signal_mouse_moved() const
@@ -52,6 +78,8 @@ void Visualizer::on_hide()
 {
     Gtk::DrawingArea::on_hide();
     update_connection.block();
+    frame_timer_connection.disconnect();
+    update_pending = false;
 }
 
 void Visualizer::on_size_allocate(Gtk::Allocation &alloc)
@@ -64,8 +92,16 @@ bool Visualizer::on_draw(const Cairo::RefPtr<Cairo::Context> &ctx)
 {
     Gtk::DrawingArea::on_draw(ctx);
 
-    // Fill the background with field-green.
-    ctx->set_source_rgb(0.0, 0.33, 0.0);
+    // The background and field lines only change with the field geometry or
+    // the widget size, so render them once and reuse the result.
+    if (!field_surface || field_surface_lines != show_field)
+    {
+        field_surface = ctx->get_target()->create_similar(
+            Cairo::CONTENT_COLOR, get_width(), get_height());
+        field_surface_lines = show_field;
+        draw_field(Cairo::Context::create(field_surface));
+    }
+    ctx->set_source(field_surface, 0.0, 0.0);
     ctx->paint();
 
     // If the field data is invalid, go no further.
@@ -80,102 +116,6 @@ bool Visualizer::on_draw(const Cairo::RefPtr<Cairo::Context> &ctx)
     ctx->scale(scale, -scale);
     ctx->set_line_width(0.01);
 
-    if (show_field)
-    {
-        // Draw the outline of the referee area.
-        ctx->set_source_rgb(0.0, 0.0, 0.0);
-        ctx->move_to(
-            -data.field().total_length() / 2.0,
-            -data.field().total_width() / 2.0);
-        ctx->line_to(
-            data.field().total_length() / 2.0,
-            -data.field().total_width() / 2.0);
-        ctx->line_to(
-            data.field().total_length() / 2.0,
-            data.field().total_width() / 2.0);
-        ctx->line_to(
-            -data.field().total_length() / 2.0,
-            data.field().total_width() / 2.0);
-        ctx->line_to(
-            -data.field().total_length() / 2.0,
-            -data.field().total_width() / 2.0);
-        ctx->stroke();
-
-        // Draw the rectangular outline.
-        ctx->set_source_rgb(1.0, 1.0, 1.0);
-        ctx->move_to(-data.field().length() / 2.0, -data.field().width() / 2.0);
-        ctx->line_to(data.field().length() / 2.0, -data.field().width() / 2.0);
-        ctx->line_to(data.field().length() / 2.0, data.field().width() / 2.0);
-        ctx->line_to(-data.field().length() / 2.0, data.field().width() / 2.0);
-        ctx->line_to(-data.field().length() / 2.0, -data.field().width() / 2.0);
-        ctx->stroke();
-
-        // Draw the centre line.
-        ctx->move_to(0.0, -data.field().width() / 2.0);
-        ctx->line_to(0.0, data.field().width() / 2.0);
-        ctx->stroke();
-
-        // Draw the centre circle.
-        ctx->arc(0.0, 0.0, data.field().centre_circle_radius(), 0.0, 2 * M_PI);
-        ctx->stroke();
-
-        // Draw the west defense area.
-        ctx->move_to(
-            -data.field().length() / 2.0,
-            data.field().defense_area_stretch() / 2.0);
-        ctx->line_to(
-            -data.field().length() / 2.0 + data.field().defense_area_width(),
-            data.field().defense_area_stretch() / 2.0);
-        ctx->line_to(
-            -data.field().length() / 2.0 + data.field().defense_area_width(),
-            -data.field().defense_area_stretch() / 2.0);
-        ctx->line_to(
-            -data.field().length() / 2.0,
-            -data.field().defense_area_stretch() / 2.0);
-        ctx->stroke();
-
-        // Draw the east defense area.
-        ctx->move_to(
-            data.field().length() / 2.0,
-            data.field().defense_area_stretch() / 2.0);
-        ctx->line_to(
-            data.field().length() / 2.0 - data.field().defense_area_width(),
-            data.field().defense_area_stretch() / 2.0);
-        ctx->line_to(
-            data.field().length() / 2.0 - data.field().defense_area_width(),
-            -data.field().defense_area_stretch() / 2.0);
-        ctx->line_to(
-            data.field().length() / 2.0,
-            -data.field().defense_area_stretch() / 2.0);
-        ctx->stroke();
-
-        // Draw the east goal.
-        ctx->move_to(
-            -data.field().length() / 2.0, data.field().goal_width() / 2.0);
-        ctx->line_to(
-            -data.field().length() / 2.0 - data.field().goal_width() / 3.0,
-            data.field().goal_width() / 2.0);
-        ctx->line_to(
-            -data.field().length() / 2.0 - data.field().goal_width() / 3.0,
-            -data.field().goal_width() / 2.0);
-        ctx->line_to(
-            -data.field().length() / 2.0, -data.field().goal_width() / 2.0);
-        ctx->stroke();
-
-        // Draw the west goal.
-        ctx->move_to(
-            data.field().length() / 2.0, data.field().goal_width() / 2.0);
-        ctx->line_to(
-            data.field().length() / 2.0 + data.field().goal_width() / 3.0,
-            data.field().goal_width() / 2.0);
-        ctx->line_to(
-            data.field().length() / 2.0 + data.field().goal_width() / 3.0,
-            -data.field().goal_width() / 2.0);
-        ctx->line_to(
-            data.field().length() / 2.0, -data.field().goal_width() / 2.0);
-        ctx->stroke();
-    }
-
     if (show_robots)
     {
         // Set font size for displaying robot pattern indices.
@@ -366,6 +306,9 @@ bool Visualizer::on_leave_notify_event(GdkEventCrossing *)
 
 void Visualizer::compute_scales()
 {
+    // Both callers mean the cached field drawing no longer matches.
+    field_surface.clear();
+
     if (data.field().valid())
     {
         int width     = get_width();
@@ -377,3 +320,133 @@ void Visualizer::compute_scales()
         ytranslate    = height / 2.0;
     }
 }
+
+bool Visualizer::on_frame_timer()
+{
+    if (!update_pending)
+    {
+        return false;
+    }
+    update_pending = false;
+    const Glib::RefPtr<Gdk::Window> win(get_window());
+    if (win)
+    {
+        win->invalidate(false);
+    }
+    return true;
+}
+
+void Visualizer::draw_field(const Cairo::RefPtr<Cairo::Context> &ctx)
+{
+    // Fill the background with field-green.
+    ctx->set_source_rgb(0.0, 0.33, 0.0);
+    ctx->paint();
+
+    // If the field data is invalid, go no further.
+    if (!data.field().valid())
+    {
+        return;
+    }
+
+    // Establish the proper transformation from world coordinates to graphical
+    // coordinates.
+    ctx->translate(xtranslate, ytranslate);
+    ctx->scale(scale, -scale);
+    ctx->set_line_width(0.01);
+
+    if (show_field)
+    {
+        // Draw the outline of the referee area.
+        ctx->set_source_rgb(0.0, 0.0, 0.0);
+        ctx->move_to(
+            -data.field().total_length() / 2.0,
+            -data.field().total_width() / 2.0);
+        ctx->line_to(
+            data.field().total_length() / 2.0,
+            -data.field().total_width() / 2.0);
+        ctx->line_to(
+            data.field().total_length() / 2.0,
+            data.field().total_width() / 2.0);
+        ctx->line_to(
+            -data.field().total_length() / 2.0,
+            data.field().total_width() / 2.0);
+        ctx->line_to(
+            -data.field().total_length() / 2.0,
+            -data.field().total_width() / 2.0);
+        ctx->stroke();
+
+        // Draw the rectangular outline.
+        ctx->set_source_rgb(1.0, 1.0, 1.0);
+        ctx->move_to(-data.field().length() / 2.0, -data.field().width() / 2.0);
+        ctx->line_to(data.field().length() / 2.0, -data.field().width() / 2.0);
+        ctx->line_to(data.field().length() / 2.0, data.field().width() / 2.0);
+        ctx->line_to(-data.field().length() / 2.0, data.field().width() / 2.0);
+        ctx->line_to(-data.field().length() / 2.0, -data.field().width() / 2.0);
+        ctx->stroke();
+
+        // Draw the centre line.
+        ctx->move_to(0.0, -data.field().width() / 2.0);
+        ctx->line_to(0.0, data.field().width() / 2.0);
+        ctx->stroke();
+
+        // Draw the centre circle.
+        ctx->arc(0.0, 0.0, data.field().centre_circle_radius(), 0.0, 2 * M_PI);
+        ctx->stroke();
+
+        // Draw the west defense area.
+        ctx->move_to(
+            -data.field().length() / 2.0,
+            data.field().defense_area_stretch() / 2.0);
+        ctx->line_to(
+            -data.field().length() / 2.0 + data.field().defense_area_width(),
+            data.field().defense_area_stretch() / 2.0);
+        ctx->line_to(
+            -data.field().length() / 2.0 + data.field().defense_area_width(),
+            -data.field().defense_area_stretch() / 2.0);
+        ctx->line_to(
+            -data.field().length() / 2.0,
+            -data.field().defense_area_stretch() / 2.0);
+        ctx->stroke();
+
+        // Draw the east defense area.
+        ctx->move_to(
+            data.field().length() / 2.0,
+            data.field().defense_area_stretch() / 2.0);
+        ctx->line_to(
+            data.field().length() / 2.0 - data.field().defense_area_width(),
+            data.field().defense_area_stretch() / 2.0);
+        ctx->line_to(
+            data.field().length() / 2.0 - data.field().defense_area_width(),
+            -data.field().defense_area_stretch() / 2.0);
+        ctx->line_to(
+            data.field().length() / 2.0,
+            -data.field().defense_area_stretch() / 2.0);
+        ctx->stroke();
+
+        // Draw the east goal.
+        ctx->move_to(
+            -data.field().length() / 2.0, data.field().goal_width() / 2.0);
+        ctx->line_to(
+            -data.field().length() / 2.0 - data.field().goal_width() / 3.0,
+            data.field().goal_width() / 2.0);
+        ctx->line_to(
+            -data.field().length() / 2.0 - data.field().goal_width() / 3.0,
+            -data.field().goal_width() / 2.0);
+        ctx->line_to(
+            -data.field().length() / 2.0, -data.field().goal_width() / 2.0);
+        ctx->stroke();
+
+        // Draw the west goal.
+        ctx->move_to(
+            data.field().length() / 2.0, data.field().goal_width() / 2.0);
+        ctx->line_to(
+            data.field().length() / 2.0 + data.field().goal_width() / 3.0,
+            data.field().goal_width() / 2.0);
+        ctx->line_to(
+            data.field().length() / 2.0 + data.field().goal_width() / 3.0,
+            -data.field().goal_width() / 2.0);
+        ctx->line_to(
+            data.field().length() / 2.0, -data.field().goal_width() / 2.0);
+        ctx->stroke();
+    }
+}
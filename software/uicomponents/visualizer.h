@@ -400,11 +400,21 @@ class Visualizer final : public Gtk::DrawingArea
      * Constructs a new Visualizer.
      *
      * \param[in] data the Visualizable data source to display.
+     *
+     * \param[in] max_frame_rate the largest number of times per second to
+     * redraw, regardless of how often the data source ticks.
+     *
+     * \exception std::invalid_argument if \p max_frame_rate is zero.
      */
-    explicit Visualizer(Visualizable::World &data);
+    explicit Visualizer(
+        Visualizable::World &data, unsigned int max_frame_rate = 20);
 
     /**
-     * Redraws the Visualizer.
+     * Schedules a redraw of the Visualizer.
+     *
+     * The redraw happens immediately if the last one was long enough ago, or
+     * otherwise once the frame rate limit allows it; any number of updates in
+     * between are merged into one redraw.
      */
     void update();
 
@@ -417,9 +427,14 @@ class Visualizer final : public Gtk::DrawingArea
 
    private:
     Visualizable::World &data;
+    const unsigned int frame_interval;
     double scale;
     double xtranslate, ytranslate;
     sigc::connection update_connection;
+    sigc::connection frame_timer_connection;
+    bool update_pending;
+    Cairo::RefPtr<Cairo::Surface> field_surface;
+    bool field_surface_lines;
     mutable sigc::signal<void, Point> signal_mouse_moved_;
 
     void on_show() override;
@@ -432,6 +447,8 @@ class Visualizer final : public Gtk::DrawingArea
     bool on_leave_notify_event(GdkEventCrossing *evt) override;
 
     void compute_scales();
+    bool on_frame_timer();
+    void draw_field(const Cairo::RefPtr<Cairo::Context> &ctx);
     double xtow(double x) __attribute__((warn_unused_result))
     {
         return (x - xtranslate) / scale;
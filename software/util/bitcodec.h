@@ -45,6 +45,16 @@
  * measured in bits, and will consume 1 bit.
  * When a new instance of the structure is created without decoding a buffer,
  * the field will be given the default value \p def.</dd>
+ *
+ * <dt>BITCODEC_DATA_U_LE(type, name, offset, length, def)</dt>
+ * <dd>Like \c BITCODEC_DATA_U, but the field is stored in little-endian byte
+ * order.
+ * Both \p offset and \p length must be multiples of 8.</dd>
+ *
+ * <dt>BITCODEC_DATA_S_LE(type, utype, name, offset, length, def)</dt>
+ * <dd>Like \c BITCODEC_DATA_S, but the field is stored in little-endian byte
+ * order.
+ * Both \p offset and \p length must be multiples of 8.</dd>
  * </dl>
  *
  * You will end up with a structure of the requested name containing the
@@ -63,6 +73,18 @@
  * compile-time constant and indicates the proper length for the buffers passed
  * to the constructor and \c encode function.
  *
+ * If, in your \c .h file, you also define the symbol \c BITCODEC_VIEW_NAME, you
+ * will additionally get a class of that name which reads the fields in place:
+ * \li a constructor <code>BITCODEC_VIEW_NAME(const void *buffer)</code> which
+ * remembers \p buffer without reading it.
+ * \li a const member function of the requested type and name for each declared
+ * field, which decodes only that field from the buffer each time it is called.
+ *
+ * The buffer must hold at least the structure’s \c BUFFER_SIZE bytes and must
+ * outlive the view.
+ * A view suits a packet that is received, read once, and discarded, since
+ * nothing is copied and fields that are never asked for are never decoded.
+ *
  * It is legal for some bits to remain unused in the structure.
  * Unused bits are ignored by the constructor when decoding a packed structure.
  * Unused bits are zeroed by \c encode when encoding a packed structure.
@@ -115,10 +137,15 @@ struct BITCODEC_STRUCT_NAME final
 #define BITCODEC_DATA_U(type, name, offset, length, def) , offset, length
 #define BITCODEC_DATA_S(type, utype, name, offset, length, def) , offset, length
 #define BITCODEC_DATA_BOOL(name, offset, def) , offset, 1
+#define BITCODEC_DATA_U_LE(type, name, offset, length, def) , offset, length
+#define BITCODEC_DATA_S_LE(type, utype, name, offset, length, def)             \
+    , offset, length
 #include BITCODEC_DEF_FILE
 #undef BITCODEC_DATA_U
 #undef BITCODEC_DATA_S
 #undef BITCODEC_DATA_BOOL
+#undef BITCODEC_DATA_U_LE
+#undef BITCODEC_DATA_S_LE
             >::BYTES;
 
     explicit BITCODEC_STRUCT_NAME();
@@ -139,10 +166,16 @@ struct BITCODEC_STRUCT_NAME final
         "Element target type and unsigned type must be equal sizes.");         \
     type name;
 #define BITCODEC_DATA_BOOL(name, offset, def) bool name;
+#define BITCODEC_DATA_U_LE(type, name, offset, length, def)                    \
+    BITCODEC_DATA_U(type, name, offset, length, def)
+#define BITCODEC_DATA_S_LE(type, utype, name, offset, length, def)             \
+    BITCODEC_DATA_S(type, utype, name, offset, length, def)
 #include BITCODEC_DEF_FILE
 #undef BITCODEC_DATA_U
 #undef BITCODEC_DATA_S
 #undef BITCODEC_DATA_BOOL
+#undef BITCODEC_DATA_U_LE
+#undef BITCODEC_DATA_S_LE
 };
 
 bool operator==(const BITCODEC_STRUCT_NAME &x, const BITCODEC_STRUCT_NAME &y)
@@ -150,6 +183,55 @@ bool operator==(const BITCODEC_STRUCT_NAME &x, const BITCODEC_STRUCT_NAME &y)
 
 bool operator!=(const BITCODEC_STRUCT_NAME &x, const BITCODEC_STRUCT_NAME &y)
     __attribute__((unused));
+
+#if defined BITCODEC_VIEW_NAME
+class BITCODEC_VIEW_NAME final
+{
+   public:
+    explicit BITCODEC_VIEW_NAME(const void *buffer) : buffer_(buffer)
+    {
+    }
+
+#define BITCODEC_DATA_U(type, name, offset, length, def)                       \
+    type name() const                                                          \
+    {                                                                          \
+        return BitcodecPrimitives::Decoder<type, offset, length>()(buffer_);   \
+    }
+#define BITCODEC_DATA_S(type, utype, name, offset, length, def)                \
+    type name() const                                                          \
+    {                                                                          \
+        return BitcodecPrimitives::SignExtender<type, utype, length>()(        \
+            BitcodecPrimitives::Decoder<utype, offset, length>()(buffer_));    \
+    }
+#define BITCODEC_DATA_BOOL(name, offset, def)                                  \
+    bool name() const                                                          \
+    {                                                                          \
+        return !!BitcodecPrimitives::Decoder<uint8_t, offset, 1>()(buffer_);   \
+    }
+#define BITCODEC_DATA_U_LE(type, name, offset, length, def)                    \
+    type name() const                                                          \
+    {                                                                          \
+        return BitcodecPrimitives::LittleEndianDecoder<                        \
+            type, offset, length>()(buffer_);                                  \
+    }
+#define BITCODEC_DATA_S_LE(type, utype, name, offset, length, def)             \
+    type name() const                                                          \
+    {                                                                          \
+        return BitcodecPrimitives::SignExtender<type, utype, length>()(        \
+            BitcodecPrimitives::LittleEndianDecoder<utype, offset, length>()(  \
+                buffer_));                                                     \
+    }
+#include BITCODEC_DEF_FILE
+#undef BITCODEC_DATA_U
+#undef BITCODEC_DATA_S
+#undef BITCODEC_DATA_BOOL
+#undef BITCODEC_DATA_U_LE
+#undef BITCODEC_DATA_S_LE
+
+   private:
+    const void *buffer_;
+};
+#endif
 BITCODEC_NS_END
 
 static_assert(
@@ -158,10 +240,15 @@ static_assert(
 #define BITCODEC_DATA_U(type, name, offset, length, def) , offset, length
 #define BITCODEC_DATA_S(type, utype, name, offset, length, def) , offset, length
 #define BITCODEC_DATA_BOOL(name, offset, def) , offset, 1
+#define BITCODEC_DATA_U_LE(type, name, offset, length, def) , offset, length
+#define BITCODEC_DATA_S_LE(type, utype, name, offset, length, def)             \
+    , offset, length
 #include BITCODEC_DEF_FILE
 #undef BITCODEC_DATA_U
 #undef BITCODEC_DATA_S
 #undef BITCODEC_DATA_BOOL
+#undef BITCODEC_DATA_U_LE
+#undef BITCODEC_DATA_S_LE
         >::OK,
     "Packet fields overlap!");
 #endif
@@ -175,10 +262,15 @@ BITCODEC_NS_PREFIX BITCODEC_STRUCT_NAME::BITCODEC_STRUCT_NAME()
 #define BITCODEC_DATA_S(type, utype, name, offset, length, def)                \
     this->name = def;
 #define BITCODEC_DATA_BOOL(name, offset, def) this->name = def;
+#define BITCODEC_DATA_U_LE(type, name, offset, length, def) this->name = def;
+#define BITCODEC_DATA_S_LE(type, utype, name, offset, length, def)             \
+    this->name = def;
 #include BITCODEC_DEF_FILE
 #undef BITCODEC_DATA_U
 #undef BITCODEC_DATA_S
 #undef BITCODEC_DATA_BOOL
+#undef BITCODEC_DATA_U_LE
+#undef BITCODEC_DATA_S_LE
 }
 
 BITCODEC_NS_PREFIX BITCODEC_STRUCT_NAME::BITCODEC_STRUCT_NAME(
@@ -191,10 +283,20 @@ BITCODEC_NS_PREFIX BITCODEC_STRUCT_NAME::BITCODEC_STRUCT_NAME(
         BitcodecPrimitives::Decoder<utype, offset, length>()(buffer));
 #define BITCODEC_DATA_BOOL(name, offset, def)                                  \
     this->name = !!BitcodecPrimitives::Decoder<uint8_t, offset, 1>()(buffer);
+#define BITCODEC_DATA_U_LE(type, name, offset, length, def)                    \
+    this->name =                                                               \
+        BitcodecPrimitives::LittleEndianDecoder<type, offset, length>()(       \
+            buffer);
+#define BITCODEC_DATA_S_LE(type, utype, name, offset, length, def)             \
+    this->name = BitcodecPrimitives::SignExtender<type, utype, length>()(      \
+        BitcodecPrimitives::LittleEndianDecoder<utype, offset, length>()(      \
+            buffer));
 #include BITCODEC_DEF_FILE
 #undef BITCODEC_DATA_U
 #undef BITCODEC_DATA_S
 #undef BITCODEC_DATA_BOOL
+#undef BITCODEC_DATA_U_LE
+#undef BITCODEC_DATA_S_LE
 }
 
 void BITCODEC_NS_PREFIX BITCODEC_STRUCT_NAME::encode(void *buffer) const
@@ -210,10 +312,18 @@ void BITCODEC_NS_PREFIX BITCODEC_STRUCT_NAME::encode(void *buffer) const
 #define BITCODEC_DATA_BOOL(name, offset, def)                                  \
     BitcodecPrimitives::Encoder<uint8_t, offset, 1>()(                         \
         buffer, this->name ? 1 : 0);
+#define BITCODEC_DATA_U_LE(type, name, offset, length, def)                    \
+    BitcodecPrimitives::LittleEndianEncoder<type, offset, length>()(           \
+        buffer, this->name);
+#define BITCODEC_DATA_S_LE(type, utype, name, offset, length, def)             \
+    BitcodecPrimitives::LittleEndianEncoder<utype, offset, length>()(          \
+        buffer, static_cast<utype>(this->name));
 #include BITCODEC_DEF_FILE
 #undef BITCODEC_DATA_U
 #undef BITCODEC_DATA_S
 #undef BITCODEC_DATA_BOOL
+#undef BITCODEC_DATA_U_LE
+#undef BITCODEC_DATA_S_LE
 }
 
 BITCODEC_NS_BEGIN
@@ -226,10 +336,15 @@ bool operator==(
 #define BITCODEC_DATA_S(type, utype, name, offset, length, def)                \
     &&x.name == y.name
 #define BITCODEC_DATA_BOOL(name, offset, def) &&x.name == y.name
+#define BITCODEC_DATA_U_LE(type, name, offset, length, def) &&x.name == y.name
+#define BITCODEC_DATA_S_LE(type, utype, name, offset, length, def)             \
+    &&x.name == y.name
 #include BITCODEC_DEF_FILE
 #undef BITCODEC_DATA_U
 #undef BITCODEC_DATA_S
 #undef BITCODEC_DATA_BOOL
+#undef BITCODEC_DATA_U_LE
+#undef BITCODEC_DATA_S_LE
         ;
 }
 
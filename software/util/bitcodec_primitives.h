@@ -129,6 +129,93 @@ class Decoder<T, Offset, 0> final
 };
 /** \endcond */
 
+/**
+ * \brief Encodes a single little-endian field into whole bytes of a buffer.
+ *
+ * \tparam T the type of the field, which must be an unsigned integral type.
+ *
+ * \tparam Offset the offset into the buffer at which to store the field,
+ * measured in bits, which must be a multiple of 8.
+ *
+ * \tparam Length the number of bits to use to store the field, which must be
+ * a multiple of 8.
+ */
+template <typename T, std::size_t Offset, std::size_t Length>
+class LittleEndianEncoder final
+{
+   public:
+    /**
+     * \brief Executes the encoding operation.
+     *
+     * \param[out] buffer the buffer to store the field into.
+     *
+     * \param[in] value the field value to store.
+     */
+    void operator()(void *buffer, T value) const
+    {
+        uint8_t *p = static_cast<uint8_t *>(buffer) + (Offset / 8);
+        for (std::size_t i = 0; i != Length / 8; ++i)
+        {
+            p[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+   private:
+    static_assert(sizeof(T) <= 8, "value must be no larger than a uint64_t!");
+    static_assert(
+        sizeof(T) * 8 >= Length,
+        "value must be large enough to hold \"Length\" bits!");
+    static_assert(Length, "Length must be nonzero!");
+    static_assert(
+        !(Offset % 8) && !(Length % 8),
+        "little-endian fields must occupy whole bytes!");
+};
+
+/**
+ * \brief Extracts and decodes a single little-endian field from whole bytes of
+ * a buffer.
+ *
+ * \tparam T the type of the field, which must be an unsigned integral type.
+ *
+ * \tparam Offset the offset into the buffer at which to extract the field,
+ * measured in bits, which must be a multiple of 8.
+ *
+ * \tparam Length the number of bits to extract from the buffer, which must be
+ * a multiple of 8.
+ */
+template <typename T, std::size_t Offset, std::size_t Length>
+class LittleEndianDecoder final
+{
+   public:
+    /**
+     * \brief Executes the decoding operation.
+     *
+     * \param[in] buffer the buffer to extract the field from.
+     *
+     * \return the field value.
+     */
+    T operator()(const void *buffer) const
+    {
+        const uint8_t *p = static_cast<const uint8_t *>(buffer) + (Offset / 8);
+        T value          = 0;
+        for (std::size_t i = 0; i != Length / 8; ++i)
+        {
+            value = static_cast<T>(value | (static_cast<T>(p[i]) << (8 * i)));
+        }
+        return value;
+    }
+
+   private:
+    static_assert(sizeof(T) <= 8, "value must be no larger than a uint64_t!");
+    static_assert(
+        sizeof(T) * 8 >= Length,
+        "value must be large enough to hold \"Length\" bits!");
+    static_assert(Length, "Length must be nonzero!");
+    static_assert(
+        !(Offset % 8) && !(Length % 8),
+        "little-endian fields must occupy whole bytes!");
+};
+
 template <std::size_t... Elements>
 struct OverlapChecker;
 
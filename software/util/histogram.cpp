@@ -0,0 +1,64 @@
+#include "util/histogram.h"
+#include <algorithm>
+#include <cmath>
+
+constexpr std::size_t LatencyHistogram::NUM_BUCKETS;
+
+LatencyHistogram::LatencyHistogram(Duration bucket_width)
+    : bucket_width_(bucket_width)
+{
+    reset();
+}
+
+void LatencyHistogram::record(Duration sample)
+{
+    if (sample.count() < 0)
+    {
+        sample = Duration::zero();
+    }
+    std::size_t index =
+        static_cast<std::size_t>(sample.count() / bucket_width_.count());
+    ++buckets[std::min(index, NUM_BUCKETS)];
+    ++count_;
+    total += sample.count();
+    max_ = std::max(max_, sample);
+}
+
+void LatencyHistogram::reset()
+{
+    buckets.fill(0);
+    count_ = 0;
+    total  = 0;
+    max_   = Duration::zero();
+}
+
+LatencyHistogram::Duration LatencyHistogram::mean() const
+{
+    if (!count_)
+    {
+        return Duration::zero();
+    }
+    return Duration(total / static_cast<Duration::rep>(count_));
+}
+
+LatencyHistogram::Duration LatencyHistogram::percentile(double fraction) const
+{
+    if (!count_)
+    {
+        return Duration::zero();
+    }
+    uint64_t target = static_cast<uint64_t>(std::ceil(
+        std::min(std::max(fraction, 0.0), 1.0) * static_cast<double>(count_)));
+    target       = std::max<uint64_t>(target, 1);
+    uint64_t acc = 0;
+    for (std::size_t i = 0; i != NUM_BUCKETS; ++i)
+    {
+        acc += buckets[i];
+        if (acc >= target)
+        {
+            return std::min(
+                max_, bucket_width_ * static_cast<Duration::rep>(i + 1));
+        }
+    }
+    return max_;
+}
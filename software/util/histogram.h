@@ -0,0 +1,117 @@
+#ifndef UTIL_HISTOGRAM_H
+#define UTIL_HISTOGRAM_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * \brief A fixed-size histogram of latency samples.
+ *
+ * Samples are counted into buckets of equal width; anything beyond the last
+ * bucket is counted in an overflow bucket. Recording a sample never allocates,
+ * so it is safe to use from hot paths such as USB completion callbacks.
+ */
+class LatencyHistogram final
+{
+   public:
+    /**
+     * \brief The type of a latency sample.
+     */
+    typedef std::chrono::microseconds Duration;
+
+    /**
+     * \brief The number of regular (non-overflow) buckets.
+     */
+    static constexpr std::size_t NUM_BUCKETS = 200;
+
+    /**
+     * \brief Constructs an empty histogram.
+     *
+     * \param[in] bucket_width the width of each bucket
+     */
+    explicit LatencyHistogram(Duration bucket_width = Duration(250));
+
+    /**
+     * \brief Adds a sample to the histogram.
+     *
+     * \param[in] sample the sample to add; negative samples are counted as
+     * zero
+     */
+    void record(Duration sample);
+
+    /**
+     * \brief Discards all samples.
+     */
+    void reset();
+
+    /**
+     * \brief Returns the number of samples recorded.
+     *
+     * \return the sample count
+     */
+    uint64_t count() const
+    {
+        return count_;
+    }
+
+    /**
+     * \brief Returns the largest sample recorded.
+     *
+     * \return the maximum, or zero if no samples have been recorded
+     */
+    Duration max() const
+    {
+        return max_;
+    }
+
+    /**
+     * \brief Returns the mean of the samples recorded.
+     *
+     * \return the mean, or zero if no samples have been recorded
+     */
+    Duration mean() const;
+
+    /**
+     * \brief Returns an upper bound on a percentile of the samples.
+     *
+     * \param[in] fraction the percentile to compute, between 0 and 1
+     *
+     * \return the upper edge of the bucket containing the requested
+     * percentile, or \ref max() if it falls in the overflow bucket
+     */
+    Duration percentile(double fraction) const;
+
+    /**
+     * \brief Returns the width of each bucket.
+     *
+     * \return the bucket width
+     */
+    Duration bucket_width() const
+    {
+        return bucket_width_;
+    }
+
+    /**
+     * \brief Returns the number of samples in a bucket.
+     *
+     * \param[in] index the bucket index, where \ref NUM_BUCKETS is the
+     * overflow bucket
+     *
+     * \return the number of samples in the bucket
+     */
+    uint64_t bucket(std::size_t index) const
+    {
+        return buckets[index];
+    }
+
+   private:
+    Duration bucket_width_;
+    std::array<uint64_t, NUM_BUCKETS + 1> buckets;
+    uint64_t count_;
+    Duration::rep total;
+    Duration max_;
+};
+
+#endif
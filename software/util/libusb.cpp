@@ -227,7 +227,7 @@ USB::TransferCancelledError::TransferCancelledError(unsigned int endpoint)
 {
 }
 
-USB::Context::Context()
+USB::Context::Context(int priority) : priority(priority)
 {
     check_fn("libusb_init", libusb_init(&context), 0);
     const libusb_pollfd **pfds = libusb_get_pollfds(context);
@@ -274,7 +274,7 @@ void USB::Context::add_pollfd(int fd, short events)
     fd_connections[fd] = Glib::signal_io().connect(
         sigc::bind_return(
             sigc::hide(sigc::mem_fun(this, &Context::handle_usb_fds)), true),
-        fd, cond);
+        fd, cond, priority);
 }
 
 void USB::Context::remove_pollfd(int fd)
@@ -924,17 +924,30 @@ USB::BulkInTransfer::BulkInTransfer(
 USB::BulkOutTransfer::BulkOutTransfer(
     DeviceHandle &dev, unsigned char endpoint, const void *data,
     std::size_t len, std::size_t max_len, unsigned int timeout)
-    : Transfer(dev)
+    : Transfer(dev), capacity(std::max(len, max_len)), max_len(max_len)
 {
     assert((endpoint & LIBUSB_ENDPOINT_ADDRESS_MASK) == endpoint);
     libusb_fill_bulk_transfer(
         transfer, dev.handle, endpoint | LIBUSB_ENDPOINT_OUT,
-        new unsigned char[len], static_cast<int>(len),
+        new unsigned char[capacity], static_cast<int>(len),
         &usb_transfer_handle_completed_transfer_trampoline, transfer->user_data,
         timeout);
+    refill(data, len);
+}
+
+void USB::BulkOutTransfer::refill(const void *data, std::size_t len)
+{
+    assert(!submitted_);
+    assert(len <= capacity);
+    transfer->length = static_cast<int>(len);
     if (!max_len || len != max_len)
     {
         transfer->flags |= LIBUSB_TRANSFER_ADD_ZERO_PACKET;
     }
+    else
+    {
+        transfer->flags &=
+            static_cast<uint8_t>(~LIBUSB_TRANSFER_ADD_ZERO_PACKET);
+    }
     std::memcpy(transfer->buffer, data, len);
 }
@@ -116,8 +116,12 @@ class Context final : public NonCopyable
    public:
     /**
      * \brief Initializes the library and creates a context.
+     *
+     * \param[in] priority the main loop priority at which to handle USB
+     * events; raising it above the default lets transfer completions be
+     * processed ahead of redraws and idle handlers
      */
-    explicit Context();
+    explicit Context(int priority = G_PRIORITY_DEFAULT);
 
     /**
      * \brief Deinitializes the library and destroys the context.
@@ -135,6 +139,7 @@ class Context final : public NonCopyable
     friend void usb_context_pollfd_remove_trampoline(int fd, void *user_data);
 
     libusb_context *context;
+    int priority;
     std::unordered_map<int, sigc::connection> fd_connections;
 
     void add_pollfd(int fd, short events);
@@ -874,6 +879,23 @@ class BulkOutTransfer final : public Transfer
     explicit BulkOutTransfer(
         DeviceHandle &dev, unsigned char endpoint, const void *data,
         std::size_t len, std::size_t max_len, unsigned int timeout);
+
+    /**
+     * \brief Replaces the data to send, allowing the transfer to be reused
+     * without reallocating it.
+     *
+     * The transfer must not be submitted when this is called.
+     *
+     * \param[in] data the data to send, which is copied internally before the
+     * function returns
+     *
+     * \param[in] len the number of bytes to send, which must not exceed the
+     * larger of the \p len and \p max_len passed to the constructor
+     */
+    void refill(const void *data, std::size_t len);
+
+   private:
+    std::size_t capacity, max_len;
 };
 }
 
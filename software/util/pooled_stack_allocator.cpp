@@ -0,0 +1,113 @@
+#include "util/pooled_stack_allocator.h"
+#include <sys/mman.h>
+#include <unistd.h>
+#include <iterator>
+#include <mutex>
+#include <new>
+#include <vector>
+#include "util/tick_counter.h"
+
+namespace
+{
+TickCounter reused(u8"Coroutine stacks reused");
+TickCounter mapped(u8"Coroutine stacks mapped");
+
+std::mutex &pool_mutex()
+{
+    static std::mutex m;
+    return m;
+}
+
+std::vector<boost::coroutines::stack_context> &pool()
+{
+    static std::vector<boost::coroutines::stack_context> v;
+    return v;
+}
+
+std::size_t page_size()
+{
+    static const std::size_t size =
+        static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+void unmap(const boost::coroutines::stack_context &ctx)
+{
+    munmap(static_cast<char *>(ctx.sp) - ctx.size, ctx.size);
+}
+}
+
+constexpr std::size_t PooledStackAllocator::MAX_IDLE;
+
+void PooledStackAllocator::allocate(
+    boost::coroutines::stack_context &ctx, std::size_t size)
+{
+    // As in the standard allocator, the size recorded in the context covers
+    // the whole mapping, including the guard page at the bottom.
+    std::size_t page  = page_size();
+    std::size_t total = ((size + page - 1) / page + 1) * page;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex());
+        std::vector<boost::coroutines::stack_context> &v = pool();
+        for (auto i = v.rbegin(); i != v.rend(); ++i)
+        {
+            if (i->size == total)
+            {
+                ctx = *i;
+                v.erase(std::next(i).base());
+                reused.increment();
+                return;
+            }
+        }
+    }
+
+    void *base = mmap(
+        nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1,
+        0);
+    if (base == MAP_FAILED)
+    {
+        throw std::bad_alloc();
+    }
+    mprotect(base, page, PROT_NONE);
+    mapped.increment();
+    ctx.size = total;
+    ctx.sp   = static_cast<char *>(base) + total;
+}
+
+void PooledStackAllocator::deallocate(boost::coroutines::stack_context &ctx)
+{
+    if (!ctx.sp)
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex());
+        if (pool().size() < MAX_IDLE)
+        {
+            pool().push_back(ctx);
+            ctx = boost::coroutines::stack_context();
+            return;
+        }
+    }
+    unmap(ctx);
+    ctx = boost::coroutines::stack_context();
+}
+
+std::size_t PooledStackAllocator::idle()
+{
+    std::lock_guard<std::mutex> lock(pool_mutex());
+    return pool().size();
+}
+
+void PooledStackAllocator::release_idle()
+{
+    std::vector<boost::coroutines::stack_context> v;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex());
+        v.swap(pool());
+    }
+    for (const boost::coroutines::stack_context &i : v)
+    {
+        unmap(i);
+    }
+}
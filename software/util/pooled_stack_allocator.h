@@ -0,0 +1,63 @@
+#ifndef UTIL_POOLED_STACK_ALLOCATOR_H
+#define UTIL_POOLED_STACK_ALLOCATOR_H
+
+#include <boost/coroutine/stack_context.hpp>
+#include <cstddef>
+
+/**
+ * \brief A coroutine stack allocator that keeps freed stacks for reuse.
+ *
+ * This meets the Boost.Coroutine StackAllocator requirements and lays out
+ * stacks the same way as the standard allocator, with a guard page below each
+ * one. Rather than unmapping a stack when its coroutine is destroyed, though,
+ * the stack is kept in a process-wide pool and handed to the next coroutine
+ * that asks for a stack of the same size. A play switch or tactic
+ * reassignment, which destroys one coroutine and immediately creates another,
+ * then costs no system calls.
+ *
+ * Allocators are stateless handles onto the one pool, so they may be copied
+ * freely and used from any thread.
+ */
+class PooledStackAllocator final
+{
+   public:
+    /**
+     * \brief The most stacks the pool holds while they are not in use.
+     *
+     * Stacks freed while the pool is full are unmapped.
+     */
+    static constexpr std::size_t MAX_IDLE = 32;
+
+    /**
+     * \brief Provides a stack, reusing one from the pool if possible.
+     *
+     * \param[out] ctx the stack
+     * \param[in] size the minimum usable size of the stack, in bytes
+     *
+     * \exception std::bad_alloc if a new stack is needed and cannot be mapped
+     */
+    void allocate(boost::coroutines::stack_context &ctx, std::size_t size);
+
+    /**
+     * \brief Returns a stack to the pool.
+     *
+     * \param[in, out] ctx the stack, which must have come from \ref allocate
+     * and is cleared
+     */
+    void deallocate(boost::coroutines::stack_context &ctx);
+
+    /**
+     * \brief Returns the number of stacks held by the pool that are not in
+     * use.
+     *
+     * \return the number of idle stacks
+     */
+    static std::size_t idle();
+
+    /**
+     * \brief Unmaps every stack held by the pool that is not in use.
+     */
+    static void release_idle();
+};
+
+#endif
@@ -0,0 +1,195 @@
+#include "util/small_assignment.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+const double INF = std::numeric_limits<double>::infinity();
+
+unsigned int count_bits(unsigned int x)
+{
+    unsigned int count = 0;
+    for (; x; x &= x - 1)
+    {
+        ++count;
+    }
+    return count;
+}
+
+unsigned int lowest_bit(unsigned int x)
+{
+    unsigned int i = 0;
+    while (!(x & (1U << i)))
+    {
+        ++i;
+    }
+    return i;
+}
+}
+
+constexpr std::size_t SmallAssignment::MAX_SIZE;
+
+SmallAssignment::SmallAssignment(std::size_t rows, std::size_t columns)
+    : rows_(rows),
+      columns_(columns),
+      dirty_rows(0),
+      dirty_columns(0),
+      solved(false)
+{
+    if (columns > MAX_SIZE)
+    {
+        throw std::invalid_argument(u8"Too many columns for SmallAssignment");
+    }
+    if (rows > columns)
+    {
+        throw std::invalid_argument(u8"More rows than columns");
+    }
+    for (std::array<double, MAX_SIZE> &i : costs)
+    {
+        i.fill(0.0);
+    }
+}
+
+void SmallAssignment::cost(std::size_t row, std::size_t column, double value)
+{
+    assert(row < rows_);
+    assert(column < columns_);
+    if (costs[row][column] != value)
+    {
+        costs[row][column] = value;
+        dirty_rows |= 1U << row;
+        dirty_columns |= 1U << column;
+    }
+}
+
+void SmallAssignment::solve()
+{
+    if (!solved)
+    {
+        solve_all();
+    }
+    else if (count_bits(dirty_rows) == 1)
+    {
+        // Every change is in this row. Free it, lower its potential until no
+        // reduced cost in it is negative, and find it a new column.
+        std::size_t row              = lowest_bit(dirty_rows);
+        column_owner[row_match[row]] = columns_;
+        double pot                   = INF;
+        for (std::size_t j = 0; j != columns_; ++j)
+        {
+            pot = std::min(pot, costs[row][j] - column_pot[j]);
+        }
+        row_pot[row] = pot;
+        augment(row);
+    }
+    else if (count_bits(dirty_columns) == 1)
+    {
+        // Every change is in this column. Free it and its row, fix up its
+        // potential the same way, and find that row a new column.
+        std::size_t column   = lowest_bit(dirty_columns);
+        std::size_t row      = column_owner[column];
+        column_owner[column] = columns_;
+        double pot           = INF;
+        for (std::size_t i = 0; i != columns_; ++i)
+        {
+            pot = std::min(pot, costs[i][column] - row_pot[i]);
+        }
+        column_pot[column] = pot;
+        augment(row);
+    }
+    else if (dirty_rows)
+    {
+        solve_all();
+    }
+    dirty_rows    = 0;
+    dirty_columns = 0;
+}
+
+double SmallAssignment::total() const
+{
+    double sum = 0.0;
+    for (std::size_t i = 0; i != rows_; ++i)
+    {
+        sum += costs[i][row_match[i]];
+    }
+    return sum;
+}
+
+void SmallAssignment::solve_all()
+{
+    // The padding rows are never written, so they are still zero.
+    row_pot.fill(0.0);
+    column_pot.fill(0.0);
+    column_owner.fill(columns_);
+    for (std::size_t i = 0; i != columns_; ++i)
+    {
+        augment(i);
+    }
+    solved = true;
+}
+
+void SmallAssignment::augment(std::size_t row)
+{
+    // Grow a tree of tight cells from the free row, Dijkstra-style on reduced
+    // costs, until it reaches a free column; then flip the path. Index
+    // columns_ stands for a virtual column holding the free row.
+    const std::size_t n = columns_;
+    std::array<double, MAX_SIZE + 1> min_reduced;
+    std::array<std::size_t, MAX_SIZE + 1> way;
+    std::array<bool, MAX_SIZE + 1> used;
+    std::array<std::size_t, MAX_SIZE + 1> owner;
+    std::fill(min_reduced.begin(), min_reduced.begin() + n, INF);
+    std::fill(used.begin(), used.begin() + n + 1, false);
+    std::copy(column_owner.begin(), column_owner.begin() + n, owner.begin());
+    owner[n] = row;
+
+    std::size_t current = n;
+    do
+    {
+        used[current]    = true;
+        std::size_t i    = owner[current];
+        double delta     = INF;
+        std::size_t next = n;
+        for (std::size_t j = 0; j != n; ++j)
+        {
+            if (!used[j])
+            {
+                double reduced = costs[i][j] - row_pot[i] - column_pot[j];
+                if (reduced < min_reduced[j])
+                {
+                    min_reduced[j] = reduced;
+                    way[j]         = current;
+                }
+                if (min_reduced[j] < delta)
+                {
+                    delta = min_reduced[j];
+                    next  = j;
+                }
+            }
+        }
+        for (std::size_t j = 0; j != n; ++j)
+        {
+            if (used[j])
+            {
+                row_pot[owner[j]] += delta;
+                column_pot[j] -= delta;
+            }
+            else
+            {
+                min_reduced[j] -= delta;
+            }
+        }
+        row_pot[row] += delta;
+        current = next;
+    } while (owner[current] != n);
+
+    while (current != n)
+    {
+        std::size_t prev          = way[current];
+        owner[current]            = owner[prev];
+        row_match[owner[current]] = current;
+        current                   = prev;
+    }
+    std::copy(owner.begin(), owner.begin() + n, column_owner.begin());
+}
@@ -0,0 +1,156 @@
+#ifndef UTIL_SMALL_ASSIGNMENT_H
+#define UTIL_SMALL_ASSIGNMENT_H
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+/**
+ * \brief Finds the cheapest way to give each of a few rows its own column.
+ *
+ * Given a matrix of costs with no more rows than columns, picks one cell in
+ * every row, no two in the same column, so that the sum of the picked costs
+ * is as small as possible. Rows are typically roles and columns robots, so
+ * when there are more robots than roles, some robots go unassigned.
+ *
+ * Unlike \ref Hungarian, the matrix is held in fixed-size arrays and solving
+ * never allocates, and the solver remembers its last solution. If, since the
+ * last solve, only the costs in one row or only the costs in one column have
+ * changed, the next solve repairs the old solution in time proportional to
+ * the square of the size rather than the cube. Setting a cost to the value it
+ * already has does not count as a change, so a caller can refill the whole
+ * matrix every tick and still get the cheap repair when little has moved.
+ */
+class SmallAssignment final
+{
+   public:
+    /**
+     * \brief The largest number of rows or columns.
+     */
+    static constexpr std::size_t MAX_SIZE = 12;
+
+    /**
+     * \brief Constructs a solver with every cost zero.
+     *
+     * \param[in] rows the number of rows
+     * \param[in] columns the number of columns
+     *
+     * \exception std::invalid_argument if \p rows is greater than \p columns
+     * or \p columns is greater than \ref MAX_SIZE
+     */
+    explicit SmallAssignment(std::size_t rows, std::size_t columns);
+
+    /**
+     * \brief Returns the number of rows.
+     *
+     * \return the number of rows
+     */
+    std::size_t rows() const;
+
+    /**
+     * \brief Returns the number of columns.
+     *
+     * \return the number of columns
+     */
+    std::size_t columns() const;
+
+    /**
+     * \brief Returns a cost.
+     *
+     * \param[in] row the row
+     * \param[in] column the column
+     *
+     * \return the cost of assigning \p column to \p row
+     */
+    double cost(std::size_t row, std::size_t column) const;
+
+    /**
+     * \brief Sets a cost.
+     *
+     * \param[in] row the row
+     * \param[in] column the column
+     * \param[in] value the cost of assigning \p column to \p row
+     */
+    void cost(std::size_t row, std::size_t column, double value);
+
+    /**
+     * \brief Finds the cheapest assignment for the current costs.
+     */
+    void solve();
+
+    /**
+     * \brief Returns the column assigned to a row by the last solve.
+     *
+     * \param[in] row the row
+     *
+     * \return the column assigned to \p row
+     */
+    std::size_t column_of(std::size_t row) const;
+
+    /**
+     * \brief Returns the row assigned to a column by the last solve.
+     *
+     * \param[in] column the column
+     *
+     * \return the row assigned to \p column, or \ref rows if no row is
+     */
+    std::size_t row_of(std::size_t column) const;
+
+    /**
+     * \brief Returns the total cost of the last solve.
+     *
+     * \return the sum of the costs of the assigned cells
+     */
+    double total() const;
+
+   private:
+    // Rows past rows_ cost nothing anywhere; they soak up the columns no real
+    // row wants, which keeps the problem square.
+    std::size_t rows_, columns_;
+    std::array<std::array<double, MAX_SIZE>, MAX_SIZE> costs;
+
+    // Dual potentials for rows and columns: costs[i][j] - row_pot[i] -
+    // column_pot[j] is never negative, and is zero for assigned cells.
+    std::array<double, MAX_SIZE> row_pot, column_pot;
+
+    // The row assigned to each column and the column assigned to each row.
+    std::array<std::size_t, MAX_SIZE> column_owner, row_match;
+
+    // Bit i is set if row i or column i has changed since the last solve.
+    unsigned int dirty_rows, dirty_columns;
+    bool solved;
+
+    void solve_all();
+    void augment(std::size_t row);
+};
+
+inline std::size_t SmallAssignment::rows() const
+{
+    return rows_;
+}
+
+inline std::size_t SmallAssignment::columns() const
+{
+    return columns_;
+}
+
+inline double SmallAssignment::cost(std::size_t row, std::size_t column) const
+{
+    assert(row < rows_);
+    assert(column < columns_);
+    return costs[row][column];
+}
+
+inline std::size_t SmallAssignment::column_of(std::size_t row) const
+{
+    assert(row < rows_);
+    return row_match[row];
+}
+
+inline std::size_t SmallAssignment::row_of(std::size_t column) const
+{
+    assert(column < columns_);
+    return column_owner[column] < rows_ ? column_owner[column] : rows_;
+}
+
+#endif
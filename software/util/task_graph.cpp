@@ -0,0 +1,147 @@
+#include "util/task_graph.h"
+#include <stdexcept>
+
+TaskGraph::TaskGraph(unsigned int threads) : remaining(0), stopping(false)
+{
+    for (unsigned int i = 0; i != threads; ++i)
+    {
+        workers.emplace_back(&TaskGraph::worker_main, this);
+    }
+}
+
+TaskGraph::~TaskGraph()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cond.notify_all();
+    for (std::thread &i : workers)
+    {
+        i.join();
+    }
+}
+
+void TaskGraph::clear()
+{
+    nodes.clear();
+}
+
+TaskGraph::Task TaskGraph::add(
+    std::function<void()> fn, std::initializer_list<Task> after)
+{
+    Task task = nodes.size();
+    for (Task i : after)
+    {
+        if (i >= task)
+        {
+            throw std::invalid_argument(
+                u8"Task depends on a task not yet added");
+        }
+    }
+    Node node;
+    node.fn           = std::move(fn);
+    node.dependencies = after.size();
+    node.waiting      = 0;
+    nodes.push_back(std::move(node));
+    for (Task i : after)
+    {
+        nodes[i].dependents.push_back(task);
+    }
+    return task;
+}
+
+void TaskGraph::run(bool parallel)
+{
+    if (!parallel || workers.empty())
+    {
+        // Every task comes after the tasks it depends on.
+        for (Node &i : nodes)
+        {
+            i.fn();
+        }
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    ready.clear();
+    for (Task i = 0; i != nodes.size(); ++i)
+    {
+        nodes[i].waiting = nodes[i].dependencies;
+        if (!nodes[i].waiting)
+        {
+            ready.push_back(i);
+        }
+    }
+    remaining = nodes.size();
+    error     = nullptr;
+    cond.notify_all();
+    while (remaining)
+    {
+        if (ready.empty())
+        {
+            cond.wait(lock);
+        }
+        else
+        {
+            run_one(lock);
+        }
+    }
+    std::exception_ptr e = error;
+    error                = nullptr;
+    lock.unlock();
+    if (e)
+    {
+        std::rethrow_exception(e);
+    }
+}
+
+void TaskGraph::worker_main()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;)
+    {
+        cond.wait(lock, [this]() { return stopping || !ready.empty(); });
+        if (stopping)
+        {
+            return;
+        }
+        run_one(lock);
+    }
+}
+
+void TaskGraph::run_one(std::unique_lock<std::mutex> &lock)
+{
+    Task task = ready.back();
+    ready.pop_back();
+    bool skip = !!error;
+    lock.unlock();
+
+    std::exception_ptr e;
+    if (!skip)
+    {
+        try
+        {
+            nodes[task].fn();
+        }
+        catch (...)
+        {
+            e = std::current_exception();
+        }
+    }
+
+    lock.lock();
+    if (e && !error)
+    {
+        error = e;
+    }
+    for (Task i : nodes[task].dependents)
+    {
+        if (!--nodes[i].waiting)
+        {
+            ready.push_back(i);
+        }
+    }
+    --remaining;
+    cond.notify_all();
+}
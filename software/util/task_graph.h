@@ -0,0 +1,114 @@
+#ifndef UTIL_TASK_GRAPH_H
+#define UTIL_TASK_GRAPH_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "util/noncopyable.h"
+
+/**
+ * \brief A set of tasks, some of which must wait for others to finish, run
+ * together on a pool of worker threads.
+ *
+ * The graph is filled with \ref add and then run to completion with \ref run.
+ * Tasks that do not depend on one another may run at the same time on
+ * different threads, so they must not touch the same data unless it is only
+ * read. The thread that calls \ref run works through tasks too, rather than
+ * sitting idle until the workers finish.
+ *
+ * The worker threads are started once, when the graph is constructed, and
+ * sleep between runs, so a graph can be cleared, refilled and run every tick
+ * without creating threads.
+ */
+class TaskGraph final : public NonCopyable
+{
+   public:
+    /**
+     * \brief Identifies a task within a graph.
+     */
+    typedef std::size_t Task;
+
+    /**
+     * \brief Constructs an empty graph.
+     *
+     * \param[in] threads the number of worker threads to start, not counting
+     * the thread that calls \ref run
+     */
+    explicit TaskGraph(unsigned int threads);
+
+    /**
+     * \brief Stops the worker threads.
+     */
+    ~TaskGraph();
+
+    /**
+     * \brief Returns the number of worker threads.
+     *
+     * \return the number of worker threads
+     */
+    std::size_t threads() const;
+
+    /**
+     * \brief Removes all tasks.
+     */
+    void clear();
+
+    /**
+     * \brief Adds a task.
+     *
+     * \param[in] fn the function to call
+     * \param[in] after the tasks that must finish before this one starts, all
+     * of which must already have been added
+     *
+     * \return the new task
+     *
+     * \exception std::invalid_argument if one of \p after has not been added
+     */
+    Task add(std::function<void()> fn, std::initializer_list<Task> after = {});
+
+    /**
+     * \brief Runs every task once and waits for them all to finish.
+     *
+     * If a task throws an exception, tasks that have not yet started are
+     * skipped, and once the running ones have finished, the first exception
+     * is rethrown.
+     *
+     * \param[in] parallel \c false to run every task on the calling thread in
+     * the order in which they were added, which is also what happens if there
+     * are no worker threads
+     */
+    void run(bool parallel = true);
+
+   private:
+    struct Node final
+    {
+        std::function<void()> fn;
+        std::vector<Task> dependents;
+        std::size_t dependencies;
+        std::size_t waiting;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<Task> ready;
+    std::size_t remaining;
+    std::exception_ptr error;
+    bool stopping;
+
+    void worker_main();
+    void run_one(std::unique_lock<std::mutex> &lock);
+};
+
+inline std::size_t TaskGraph::threads() const
+{
+    return workers.size();
+}
+
+#endif
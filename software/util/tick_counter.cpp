@@ -0,0 +1,34 @@
+#include "util/tick_counter.h"
+#include <algorithm>
+
+namespace
+{
+std::vector<TickCounter *> &vec()
+{
+    static std::vector<TickCounter *> v;
+    return v;
+}
+}
+
+TickCounter::TickCounter(const char *name) : name_(name), count_(0)
+{
+    vec().push_back(this);
+}
+
+TickCounter::~TickCounter()
+{
+    vec().erase(std::remove(vec().begin(), vec().end(), this), vec().end());
+}
+
+void TickCounter::reset_all()
+{
+    for (TickCounter *i : vec())
+    {
+        i->count_.store(0, std::memory_order_relaxed);
+    }
+}
+
+const std::vector<TickCounter *> &TickCounter::all()
+{
+    return vec();
+}
@@ -0,0 +1,82 @@
+#ifndef UTIL_TICK_COUNTER_H
+#define UTIL_TICK_COUNTER_H
+
+#include <atomic>
+#include <vector>
+#include "util/noncopyable.h"
+
+/**
+ * \brief A count of how often something happens during one tick, such as a
+ * cache being hit, which is written to the log with the rest of the tick.
+ *
+ * Every counter in the program is reset by \ref reset_all at the start of
+ * each tick. Counters may be incremented from several threads at once.
+ */
+class TickCounter final : public NonCopyable
+{
+   public:
+    /**
+     * \brief Constructs a counter and adds it to the set of all counters.
+     *
+     * \param[in] name the name under which to log the counter, which must
+     * outlive the counter
+     */
+    explicit TickCounter(const char *name);
+
+    /**
+     * \brief Removes the counter from the set of all counters.
+     */
+    ~TickCounter();
+
+    /**
+     * \brief Resets every counter to zero.
+     */
+    static void reset_all();
+
+    /**
+     * \brief Returns every counter.
+     *
+     * \return the counters, in the order in which they were constructed
+     */
+    static const std::vector<TickCounter *> &all();
+
+    /**
+     * \brief Returns the name of the counter.
+     *
+     * \return the name
+     */
+    const char *name() const;
+
+    /**
+     * \brief Returns the count so far this tick.
+     *
+     * \return the count
+     */
+    unsigned int count() const;
+
+    /**
+     * \brief Adds one to the count.
+     */
+    void increment();
+
+   private:
+    const char *name_;
+    std::atomic<unsigned int> count_;
+};
+
+inline const char *TickCounter::name() const
+{
+    return name_;
+}
+
+inline unsigned int TickCounter::count() const
+{
+    return count_.load(std::memory_order_relaxed);
+}
+
+inline void TickCounter::increment()
+{
+    count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+#endif
@@ -0,0 +1,214 @@
+/**
+ * \file
+ *
+ * \brief Runs one primitive configuration many times with random sensor and
+ * actuator noise, using every core, and summarizes how the outcomes are
+ * distributed.
+ *
+ * Usage: montecarlo [-j THREADS] [-n TRIALS] [-s SEED] [-o OUTFILE] PRIM SETTING...
+ *
+ * Each SETTING has the form NAME=VALUE, where NAME is any field that sweep
+ * accepts: the primitive parameters, the robot’s initial state, the ball
+ * position, and the noise settings (encoder, encoder_a, camera, camera_a,
+ * delay, jitter, period, slip and friction). Anything not given is zero.
+ *
+ * The configuration is first run once without noise, as a reference. Then
+ * TRIALS noisy runs are made, each with its own seed drawn from SEED. The
+ * final position and angle errors are measured against the reference run.
+ * For each of settle time, arrival time, overshoot, final position error and
+ * final angle error, the mean, median, 90th, 99th and 99.9th percentiles and
+ * maximum are printed. With -o, one CSV line per trial is also written to OUTFILE.
+ */
+#include <errno.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "run.h"
+
+#define NUM_METRICS 5
+
+static const char *const METRIC_NAMES[NUM_METRICS] = {
+    "settle time (s)", "arrival time (s)", "overshoot (m)", "position error (m)", "angle error (rad)",
+};
+
+/**
+ * \brief Returns the next number from a splitmix64 generator, which gives
+ * well separated seeds even from consecutive states.
+ */
+static uint64_t next_seed(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z          = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * \brief Returns the magnitude of an angle difference, wrapped to [0, π].
+ */
+static float angle_error(float a, float b)
+{
+    float diff = fmodf(fabsf(a - b), 2.0f * (float)M_PI);
+    return diff > (float)M_PI ? 2.0f * (float)M_PI - diff : diff;
+}
+
+/**
+ * \brief Computes the metrics of one trial against the reference run.
+ */
+static void measure(const fwsim_result_t *r, const fwsim_result_t *reference, double metrics[NUM_METRICS])
+{
+    metrics[0] = r->settle_time;
+    metrics[1] = r->arrival_time;
+    metrics[2] = r->overshoot;
+    metrics[3] = hypotf(r->pos[0] - reference->pos[0], r->pos[1] - reference->pos[1]);
+    metrics[4] = angle_error(r->pos[2], reference->pos[2]);
+}
+
+static int compare_doubles(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return x < y ? -1 : x > y ? 1 : 0;
+}
+
+/**
+ * \brief Returns a percentile of sorted values, by the nearest rank.
+ */
+static double percentile(const double *sorted, size_t count, double p)
+{
+    size_t rank = (size_t)ceil(p / 100.0 * count);
+    return sorted[rank ? rank - 1 : 0];
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "Usage: montecarlo [-j THREADS] [-n TRIALS] [-s SEED] [-o OUTFILE] PRIM NAME=VALUE...\n");
+    fprintf(stderr, "NAME is one of:");
+    for (unsigned int i = 0; i < FWSIM_NUM_CASE_FIELDS; i++)
+    {
+        fprintf(stderr, " %s", FWSIM_CASE_FIELDS[i]);
+    }
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char **argv)
+{
+    long threads         = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t trials        = 1000;
+    uint64_t seed        = 1;
+    const char *out_name = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "j:n:s:o:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'j':
+                threads = strtol(optarg, NULL, 0);
+                break;
+            case 'n':
+                trials = strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                seed = strtoull(optarg, NULL, 0);
+                break;
+            case 'o':
+                out_name = optarg;
+                break;
+            default:
+                usage();
+                return 1;
+        }
+    }
+    if (argc - optind < 1 || threads < 1 || !trials)
+    {
+        usage();
+        return 1;
+    }
+    unsigned int primitive = (unsigned int)strtoul(argv[optind], NULL, 0);
+
+    fwsim_case_t base;
+    memset(&base, 0, sizeof(base));
+    for (int i = optind + 1; i < argc; i++)
+    {
+        char name[16];
+        double value;
+        int fields         = sscanf(argv[i], "%15[a-z0-9_]=%lf", name, &value);
+        unsigned int field = fwsim_case_field(name);
+        if (fields < 2 || field == FWSIM_NUM_CASE_FIELDS || !strcmp(name, "seed"))
+        {
+            fprintf(stderr, "Bad SETTING “%s”\n", argv[i]);
+            usage();
+            return 1;
+        }
+        fwsim_case_set(&base, field, value);
+    }
+
+    // The reference run is cases[0], with the noise taken away.
+    size_t count            = trials + 1;
+    fwsim_case_t *cases     = calloc(count, sizeof(*cases));
+    fwsim_result_t *results = calloc(count, sizeof(*results));
+    double *metrics         = calloc(trials * NUM_METRICS, sizeof(*metrics));
+    double *sorted          = calloc(trials, sizeof(*sorted));
+    if (!cases || !results || !metrics || !sorted)
+    {
+        fprintf(stderr, "Out of memory for %zu trials\n", trials);
+        return 1;
+    }
+    cases[0] = base;
+    memset(&cases[0].noise, 0, sizeof(cases[0].noise));
+    uint64_t rng = seed;
+    for (size_t i = 1; i < count; i++)
+    {
+        cases[i]      = base;
+        cases[i].seed = next_seed(&rng);
+    }
+
+    fwsim_run_batch(primitive, cases, results, count, threads, NULL);
+
+    const fwsim_result_t *reference = &results[0];
+    printf("reference: X %f, Y %f, THETA %f, settle time %f s, arrival time %f s, overshoot %f m\n", reference->pos[0], reference->pos[1], reference->pos[2], reference->settle_time, reference->arrival_time, reference->overshoot);
+    for (size_t i = 0; i < trials; i++)
+    {
+        measure(&results[i + 1], reference, &metrics[i * NUM_METRICS]);
+    }
+    printf("%-20s %10s %10s %10s %10s %10s %10s\n", "", "mean", "p50", "p90", "p99", "p99.9", "max");
+    for (unsigned int m = 0; m < NUM_METRICS; m++)
+    {
+        double total = 0.0;
+        for (size_t i = 0; i < trials; i++)
+        {
+            sorted[i] = metrics[i * NUM_METRICS + m];
+            total += sorted[i];
+        }
+        qsort(sorted, trials, sizeof(*sorted), &compare_doubles);
+        printf("%-20s %10.4f %10.4f %10.4f %10.4f %10.4f %10.4f\n", METRIC_NAMES[m], total / trials, percentile(sorted, trials, 50.0), percentile(sorted, trials, 90.0), percentile(sorted, trials, 99.0), percentile(sorted, trials, 99.9), sorted[trials - 1]);
+    }
+
+    if (out_name)
+    {
+        FILE *out = fopen(out_name, "w");
+        if (!out)
+        {
+            fprintf(stderr, "%s: %s\n", out_name, strerror(errno));
+            return 1;
+        }
+        fprintf(out, "SEED, X, Y, THETA, VX, VY, VA, SETTLE_TIME, ARRIVAL_TIME, OVERSHOOT, POSITION_ERROR, ANGLE_ERROR\n");
+        for (size_t i = 0; i < trials; i++)
+        {
+            const fwsim_result_t *r = &results[i + 1];
+            const double *m         = &metrics[i * NUM_METRICS];
+            fprintf(out, "%llu, ", (unsigned long long)cases[i + 1].seed);
+            fprintf(out, "%f, %f, %f, %f, %f, %f, ", r->pos[0], r->pos[1], r->pos[2], r->vel[0], r->vel[1], r->vel[2]);
+            fprintf(out, "%f, %f, %f, %f, %f\n", m[0], m[1], m[2], m[3], m[4]);
+        }
+        fclose(out);
+    }
+
+    free(sorted);
+    free(metrics);
+    free(results);
+    free(cases);
+    return 0;
+}
@@ -201,8 +201,9 @@ class Interface(QWidget):
         Run the simulator using the visualization tool specified by the radio buttons
         :return: None
         """
-        # the name of the output csv
-        output = "sim.csv"
+        # the name of the output log, in the binary format since it is much
+        # smaller and faster to load than CSV
+        output = "sim.trj"
         run_args = [
             output,
             self.primNum,
@@ -4,6 +4,7 @@ import numpy as np
 from matplotlib.animation import FuncAnimation
 import csv
 import re
+import trajectory
 
 class Control:
     xmin, ymin = -3, -3
@@ -23,7 +24,10 @@ class Control:
 
     def main(self, file):
         """Select your plot in here."""
-        arr = np.float_(np.loadtxt(file, delimiter=",", dtype=str)[1:][:,1:])
+        if file.endswith(".trj"):
+            arr = trajectory.load(file).arr
+        else:
+            arr = np.float_(np.loadtxt(file, delimiter=",", dtype=str)[1:][:,1:])
         self.firstPoints, self.lastPoints = 5, 5
         self.arr = arr
 
@@ -0,0 +1,55 @@
+import struct
+import numpy as np
+
+# Must match sim_log_header_t and sim_log_record_t in firmware/main/simulate.h.
+MAGIC = b"FWSIMTRJ"
+VERSION = 1
+HEADER = struct.Struct("=8sIII4hBB2xf")
+RECORD_FIELDS = 10
+
+
+class Trajectory:
+    """
+    A trajectory read from a binary fwsim log.
+
+    Attributes:
+        primitive (int): The index of the primitive that was run.
+        params (tuple): The primitive's four parameters.
+        extra (int): The primitive's extra byte.
+        slow (bool): Whether the primitive was ordered to drive slowly.
+        log_period (float): The time between records, in seconds.
+        arr (numpy.ndarray): One row per record, with the columns time, x, y,
+            theta, vx, vy, va, ax, ay and aa, as in the CSV log.
+    """
+
+
+def load(file):
+    """
+    Reads a binary fwsim log.
+
+    Args:
+        file (str): The path of the log.
+
+    Returns:
+        Trajectory: The header fields and the records.
+    """
+    with open(file, "rb") as f:
+        data = f.read()
+    (magic, version, record_size, primitive, p0, p1, p2, p3, extra, slow,
+     log_period) = HEADER.unpack_from(data)
+    if magic != MAGIC or version != VERSION:
+        raise ValueError("{} is not a version {} fwsim log".format(file, VERSION))
+    if record_size != RECORD_FIELDS * 4:
+        raise ValueError("{} has {}-byte records".format(file, record_size))
+    body = data[HEADER.size:]
+    count = len(body) // record_size
+    traj = Trajectory()
+    traj.primitive = primitive
+    traj.params = (p0, p1, p2, p3)
+    traj.extra = extra
+    traj.slow = bool(slow)
+    traj.log_period = log_period
+    traj.arr = np.frombuffer(
+        body, dtype=np.float32, count=count * RECORD_FIELDS).reshape(
+            count, RECORD_FIELDS).astype(np.float64)
+    return traj
@@ -0,0 +1,400 @@
+/**
+ * \file
+ *
+ * \brief Times the CVXGEN wheel force solver used by quad_optimize, from
+ * scratch and warm started, over sequences of consecutive control ticks.
+ *
+ * Usage: quadbench [-n SEQUENCES] [-l TICKS] [-s SEED] [-o OUTFILE] [PROBLEMFILE]
+ *
+ * Without PROBLEMFILE, SEQUENCES synthetic sequences of TICKS ticks each are
+ * generated: the robot turns at a steady rate while the requested
+ * accelerations wander the way a primitive’s would from tick to tick. A
+ * PROBLEMFILE holds recorded problems instead, one tick per line as
+ *
+ *     ANGLE MAJOR_X MAJOR_Y ROT_DISP A_MAJOR A_MINOR A_ROT
+ *
+ * with a blank line between sequences. Every problem is solved once from
+ * scratch and once warm started from the previous tick of its sequence; the
+ * first tick of a sequence is always solved from scratch. A summary of
+ * iterations and solve times is printed, counting the iterations of both
+ * attempts when a warm start falls back to a cold one. With -o, one CSV line
+ * per problem is also written to OUTFILE.
+ *
+ * Times are measured on the host and only compare the two modes with each
+ * other; the robot is many times slower.
+ */
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "run.h"
+#include "cvxgen/solver.h"
+#include "util/quadratic.h"
+
+typedef struct {
+    /**
+     * \brief The robot’s angle and the axes of its movement.
+     */
+    float angle, major_vec[2], minor_vec[2];
+
+    /**
+     * \brief The rotational displacement still to go, which sets the wheel
+     * spin direction.
+     */
+    float rot_disp;
+
+    /**
+     * \brief The requested major, minor and rotational accelerations.
+     */
+    float a_req[3];
+
+    /**
+     * \brief Whether this is the first tick of a sequence.
+     */
+    bool first;
+} problem_t;
+
+typedef struct {
+    long iterations;
+    bool converged;
+    double time;
+    double objective;
+} solution_t;
+
+typedef struct {
+    const char *name;
+    unsigned long count, unconverged;
+    long total_iterations, max_iterations;
+    double *times;
+} summary_t;
+
+/**
+ * \brief Returns a uniformly distributed number in [0, 1) from an xorshift
+ * generator.
+ */
+static double next_uniform(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return (double)(*state >> 11) / 9007199254740992.0;
+}
+
+static double uniform(uint64_t *state, double min, double max)
+{
+    return min + (max - min) * next_uniform(state);
+}
+
+static float clamp(float value, float limit)
+{
+    return value > limit ? limit : value < -limit ? -limit : value;
+}
+
+static void set_axes(problem_t *p, float major_angle)
+{
+    p->major_vec[0] = cosf(major_angle);
+    p->major_vec[1] = sinf(major_angle);
+    p->minor_vec[0] = -p->major_vec[1];
+    p->minor_vec[1] = p->major_vec[0];
+}
+
+/**
+ * \brief Fills in synthetic sequences of problems.
+ */
+static void generate(problem_t *problems, unsigned long sequences, unsigned long ticks, uint64_t seed)
+{
+    static const float A_LIMITS[3] = {3.0f, 1.5f, 10.0f};
+    uint64_t rng = seed ? seed : 1;
+    for (unsigned long i = 0; i < sequences; i++)
+    {
+        float angle       = (float)uniform(&rng, -M_PI, M_PI);
+        float avel        = (float)uniform(&rng, -4.0, 4.0);
+        float major_angle = (float)uniform(&rng, -M_PI, M_PI);
+        float rot_disp    = (float)uniform(&rng, -M_PI, M_PI);
+        float a_req[3];
+        for (unsigned int j = 0; j < 3; j++)
+        {
+            a_req[j] = (float)uniform(&rng, -A_LIMITS[j], A_LIMITS[j]);
+        }
+        for (unsigned long t = 0; t < ticks; t++)
+        {
+            problem_t *p = &problems[i * ticks + t];
+            p->angle     = angle;
+            set_axes(p, major_angle);
+            p->rot_disp = rot_disp;
+            memcpy(p->a_req, a_req, sizeof(a_req));
+            p->first = t == 0;
+
+            angle += avel * ROBOT_TICK_T;
+            rot_disp -= avel * ROBOT_TICK_T;
+            for (unsigned int j = 0; j < 3; j++)
+            {
+                a_req[j] = clamp(a_req[j] + (float)uniform(&rng, -0.05, 0.05) * A_LIMITS[j], A_LIMITS[j]);
+            }
+        }
+    }
+}
+
+/**
+ * \brief Reads recorded sequences of problems.
+ *
+ * \return the problems, or NULL on error
+ */
+static problem_t *load(const char *name, unsigned long *count)
+{
+    FILE *in = fopen(name, "r");
+    if (!in)
+    {
+        fprintf(stderr, "%s: %s\n", name, strerror(errno));
+        return NULL;
+    }
+    problem_t *problems = NULL;
+    size_t capacity = 0;
+    bool first = true;
+    char line[256];
+    unsigned long line_number = 0;
+    *count = 0;
+    while (fgets(line, sizeof(line), in))
+    {
+        line_number++;
+        float major[2];
+        problem_t p;
+        int fields = sscanf(line, "%f %f %f %f %f %f %f", &p.angle, &major[0], &major[1], &p.rot_disp, &p.a_req[0], &p.a_req[1], &p.a_req[2]);
+        if (fields <= 0)
+        {
+            first = true;
+            continue;
+        }
+        if (fields != 7)
+        {
+            fprintf(stderr, "%s:%lu: expected 7 numbers\n", name, line_number);
+            free(problems);
+            fclose(in);
+            return NULL;
+        }
+        set_axes(&p, atan2f(major[1], major[0]));
+        p.first = first;
+        first   = false;
+        if (*count == capacity)
+        {
+            capacity = capacity ? capacity * 2 : 256;
+            problem_t *grown = realloc(problems, capacity * sizeof(*problems));
+            if (!grown)
+            {
+                fprintf(stderr, "Out of memory for %zu problems\n", capacity);
+                free(problems);
+                fclose(in);
+                return NULL;
+            }
+            problems = grown;
+        }
+        problems[(*count)++] = p;
+    }
+    fclose(in);
+    return problems;
+}
+
+/**
+ * \brief Sets up a problem the way quad_optimize does and solves it.
+ */
+static void solve_problem(const problem_t *p, bool warm_start, solution_t *out)
+{
+    PhysBot pb = {
+        .rot = {
+            .disp = p->rot_disp,
+        },
+        .major_vec = {p->major_vec[0], p->major_vec[1]},
+        .minor_vec = {p->minor_vec[0], p->minor_vec[1]},
+    };
+    dr_data_t state;
+    state.angle = p->angle;
+    float a_req[3];
+    memcpy(a_req, p->a_req, sizeof(a_req));
+    float M[3][4];
+    float M_T[4][3];
+    float Q[4][4];
+    float c[4];
+    build_M_matrix(pb, state, M);
+    transpose_qp(M, M_T);
+    build_c_matrix(a_req, M, c);
+    build_Q_matrix(M, M_T, Q);
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    out->iterations = quad_solve(Q, c, warm_start);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    out->time      = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1.0e9;
+    out->converged = work.converged;
+    out->objective = eval_objv();
+}
+
+static void add(summary_t *s, const solution_t *sol)
+{
+    s->times[s->count++] = sol->time;
+    s->total_iterations += sol->iterations;
+    if (sol->iterations > s->max_iterations)
+    {
+        s->max_iterations = sol->iterations;
+    }
+    if (!sol->converged)
+    {
+        s->unconverged++;
+    }
+}
+
+static int compare_doubles(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return x < y ? -1 : x > y ? 1 : 0;
+}
+
+static void print_summary(summary_t *s)
+{
+    qsort(s->times, s->count, sizeof(*s->times), &compare_doubles);
+    double total = 0.0;
+    for (unsigned long i = 0; i < s->count; i++)
+    {
+        total += s->times[i];
+    }
+    printf("%-6s iterations mean %5.2f max %3ld, time (us) mean %7.3f p99 %7.3f max %7.3f, unconverged %lu/%lu\n",
+        s->name,
+        (double)s->total_iterations / s->count,
+        s->max_iterations,
+        total / s->count * 1.0e6,
+        s->times[(s->count - 1) * 99 / 100] * 1.0e6,
+        s->times[s->count - 1] * 1.0e6,
+        s->unconverged,
+        s->count);
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "Usage: quadbench [-n SEQUENCES] [-l TICKS] [-s SEED] [-o OUTFILE] [PROBLEMFILE]\n");
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long sequences = 100;
+    unsigned long ticks     = 200;
+    uint64_t seed           = 1;
+    const char *out_name    = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:l:s:o:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                sequences = strtoul(optarg, NULL, 0);
+                break;
+            case 'l':
+                ticks = strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                seed = strtoull(optarg, NULL, 0);
+                break;
+            case 'o':
+                out_name = optarg;
+                break;
+            default:
+                usage();
+                return 1;
+        }
+    }
+    if (argc - optind > 1)
+    {
+        usage();
+        return 1;
+    }
+
+    problem_t *problems;
+    unsigned long count;
+    if (optind < argc)
+    {
+        problems = load(argv[optind], &count);
+        if (!problems)
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        count    = sequences * ticks;
+        problems = calloc(count, sizeof(*problems));
+        if (!problems && count)
+        {
+            fprintf(stderr, "Out of memory for %lu problems\n", count);
+            return 1;
+        }
+        generate(problems, sequences, ticks, seed);
+    }
+    if (!count)
+    {
+        fprintf(stderr, "No problems to solve\n");
+        return 1;
+    }
+
+    solution_t *cold = calloc(count, sizeof(*cold));
+    solution_t *warm = calloc(count, sizeof(*warm));
+    summary_t cold_summary = {.name = "cold", .times = calloc(count, sizeof(double))};
+    summary_t warm_summary = {.name = "warm", .times = calloc(count, sizeof(double))};
+    if (!cold || !warm || !cold_summary.times || !warm_summary.times)
+    {
+        fprintf(stderr, "Out of memory for %lu problems\n", count);
+        return 1;
+    }
+
+    // Run the two modes one after the other, so the warm runs really do
+    // start from the previous tick’s warm solution.
+    for (unsigned long i = 0; i < count; i++)
+    {
+        solve_problem(&problems[i], false, &cold[i]);
+        add(&cold_summary, &cold[i]);
+    }
+    double max_difference = 0.0;
+    for (unsigned long i = 0; i < count; i++)
+    {
+        solve_problem(&problems[i], !problems[i].first, &warm[i]);
+        add(&warm_summary, &warm[i]);
+        // Q is singular, so the solution need not be unique; compare the
+        // objective instead.
+        double difference = fabs(warm[i].objective - cold[i].objective);
+        if (difference > max_difference)
+        {
+            max_difference = difference;
+        }
+    }
+
+    print_summary(&cold_summary);
+    print_summary(&warm_summary);
+    printf("largest difference between cold and warm objectives: %g\n", max_difference);
+
+    if (out_name)
+    {
+        FILE *out = fopen(out_name, "w");
+        if (!out)
+        {
+            fprintf(stderr, "%s: %s\n", out_name, strerror(errno));
+            return 1;
+        }
+        fprintf(out, "ANGLE, MAJOR_X, MAJOR_Y, ROT_DISP, A_MAJOR, A_MINOR, A_ROT, COLD_ITERS, COLD_US, WARM_ITERS, WARM_US\n");
+        for (unsigned long i = 0; i < count; i++)
+        {
+            const problem_t *p = &problems[i];
+            fprintf(out, "%f, %f, %f, %f, %f, %f, %f, ", p->angle, p->major_vec[0], p->major_vec[1], p->rot_disp, p->a_req[0], p->a_req[1], p->a_req[2]);
+            fprintf(out, "%ld, %f, %ld, %f\n", cold[i].iterations, cold[i].time * 1.0e6, warm[i].iterations, warm[i].time * 1.0e6);
+        }
+        fclose(out);
+    }
+
+    free(warm_summary.times);
+    free(cold_summary.times);
+    free(warm);
+    free(cold);
+    free(problems);
+    return 0;
+}
@@ -0,0 +1,352 @@
+#include "run.h"
+#include "simulate.h"
+#include <math.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief The number of robot ticks in a simulation, with room to spare.
+ */
+#define MAX_ROBOT_TICKS ((size_t)(MAX_SIM_T / ROBOT_TICK_T) + 2U)
+
+typedef struct {
+    unsigned int primitive;
+    const fwsim_case_t *cases;
+    fwsim_result_t *results;
+    size_t count;
+    size_t next;
+    const char *trajectory_dir;
+} batch_t;
+
+typedef struct {
+    const batch_t *batch;
+    size_t index;
+} job_t;
+
+/**
+ * \brief The names of the fields of a case, for tools that set them from the
+ * command line.
+ *
+ * In order: the four primitive parameters, the extra byte, the robot’s initial
+ * position and velocity, the ball position, the slow flag, then the noise
+ * settings of \ref sim_noise_t (encoder and angular encoder noise, camera and
+ * angular camera noise, camera delay, jitter and period in robot ticks, and
+ * the relative variation in slip force and friction) and the random seed.
+ */
+const char *const FWSIM_CASE_FIELDS[FWSIM_NUM_CASE_FIELDS] = {
+    "p0", "p1", "p2", "p3", "extra", "x", "y", "theta", "vx", "vy", "va", "bx", "by", "slow",
+    "encoder", "encoder_a", "camera", "camera_a", "delay", "jitter", "period", "slip", "friction", "seed",
+};
+
+/**
+ * \brief Looks up a case field by name.
+ *
+ * \param[in] name the name of the field, one of \ref FWSIM_CASE_FIELDS
+ *
+ * \return the index of the field, or \ref FWSIM_NUM_CASE_FIELDS if there is
+ * no such field
+ */
+unsigned int fwsim_case_field(const char *name)
+{
+    unsigned int field = 0;
+    while (field < FWSIM_NUM_CASE_FIELDS && strcmp(name, FWSIM_CASE_FIELDS[field]))
+    {
+        field++;
+    }
+    return field;
+}
+
+/**
+ * \brief Fills in one field of a case.
+ *
+ * \param[in,out] c the case
+ * \param[in] field the index of the field in \ref FWSIM_CASE_FIELDS
+ * \param[in] value the value, rounded if the field is an integer
+ */
+void fwsim_case_set(fwsim_case_t *c, unsigned int field, double value)
+{
+    unsigned int ticks = (unsigned int)(value < 0 ? 0 : value + 0.5);
+    switch (field)
+    {
+        case 0:
+        case 1:
+        case 2:
+        case 3:
+            c->params.params[field] = (int16_t)(value < 0 ? value - 0.5 : value + 0.5);
+            break;
+        case 4:
+            c->params.extra = (uint8_t)(value + 0.5);
+            break;
+        case 5:
+        case 6:
+        case 7:
+            c->pos[field - 5] = (float)value;
+            break;
+        case 8:
+        case 9:
+        case 10:
+            c->vel[field - 8] = (float)value;
+            break;
+        case 11:
+        case 12:
+            c->ball[field - 11] = (float)value;
+            break;
+        case 13:
+            c->params.slow = value >= 0.5;
+            break;
+        case 14:
+            c->noise.encoder_noise = (float)value;
+            break;
+        case 15:
+            c->noise.encoder_angular_noise = (float)value;
+            break;
+        case 16:
+            c->noise.camera_noise = (float)value;
+            break;
+        case 17:
+            c->noise.camera_angular_noise = (float)value;
+            break;
+        case 18:
+            c->noise.camera_delay = ticks;
+            break;
+        case 19:
+            c->noise.camera_jitter = ticks;
+            break;
+        case 20:
+            c->noise.camera_period = ticks;
+            break;
+        case 21:
+            c->noise.slip_variation = (float)value;
+            break;
+        case 22:
+            c->noise.friction_variation = (float)value;
+            break;
+        case 23:
+            c->seed = (uint64_t)(value < 0 ? 0 : value + 0.5);
+            break;
+    }
+}
+
+/**
+ * \brief Checks whether a log file name asks for the binary trajectory format.
+ */
+static bool is_binary_log(const char *log_file)
+{
+    size_t len = strlen(log_file);
+    size_t ext = strlen(FWSIM_BINARY_LOG_EXTENSION);
+    return len >= ext && !strcmp(log_file + len - ext, FWSIM_BINARY_LOG_EXTENSION);
+}
+
+/**
+ * \brief Simulates one primitive from start to \ref MAX_SIM_T.
+ *
+ * The robot is private to this call, but the primitives and controllers keep
+ * their state per thread, so a thread must not run two simulations at once
+ * and should not run two in succession if the second must not see what the
+ * first left behind.
+ *
+ * \param[in] primitive the index of the primitive to run
+ * \param[in] c the starting conditions
+ * \param[in] log_file the file to log the trajectory to, or null to not log;
+ * names ending in \ref FWSIM_BINARY_LOG_EXTENSION get the binary format and
+ * anything else gets CSV
+ * \param[out] result the outcome
+ */
+void fwsim_run(unsigned int primitive, const fwsim_case_t *c, const char *log_file, fwsim_result_t *result)
+{
+    sim_robot_t robot;
+    sim_robot_init(&robot);
+    for (unsigned int i = 0; i < 3; i++)
+    {
+        robot.pos[i] = c->pos[i];
+        robot.vel[i] = c->vel[i];
+    }
+    robot.ball[0] = c->ball[0];
+    robot.ball[1] = c->ball[1];
+    sim_robot_start_noise(&robot, &c->noise, c->seed);
+    sim_robot_select(&robot);
+
+    primitive_start(primitive, &c->params);
+    if (log_file && is_binary_log(log_file))
+    {
+        sim_log_start_binary(log_file, primitive, c->params.params, c->params.extra, c->params.slow);
+    }
+    else if (log_file)
+    {
+        sim_log_start(log_file);
+    }
+    log_record_t *notUsedLog = NULL;
+
+    float time            = 0.0;
+    float last_robot_tick = 0.0;
+    float last_log_tick   = 0.0;
+    float settle_time     = 0.0;
+    float path[MAX_ROBOT_TICKS][3];
+    size_t path_length = 0;
+    while (time < MAX_SIM_T)
+    {
+        time += DELTA_T;
+        sim_robot_tick(&robot, DELTA_T);
+
+        if (time - last_robot_tick >= ROBOT_TICK_T)
+        {
+            sim_robot_sense(&robot, time - last_robot_tick);
+            primitive_tick(notUsedLog);
+            last_robot_tick = time;
+            if (path_length < MAX_ROBOT_TICKS)
+            {
+                path[path_length][0] = robot.pos[0];
+                path[path_length][1] = robot.pos[1];
+                path[path_length][2] = time;
+                path_length++;
+            }
+        }
+
+        if (log_file && time - last_log_tick >= LOG_TICK_T)
+        {
+            sim_log_tick(time);
+            last_log_tick = time;
+        }
+
+        if (hypotf(robot.vel[0], robot.vel[1]) > REST_SPEED ||
+            fabsf(robot.vel[2]) > REST_SPEED)
+        {
+            settle_time = time;
+        }
+    }
+    if (log_file)
+    {
+        sim_log_end();
+    }
+    sim_robot_select(NULL);
+
+    for (unsigned int i = 0; i < 3; i++)
+    {
+        result->pos[i] = robot.pos[i];
+        result->vel[i] = robot.vel[i];
+    }
+    result->settle_time = settle_time;
+
+    float dir[2]  = {robot.pos[0] - c->pos[0], robot.pos[1] - c->pos[1]};
+    float dist    = hypotf(dir[0], dir[1]);
+    result->overshoot    = 0.0f;
+    result->arrival_time = 0.0f;
+    for (size_t i = 0; i < path_length; i++)
+    {
+        float offset[2] = {path[i][0] - robot.pos[0], path[i][1] - robot.pos[1]};
+        if (dist > 1e-3f)
+        {
+            float past = (offset[0] * dir[0] + offset[1] * dir[1]) / dist;
+            result->overshoot = fmaxf(result->overshoot, past);
+        }
+        if (hypotf(offset[0], offset[1]) > ARRIVAL_DISTANCE)
+        {
+            result->arrival_time = path[i][2];
+        }
+    }
+}
+
+/**
+ * \brief Runs one case of a batch on a thread of its own.
+ *
+ * The primitives keep their state in thread-local storage, so a fresh thread
+ * starts every run from exactly the state a fresh process would.
+ */
+static void *run_case(void *arg)
+{
+    const job_t *job = arg;
+    const batch_t *batch = job->batch;
+    char log_file[4096];
+    if (batch->trajectory_dir)
+    {
+        snprintf(log_file, sizeof(log_file), "%s/%06zu%s", batch->trajectory_dir, job->index + 1, FWSIM_BINARY_LOG_EXTENSION);
+    }
+    fwsim_run(batch->primitive, &batch->cases[job->index], batch->trajectory_dir ? log_file : NULL, &batch->results[job->index]);
+    return NULL;
+}
+
+/**
+ * \brief Claims cases one at a time until none remain.
+ */
+static void *worker(void *arg)
+{
+    batch_t *batch = arg;
+    for (;;)
+    {
+        job_t job = {
+            .batch = batch,
+            .index = __atomic_fetch_add(&batch->next, 1, __ATOMIC_RELAXED),
+        };
+        if (job.index >= batch->count)
+        {
+            return NULL;
+        }
+
+        pthread_t thread;
+        int err = pthread_create(&thread, NULL, &run_case, &job);
+        if (err)
+        {
+            fprintf(stderr, "pthread_create: %s\n", strerror(err));
+            exit(1);
+        }
+        pthread_join(thread, NULL);
+    }
+}
+
+/**
+ * \brief Simulates many cases of one primitive, spread over several threads.
+ *
+ * Each case runs on a fresh thread, so no case sees state left behind by
+ * another, and its result does not depend on how the cases were scheduled.
+ *
+ * \param[in] primitive the index of the primitive to run
+ * \param[in] cases the starting conditions of each run
+ * \param[out] results the outcome of each run
+ * \param[in] count the number of runs
+ * \param[in] threads the number of runs to do at once
+ * \param[in] trajectory_dir the directory to log each run’s trajectory to in
+ * the binary format, named after its index counting from one, or null to not
+ * log
+ */
+void fwsim_run_batch(unsigned int primitive, const fwsim_case_t *cases, fwsim_result_t *results, size_t count, long threads, const char *trajectory_dir)
+{
+    batch_t batch = {
+        .primitive = primitive,
+        .cases     = cases,
+        .results   = results,
+        .count     = count,
+        .next      = 0,
+        .trajectory_dir = trajectory_dir,
+    };
+    if ((size_t)threads > count)
+    {
+        threads = (long)count;
+    }
+    if (threads < 1)
+    {
+        threads = 1;
+    }
+    pthread_t *workers = calloc((size_t)threads, sizeof(*workers));
+    if (!workers)
+    {
+        fprintf(stderr, "Out of memory for %ld threads\n", threads);
+        exit(1);
+    }
+    for (long i = 0; i < threads; i++)
+    {
+        int err = pthread_create(&workers[i], NULL, &worker, &batch);
+        if (err)
+        {
+            fprintf(stderr, "pthread_create: %s\n", strerror(err));
+            exit(1);
+        }
+    }
+    for (long i = 0; i < threads; i++)
+    {
+        pthread_join(workers[i], NULL);
+    }
+    free(workers);
+}
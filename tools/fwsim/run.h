@@ -0,0 +1,114 @@
+#ifndef FWSIM_RUN_H
+#define FWSIM_RUN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "primitive.h"
+#include "simulate.h"
+
+#define DELTA_T 0.0001
+#define ROBOT_TICK_T 0.005
+#define MAX_SIM_T 15.0f
+
+/**
+ * \brief The file name extension that selects the binary trajectory format.
+ */
+#define FWSIM_BINARY_LOG_EXTENSION ".trj"
+
+/**
+ * \brief The speed, in metres or radians per second, below which the robot is
+ * considered to be at rest.
+ */
+#define REST_SPEED 0.01f
+
+/**
+ * \brief The distance, in metres, from its final position within which the
+ * robot is considered to have arrived.
+ */
+#define ARRIVAL_DISTANCE 0.02f
+
+/**
+ * \brief The starting conditions of one simulation.
+ */
+typedef struct {
+	/**
+	 * \brief The parameters passed to the primitive.
+	 */
+	primitive_params_t params;
+
+	/**
+	 * \brief The initial position (X, Y, angle) of the robot.
+	 */
+	float pos[3];
+
+	/**
+	 * \brief The initial velocity of the robot.
+	 */
+	float vel[3];
+
+	/**
+	 * \brief The position of the ball.
+	 */
+	float ball[2];
+
+	/**
+	 * \brief The sensor and actuator imperfections to simulate; all zero for
+	 * a perfect robot.
+	 */
+	sim_noise_t noise;
+
+	/**
+	 * \brief The seed for the random numbers behind \ref noise.
+	 */
+	uint64_t seed;
+} fwsim_case_t;
+
+/**
+ * \brief The outcome of one simulation.
+ */
+typedef struct {
+	/**
+	 * \brief The position of the robot when the simulation ended.
+	 */
+	float pos[3];
+
+	/**
+	 * \brief The velocity of the robot when the simulation ended.
+	 */
+	float vel[3];
+
+	/**
+	 * \brief The last time at which the robot was moving faster than \ref
+	 * REST_SPEED, or zero if it never was.
+	 */
+	float settle_time;
+
+	/**
+	 * \brief The last time at which the robot was farther than \ref
+	 * ARRIVAL_DISTANCE from its final position, or zero if it never was.
+	 *
+	 * Unlike \ref settle_time, this stays meaningful when noise keeps the
+	 * robot from ever coming to rest.
+	 */
+	float arrival_time;
+
+	/**
+	 * \brief The furthest the robot went past its final position, in metres,
+	 * measured along the line from its starting position to its final one.
+	 */
+	float overshoot;
+} fwsim_result_t;
+
+/**
+ * \brief The number of fields of \ref fwsim_case_t that can be set by name.
+ */
+#define FWSIM_NUM_CASE_FIELDS 24
+
+extern const char *const FWSIM_CASE_FIELDS[FWSIM_NUM_CASE_FIELDS];
+
+unsigned int fwsim_case_field(const char *name);
+void fwsim_case_set(fwsim_case_t *c, unsigned int field, double value);
+void fwsim_run(unsigned int primitive, const fwsim_case_t *c, const char *log_file, fwsim_result_t *result);
+void fwsim_run_batch(unsigned int primitive, const fwsim_case_t *cases, fwsim_result_t *results, size_t count, long threads, const char *trajectory_dir);
+
+#endif
@@ -0,0 +1,175 @@
+/**
+ * \file
+ *
+ * \brief Runs a primitive over a grid or random sample of parameters and
+ * initial states, using every core, and writes one CSV line per run.
+ *
+ * Usage: sweep [-j THREADS] [-n SAMPLES] [-s SEED] [-t DIR] OUTFILE PRIM SPEC...
+ *
+ * Each SPEC has the form NAME=MIN:MAX:STEPS, where NAME is one of p0, p1, p2,
+ * p3, extra and slow (the primitive parameters), x, y, theta, vx, vy and va (the
+ * robot’s initial state), bx and by (the ball position) or one of the noise
+ * settings listed in run.c. Anything not given is zero. Without -n, every combination of STEPS evenly spaced values of
+ * each SPEC is run; with -n, SAMPLES runs are drawn uniformly at random
+ * between each MIN and MAX and STEPS may be omitted. With -t, each run’s
+ * trajectory is also written to DIR in the binary format, named after its
+ * line number in OUTFILE.
+ */
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "run.h"
+
+typedef struct {
+    double min, max;
+    unsigned long steps;
+} dimension_t;
+
+/**
+ * \brief Returns a uniformly distributed number in [0, 1) from an xorshift
+ * generator.
+ */
+static double next_uniform(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return (double)(*state >> 11) / 9007199254740992.0;
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "Usage: sweep [-j THREADS] [-n SAMPLES] [-s SEED] [-t DIR] OUTFILE PRIM NAME=MIN:MAX[:STEPS]...\n");
+    fprintf(stderr, "NAME is one of:");
+    for (unsigned int i = 0; i < FWSIM_NUM_CASE_FIELDS; i++)
+    {
+        fprintf(stderr, " %s", FWSIM_CASE_FIELDS[i]);
+    }
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char **argv)
+{
+    long threads          = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned long samples = 0;
+    uint64_t seed         = 1;
+    const char *trajectory_dir = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "j:n:s:t:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'j':
+                threads = strtol(optarg, NULL, 0);
+                break;
+            case 'n':
+                samples = strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                seed = strtoull(optarg, NULL, 0);
+                break;
+            case 't':
+                trajectory_dir = optarg;
+                break;
+            default:
+                usage();
+                return 1;
+        }
+    }
+    if (argc - optind < 2 || threads < 1)
+    {
+        usage();
+        return 1;
+    }
+    const char *out_name = argv[optind];
+    unsigned int primitive = (unsigned int)strtoul(argv[optind + 1], NULL, 0);
+
+    dimension_t dims[FWSIM_NUM_CASE_FIELDS];
+    for (unsigned int i = 0; i < FWSIM_NUM_CASE_FIELDS; i++)
+    {
+        dims[i].min = dims[i].max = 0.0;
+        dims[i].steps             = 1;
+    }
+    for (int i = optind + 2; i < argc; i++)
+    {
+        char name[16];
+        double min, max;
+        unsigned long steps = 1;
+        int fields = sscanf(argv[i], "%15[a-z0-9_]=%lf:%lf:%lu", name, &min, &max, &steps);
+        unsigned int dim = fwsim_case_field(name);
+        if (fields < 3 || (fields < 4 && !samples) || !steps || dim == FWSIM_NUM_CASE_FIELDS)
+        {
+            fprintf(stderr, "Bad SPEC “%s”\n", argv[i]);
+            usage();
+            return 1;
+        }
+        dims[dim].min   = min;
+        dims[dim].max   = max;
+        dims[dim].steps = steps;
+    }
+
+    // Lay out every case up front so the output order does not depend on
+    // thread scheduling.
+    size_t count = samples;
+    if (!samples)
+    {
+        count = 1;
+        for (unsigned int i = 0; i < FWSIM_NUM_CASE_FIELDS; i++)
+        {
+            count *= dims[i].steps;
+        }
+    }
+    fwsim_case_t *cases      = calloc(count, sizeof(*cases));
+    fwsim_result_t *results  = calloc(count, sizeof(*results));
+    if (!cases || !results)
+    {
+        fprintf(stderr, "Out of memory for %zu runs\n", count);
+        return 1;
+    }
+    uint64_t rng = seed ? seed : 1;
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t rest = i;
+        for (unsigned int dim = 0; dim < FWSIM_NUM_CASE_FIELDS; dim++)
+        {
+            double value;
+            if (samples)
+            {
+                value = dims[dim].min + (dims[dim].max - dims[dim].min) * next_uniform(&rng);
+            }
+            else
+            {
+                unsigned long step = rest % dims[dim].steps;
+                rest /= dims[dim].steps;
+                value = dims[dim].steps > 1 ? dims[dim].min + (dims[dim].max - dims[dim].min) * step / (dims[dim].steps - 1) : dims[dim].min;
+            }
+            fwsim_case_set(&cases[i], dim, value);
+        }
+    }
+
+    fwsim_run_batch(primitive, cases, results, count, threads, trajectory_dir);
+
+    FILE *out = fopen(out_name, "w");
+    if (!out)
+    {
+        fprintf(stderr, "%s: %s\n", out_name, strerror(errno));
+        return 1;
+    }
+    fprintf(out, "PRIM, P0, P1, P2, P3, EXTRA, SLOW, X0, Y0, THETA0, VX0, VY0, VA0, BX, BY, X, Y, THETA, VX, VY, VA, SETTLE_TIME, ARRIVAL_TIME, OVERSHOOT\n");
+    for (size_t i = 0; i < count; i++)
+    {
+        const fwsim_case_t *c   = &cases[i];
+        const fwsim_result_t *r = &results[i];
+        fprintf(out, "%u, %d, %d, %d, %d, %u, %d, ", primitive, c->params.params[0], c->params.params[1], c->params.params[2], c->params.params[3], c->params.extra, c->params.slow);
+        fprintf(out, "%f, %f, %f, %f, %f, %f, %f, %f, ", c->pos[0], c->pos[1], c->pos[2], c->vel[0], c->vel[1], c->vel[2], c->ball[0], c->ball[1]);
+        fprintf(out, "%f, %f, %f, %f, %f, %f, %f, %f, %f\n", r->pos[0], r->pos[1], r->pos[2], r->vel[0], r->vel[1], r->vel[2], r->settle_time, r->arrival_time, r->overshoot);
+    }
+    fclose(out);
+
+    free(results);
+    free(cases);
+    return 0;
+}